@@ -27,6 +27,8 @@ function print_compile_options() {
     echo "                enable_gmssl: ${rtt_enable_gmssl}"
     echo "enable_protocol_mpc_securenn: ${rtt_enable_protocol_mpc_securenn}"
     echo "   enable_protocol_mpc_helix: ${rtt_enable_protocol_mpc_helix}"
+    echo "   enable_protocol_mpc_ot2pc: ${rtt_enable_protocol_mpc_ot2pc}"
+    echo "  enable_protocol_mpc_shamir: ${rtt_enable_protocol_mpc_shamir}"
 
     echo "          enable_protocol_zk: ${rtt_enable_protocol_zk}"
     echo "               enable_128bit: ${rtt_enable_128bit}"
@@ -48,6 +50,8 @@ function save_compile_options() {
     echo "${rtt_enable_128bit}" >>${compile_options_file}
     echo "${rtt_enable_shape_inference}" >>${compile_options_file}
     echo "${rtt_enable_tests}" >>${compile_options_file}
+    echo "${rtt_enable_protocol_mpc_ot2pc}" >>${compile_options_file}
+    echo "${rtt_enable_protocol_mpc_shamir}" >>${compile_options_file}
 }
 function load_compile_options() {
     if [ ! -f "${compile_options_file}" ]; then
@@ -65,6 +69,8 @@ function load_compile_options() {
     export rtt_enable_128bit=${x[7]}
     export rtt_enable_shape_inference=${x[8]}
     export rtt_enable_tests=${x[9]}
+    export rtt_enable_protocol_mpc_ot2pc=${x[10]:-OFF}
+    export rtt_enable_protocol_mpc_shamir=${x[11]:-OFF}
 }
 
 #
@@ -87,9 +93,8 @@ function install_emptoolkit() {
     echo "install emp-tool ok. Elapsed Time (using \$SECONDS): $SECONDS seconds"
 }
 
-# install emp-zk
-function install_emp_zk() {
-    # install emp-ot
+# install emp-ot
+function install_emp_ot() {
     echo "to install emp-ot..."
 
     mkdir -p ${third_builddir}/emp-ot
@@ -99,8 +104,10 @@ function install_emp_zk() {
         -DCMAKE_BUILD_TYPE=${rtt_build_type}
     make -j4 && make install
     echo "install emp-ot ok"
+}
 
-    # install emp-zk
+# install emp-zk
+function install_emp_zk() {
     echo "to install emp-zk..."
     mkdir -p ${third_builddir}/emp-zk
     cd ${third_builddir}/emp-zk
@@ -126,9 +133,13 @@ function compile_cpp() {
         -DCMAKE_BUILD_TYPE=${rtt_build_type} \
         -DROSETTA_MPC_128=${rtt_enable_128bit} \
         -DROSETTA_ENABLES_SHAPE_INFERENCE=${rtt_enable_shape_inference} \
+        -DROSETTA_ENABLES_SECURE_DEBUG=${ROSETTA_ENABLES_SECURE_DEBUG:-OFF} \
+        -DROSETTA_LOG_MIN_LEVEL=${ROSETTA_LOG_MIN_LEVEL:-0} \
         -DROSETTA_COMPILE_TESTS=${rtt_enable_tests} \
         -DROSETTA_ENABLES_PROTOCOL_MPC_SECURENN=${rtt_enable_protocol_mpc_securenn} \
         -DROSETTA_ENABLES_PROTOCOL_MPC_HELIX=${rtt_enable_protocol_mpc_helix} \
+        -DROSETTA_ENABLES_PROTOCOL_MPC_OT2PC=${rtt_enable_protocol_mpc_ot2pc:-OFF} \
+        -DROSETTA_ENABLES_PROTOCOL_MPC_SHAMIR=${rtt_enable_protocol_mpc_shamir:-OFF} \
         -DROSETTA_ENABLES_PROTOCOL_ZK=${rtt_enable_protocol_zk} \
         -DUSE_GMTASSL=${rtt_enable_gmssl} \
         -DCMAKE_PREFIX_PATH=${builddir}
@@ -173,6 +184,7 @@ function run_protocol_mpc_snn_tests() {
 
     # sepcs here
     run_protocol_mpc_test protocol_mpc_snn_tests_snn_matmul
+    run_protocol_mpc_test protocol_mpc_tests_snn_secure_debug
 
     echo "run run protocol mpc snn tests end."
 }
@@ -183,6 +195,7 @@ function run_protocol_mpc_helix_tests() {
     run_protocol_mpc_test protocol_mpc_tests_helix_check
 
     # sepcs here
+    run_protocol_mpc_test protocol_mpc_tests_helix_secure_debug
 
     echo "run run protocol mpc helix tests end."
 }
@@ -247,6 +260,9 @@ if [ "${rtt_command}" = "compile" ]; then
 
     # install deps. emp-toolkit, ...
     install_emptoolkit
+    if [ "${rtt_enable_protocol_zk}" = "ON" ] || [ "${rtt_enable_protocol_mpc_ot2pc}" = "ON" ]; then
+        install_emp_ot
+    fi
     if [ "${rtt_enable_protocol_zk}" = "ON" ]; then
         install_emp_zk
     fi
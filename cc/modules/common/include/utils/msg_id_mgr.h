@@ -20,10 +20,13 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include <iostream>
 #include <assert.h>
 #include <limits>
 #include <atomic>
+#include <mutex>
 
 #include "msg_id.h"
 
@@ -55,6 +58,47 @@ class MsgIdMgr {
    */
   bool UpdateMsgIdInfo(const string& msg_infos);
 
+  /**
+   * @desc: Update the message ids of a graph from its binary table, built once
+   *     when the graph is finalized (see msg_id_gen.py)
+   * @param:
+   * 	table, "RTTMID01", uint32 count, then per node:
+   * 		uint32 message id index, uint32 name length, op name
+   * 		(little-endian). The msg_id_t of every node is computed here, once.
+   * @returns:
+   * 	True if success, false if the table is malformed (nothing is updated).
+   */
+  bool UpdateMsgIdTable(const string& table);
+
+  /**
+   * @desc: Find the message id of an operation, without adding it.
+   *     Kernels resolve theirs once at construction, and again only when
+   *     TableVersion changes.
+   * @returns:
+   * 	True if found
+   */
+  bool FindMsgId(const string& OpName, msg_id_t& msg_id);
+
+  /**
+   * @desc: The message id the graph op OpName runs under in task TaskId, the
+   *     entry of the table (keyed by the graph name, see msg_id_gen.py) if it is
+   *     there, else derived from TaskOpName(OpName, TaskId). Table ids need no
+   *     task in them, each task talks through its own IO wrapper.
+   *     Kernels and the ops that refer to another kernel's state (eg.
+   *     DropoutGrad) resolve names through this.
+   * @returns:
+   * 	True if the message id comes from the table
+   */
+  bool ResolveMsgId(const string& OpName, const string& TaskId, msg_id_t& msg_id);
+
+  //! the name of a graph op in a task, the source of its message id outside the table
+  static string TaskOpName(const string& OpName, const string& TaskId) {
+    return OpName + "#T" + TaskId;
+  }
+
+  //! changes with every update of the message ids
+  uint64_t TableVersion() const { return _version; }
+
   /**
    * @desc: Get the message id from the operation name
    * @param:
@@ -80,9 +124,15 @@ class MsgIdMgr {
    */
   id_type GetMaxMsgIdNum();
 
+ private:
+  // publishes the entries of an update
+  void Publish(std::vector<std::pair<string, msg_id_t>>& entries, id_type max_id);
+
  private:
   // message id maping to message id info
+  std::mutex _mutex;
   unordered_map<string, msg_id_t> _msg_id_info;
+  std::atomic<uint64_t> _version{0};
 
   // default graph max id value
   std::atomic<id_type> _MaxId{0};
@@ -25,6 +25,7 @@
 #include <string>
 #include <vector>
 #include <iomanip>
+#include <map>
 
 #define DO_ELAPSED_STATISTIC 0
 namespace rosetta {
@@ -106,6 +107,18 @@ class PerfStats {
   } s;
   struct timespec process_cpu_time; // for s.cpu_seconds field
 
+  // numeric range of op outputs, only filled in secure-debug builds.
+  // @see cc/modules/protocol/mpc/comm/include/mpc_secure_debug.h
+  struct __numeric_stat {
+    uint64_t calls = 0;
+    uint64_t overflows = 0; // values out of the safe range for the precision
+    double max_abs = 0; // upper bound of max |x|, a power of 2
+    int lost_bits = 0; // max fractional bits missing on the smallest non-zero values
+  };
+  std::map<std::string, __numeric_stat> numerics;
+  std::string first_overflow; // "op @ msg_id" of the first op out of the safe range
+  std::string precision_hint;
+
   bool do_memcpu_stats = false;
   /**
    * start timer/mem/cpu/...
@@ -0,0 +1,192 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+/**
+ * asynchronous binary event log for hot paths
+ *
+ * ATRACE/ADEB/AAUDIT record a binary event into a bounded ring and return: the format
+ * literal (by pointer), the msg id digest, up to ASYNC_LOG_MAX_ARGS integer or string
+ * arguments and a copy of at most AUDIT_ARRAY_LIMIT elements of a payload vector.
+ * A background thread renders the events with the Vector<T> formatting and writes them
+ * to the task logger.
+ *
+ * The "{}" of the format are filled in order by the msg id, the arguments and the payload:
+ *   AAUDIT("id:{}, P{} Reveal, input(Share){}", msgid, player, X);
+ *
+ * The producer never blocks, if the ring is full the event is dropped and the number of
+ * dropped events is reported with the next written one. Levels below ROSETTA_LOG_MIN_LEVEL
+ * are compiled out like the synchronous macros (see rtt_logger.h).
+ */
+#include "cc/modules/common/include/utils/rtt_logger.h"
+#include "cc/modules/common/include/utils/msg_id.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define ASYNC_LOG_MAX_ARGS 6
+#define ASYNC_LOG_RING_SIZE 8192
+
+namespace rosetta {
+
+struct AsyncLogEvent {
+  int level = LogLevel::Info;
+  const char* fmt = nullptr; //! must be a string literal, it is read by the background thread
+  char msgid[BIN_SIZE];
+  int nargs = 0;
+  int64_t args[ASYNC_LOG_MAX_ARGS]; //! the value, or the offset in strs if kinds[i] is 's'
+  char kinds[ASYNC_LOG_MAX_ARGS];
+  std::string strs; //! '\0' separated string arguments
+  size_t size = 0; //! number of elements of the payload vector
+  size_t count = 0; //! number of elements copied into payload
+  std::string payload;
+  void (*format)(std::ostream&, const std::string&, size_t) = nullptr;
+  std::string task_id;
+};
+
+template <typename T>
+void async_log_format(std::ostream& os, const std::string& payload, size_t count) {
+  std::vector<T> vec(count);
+  memcpy((char*)vec.data(), payload.data(), count * sizeof(T));
+  os << Vector<T>(vec);
+}
+
+class AsyncLogger {
+ public:
+  static AsyncLogger& Get();
+  ~AsyncLogger();
+
+  //! runtime level of the async events, set together with Logger::set_level by set_log_level
+  void set_level(int level) { level_ = level; }
+  int level() const { return level_.load(std::memory_order_relaxed); }
+  bool should_log(int level) const { return level >= level_.load(std::memory_order_relaxed); }
+
+  template <typename... Args>
+  void log(
+    int level,
+    const std::string& task_id,
+    const char* fmt,
+    const msg_id_t& msgid,
+    const Args&... args) {
+    static_assert(sizeof...(Args) <= ASYNC_LOG_MAX_ARGS + 1, "too many async log arguments");
+    if (!should_log(level))
+      return;
+
+    std::unique_lock<std::mutex> lck(mtx_);
+    if (count_ == ring_.size()) {
+      dropped_++;
+      return;
+    }
+    AsyncLogEvent& ev = ring_[(head_ + count_) % ring_.size()];
+    ev.level = level;
+    ev.fmt = fmt;
+    memcpy(ev.msgid, msgid.data(), BIN_SIZE);
+    ev.nargs = 0;
+    ev.strs.clear();
+    ev.size = ev.count = 0;
+    ev.format = nullptr;
+    ev.task_id.assign(task_id);
+    int dummy[] = {0, (capture(ev, args), 0)...};
+    (void)dummy;
+    count_++;
+    lck.unlock();
+    cv_.notify_one();
+  }
+
+  //! blocks until every recorded event is written
+  void flush();
+
+ private:
+  AsyncLogger();
+  AsyncLogger(const AsyncLogger&) = delete;
+  AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+  template <typename T>
+  static void capture(AsyncLogEvent& ev, const T& v) {
+    if (ev.nargs == ASYNC_LOG_MAX_ARGS)
+      return;
+    ev.kinds[ev.nargs] = 'i';
+    ev.args[ev.nargs++] = (int64_t)v;
+  }
+  static void capture(AsyncLogEvent& ev, const std::string& v) {
+    if (ev.nargs == ASYNC_LOG_MAX_ARGS)
+      return;
+    ev.kinds[ev.nargs] = 's';
+    ev.args[ev.nargs++] = ev.strs.size();
+    ev.strs.append(v.c_str(), v.size() + 1);
+  }
+  template <typename T>
+  static void capture(AsyncLogEvent& ev, const std::vector<T>& v) {
+    ev.size = v.size();
+    ev.count = std::min(v.size(), (size_t)AUDIT_ARRAY_LIMIT);
+    ev.payload.assign((const char*)v.data(), ev.count * sizeof(T));
+    ev.format = &async_log_format<T>;
+  }
+
+  void run();
+  void write(const AsyncLogEvent& ev);
+
+ private:
+  //! records everything until a level is set, the task logger filters again when writing,
+  //! so events are never dropped that the synchronous logger would have written
+  std::atomic<int> level_{LogLevel::Trace};
+  std::vector<AsyncLogEvent> ring_;
+  size_t head_ = 0;
+  size_t count_ = 0;
+  bool busy_ = false;
+  bool stop_ = false;
+  uint64_t dropped_ = 0;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::condition_variable idle_cv_;
+  std::thread worker_;
+};
+
+/**
+ * Sets the runtime level of the task loggers and of the async events, use it instead of
+ * Logger::set_level so that both filter the same events.
+ */
+inline void set_log_level(int level) {
+  Logger::Get().set_level(level);
+  AsyncLogger::Get().set_level(level);
+}
+
+} // namespace rosetta
+
+#if ROSETTA_LOG_MIN_LEVEL > 0 // Trace
+#define ATRACE(...) RTT_ELIDED_LOG_()
+#else
+#define ATRACE(...) rosetta::AsyncLogger::Get().log(LogLevel::Trace, context_->TASK_ID, ##__VA_ARGS__)
+#endif
+#if ROSETTA_LOG_MIN_LEVEL > 1 // Debug
+#define ADEB(...) RTT_ELIDED_LOG_()
+#else
+#define ADEB(...) rosetta::AsyncLogger::Get().log(LogLevel::Debug, context_->TASK_ID, ##__VA_ARGS__)
+#endif
+#if ROSETTA_LOG_MIN_LEVEL > 2 // Audit
+#define AAUDIT(...) RTT_ELIDED_LOG_()
+#else
+#define AAUDIT(...) rosetta::AsyncLogger::Get().log(LogLevel::Audit, context_->TASK_ID, ##__VA_ARGS__)
+#endif
@@ -53,3 +53,27 @@ make_general_exception(ssl_socket);
 make_general_exception(socket_recv);
 make_general_exception(socket_send);
 make_general_exception(other);
+make_general_exception(replay_divergence);
+
+// a peer is disconnected, silent or too slow, node() is the peer
+class network_failure_exp : public exception {
+  string node_;
+  string msg_;
+
+ public:
+  network_failure_exp(const string& node, const string& s = "", const string& cls = "network_failure")
+      : node_(node) {
+    msg_ = string("exception ") + cls + " - node " + node;
+    if (!s.empty())
+      msg_ = msg_ + ": " + s;
+  }
+  const string& node() const { return node_; }
+  virtual const char* what() const throw() { return msg_.c_str(); }
+};
+
+// the task was aborted on purpose, node() is the party that asked
+class peer_abort_exp : public network_failure_exp {
+ public:
+  peer_abort_exp(const string& node, const string& s = "")
+      : network_failure_exp(node, s, "peer_abort") {}
+};
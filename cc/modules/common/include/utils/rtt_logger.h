@@ -23,6 +23,8 @@
 #include "cc/modules/common/include/utils/logger_vector.h"
 #include "spdlog/loggers.h"
 
+#include <ostream>
+
 enum LogLevel {
 	Trace = 0,
 	Debug,
@@ -34,6 +36,67 @@ enum LogLevel {
 	Off
 };
 
+/**
+ * Compile-time minimum log level, one of LogLevel (cmake -DROSETTA_LOG_MIN_LEVEL=2).
+ * Calls below it expand to nothing, so their arguments (Vector<T>(X), msgid.get_hex(), ...)
+ * are never evaluated. The default 0 compiles everything in and leaves it to the runtime level.
+ */
+#ifndef ROSETTA_LOG_MIN_LEVEL
+#define ROSETTA_LOG_MIN_LEVEL 0
+#endif
+
+struct rtt_null_log_stream {
+	template<typename T>
+	const rtt_null_log_stream& operator<<(const T&) const { return *this; }
+	const rtt_null_log_stream& operator<<(std::ostream& (*)(std::ostream&)) const { return *this; }
+};
+
+#define RTT_ELIDED_LOG_(...) do {} while (0)
+#define RTT_ELIDED_LOG_STREAM_(task) if (true) {} else rtt_null_log_stream()
+
+#if ROSETTA_LOG_MIN_LEVEL > 0 // Trace
+#undef TTRACE_
+#undef tlog_trace_
+#define TTRACE_(...) RTT_ELIDED_LOG_()
+#define tlog_trace_(task) RTT_ELIDED_LOG_STREAM_(task)
+#endif
+#if ROSETTA_LOG_MIN_LEVEL > 1 // Debug
+#undef TDEB_
+#undef tlog_debug_
+#define TDEB_(...) RTT_ELIDED_LOG_()
+#define tlog_debug_(task) RTT_ELIDED_LOG_STREAM_(task)
+#endif
+#if ROSETTA_LOG_MIN_LEVEL > 2 // Audit
+#undef TAUDIT_
+#undef tlog_audit_
+#define TAUDIT_(...) RTT_ELIDED_LOG_()
+#define tlog_audit_(task) RTT_ELIDED_LOG_STREAM_(task)
+#endif
+#if ROSETTA_LOG_MIN_LEVEL > 3 // Info
+#undef TINFO_
+#undef tlog_info_
+#define TINFO_(...) RTT_ELIDED_LOG_()
+#define tlog_info_(task) RTT_ELIDED_LOG_STREAM_(task)
+#endif
+#if ROSETTA_LOG_MIN_LEVEL > 4 // Warn
+#undef TWARN_
+#undef tlog_warn_
+#define TWARN_(...) RTT_ELIDED_LOG_()
+#define tlog_warn_(task) RTT_ELIDED_LOG_STREAM_(task)
+#endif
+#if ROSETTA_LOG_MIN_LEVEL > 5 // Error
+#undef TERROR_
+#undef tlog_error_
+#define TERROR_(...) RTT_ELIDED_LOG_()
+#define tlog_error_(task) RTT_ELIDED_LOG_STREAM_(task)
+#endif
+#if ROSETTA_LOG_MIN_LEVEL > 6 // Fatal
+#undef TFATAL_
+#undef tlog_fatal_
+#define TFATAL_(...) RTT_ELIDED_LOG_()
+#define tlog_fatal_(task) RTT_ELIDED_LOG_STREAM_(task)
+#endif
+
 // log stream 
 #if 1
 #define log_trace tlog_trace_("")
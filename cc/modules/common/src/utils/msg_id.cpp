@@ -31,7 +31,7 @@
 using namespace std;
 
 #if USE_SHA256_ID
-#include <openssl/sha.h>
+#include <openssl/evp.h>
 namespace {
 inline std::string to_hex(const char* data, int size) {
   /**
@@ -40,11 +40,11 @@ inline std::string to_hex(const char* data, int size) {
    */
   //return std::string("");
 
-  std::string str("");
-  char tmp[3] = {0};
+  static const char digits[] = "0123456789abcdef";
+  std::string str(size * 2, '0');
   for (int i = 0; i < size; i++) {
-    sprintf(tmp, "%02x", data[i] & 0xFF);
-    str += std::string(tmp, 2);
+    str[2 * i] = digits[(data[i] >> 4) & 0x0F];
+    str[2 * i + 1] = digits[data[i] & 0x0F];
   }
   return str;
 }
@@ -155,8 +155,11 @@ bool msg_id_t::operator==(const msg_id_t& id) const {
 
 #if USE_SHA256_ID
 void msg_id_t::hash() {
-  char bin[33] = {0};
-  ::SHA256((const unsigned char*)src_.data(), src_.size(), (unsigned char*)bin);
+  // the digest is looked up once, with OpenSSL 3 the one-shot ::SHA256 fetches it on every call
+  static const EVP_MD* sha256 = EVP_sha256();
+  unsigned char bin[EVP_MAX_MD_SIZE] = {0};
+  unsigned int len = 0;
+  EVP_Digest(src_.data(), src_.size(), bin, &len, sha256, nullptr);
   memcpy(bin_, bin, BIN_SIZE); // get the first BIN_SIZE bytes
   str_.assign(to_hex(bin_, BIN_SIZE));
 }
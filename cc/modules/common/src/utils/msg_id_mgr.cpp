@@ -27,6 +27,7 @@
 #include <deque>
 #include <iostream>
 #include <cassert>
+#include <cstring>
 using namespace std;
 
 ////////////////////////////////////////////////////////////
@@ -42,11 +43,35 @@ MsgIdMgr* MsgIdMgr::Instance() {
   return &_MsgIdMgrInst;
 }
 
+namespace {
+const char kMsgIdTableMagic[8] = {'R', 'T', 'T', 'M', 'I', 'D', '0', '1'};
+
+bool get_u32(const string& table, size_t& pos, uint32_t& v) {
+  if (table.size() - pos < sizeof(v))
+    return false;
+  memcpy(&v, table.data() + pos, sizeof(v));
+  pos += sizeof(v);
+  return true;
+}
+} // namespace
+
+void MsgIdMgr::Publish(vector<pair<string, msg_id_t>>& entries, id_type max_id) {
+  std::unique_lock<std::mutex> lck(_mutex);
+  if (max_id > _MaxId)
+    _MaxId = max_id;
+  _msg_id_info.reserve(_msg_id_info.size() + entries.size());
+  for (auto& entry : entries)
+    _msg_id_info[std::move(entry.first)] = entry.second;
+  _version++;
+}
+
 bool MsgIdMgr::UpdateMsgIdInfo(const string& msg_infos) {
   if (msg_infos.empty())
     return false;
 
   bool ret = true;
+  id_type max_id = 0;
+  vector<pair<string, msg_id_t>> entries;
   size_t start_pos = 0;
   size_t len = msg_infos.find_first_of(_delim);
   string unit_info;
@@ -57,9 +82,9 @@ bool MsgIdMgr::UpdateMsgIdInfo(const string& msg_infos) {
       string op_name = unit_info.substr(0, pos);
       string uid = unit_info.substr(pos + 1);
       id_type nid = strtoul(uid.c_str(), nullptr, 10);
-      if (nid > _MaxId)
-        _MaxId = nid;
-      _msg_id_info[op_name] = msg_id_t(nid, op_name);
+      if (nid > max_id)
+        max_id = nid;
+      entries.emplace_back(op_name, msg_id_t(nid, op_name));
     } else {
       std::cout << "message id format incorret!(" << unit_info << ")" << std::endl;
       ret = false;
@@ -70,15 +95,68 @@ bool MsgIdMgr::UpdateMsgIdInfo(const string& msg_infos) {
     len = msg_infos.find_first_of(_delim, start_pos);
   }
 
+  Publish(entries, max_id);
   return ret;
 }
 
+bool MsgIdMgr::UpdateMsgIdTable(const string& table) {
+  size_t pos = sizeof(kMsgIdTableMagic);
+  uint32_t count = 0;
+  if (table.size() < pos || memcmp(table.data(), kMsgIdTableMagic, pos) != 0 ||
+      !get_u32(table, pos, count)) {
+    log_error << "message id table: bad header";
+    return false;
+  }
+
+  id_type max_id = 0;
+  vector<pair<string, msg_id_t>> entries;
+  entries.reserve(count);
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t nid = 0, name_len = 0;
+    if (!get_u32(table, pos, nid) || !get_u32(table, pos, name_len) || table.size() - pos < name_len) {
+      log_error << "message id table: entry " << i << " of " << count << " is cut short";
+      return false;
+    }
+    string op_name(table.data() + pos, name_len);
+    pos += name_len;
+    if (nid > max_id)
+      max_id = nid;
+    entries.emplace_back(op_name, msg_id_t(id_type(nid), op_name));
+  }
+  if (pos != table.size()) {
+    log_error << "message id table: " << table.size() - pos << " trailing bytes";
+    return false;
+  }
+
+  Publish(entries, max_id);
+  log_debug << "message id table: " << count << " entries";
+  return true;
+}
+
 msg_id_t& MsgIdMgr::GetMsgIdFromOpName(const string& OpName) {
   assert(!OpName.empty());
+  std::unique_lock<std::mutex> lck(_mutex);
   return _msg_id_info[OpName];
 }
 
+bool MsgIdMgr::FindMsgId(const string& OpName, msg_id_t& msg_id) {
+  std::unique_lock<std::mutex> lck(_mutex);
+  auto iter = _msg_id_info.find(OpName);
+  if (iter == _msg_id_info.end() || iter->second.str().empty())
+    return false;
+  msg_id = iter->second;
+  return true;
+}
+
+bool MsgIdMgr::ResolveMsgId(const string& OpName, const string& TaskId, msg_id_t& msg_id) {
+  if (FindMsgId(OpName, msg_id))
+    return true;
+  msg_id = msg_id_t(TaskOpName(OpName, TaskId));
+  return false;
+}
+
 msg_id_t& MsgIdMgr::GetUniqueMsgId(const string& unique_name) {
+  std::unique_lock<std::mutex> lck(_mutex);
   auto iter = _msg_id_info.find(unique_name);
   if (iter != _msg_id_info.end())
     return _msg_id_info[unique_name];
@@ -254,6 +254,9 @@ void PerfStats::reset() {
   name = "default";
   do_memcpu_stats = false;
   memset(&s, 0, sizeof(__stat));
+  numerics.clear();
+  first_overflow.clear();
+  precision_hint.clear();
 }
 
 std::string PerfStats::to_console() {
@@ -315,6 +318,34 @@ void write_obj(WRITER_REF& writer, const PerfStats& ps) {
       // writer.Double(ps.s.avg_cpuusage);
     }
     writer.EndObject();
+
+    if (!ps.numerics.empty()) {
+      writer.Key("secure-debug");
+      writer.StartObject();
+      {
+        writer.Key("first-overflow");
+        writer.String(ps.first_overflow.c_str());
+        writer.Key("hint");
+        writer.String(ps.precision_hint.c_str());
+        writer.Key("ops");
+        writer.StartObject();
+        for (auto& iter : ps.numerics) {
+          writer.Key(iter.first.c_str());
+          writer.StartObject();
+          writer.Key("calls");
+          writer.Int64(iter.second.calls);
+          writer.Key("overflows");
+          writer.Int64(iter.second.overflows);
+          writer.Key("max-abs");
+          writer.Double(iter.second.max_abs);
+          writer.Key("lost-bits");
+          writer.Int(iter.second.lost_bits);
+          writer.EndObject();
+        }
+        writer.EndObject();
+      }
+      writer.EndObject();
+    }
   }
   writer.EndObject();
 }
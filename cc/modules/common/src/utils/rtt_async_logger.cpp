@@ -0,0 +1,128 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/common/include/utils/rtt_async_logger.h"
+
+#include <sstream>
+
+namespace rosetta {
+
+AsyncLogger& AsyncLogger::Get() {
+  static AsyncLogger logger;
+  return logger;
+}
+
+AsyncLogger::AsyncLogger() : ring_(ASYNC_LOG_RING_SIZE) {
+  // constructs the underlying logger first, so that it outlives this one at exit
+  Logger::Get();
+  worker_ = std::thread(&AsyncLogger::run, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  if (worker_.joinable())
+    worker_.join();
+}
+
+void AsyncLogger::flush() {
+  std::unique_lock<std::mutex> lck(mtx_);
+  idle_cv_.wait(lck, [this] { return count_ == 0 && !busy_; });
+}
+
+void AsyncLogger::run() {
+  AsyncLogEvent ev;
+  std::unique_lock<std::mutex> lck(mtx_);
+  while (true) {
+    cv_.wait(lck, [this] { return stop_ || count_ > 0; });
+    if (count_ == 0) // stopped and drained
+      break;
+
+    // swap out, so the payload buffers keep their capacity in the ring
+    std::swap(ev, ring_[head_]);
+    head_ = (head_ + 1) % ring_.size();
+    count_--;
+    uint64_t dropped = dropped_;
+    dropped_ = 0;
+    busy_ = true;
+    lck.unlock();
+
+    if (dropped > 0)
+      tlog_warn_(ev.task_id) << "[async-log] ring full, dropped " << dropped << " events";
+    write(ev);
+
+    lck.lock();
+    busy_ = false;
+    if (count_ == 0)
+      idle_cv_.notify_all();
+  }
+  idle_cv_.notify_all();
+}
+
+void AsyncLogger::write(const AsyncLogEvent& ev) {
+  std::stringstream ss;
+  int next = 0; // 0: msg id, [1, nargs]: args, nargs+1: payload
+  for (const char* p = ev.fmt; *p != '\0'; p++) {
+    if (p[0] != '{' || p[1] != '}') {
+      ss << *p;
+      continue;
+    }
+    if (next == 0) {
+      ss << msg_id_t(ev.msgid, BIN_SIZE).get_hex();
+    } else if (next <= ev.nargs) {
+      if (ev.kinds[next - 1] == 's')
+        ss << ev.strs.c_str() + ev.args[next - 1];
+      else
+        ss << ev.args[next - 1];
+    } else if (ev.format != nullptr) {
+      if (ev.size > ev.count)
+        ss << " [size " << ev.size << "]";
+      ev.format(ss, ev.payload, ev.count);
+    }
+    next++;
+    p++;
+  }
+
+  switch (ev.level) {
+    case LogLevel::Trace:
+      tlog_trace_(ev.task_id) << ss.str();
+      break;
+    case LogLevel::Debug:
+      tlog_debug_(ev.task_id) << ss.str();
+      break;
+    case LogLevel::Audit:
+      tlog_audit_(ev.task_id) << ss.str();
+      break;
+    case LogLevel::Info:
+      tlog_info_(ev.task_id) << ss.str();
+      break;
+    case LogLevel::Warn:
+      tlog_warn_(ev.task_id) << ss.str();
+      break;
+    case LogLevel::Error:
+      tlog_error_(ev.task_id) << ss.str();
+      break;
+    default:
+      tlog_fatal_(ev.task_id) << ss.str();
+      break;
+  }
+}
+
+} // namespace rosetta
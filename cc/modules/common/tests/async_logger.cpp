@@ -0,0 +1,46 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/common/tests/test.h"
+#include "cc/modules/common/include/utils/rtt_async_logger.h"
+
+TEST_CASE("async logger follows the configured level", "[common][utils]") {
+  rosetta::AsyncLogger& alog = rosetta::AsyncLogger::Get();
+  int saved = alog.level();
+
+  // nothing is filtered before a level is configured, the task logger decides
+  alog.set_level(LogLevel::Trace);
+  REQUIRE(alog.should_log(LogLevel::Trace));
+
+  rosetta::set_log_level(LogLevel::Audit);
+  REQUIRE(alog.level() == LogLevel::Audit);
+  REQUIRE_FALSE(alog.should_log(LogLevel::Trace));
+  REQUIRE_FALSE(alog.should_log(LogLevel::Debug));
+  REQUIRE(alog.should_log(LogLevel::Audit));
+  REQUIRE(alog.should_log(LogLevel::Error));
+
+  rosetta::set_log_level(LogLevel::Error);
+  REQUIRE_FALSE(alog.should_log(LogLevel::Audit));
+  REQUIRE(alog.should_log(LogLevel::Fatal));
+
+  // events below the level are not recorded, flush must not wait for them
+  msg_id_t msgid("async logger test");
+  alog.log(LogLevel::Debug, "", "id:{}, filtered {}", msgid, 1);
+  alog.flush();
+
+  rosetta::set_log_level(saved);
+}
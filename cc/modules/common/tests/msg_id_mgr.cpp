@@ -0,0 +1,70 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/common/tests/test.h"
+#include "cc/modules/common/include/utils/msg_id_mgr.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace rosetta;
+
+namespace {
+// a table as msg_id_gen.py packs it
+std::string pack_table(const std::vector<std::pair<uint32_t, std::string>>& ops) {
+  std::string table("RTTMID01");
+  auto put_u32 = [&table](uint32_t v) { table.append((const char*)&v, sizeof(v)); };
+  put_u32(ops.size());
+  for (auto& op : ops) {
+    put_u32(op.first);
+    put_u32(op.second.size());
+    table.append(op.second);
+  }
+  return table;
+}
+} // namespace
+
+TEST_CASE("utils msg_id_mgr table", "[common][utils]") {
+  MsgIdMgr* mgr = MsgIdMgr::Instance();
+  uint64_t version = mgr->TableVersion();
+  REQUIRE(mgr->UpdateMsgIdTable(pack_table({{3, "dense/SecureMatMul"}, {4, "SecureDropout"}})));
+  REQUIRE(mgr->TableVersion() != version);
+
+  // a kernel resolves its graph name, in any task, to the entry of the table
+  msg_id_t id, expected(id_type(3), std::string("dense/SecureMatMul"));
+  REQUIRE(mgr->ResolveMsgId("dense/SecureMatMul", "task-a", id));
+  REQUIRE(memcmp(id.data(), expected.data(), msg_id_t::Size()) == 0);
+  msg_id_t fallback(MsgIdMgr::TaskOpName("dense/SecureMatMul", "task-a"));
+  REQUIRE(memcmp(id.data(), fallback.data(), msg_id_t::Size()) != 0);
+
+  // DropoutGrad finds the id of its forward kernel
+  msg_id_t forward, grad;
+  REQUIRE(mgr->ResolveMsgId("SecureDropout", "task-a", forward));
+  REQUIRE(mgr->ResolveMsgId("SecureDropout", "task-a", grad));
+  REQUIRE(forward == grad);
+
+  // ops outside the table fall back to the task-qualified name
+  msg_id_t other;
+  REQUIRE(!mgr->ResolveMsgId("SecureAdd", "task-a", other));
+  msg_id_t other_expected(MsgIdMgr::TaskOpName("SecureAdd", "task-a"));
+  REQUIRE(other == other_expected);
+
+  REQUIRE(!mgr->UpdateMsgIdTable(pack_table({{5, "cut"}}).substr(0, 20)));
+}
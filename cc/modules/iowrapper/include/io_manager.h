@@ -54,6 +54,14 @@ class IOManager {
 
     bool CreateChannel(const string& task_id, const string& node_id, const string& io_config_json_str);
     
+    /**
+     * @desc: an IOWrapper for task_id that replays the party recorded in a transcript,
+     *     see IOWrapper::StartRecording. It needs no network, the protocol runs as usual
+     *     on it and DestroyChannel drops it.
+     * @return: false if the task exists or the transcript can not be read
+     */
+    bool CreateReplayChannel(const string& task_id, const string& transcript_path);
+
     void DestroyChannel(const string& task_id);
  private:
     std::mutex ios_mutex_;
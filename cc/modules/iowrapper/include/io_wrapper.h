@@ -19,9 +19,14 @@
 
 #include "cc/modules/common/include/utils/msg_id.h"
 #include "cc/modules/iowrapper/include/stat.h"
+#include "cc/modules/iowrapper/include/transcript.h"
 #include "cc/modules/common/include/utils/rtt_logger.h"
 #include "io/channel.h"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <string>
 #include <list>
@@ -33,10 +38,25 @@ namespace rosetta {
 class IOWrapper;
 class ChannelConfig;
 
+/**
+ * Liveness settings of an IOWrapper, see IOWrapper::StartHealth.
+ *
+ * All the parties of a task must start the health layer with the same settings,
+ * the heartbeats of one party are only drained by the others' health threads.
+ */
+struct IOHealthConfig {
+  int heartbeat_interval_ms = 200; // heartbeat period, also the slice a blocked recv waits between checks
+  int peer_timeout_ms = 3000; // a peer silent for longer than this is taken as failed
+  int64_t op_timeout_ms = 10 * 1000; // deadline of one recv without a ScopedDeadline or timeout
+};
+
 class IOWrapper {
   public:
     IOWrapper(const string& task_id, IChannel* io);
 
+    //! replays one party offline from its transcript, see StartRecording. There is no channel.
+    IOWrapper(const string& task_id, const TranscriptHeader& header, const vector<TranscriptRecord>& records);
+
     ~IOWrapper();
 
     void sync_with(const msg_id_t& msg_id);
@@ -129,6 +149,101 @@ class IOWrapper {
     
     const vector<string>& GetNonComputationNodes();
 
+  public:
+    /**
+     * @desc: starts the heartbeats to and from the connected nodes.
+     *     Once started, a recv that runs into an abort, a failed peer or its deadline
+     *     throws instead of returning short: peer_abort_exp if the task was aborted
+     *     (by a peer or by Abort), network_failure_exp if a peer is gone or silent.
+     *     A failure found here is broadcast as an abort, so every party unwinds.
+     */
+    void StartHealth(const IOHealthConfig& config);
+
+    //! stops the health threads, before the channel is destroyed
+    void StopHealth();
+
+    //! aborts the task here and on all the connected nodes. In-flight ops throw peer_abort_exp.
+    void Abort(const string& reason);
+
+    bool Aborted() const { return aborted_; }
+
+    string AbortReason();
+
+    //! marks a peer as failed and aborts the task, e.g. from the channel error callback
+    void OnPeerError(const string& node_id, const string& why);
+
+    /**
+     * Sets the deadline of the recvs made by this thread within its scope,
+     * e.g. around one protocol op. Nested deadlines never extend an outer one.
+     */
+    class ScopedDeadline {
+     public:
+      explicit ScopedDeadline(int64_t timeout_ms);
+      ~ScopedDeadline();
+
+     private:
+      int64_t saved_us_ = 0;
+    };
+
+  public:
+    /**
+     * @desc: records this party's side of the task to path, from now until the wrapper
+     *     is destroyed: every message sent and received (per peer and msg id), the seeds
+     *     given to RecordSeed and the ops given to RecordOp. Start it before the protocol
+     *     Init, the session state recorded by Init (see MpcProtocol::Init) then makes the
+     *     rest of the run reproducible offline with IOManager::CreateReplayChannel.
+     *     Heartbeats are not recorded.
+     * @return: false if the file can not be created
+     */
+    bool StartRecording(const string& path);
+
+    void StopRecording();
+
+    bool Recording() const { return recorder_ != nullptr; }
+
+    bool Replaying() const { return replay_ != nullptr; }
+
+    //! keeps a seed in the transcript, e.g. the keys of a session
+    void RecordSeed(const string& name, const string& seed);
+
+    /**
+     * @desc: on a replay, the next seed recorded under name.
+     *     The sends recorded before the first seed are not checked, they depend on the
+     *     fresh randomness the seed takes the place of.
+     * @return: false if there is none
+     */
+    bool ReplaySeed(const string& name, string& seed);
+
+    //! records an op run under msg_id, on a replay checks it is the one recorded next for msg_id
+    void RecordOp(const string& op, const msg_id_t& msg_id);
+
+    /**
+     * On a replay, the sends that differ from the transcript and the ops or messages
+     * that are not in it. The first one is logged with its details, set a breakpoint
+     * on IOWrapper::on_divergence to stop there. A recv with nothing recorded throws
+     * replay_divergence_exp, the party can not go on.
+     */
+    size_t ReplayDivergences();
+
+    string FirstDivergence();
+
+  private:
+    struct Replay;
+    // the node layout, from the channel or from a transcript
+    void init_nodes();
+    void replay_recv(const string& node_id, char* data, size_t len, const msg_id_t& msg_id);
+    void replay_send(const string& node_id, const char* data, size_t len, const msg_id_t& msg_id);
+    void on_divergence(const string& what);
+
+  private:
+    // throws if the task has been aborted
+    void check_aborted();
+    // the first abort wins, returns false if the task was aborted already
+    bool set_aborted(const string& by, const string& reason, bool failure);
+    void broadcast_abort(const string& reason);
+    void heartbeat_loop();
+    void listen_loop(const string& node_id);
+
   private:
     int party_ =  -1;
     int parties_ = 0;
@@ -151,6 +266,23 @@ class IOWrapper {
     vector<string> data_nodes_;
     vector<string> result_nodes_;
     vector<string> non_computation_nodes_;
+
+    // health
+    IOHealthConfig health_config_;
+    msg_id_t health_msgid_;
+    std::atomic<bool> health_running_{false};
+    std::atomic<bool> aborted_{false};
+    std::mutex health_mutex_;
+    bool abort_is_failure_ = false;
+    string abort_by_;
+    string abort_reason_;
+    map<string, int64_t> last_seen_us_;
+    std::thread heartbeat_thread_;
+    vector<std::thread> listen_threads_;
+
+    // transcript
+    shared_ptr<TranscriptWriter> recorder_;
+    shared_ptr<Replay> replay_;
 };
 } // namespace rosetta
 
@@ -0,0 +1,71 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * The transcript of one party's side of a session, see IOWrapper::StartRecording.
+ *
+ * A header with the task and the node layout, then the records in the order
+ * the party made them: the messages it sent and received per msg id, its seeds
+ * (eg. the session state once Init is done) and the ops it ran.
+ */
+namespace rosetta {
+
+struct TranscriptHeader {
+  std::string task_id;
+  std::string node_id;
+  std::map<std::string, int> computation_nodes;
+  std::vector<std::string> connected_nodes;
+  std::vector<std::string> data_nodes;
+  std::vector<std::string> result_nodes;
+};
+
+struct TranscriptRecord {
+  enum Kind : uint8_t { kSend = 1, kRecv = 2, kSeed = 3, kOp = 4 };
+  uint8_t kind = 0;
+  std::string peer; // the other node of a message
+  std::string name; // msg id of a message or an op, name of a seed
+  std::string data;
+};
+
+class TranscriptWriter {
+ public:
+  ~TranscriptWriter() { Close(); }
+
+  bool Open(const std::string& path, const TranscriptHeader& header);
+  //! thread safe, records are kept in the order of the calls
+  void Append(uint8_t kind, const std::string& peer, const std::string& name, const char* data, size_t len);
+  void Flush();
+  void Close();
+
+ private:
+  std::mutex mutex_;
+  FILE* file_ = nullptr;
+};
+
+//! the whole transcript, false if it is not one or is cut short
+bool ReadTranscript(const std::string& path, TranscriptHeader& header, std::vector<TranscriptRecord>& records);
+
+} // namespace rosetta
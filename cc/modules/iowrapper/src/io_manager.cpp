@@ -26,6 +26,15 @@ namespace rosetta {
 
 void IOManager::process_error(const char* current_node_id, const char* node_id, int errorno, const char* errormsg, void*user_data) {
   log_error << "the connection to party " << node_id << " is broken, errorno:" << errorno << " errormsg:" << errormsg ;
+  // the wrappers with a running health layer abort their tasks
+  vector<shared_ptr<IOWrapper>> ios;
+  {
+    std::unique_lock<std::mutex> lck(Instance()->ios_mutex_);
+    for (auto& io : Instance()->ios_)
+      ios.push_back(io.second);
+  }
+  for (auto& io : ios)
+    io->OnPeerError(node_id, string("connection broken, ") + errormsg);
 }
 
 bool IOManager::CreateChannel(const string& task_id, const string& node_id, const string& io_config_json_str) {
@@ -44,6 +53,25 @@ bool IOManager::CreateChannel(const string& task_id, const string& node_id, cons
   return true;
 }
 
+bool IOManager::CreateReplayChannel(const string& task_id, const string& transcript_path) {
+  TranscriptHeader header;
+  vector<TranscriptRecord> records;
+  if (!ReadTranscript(transcript_path, header, records)) {
+    log_error << "task id:" << task_id << " can not read the transcript " << transcript_path;
+    return false;
+  }
+  std::unique_lock<std::mutex> lck(ios_mutex_);
+  auto iter = ios_.find(task_id);
+  if (iter != ios_.end()) {
+    return false;
+  }
+  shared_ptr<IOWrapper> io = make_shared<IOWrapper>(task_id, header, records);
+  ios_.insert(std::pair<string, shared_ptr<IOWrapper>>(task_id, io));
+  // internal, DestroyChannel drops it and there is no channel to destroy
+  internal_map_.insert(std::pair<string, bool>(task_id, true));
+  return true;
+}
+
 void IOManager::SetChannel(const string& task_id, IChannel* channel) {
   std::unique_lock<std::mutex> lck(ios_mutex_);
   auto iter = ios_.find(task_id);
@@ -80,6 +108,8 @@ void IOManager::DestroyChannel(const string& task_id) {
     auto iter = internal_map_.find(task_id);
     if (iter != internal_map_.end() && iter->second) {
       auto iter2 = ios_.find(task_id);
+      // the health threads use the channel
+      iter2->second->StopHealth();
       channel = iter2->second->GetIO();
       ios_.erase(iter2);
       internal_map_.erase(iter);
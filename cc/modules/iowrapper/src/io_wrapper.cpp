@@ -23,17 +23,91 @@
 #include <iostream>
 #include <string.h>
 #include <algorithm>
+#include <chrono>
 #include <iomanip>
+#include <deque>
 using namespace std;
 
 namespace rosetta {
 
+namespace {
+const char kHealthAlive = 1;
+const char kHealthAbort = 2;
+
+// heartbeats and aborts share one fixed size frame
+struct HealthFrame {
+  char kind = kHealthAlive;
+  char reason[63] = {0};
+};
+
+int64_t now_us() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+// the deadline of the current thread's recvs, 0 if none, see ScopedDeadline
+thread_local int64_t op_deadline_us = 0;
+} // namespace
+
+// the transcript of the replayed party, one queue per kind, peer and name
+struct IOWrapper::Replay {
+  static string key(uint8_t kind, const string& peer, const string& name) {
+    return string(1, char(kind)) + peer + "|" + name;
+  }
+
+  std::mutex mutex;
+  map<string, std::deque<std::pair<size_t, string>>> queues;
+  size_t checked_from = 0; // index of the first seed, the sends before it are not checked
+  size_t divergences = 0;
+  string first_divergence;
+};
+
+IOWrapper::ScopedDeadline::ScopedDeadline(int64_t timeout_ms) {
+  saved_us_ = op_deadline_us;
+  int64_t deadline = now_us() + timeout_ms * 1000;
+  if (saved_us_ == 0 || deadline < saved_us_)
+    op_deadline_us = deadline;
+}
+
+IOWrapper::ScopedDeadline::~ScopedDeadline() { op_deadline_us = saved_us_; }
+
 IOWrapper::IOWrapper(const string& task_id, IChannel* channel) {
   task_id_ = task_id;
   channel_ = channel;
   node_id_ = decode_string(channel_->GetCurrentNodeID());
-  log_debug << "node id:" << node_id_;
   node2party_ = decode_map(channel_->GetComputationNodeIDs());
+  connected_nodes_ = decode_vector(channel_->GetConnectedNodeIDs());
+  data_nodes_ = decode_vector(channel_->GetDataNodeIDs());
+  result_nodes_ = decode_vector(channel_->GetResultNodeIDs());
+  init_nodes();
+}
+
+IOWrapper::IOWrapper(
+  const string& task_id,
+  const TranscriptHeader& header,
+  const vector<TranscriptRecord>& records) {
+  task_id_ = task_id;
+  node_id_ = header.node_id;
+  node2party_ = header.computation_nodes;
+  connected_nodes_ = header.connected_nodes;
+  data_nodes_ = header.data_nodes;
+  result_nodes_ = header.result_nodes;
+  init_nodes();
+
+  replay_ = make_shared<Replay>();
+  for (size_t i = 0; i < records.size(); i++) {
+    auto& rec = records[i];
+    if (rec.kind == TranscriptRecord::kSeed && replay_->checked_from == 0)
+      replay_->checked_from = i;
+    replay_->queues[Replay::key(rec.kind, rec.peer, rec.name)].push_back(std::make_pair(i, rec.data));
+  }
+  log_info << "task id:" << task_id_ << " replays node " << node_id_ << " from "
+           << records.size() << " records";
+}
+
+void IOWrapper::init_nodes() {
+  log_debug << "node id:" << node_id_;
   party2node_.resize(node2party_.size());
   for (auto iter = node2party_.begin(); iter != node2party_.end(); iter++) {
     party2node_[iter->second] = iter->first;
@@ -42,17 +116,14 @@ IOWrapper::IOWrapper(const string& task_id, IChannel* channel) {
   party_ = GetPartyId(node_id_);
   log_debug << "party id:" << party_ ;
   parties_ = node2party_.size();
-  connected_nodes_ = decode_vector(channel_->GetConnectedNodeIDs());
   std::sort(connected_nodes_.begin(), connected_nodes_.end());
   for (int i = 0; i < connected_nodes_.size(); i++) {
     log_debug << "connected node:" << connected_nodes_[i] ;
   }
-  data_nodes_ = decode_vector(channel_->GetDataNodeIDs());
   std::sort(data_nodes_.begin(), data_nodes_.end());
   for (int i = 0; i < data_nodes_.size(); i++) {
     log_debug << "data node:" << data_nodes_[i] ;
   }
-  result_nodes_ = decode_vector(channel_->GetResultNodeIDs());
   std::sort(result_nodes_.begin(), result_nodes_.end());
   for (int i = 0; i < result_nodes_.size(); i++) {
     log_debug << "result node:" << result_nodes_[i] ;
@@ -81,6 +152,8 @@ IOWrapper::IOWrapper(const string& task_id, IChannel* channel) {
 }
 
 IOWrapper::~IOWrapper() {
+  StopHealth();
+  StopRecording();
   node2party_.clear();
   party2node_.clear();
   data_nodes_.clear();
@@ -125,12 +198,40 @@ ssize_t IOWrapper::recv(const string& node_id, char* data, size_t len, const msg
 #endif
 
   log_debug << "begin recv data from " << node_id << " id:" << id << " len:" << len;
-  if (timeout < 0)
-    timeout = 10 * 1000000;
-  ssize_t ret = channel_->Recv(node_id.c_str(), data_id, data, len, timeout);
-  if (ret != len) {
-    log_error << "recv len:" << ret << " expect: " << len;
+  check_aborted();
+  ssize_t ret = -1;
+  if (replay_) {
+    replay_recv(node_id, data, len, msg_id);
+    ret = len;
+  } else if (!health_running_) {
+    if (timeout < 0)
+      timeout = op_deadline_us > 0 ? std::max<int64_t>(op_deadline_us - now_us(), 0) : 10 * 1000000;
+    ret = channel_->Recv(node_id.c_str(), data_id, data, len, timeout);
+    if (ret != len) {
+      log_error << "recv len:" << ret << " expect: " << len;
+    }
+  } else {
+    // wait in heartbeat slices, so that an abort or a failed peer unwinds this recv
+    int64_t deadline = timeout >= 0 ? now_us() + timeout
+      : op_deadline_us > 0          ? op_deadline_us
+                                    : now_us() + health_config_.op_timeout_ms * 1000;
+    const int64_t slice = health_config_.heartbeat_interval_ms * 1000;
+    while (true) {
+      int64_t left = deadline - now_us();
+      if (left <= 0)
+        OnPeerError(node_id, "no message " + id.str() + " within the deadline");
+      check_aborted();
+      ret = channel_->Recv(node_id.c_str(), data_id, data, len, std::min(left, slice));
+      if (ret == len)
+        break;
+      if (ret == 0)
+        OnPeerError(node_id, "disconnected");
+      else if (ret > 0)
+        OnPeerError(node_id, "recv len:" + std::to_string(ret) + " expect: " + std::to_string(len));
+    }
   }
+  if (recorder_)
+    recorder_->Append(TranscriptRecord::kRecv, node_id, msg_id.str(), data, len);
   {
     net_stat_st_.message_received++;
     net_stat_st_.bytes_received += sizeof(int32_t);
@@ -173,9 +274,21 @@ ssize_t IOWrapper::send(const string& node_id, const char* data, size_t len, con
 #endif
 
   log_debug << "begin send data to " << node_id << " id:" << id << " len:" << len;
+  check_aborted();
   if (timeout < 0)
     timeout = 10 * 1000000;
-  ssize_t ret = channel_->Send(node_id.c_str(), data_id, data, len, timeout);
+  ssize_t ret = len;
+  if (replay_) {
+    replay_send(node_id, data, len, msg_id);
+  } else {
+    ret = channel_->Send(node_id.c_str(), data_id, data, len, timeout);
+    if (ret != len && health_running_) {
+      OnPeerError(node_id, "send len:" + std::to_string(ret) + " expect: " + std::to_string(len));
+      check_aborted();
+    }
+  }
+  if (recorder_)
+    recorder_->Append(TranscriptRecord::kSend, node_id, msg_id.str(), data, len);
   {
     net_stat_st_.message_sent++;
     net_stat_st_.bytes_sent += sizeof(int32_t);
@@ -199,6 +312,279 @@ void IOWrapper::sync_with(const msg_id_t& msg_id) {
   }
 }
 
+void IOWrapper::StartHealth(const IOHealthConfig& config) {
+  if (health_running_ || replay_)
+    return;
+  health_config_ = config;
+  health_config_.heartbeat_interval_ms = std::max(config.heartbeat_interval_ms, 1);
+  health_msgid_ = msg_id_t(task_id_ + "|this message id for iowrapper heartbeats and aborts");
+  {
+    std::unique_lock<std::mutex> lck(health_mutex_);
+    int64_t now = now_us();
+    for (auto& node : connected_nodes_)
+      last_seen_us_[node] = now;
+  }
+  health_running_ = true;
+  heartbeat_thread_ = std::thread(&IOWrapper::heartbeat_loop, this);
+  for (auto& node : connected_nodes_)
+    listen_threads_.push_back(std::thread(&IOWrapper::listen_loop, this, node));
+  log_info << "task id:" << task_id_ << " health started, heartbeat "
+           << health_config_.heartbeat_interval_ms << "ms, peer timeout "
+           << health_config_.peer_timeout_ms << "ms, op timeout " << health_config_.op_timeout_ms
+           << "ms";
+}
+
+void IOWrapper::StopHealth() {
+  if (!health_running_.exchange(false))
+    return;
+  if (heartbeat_thread_.joinable())
+    heartbeat_thread_.join();
+  for (auto& t : listen_threads_) {
+    if (t.joinable())
+      t.join();
+  }
+  listen_threads_.clear();
+  log_debug << "task id:" << task_id_ << " health stopped";
+}
+
+void IOWrapper::Abort(const string& reason) {
+  if (set_aborted(node_id_, reason, false))
+    broadcast_abort(reason);
+}
+
+string IOWrapper::AbortReason() {
+  std::unique_lock<std::mutex> lck(health_mutex_);
+  return abort_reason_;
+}
+
+void IOWrapper::OnPeerError(const string& node_id, const string& why) {
+  if (!health_running_)
+    return;
+  if (std::find(connected_nodes_.begin(), connected_nodes_.end(), node_id) == connected_nodes_.end())
+    return;
+  if (set_aborted(node_id, why, true))
+    broadcast_abort("node " + node_id + " failed, " + why);
+}
+
+void IOWrapper::check_aborted() {
+  if (!aborted_)
+    return;
+  std::unique_lock<std::mutex> lck(health_mutex_);
+  if (abort_is_failure_)
+    throw network_failure_exp(abort_by_, abort_reason_);
+  throw peer_abort_exp(abort_by_, abort_reason_);
+}
+
+bool IOWrapper::set_aborted(const string& by, const string& reason, bool failure) {
+  std::unique_lock<std::mutex> lck(health_mutex_);
+  if (aborted_)
+    return false;
+  abort_by_ = by;
+  abort_reason_ = reason;
+  abort_is_failure_ = failure;
+  aborted_ = true;
+  log_error << "task id:" << task_id_ << " aborted by " << by << ": " << reason;
+  return true;
+}
+
+void IOWrapper::broadcast_abort(const string& reason) {
+  if (!health_running_)
+    return;
+  HealthFrame frame;
+  frame.kind = kHealthAbort;
+  strncpy(frame.reason, reason.c_str(), sizeof(frame.reason) - 1);
+  // a failed peer may get it too, it is only told once and the send times out
+  for (auto& node : connected_nodes_)
+    channel_->Send(node.c_str(), health_msgid_.get_hex(), (const char*)&frame, sizeof(frame),
+                   health_config_.heartbeat_interval_ms * 1000);
+}
+
+void IOWrapper::heartbeat_loop() {
+  HealthFrame frame;
+  const int64_t interval = health_config_.heartbeat_interval_ms * 1000;
+  while (health_running_) {
+    for (auto& node : connected_nodes_)
+      channel_->Send(node.c_str(), health_msgid_.get_hex(), (const char*)&frame, sizeof(frame), interval);
+
+    vector<string> silent;
+    {
+      std::unique_lock<std::mutex> lck(health_mutex_);
+      int64_t now = now_us();
+      for (auto& seen : last_seen_us_) {
+        if (now - seen.second > health_config_.peer_timeout_ms * 1000)
+          silent.push_back(seen.first);
+      }
+    }
+    for (auto& node : silent)
+      OnPeerError(node, "no heartbeat for " + std::to_string(health_config_.peer_timeout_ms) + "ms");
+
+    std::this_thread::sleep_for(std::chrono::microseconds(interval));
+  }
+}
+
+void IOWrapper::listen_loop(const string& node_id) {
+  const int64_t interval = health_config_.heartbeat_interval_ms * 1000;
+  while (health_running_) {
+    HealthFrame frame;
+    int64_t ret = channel_->Recv(node_id.c_str(), health_msgid_.get_hex(), (char*)&frame, sizeof(frame), interval);
+    if (ret == sizeof(frame)) {
+      {
+        std::unique_lock<std::mutex> lck(health_mutex_);
+        last_seen_us_[node_id] = now_us();
+      }
+      if (frame.kind == kHealthAbort) {
+        frame.reason[sizeof(frame.reason) - 1] = 0;
+        set_aborted(node_id, frame.reason, false);
+      }
+    } else if (ret == 0) {
+      OnPeerError(node_id, "disconnected");
+      break;
+    }
+  }
+}
+
+bool IOWrapper::StartRecording(const string& path) {
+  TranscriptHeader header;
+  header.task_id = task_id_;
+  header.node_id = node_id_;
+  header.computation_nodes = node2party_;
+  header.connected_nodes = connected_nodes_;
+  header.data_nodes = data_nodes_;
+  header.result_nodes = result_nodes_;
+  auto recorder = make_shared<TranscriptWriter>();
+  if (!recorder->Open(path, header)) {
+    log_error << "task id:" << task_id_ << " can not record to " << path;
+    return false;
+  }
+  recorder_ = recorder;
+  log_info << "task id:" << task_id_ << " records to " << path;
+  return true;
+}
+
+void IOWrapper::StopRecording() {
+  if (recorder_) {
+    recorder_->Close();
+    recorder_.reset();
+  }
+}
+
+void IOWrapper::RecordSeed(const string& name, const string& seed) {
+  if (!recorder_)
+    return;
+  recorder_->Append(TranscriptRecord::kSeed, "", name, seed.data(), seed.size());
+  // what came before the seed is worth little without it
+  recorder_->Flush();
+}
+
+bool IOWrapper::ReplaySeed(const string& name, string& seed) {
+  if (!replay_)
+    return false;
+  std::unique_lock<std::mutex> lck(replay_->mutex);
+  auto& queue = replay_->queues[Replay::key(TranscriptRecord::kSeed, "", name)];
+  if (queue.empty())
+    return false;
+  seed = queue.front().second;
+  queue.pop_front();
+  return true;
+}
+
+void IOWrapper::RecordOp(const string& op, const msg_id_t& msg_id) {
+  if (recorder_)
+    recorder_->Append(TranscriptRecord::kOp, "", msg_id.str(), op.data(), op.size());
+  if (!replay_)
+    return;
+
+  string recorded;
+  bool found = false;
+  {
+    std::unique_lock<std::mutex> lck(replay_->mutex);
+    auto& queue = replay_->queues[Replay::key(TranscriptRecord::kOp, "", msg_id.str())];
+    if (!queue.empty()) {
+      recorded = queue.front().second;
+      queue.pop_front();
+      found = true;
+    }
+  }
+  if (!found)
+    on_divergence("op " + op + " id:" + msg_id.str() + " is not in the transcript");
+  else if (recorded != op)
+    on_divergence("op " + op + " id:" + msg_id.str() + ", the transcript has " + recorded);
+}
+
+size_t IOWrapper::ReplayDivergences() {
+  if (!replay_)
+    return 0;
+  std::unique_lock<std::mutex> lck(replay_->mutex);
+  return replay_->divergences;
+}
+
+string IOWrapper::FirstDivergence() {
+  if (!replay_)
+    return "";
+  std::unique_lock<std::mutex> lck(replay_->mutex);
+  return replay_->first_divergence;
+}
+
+void IOWrapper::replay_recv(const string& node_id, char* data, size_t len, const msg_id_t& msg_id) {
+  string recorded;
+  {
+    std::unique_lock<std::mutex> lck(replay_->mutex);
+    auto& queue = replay_->queues[Replay::key(TranscriptRecord::kRecv, node_id, msg_id.str())];
+    if (queue.empty()) {
+      lck.unlock();
+      string what = "recv from " + node_id + " id:" + msg_id.str() + " is not in the transcript";
+      on_divergence(what);
+      throw replay_divergence_exp(what);
+    }
+    recorded.swap(queue.front().second);
+    queue.pop_front();
+  }
+  if (recorded.size() != len)
+    on_divergence("recv from " + node_id + " id:" + msg_id.str() + " len:" + std::to_string(len) +
+                  ", the transcript has len:" + std::to_string(recorded.size()));
+  memcpy(data, recorded.data(), std::min(len, recorded.size()));
+}
+
+void IOWrapper::replay_send(const string& node_id, const char* data, size_t len, const msg_id_t& msg_id) {
+  string recorded;
+  size_t index = 0;
+  {
+    std::unique_lock<std::mutex> lck(replay_->mutex);
+    auto& queue = replay_->queues[Replay::key(TranscriptRecord::kSend, node_id, msg_id.str())];
+    if (queue.empty()) {
+      lck.unlock();
+      on_divergence("send to " + node_id + " id:" + msg_id.str() + " is not in the transcript");
+      return;
+    }
+    index = queue.front().first;
+    recorded.swap(queue.front().second);
+    queue.pop_front();
+    if (index < replay_->checked_from)
+      return;
+  }
+  string what = "send to " + node_id + " id:" + msg_id.str() + " (record " + std::to_string(index) + ")";
+  if (recorded.size() != len) {
+    on_divergence(what + " len:" + std::to_string(len) + ", the transcript has len:" +
+                  std::to_string(recorded.size()));
+    return;
+  }
+  size_t i = 0;
+  while (i < len && data[i] == recorded[i])
+    i++;
+  if (i < len)
+    on_divergence(what + " differs from byte " + std::to_string(i) + " of " + std::to_string(len));
+}
+
+void IOWrapper::on_divergence(const string& what) {
+  std::unique_lock<std::mutex> lck(replay_->mutex);
+  if (replay_->divergences++ == 0) {
+    replay_->first_divergence = what;
+    log_error << "task id:" << task_id_ << " replay diverges: " << what;
+  } else {
+    log_debug << "task id:" << task_id_ << " replay diverges: " << what;
+  }
+}
+
 void IOWrapper::statistics(string str) {
   auto stat = net_stat();
   if (!task_id_.empty()) {
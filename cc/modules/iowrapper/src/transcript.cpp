@@ -0,0 +1,144 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/iowrapper/include/transcript.h"
+
+#include <cstring>
+
+namespace rosetta {
+
+namespace {
+const char kMagic[8] = {'R', 'T', 'T', 'T', 'R', 'S', '0', '1'};
+
+void put_u64(FILE* f, uint64_t v) { fwrite(&v, sizeof(v), 1, f); }
+void put_bytes(FILE* f, const char* data, size_t len) {
+  put_u64(f, len);
+  if (len > 0)
+    fwrite(data, 1, len, f);
+}
+void put_string(FILE* f, const std::string& s) { put_bytes(f, s.data(), s.size()); }
+void put_strings(FILE* f, const std::vector<std::string>& v) {
+  put_u64(f, v.size());
+  for (auto& s : v)
+    put_string(f, s);
+}
+
+bool get_u64(FILE* f, uint64_t& v) { return fread(&v, sizeof(v), 1, f) == 1; }
+bool get_string(FILE* f, std::string& s) {
+  uint64_t len = 0;
+  if (!get_u64(f, len))
+    return false;
+  s.resize(len);
+  return len == 0 || fread(&s[0], 1, len, f) == len;
+}
+bool get_strings(FILE* f, std::vector<std::string>& v) {
+  uint64_t n = 0;
+  if (!get_u64(f, n))
+    return false;
+  v.clear();
+  for (uint64_t i = 0; i < n; i++) {
+    std::string s;
+    if (!get_string(f, s))
+      return false;
+    v.push_back(s);
+  }
+  return true;
+}
+} // namespace
+
+bool TranscriptWriter::Open(const std::string& path, const TranscriptHeader& header) {
+  std::unique_lock<std::mutex> lck(mutex_);
+  if (file_ != nullptr)
+    fclose(file_);
+  file_ = fopen(path.c_str(), "wb");
+  if (file_ == nullptr)
+    return false;
+  fwrite(kMagic, 1, sizeof(kMagic), file_);
+  put_string(file_, header.task_id);
+  put_string(file_, header.node_id);
+  put_u64(file_, header.computation_nodes.size());
+  for (auto& node : header.computation_nodes) {
+    put_string(file_, node.first);
+    put_u64(file_, node.second);
+  }
+  put_strings(file_, header.connected_nodes);
+  put_strings(file_, header.data_nodes);
+  put_strings(file_, header.result_nodes);
+  return true;
+}
+
+void TranscriptWriter::Append(
+  uint8_t kind,
+  const std::string& peer,
+  const std::string& name,
+  const char* data,
+  size_t len) {
+  std::unique_lock<std::mutex> lck(mutex_);
+  if (file_ == nullptr)
+    return;
+  fwrite(&kind, 1, 1, file_);
+  put_string(file_, peer);
+  put_string(file_, name);
+  put_bytes(file_, data, len);
+}
+
+void TranscriptWriter::Flush() {
+  std::unique_lock<std::mutex> lck(mutex_);
+  if (file_ != nullptr)
+    fflush(file_);
+}
+
+void TranscriptWriter::Close() {
+  std::unique_lock<std::mutex> lck(mutex_);
+  if (file_ != nullptr) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+bool ReadTranscript(const std::string& path, TranscriptHeader& header, std::vector<TranscriptRecord>& records) {
+  FILE* f = fopen(path.c_str(), "rb");
+  if (f == nullptr)
+    return false;
+  char magic[sizeof(kMagic)];
+  bool ok = fread(magic, 1, sizeof(magic), f) == sizeof(magic) && memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+  uint64_t n = 0;
+  ok = ok && get_string(f, header.task_id) && get_string(f, header.node_id) && get_u64(f, n);
+  header.computation_nodes.clear();
+  for (uint64_t i = 0; ok && i < n; i++) {
+    std::string node;
+    uint64_t party = 0;
+    ok = get_string(f, node) && get_u64(f, party);
+    header.computation_nodes[node] = (int)party;
+  }
+  ok = ok && get_strings(f, header.connected_nodes) && get_strings(f, header.data_nodes) &&
+    get_strings(f, header.result_nodes);
+
+  records.clear();
+  uint8_t kind = 0;
+  while (ok && fread(&kind, 1, 1, f) == 1) {
+    TranscriptRecord rec;
+    rec.kind = kind;
+    ok = get_string(f, rec.peer) && get_string(f, rec.name) && get_string(f, rec.data);
+    if (ok)
+      records.push_back(std::move(rec));
+  }
+  fclose(f);
+  return ok;
+}
+
+} // namespace rosetta
@@ -0,0 +1,84 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include "cc/modules/protocol/mpc/comm/include/mpc_protocol.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Distributed checkpoints of a secure training session.
+ *
+ * Every computation party calls Save at the same point of its training loop.
+ * After a barrier, each party writes its own file with the step, its shares of
+ * the named tensors (protocol-encoded, as the ops take them) and the session
+ * state of the protocol (PRG keys and positions, cached triples, see
+ * MpcProtocol::SaveSessionState). The parties exchange the SHA-256 digests of
+ * their files, and each file records the digests of all of them. A file only
+ * becomes a checkpoint once every party has written its own.
+ *
+ * After a restart (a new channel and protocol Init), every party calls Restore.
+ * The parties agree on the latest step that all of them hold, check each other's
+ * files against the recorded digests, and load them. The session then draws the
+ * same randomness as the saved one would have, so the following steps give
+ * bit-identical results.
+ *
+ * The file of a party is <dir>/<node id>-<step>.ckpt and holds secrets (shares
+ * and keys) of that party only.
+ */
+namespace rosetta {
+
+class MpcCheckpoint {
+ public:
+  //! keeps the latest `keep` checkpoints of the node in dir
+  MpcCheckpoint(MpcProtocol* protocol, const std::string& dir, size_t keep = 2);
+
+  /**
+   * @desc: on every computation party, at the same step.
+   * @return: 0 once all the parties have written the step, -1 otherwise
+   */
+  int Save(uint64_t step, const std::map<std::string, std::vector<std::string>>& tensors);
+
+  /**
+   * @desc: on every computation party, right after Init.
+   * @return: 0 if restored (step and tensors are set), 1 if the parties have
+   *     no checkpoint in common, -1 if none of the common ones checks out
+   */
+  int Restore(uint64_t& step, std::map<std::string, std::vector<std::string>>& tensors);
+
+  //! the steps this node has a checkpoint file of, ascending
+  std::vector<uint64_t> LocalSteps() const;
+
+ private:
+  std::string Path(uint64_t step) const;
+  std::vector<std::string> Peers() const;
+  // true if ok on all the parties
+  bool Agree(bool ok, const std::string& what);
+  void Prune();
+
+ private:
+  MpcProtocol* protocol_ = nullptr;
+  std::string dir_;
+  size_t keep_ = 2;
+  std::string node_id_;
+};
+
+} // namespace rosetta
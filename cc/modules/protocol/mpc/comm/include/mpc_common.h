@@ -144,6 +144,22 @@ struct PolyConfFactory {
   static bool get_func_polys(
     const string& func_name,
     vector<ConstPolynomial>** approx_polys);
+
+  /**
+   * @brief: a registered piecewise function in telescoping form,
+   *   F(x) = g_0(x) + (x >= b_1) * g_1(x) + ... + (x >= b_m) * g_m(x),
+   * with g_0 = f_0 and g_k = f_k - f_{k-1}, so that the m comparisons do not depend on each other.
+   * The first segment is taken to be open to -inf and the last one to +inf.
+   * @param:
+   *   [out] break_points, b_k = the start of segment k, k = 1..m
+   *   [out] coffs, coffs[k][p] is the coefficient of X^p in g_k, scaled by precision
+   * @return: false if func_name is not registered
+   */
+  static bool get_func_telescoping(
+    const string& func_name,
+    int precision,
+    vector<double>& break_points,
+    vector<vector<mpc_t>>& coffs);
   //private:
   //	static unordered_map<string, vector<ConstPolynomial>> FUNC_POLY_MAP;
 };
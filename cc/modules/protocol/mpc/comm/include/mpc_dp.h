@@ -0,0 +1,110 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include "cc/modules/protocol/mpc/comm/include/mpc_common.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rosetta {
+
+/**
+ * @desc: parameters of the differential-privacy noise samplers (DPNoise of every backend).
+ *
+ * Both mechanisms are sampled on the fixed-point grid from jointly drawn fair coins, so no
+ * party learns the noise and its law is exactly the discrete one below, not an approximation
+ * of a continuous distribution.
+ *
+ * laplace, scale b: the discrete Laplace (two-sided geometric) on the LSB grid,
+ *   P(n LSB) ~ exp(-|n| * 2^-precision / b), sampled as G1 - G2 of two geometrics. The bits of a
+ *   geometric are independent, bit j is 1 with probability p_j = 1 / (1 + exp(2^j / t)),
+ *   t = b * 2^precision, and each is drawn as (U < T_j) on a dp_uniform_bits() uniform U.
+ *   Untruncated, this is the geometric mechanism (Ghosh et al. 2009), pure eps = s / b for a
+ *   sensitivity s. The sampler is off by at most TV = 2 * exp(-2^B / t) (the B bits of each
+ *   geometric, exp(-2^B / t) <= exp(-64)) plus 2 * B * 2^-uniform_bits (the rounded T_j), so
+ *   the release is (eps, delta) with delta = (1 + e^eps) * TV per element, about 2^-40 per
+ *   element at the defaults. B is capped by the ring, so scales above 2^(54 - 2 * precision) on
+ *   the 64-bit ring give up the exp(-64) tail bound.
+ *
+ * gaussian, scale sigma: the binomial mechanism (Agarwal et al. 2018, cpSGD). With
+ *   sd = sigma * 2^precision LSB, the input is rounded to a grid of 2^grid_bits LSB and gets
+ *   2^grid_bits * (K - N / 2), K ~ Bin(N, 1/2), a variance of 4^grid_bits * N / 4 >= sd^2.
+ *   Theorem 1 of that paper gives (eps, delta) from the L2, L1 and Linf sensitivities in grid
+ *   units, a sensitivity s becomes s * 2^(precision - grid_bits) + 2 with the rounding, as soon
+ *   as N / 4 >= max(23 * ln(10 * d / delta), 2 * Linf); N >= 4096 covers d / delta <= 2e18 for
+ *   d released elements, and the bounded support of Bin(N, 1/2) is part of that delta.
+ *   N is kept at 4096 at least, so for sd < 32 LSB the noise is larger than requested.
+ */
+
+// coins sampled per round, bounds the memory of a DPNoise call on large tensors
+static const size_t kDPCoinsPerRound = 1 << 20;
+
+// bits of the uniforms compared to the Laplace thresholds, (T - 1 - U) * 2^precision must keep its sign
+inline int dp_uniform_bits(int precision) {
+  return std::min(48, static_cast<int>(8 * sizeof(mpc_t)) - 3 - precision);
+}
+
+// T_j = round(p_j * 2^uniform_bits) for the bits j < B of one geometric, see above
+inline void dp_laplace_thresholds(
+  double scale,
+  int precision,
+  int uniform_bits,
+  std::vector<uint64_t>& thresholds) {
+  const long double t = std::ldexp(static_cast<long double>(scale), precision);
+  const int max_bits = static_cast<int>(8 * sizeof(mpc_t)) - 4 - precision;
+  int B = 1;
+  while (B < max_bits && std::ldexp(1.0L, B) < 64 * t)
+    B++;
+
+  thresholds.resize(B);
+  for (int j = 0; j < B; j++) {
+    long double p = 1.0L / (1.0L + std::exp(std::ldexp(1.0L, j) / t));
+    thresholds[j] = static_cast<uint64_t>(std::llround(std::ldexp(p, uniform_bits)));
+  }
+}
+
+// grid 2^grid_bits LSB and coins N of the binomial mechanism for a standard deviation scale, see above
+inline void dp_binomial_params(double scale, int precision, int& grid_bits, size_t& coins) {
+  const double sd = std::ldexp(scale, precision);
+  grid_bits = 0;
+  while (sd >= std::ldexp(64.0, grid_bits))
+    grid_bits++;
+
+  double ratio = 2 * std::ldexp(sd, -grid_bits);
+  coins = std::max(static_cast<size_t>(4096), static_cast<size_t>(std::ceil(ratio * ratio)));
+  coins += coins & 1;
+}
+
+/**
+ * @desc: ClipByL2Norm scales by 1 / clip_norm before squaring, 1 / clip_norm^2 itself would
+ * round to 0 in fixed-point as soon as clip_norm > 2^(precision / 2).
+ * 1 / clip_norm = 2^-shift * ratio, with ratio in (1/2, 1] for clip_norm >= 1, so the shift is a
+ * plain truncation and ratio keeps its full precision whatever clip_norm.
+ */
+inline void dp_clip_norm_split(double clip_norm, int& shift, double& ratio) {
+  int exp2 = 0;
+  std::frexp(clip_norm, &exp2);
+  shift = std::max(0, exp2 - 1);
+  ratio = std::ldexp(1.0, shift) / clip_norm;
+}
+
+} // namespace rosetta
@@ -0,0 +1,87 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include "cc/modules/protocol/public/include/protocol_base.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_common.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_defines.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rosetta {
+
+/**
+ * Picks, per call, between a garbled-circuit comparison and the native one of
+ * the protocol, by the estimated time rounds * rtt + bytes / bandwidth.
+ *
+ * The native figures are given by the protocol. The garbled-circuit figures
+ * follow from the ring size: a COT and a label per input bit, two ciphertexts
+ * per AND of the ripple-carry MSB, and one more COT to turn the output bit
+ * into an arithmetic share.
+ */
+struct MpcCmpCostModel {
+  enum Mode { AUTO = 0, NATIVE = 1, GC = 2 };
+  Mode mode = AUTO;
+
+  // measured between P0 and P1 by Calibrate
+  double rtt_ms = 0;
+  double bytes_per_ms = 125000; // 1 Gbps
+
+  // sequential round trips and bytes per element, of the slowest link
+  double native_rtts = 4;
+  double native_bytes = 340;
+  double gc_rtts = 2;
+  double gc_bytes = 16.0 * 2 * (sizeof(mpc_t) * 8) + 32.0 * (sizeof(mpc_t) * 8 - 1) + 24;
+
+  bool PreferGc(size_t size) const;
+
+  /**
+   * @desc: P0 measures the round trip and the bandwidth to P1, and sends
+   *     them to all the other computation nodes, so that every party makes
+   *     the same choices. Every computation node calls this.
+   */
+  void Calibrate(shared_ptr<NET_IO> net_io, const msg_id_t& msgid);
+
+  std::string to_string() const;
+};
+
+/**
+ * A comparison of two-party additive shares (x = x0 + x1 over the ring of
+ * mpc_t, held by P0 and P1), run as a garbled circuit in constant rounds.
+ * Other parties pass through and get zero shares.
+ */
+class MpcGcCompare {
+ public:
+  virtual ~MpcGcCompare() = default;
+
+  //! shares of (x >= 0), scaled by 2^float_precision
+  virtual int DReLU(
+    const msg_id_t& msgid,
+    const vector<mpc_t>& x,
+    vector<mpc_t>& y,
+    int float_precision) = 0;
+
+  MpcCmpCostModel& CostModel() { return cost_model_; }
+
+ protected:
+  MpcCmpCostModel cost_model_;
+};
+
+} // namespace rosetta
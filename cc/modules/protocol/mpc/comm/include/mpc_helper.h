@@ -28,6 +28,9 @@ void convert_double_to_literal_str(const vector<double>& a, vector<string>& b, i
 void convert_string_to_mpctype(const vector<std::string>& a, vector<mpc_t>& b, bool human = true);
 void convert_mpctype_to_string(const vector<mpc_t>& a, vector<std::string>& b, bool human = true);
 
+// an epsilon (eg. LayerNorm's 1e-5) raised to the fixed-point LSB 2^-precision, smaller ones encode to 0
+double clamp_fixpoint_epsilon(double epsilon, int precision);
+
 // node id, party id and party mask encoding and decoding
 string encode_reveal_nodes(const vector<string>& node_ids, const vector<int>& party_ids, int mask);
 string encode_reveal_mask(int mask);
@@ -0,0 +1,137 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include "cc/modules/protocol/mpc/comm/include/mpc_protocol.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Logistic regression inference serving for vertically partitioned models.
+ *
+ * The weights and the bias belong to the model owner, the features of each
+ * request to the feature owner. The model is secret-shared once by LoadModel
+ * and the parties stay connected. Requests are submitted on the feature owner
+ * and batched over a short window. Each batch is answered with one
+ * PrivateInput + Matmul + Add + Sigmoid + Reveal pipeline, instead of a full
+ * graph run per request.
+ *
+ * The results are revealed to the feature owner only. With label_only, the
+ * Sigmoid is replaced by the decision boundary z >= 0 (p >= 0.5). The feature
+ * owner then learns the label and not the probability, which makes it harder
+ * to reconstruct the model from answers.
+ *
+ * Every computation party runs Serve(). The feature owner decides each batch
+ * size and sends it to the others. A batch size of 0 ends Serve() everywhere.
+ */
+namespace rosetta {
+
+struct MpcLrServingConfig {
+  std::string model_owner; // node id with the weights and bias
+  std::string feature_owner; // node id that takes the requests and gets the results
+  size_t features = 0;
+  int batch_window_ms = 5; // how long the first request of a batch waits for others
+  size_t max_batch = 1024;
+  bool label_only = false;
+};
+
+struct MpcLrServingStats {
+  size_t requests = 0;
+  size_t batches = 0;
+  double mean_batch = 0;
+  // latency from Submit to answer, in milliseconds. The percentiles are over the last
+  // 65536 requests (a ring buffer on the server), max over all of them.
+  double p50_ms = 0;
+  double p90_ms = 0;
+  double p99_ms = 0;
+  double max_ms = 0;
+
+  std::string to_string() const;
+};
+
+class MpcLrServer {
+ public:
+  MpcLrServer(MpcProtocol* protocol, const MpcLrServingConfig& config);
+
+  /**
+   * @desc: secret-shares the model, on every party, once before Serve.
+   *     The model owner passes the weights (config.features of them) and the bias,
+   *     the other parties anything (ignored).
+   * @return: 0 on success, -1 if the weights do not match config.features
+   */
+  int LoadModel(const std::vector<double>& weights, double bias);
+
+  /**
+   * @desc: queues one request, on the feature owner only. Thread safe.
+   * @return: the probability of the request, or its label with label_only.
+   *     The future holds an exception for a wrong feature count or after Stop.
+   */
+  std::future<double> Submit(const std::vector<double>& features);
+
+  //! answers batches until Stop, on every computation party. Blocks the caller.
+  int Serve();
+
+  //! on the feature owner, answers what is queued and then ends Serve on all parties
+  void Stop();
+
+  MpcLrServingStats Stats() const;
+
+ private:
+  struct Request {
+    std::vector<double> features;
+    std::promise<double> result;
+    std::chrono::steady_clock::time_point submitted;
+  };
+
+  // the next batch on the feature owner, empty once stopped and drained
+  std::vector<Request> NextBatch();
+  int RunBatch(size_t size, std::vector<Request>& batch);
+
+ private:
+  MpcProtocol* protocol_ = nullptr;
+  MpcLrServingConfig config_;
+  bool is_feature_owner_ = false;
+  msg_id_t msgid_;
+  msg_id_t batch_msgid_;
+
+  std::vector<std::string> weights_;
+  std::string bias_;
+  bool loaded_ = false;
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::deque<Request> queue_;
+  bool stopping_ = false;
+
+  // the latest latencies, overwritten in turn once full
+  static const size_t kLatencyWindow = 1 << 16;
+  mutable std::mutex stats_mtx_;
+  std::vector<double> latencies_ms_;
+  size_t latency_next_ = 0;
+  size_t requests_ = 0;
+  double max_ms_ = 0;
+  size_t batches_ = 0;
+};
+
+} // namespace rosetta
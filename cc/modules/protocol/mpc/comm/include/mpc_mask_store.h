@@ -0,0 +1,86 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include "cc/modules/common/include/utils/msg_id.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rosetta {
+
+/**
+ * Dropout keeps an element when its uniform cell k, 0 <= k < 2^bits, is below the returned t,
+ * so with probability t / 2^bits exactly, 1 - rate rounded to the grid. scale = 2^bits / t is
+ * the multiplier of the kept elements, so that E[mask] = 1 whatever the rounding.
+ */
+inline uint64_t dropout_keep_cells(double rate, int bits, double& scale) {
+  const uint64_t cells = static_cast<uint64_t>(1) << bits;
+  uint64_t t = static_cast<uint64_t>(std::llround(std::ldexp(1.0 - rate, bits)));
+  t = std::min(cells, std::max(static_cast<uint64_t>(1), t));
+  scale = static_cast<double>(cells) / t;
+  return t;
+}
+
+/**
+ * A mask drawn by a random op, either commonly known to all parties (the
+ * multipliers in common) or secret-shared (the protocol-encoded shares in share).
+ */
+struct MpcMask {
+  bool is_common = true;
+  std::vector<double> common;
+  std::vector<std::string> share;
+};
+
+/**
+ * Masks of random ops (eg. Dropout) by the msg_id of the op that drew them, so that
+ * the gradient op applies exactly the same mask. A later run of the op replaces its
+ * mask, so the store holds one mask per op.
+ */
+class MpcMaskStore {
+ public:
+  void Put(const msg_id_t& msgid, const MpcMask& mask) {
+    std::unique_lock<std::mutex> lck(mutex_);
+    masks_[msgid] = mask;
+  }
+
+  bool Get(const msg_id_t& msgid, MpcMask& mask) {
+    std::unique_lock<std::mutex> lck(mutex_);
+    auto iter = masks_.find(msgid);
+    if (iter == masks_.end())
+      return false;
+    mask = iter->second;
+    return true;
+  }
+
+  void Clear() {
+    std::unique_lock<std::mutex> lck(mutex_);
+    masks_.clear();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::map<msg_id_t, MpcMask> masks_;
+};
+
+} // namespace rosetta
@@ -0,0 +1,133 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rosetta {
+
+/**
+ * @desc: vectorized square-and-multiply, Y[i] = X[i]^K[i] with a public K[i] per element.
+ *
+ * Round j holds P[i] = X[i]^(2^j). In one batched multiplication it computes
+ *   P[i] * P[i], for the elements that still have a bit above j,
+ *   P[i] * Y[i], for the elements with bit j set and a lower bit already taken.
+ * An element whose lowest set bit is j just takes Y[i] = P[i] locally.
+ * Which elements take part in each product depends only on the public exponents, so the
+ * number of rounds is bit_length(max K) whatever the mix of exponents, and each round
+ * multiplies at most two values per element.
+ * A negative K[i] takes the chain of -K[i], then one batched division ONE / Y for all the
+ * negative elements, so X[i] must not be 0 there.
+ *
+ * @param:
+ *     X, the shared base
+ *     K, the public exponents, K.size() == X.size()
+ *     ONE, the sharing of 1.0, taken by the elements with K[i] == 0
+ *     mul, the batched secure multiplication, mul(A, B, C) sets C[i] = A[i] * B[i]
+ *     div, the batched secure division, div(A, B, C) sets C[i] = A[i] / B[i]
+ * @return:
+ *     Y, the shared powers
+ */
+template <typename T, typename MulFn, typename DivFn>
+void vectorized_pow(
+  const std::vector<T>& X,
+  const std::vector<int64_t>& K,
+  const std::vector<T>& ONE,
+  std::vector<T>& Y,
+  MulFn mul,
+  DivFn div) {
+  size_t size = X.size();
+  assert(K.size() == size && ONE.size() == size);
+
+  std::vector<T> P(X);
+  // magnitudes of the exponents, the negative ones are inverted after the chain
+  std::vector<uint64_t> M(size);
+  std::vector<size_t> neg_idx;
+  for (size_t i = 0; i < size; i++) {
+    M[i] = K[i] < 0 ? 0 - (uint64_t)K[i] : (uint64_t)K[i];
+    if (K[i] < 0)
+      neg_idx.push_back(i);
+  }
+
+  Y = ONE;
+  std::vector<bool> covered(size, false);
+  std::vector<size_t> sq_idx, mul_idx;
+  std::vector<T> A, B, C;
+  for (int j = 0; j < 64; j++) {
+    sq_idx.clear();
+    mul_idx.clear();
+    for (size_t i = 0; i < size; i++) {
+      uint64_t k = M[i] >> j;
+      if (k == 0)
+        continue;
+      if (k & 1) {
+        if (covered[i]) {
+          mul_idx.push_back(i);
+        } else {
+          Y[i] = P[i];
+          covered[i] = true;
+        }
+      }
+      if ((k >> 1) != 0)
+        sq_idx.push_back(i);
+    }
+
+    size_t n_sq = sq_idx.size();
+    size_t n = n_sq + mul_idx.size();
+    if (n == 0)
+      break;
+
+    A.resize(n);
+    B.resize(n);
+    C.resize(n);
+    for (size_t t = 0; t < n_sq; t++) {
+      A[t] = P[sq_idx[t]];
+      B[t] = P[sq_idx[t]];
+    }
+    for (size_t t = 0; t < mul_idx.size(); t++) {
+      A[n_sq + t] = P[mul_idx[t]];
+      B[n_sq + t] = Y[mul_idx[t]];
+    }
+    mul(A, B, C);
+    for (size_t t = 0; t < n_sq; t++)
+      P[sq_idx[t]] = C[t];
+    for (size_t t = 0; t < mul_idx.size(); t++)
+      Y[mul_idx[t]] = C[n_sq + t];
+
+    if (n_sq == 0)
+      break;
+  }
+
+  if (neg_idx.empty())
+    return;
+  A.resize(neg_idx.size());
+  B.resize(neg_idx.size());
+  C.resize(neg_idx.size());
+  for (size_t t = 0; t < neg_idx.size(); t++) {
+    A[t] = ONE[neg_idx[t]];
+    B[t] = Y[neg_idx[t]];
+  }
+  div(A, B, C);
+  for (size_t t = 0; t < neg_idx.size(); t++)
+    Y[neg_idx[t]] = C[t];
+}
+
+} // namespace rosetta
@@ -24,6 +24,7 @@
 #include <map>
 #include "cc/modules/common/include/utils/msg_id.h"
 #include "cc/modules/protocol/utility/include/prg.h"
+#include "cc/modules/protocol/utility/include/binary_state.h"
 
 using namespace std;
 
@@ -71,6 +72,9 @@ struct MpcPRGObjsV2 {
 
  public:
   int Init(const msg_id_t& msg_id, const MpcPRGKeysV2& prg_keys);
+
+  void SaveState(BinaryStateWriter& w) const;
+  bool LoadState(BinaryStateReader& r);
 };
 
 // controller to manage keys and prg-objects for a protocol.
@@ -91,6 +95,10 @@ public:
 
   void Init(const MpcPRGKeysV2& keys);
   void Reset();
+
+  //! the keys and every PRG position, for checkpoints. LoadState replaces all of them.
+  void SaveState(BinaryStateWriter& w);
+  bool LoadState(BinaryStateReader& r);
 };
 
 } // namespace rosetta
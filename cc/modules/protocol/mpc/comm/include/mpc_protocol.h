@@ -46,6 +46,15 @@ class MpcProtocol : public ProtocolBase {
   virtual PerfStats GetPerfStats();
   virtual void StartPerfStats();
 
+  /**
+   * @desc: the randomness state of the session (PRG keys and positions, cached
+   *     triples, ...), for checkpoints. Loaded into a newly initialized session,
+   *     the next ops draw the same values as the saved session would have.
+   * @return: 0 on success, -1 if the state does not parse
+   */
+  int SaveSessionState(std::string& state);
+  int LoadSessionState(const std::string& state);
+
  public:
   // virtual shared_ptr<ProtocolOps> GetOps(const msg_id_t& msgid) = 0;
   virtual shared_ptr<NET_IO> GetNetHandler() { return net_io_; }
@@ -64,6 +73,10 @@ class MpcProtocol : public ProtocolBase {
   //! @attention! now, only for snn, will remove in the future
   virtual void InitMpcEnvironment() {}
 
+  //! subclasses with more session state append theirs after the base one
+  virtual void SaveState(BinaryStateWriter& w);
+  virtual bool LoadState(BinaryStateReader& r);
+
  protected:
   std::shared_ptr<RttPRG> gseed_ = nullptr; // for global random seed
   std::shared_ptr<MpcKeyPrgController> key_prg_controller_ = nullptr;
@@ -0,0 +1,82 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include "cc/modules/protocol/mpc/comm/include/mpc_defines.h"
+#include "cc/modules/common/include/utils/msg_id.h"
+#include "cc/modules/common/include/utils/perf_stats.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Secure-debug overflow and precision monitor.
+ *
+ * Only compiled with -DROSETTA_ENABLES_SECURE_DEBUG=1 (cmake option
+ * ROSETTA_ENABLES_SECURE_DEBUG, default OFF for every build type and refused
+ * for Release/RelWithDebInfo). In that mode the
+ * protocol reveals every op output to P0 and hands the plaintext ring
+ * elements to this monitor, which is INSECURE by construction and for
+ * tests/development only.
+ *
+ * A value x is in the safe range for precision f if a fixed-point product of
+ * x with a value of magnitude <= 1 still fits the signed ring before it is
+ * truncated, ie. |x| < 2^(RING_BITS-1-2f). The first op that leaves the safe
+ * range is reported with its msg_id, as wrapped-around outputs are usually
+ * the first sign of an overflow upstream (eg. Matmul of large activations).
+ */
+namespace rosetta {
+
+class SecureDebugMonitor {
+ public:
+  explicit SecureDebugMonitor(const std::string& task_id) : task_id_(task_id) {}
+
+  /**
+   * @desc: records the range of one op output.
+   * @param:
+   *     op, op name, eg. "Matmul"
+   *     msgid, the msg id of the ops instance
+   *     plain, the revealed (plaintext) ring elements of the output
+   *     float_precision, the fixed-point precision of the output
+   * @return:
+   *     false if any element is out of the safe range, true otherwise
+   */
+  bool Check(
+    const std::string& op,
+    const msg_id_t& msgid,
+    const std::vector<mpc_t>& plain,
+    int float_precision);
+
+  //! copies per-op statistics, the first overflow and a precision hint into ps
+  void Fill(PerfStats& ps) const;
+
+  //! largest FLOAT_PRECISION for which every value seen so far is in the safe range
+  int SuggestedPrecision() const;
+
+ private:
+  std::string task_id_;
+  mutable std::mutex mtx_;
+  std::map<std::string, PerfStats::__numeric_stat> stats_;
+  std::string first_overflow_;
+  int float_precision_ = 0;
+  int max_int_bits_ = 0; // bits of the integer part of the largest |x| seen
+};
+
+} // namespace rosetta
@@ -0,0 +1,130 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include "cc/modules/protocol/mpc/comm/include/mpc_common.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_protocol.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * A versioned binary file of one party's shares of a model, and converters.
+ *
+ * Unlike the '#'-encoded strings of SecureSaveV2, the file only holds ring
+ * words, so any tooling can read it and restoring is a plain read:
+ *
+ *   "RTTSHARE"                 magic
+ *   uint32 version             kVersion
+ *   uint64 header length       then the header, see binary_state.h:
+ *     string protocol          the protocol that made the shares, e.g. "SecureNN", "Helix"
+ *     uint32 ring bits, uint32 precision (fraction bits), int32 party id,
+ *     uint32 words per element (ring words of one element on this party),
+ *     uint64 tensor count, then per tensor:
+ *       string name, vector<int64> shape, uint64 data offset, uint64 data length
+ *   the data of each tensor, raw little-endian ring words, element-major,
+ *   starting at its offset (64 byte aligned)
+ *
+ * The shares of a party are secret, so is its file.
+ */
+namespace rosetta {
+
+struct MpcShareTensor {
+  std::string name;
+  std::vector<int64_t> shape;
+  std::vector<mpc_t> words; // elements() * words_per_element
+
+  size_t elements() const;
+};
+
+class MpcShareFile {
+ public:
+  static const uint32_t kVersion = 1;
+
+  std::string protocol;
+  uint32_t ring_bits = sizeof(mpc_t) * 8;
+  uint32_t precision = 0;
+  int32_t party_id = -1;
+  uint32_t words_per_element = 1;
+  std::vector<MpcShareTensor> tensors;
+
+ public:
+  MpcShareFile() = default;
+  //! an empty file of this party of the protocol
+  explicit MpcShareFile(MpcProtocol* protocol);
+
+  int Save(const std::string& path) const;
+  //! -1 if it is not a share file, is of another version or is cut short
+  int Load(const std::string& path);
+
+  const MpcShareTensor* Find(const std::string& name) const;
+
+  //! adds a tensor from the share strings the ops of the protocol take ('#' suffixed)
+  int AddShares(const std::string& name, const std::vector<int64_t>& shape, const std::vector<std::string>& shares);
+  //! the share strings of a tensor, as the ops of the protocol take them
+  int GetShares(const std::string& name, std::vector<std::string>& shares) const;
+};
+
+/**
+ * @desc: secret-shares a plaintext tensor of the owner into the file of every
+ *     computation party. All of them call it, the others pass no values.
+ */
+int MpcImportPlain(
+  MpcProtocol* protocol,
+  const std::string& owner,
+  const std::string& name,
+  const std::vector<int64_t>& shape,
+  const std::vector<double>& values,
+  MpcShareFile& file);
+
+/**
+ * @desc: reveals every tensor of the file to the receivers (node ids, result
+ *     nodes included). All the computation parties call it with their own file.
+ *     plain is only filled on the receivers.
+ */
+int MpcExportPlain(
+  MpcProtocol* protocol,
+  const MpcShareFile& file,
+  const std::vector<std::string>& receivers,
+  std::map<std::string, std::vector<double>>& plain);
+
+/**
+ * Resharing between the layouts of Helix and SecureNN, same ring and precision.
+ *
+ * Helix shares x as deltaX = x - A0 - A1 with P0 (deltaX, A0), P1 (deltaX, A1)
+ * and P2 (A0, A1). SecureNN shares it additively, x = x0 + x1 on P0 and P1.
+ *
+ * Helix -> SecureNN: x0 = deltaX + A0 + R, x1 = A1 - R, P2 keeps zeros. R comes
+ * from a PRG seeded by P0 and sent to P1 once (16 bytes), since P2 knows A1 and
+ * x1 = A1 would let it open x with x0. Afterwards P2 must discard its Helix
+ * shares (A0, A1): with either SecureNN share they reveal x.
+ *
+ * SecureNN -> Helix takes one round. P0 draws A0 and P1 draws A1, both sent to
+ * P2. P0 and P1 then swap x0 - A0 and x1 - A1, whose sum is deltaX. Each
+ * message is masked by a value its receiver does not know.
+ */
+int MpcReshareHelixToSnn(shared_ptr<NET_IO> net_io, const MpcShareFile& helix, MpcShareFile& snn);
+int MpcReshareSnnToHelix(shared_ptr<NET_IO> net_io, const MpcShareFile& snn, MpcShareFile& helix);
+
+//! NumPy .npy files of float64 (float32 is read too), C order, little-endian
+bool MpcReadNpy(const std::string& path, std::vector<int64_t>& shape, std::vector<double>& values);
+bool MpcWriteNpy(const std::string& path, const std::vector<int64_t>& shape, const std::vector<double>& values);
+
+} // namespace rosetta
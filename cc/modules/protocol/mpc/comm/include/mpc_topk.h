@@ -0,0 +1,173 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace rosetta {
+
+// the padding value of bitonic_topk, -2^30, below any input in the fixed-point range
+const double kBitonicTopKPad = -1073741824.0;
+
+/**
+ * @desc: batched bitonic top-k selection over the rows of a rows x cols matrix.
+ *
+ * k is rounded up to K = 2^m and each row is padded with PAD up to a multiple of K
+ * blocks, the number of blocks a power of 2. Then
+ *   1. every block of K is bitonic-sorted descending, m(m+1)/2 layers,
+ *   2. blocks are merged in pairs, A[i] = max(A[i], B[K-1-i]) keeps the K largest of
+ *      the two as a bitonic sequence and B is dropped, then m layers sort A again.
+ * Step 2 halves the candidates each time, so the whole row is never sorted and the
+ * depth is m(m+1)/2 + log2(blocks) * (m + 1) layers. Every layer of every row goes to
+ * one call of cswap, which is a secure comparison and a multiplication.
+ *
+ * @param:
+ *     X, the shared rows x cols matrix, row first
+ *     IDX, the sharings of the column indices 0 .. cols-1
+ *     PAD, PAD_IDX, the sharings the padding takes, PAD below any value of X
+ *     cswap, the batched compare-swap, cswap(A, B, IA, IB) leaves A[i] >= B[i] and
+ *            swaps IA[i], IB[i] along with them
+ * @return:
+ *     V, I, the rows x k largest values, descending, and their index sharings
+ */
+template <typename T, typename CmpSwapFn>
+void bitonic_topk(
+  const std::vector<T>& X,
+  const std::vector<T>& IDX,
+  const T& PAD,
+  const T& PAD_IDX,
+  size_t rows,
+  size_t cols,
+  size_t k,
+  std::vector<T>& V,
+  std::vector<T>& I,
+  CmpSwapFn cswap) {
+  assert(X.size() == rows * cols && IDX.size() == cols && k > 0 && k <= cols);
+
+  size_t K = 1;
+  while (K < k)
+    K <<= 1;
+  size_t blocks = 1;
+  while (blocks * K < cols)
+    blocks <<= 1;
+  size_t N = blocks * K;
+
+  std::vector<T> W(rows * N, PAD), WI(rows * N, PAD_IDX);
+  for (size_t r = 0; r < rows; r++) {
+    for (size_t j = 0; j < cols; j++) {
+      W[r * N + j] = X[r * cols + j];
+      WI[r * N + j] = IDX[j];
+    }
+  }
+
+  // one batched compare-swap layer, larger value to the first position of each pair
+  std::vector<std::pair<size_t, size_t>> pairs;
+  std::vector<T> A, B, IA, IB;
+  auto layer = [&]() {
+    size_t n = pairs.size();
+    A.resize(n);
+    B.resize(n);
+    IA.resize(n);
+    IB.resize(n);
+    for (size_t t = 0; t < n; t++) {
+      A[t] = W[pairs[t].first];
+      B[t] = W[pairs[t].second];
+      IA[t] = WI[pairs[t].first];
+      IB[t] = WI[pairs[t].second];
+    }
+    cswap(A, B, IA, IB);
+    for (size_t t = 0; t < n; t++) {
+      W[pairs[t].first] = A[t];
+      W[pairs[t].second] = B[t];
+      WI[pairs[t].first] = IA[t];
+      WI[pairs[t].second] = IB[t];
+    }
+  };
+
+  // 1. bitonic sort of each block, descending
+  for (size_t s = 2; s <= K; s <<= 1) {
+    for (size_t t = s >> 1; t > 0; t >>= 1) {
+      pairs.clear();
+      for (size_t r = 0; r < rows; r++) {
+        for (size_t i = 0; i < N; i++) {
+          size_t li = i % K, l = i ^ t;
+          if (l <= i)
+            continue;
+          bool desc = (li & s) == 0;
+          size_t hi = desc ? i : l, lo = desc ? l : i;
+          pairs.emplace_back(r * N + hi, r * N + lo);
+        }
+      }
+      layer();
+    }
+  }
+
+  // 2. merge pairs of blocks, keeping only the K largest of each pair
+  while (blocks > 1) {
+    pairs.clear();
+    for (size_t r = 0; r < rows; r++) {
+      for (size_t b = 0; b < blocks; b += 2) {
+        size_t base = r * N + b * K;
+        for (size_t i = 0; i < K; i++)
+          pairs.emplace_back(base + i, base + K + (K - 1 - i));
+      }
+    }
+    layer();
+
+    blocks >>= 1;
+    size_t M = blocks * K;
+    std::vector<T> W2(rows * M), WI2(rows * M);
+    for (size_t r = 0; r < rows; r++) {
+      for (size_t b = 0; b < blocks; b++) {
+        for (size_t i = 0; i < K; i++) {
+          W2[r * M + b * K + i] = W[r * N + 2 * b * K + i];
+          WI2[r * M + b * K + i] = WI[r * N + 2 * b * K + i];
+        }
+      }
+    }
+    W.swap(W2);
+    WI.swap(WI2);
+    N = M;
+
+    for (size_t t = K >> 1; t > 0; t >>= 1) {
+      pairs.clear();
+      for (size_t r = 0; r < rows; r++) {
+        for (size_t i = 0; i < N; i++) {
+          size_t l = i ^ t;
+          if (l > i)
+            pairs.emplace_back(r * N + i, r * N + l);
+        }
+      }
+      layer();
+    }
+  }
+
+  V.resize(rows * k);
+  I.resize(rows * k);
+  for (size_t r = 0; r < rows; r++) {
+    for (size_t j = 0; j < k; j++) {
+      V[r * k + j] = W[r * N + j];
+      I[r * k + j] = WI[r * N + j];
+    }
+  }
+}
+
+} // namespace rosetta
@@ -0,0 +1,282 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/comm/include/mpc_checkpoint.h"
+#include "cc/modules/protocol/utility/include/binary_state.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <openssl/sha.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace rosetta {
+
+namespace {
+const char kMagic[8] = {'R', 'T', 'T', 'C', 'K', 'P', '0', '1'};
+const char* kSuffix = ".ckpt";
+
+std::string sha256(const std::string& data) {
+  unsigned char digest[SHA256_DIGEST_LENGTH];
+  SHA256((const unsigned char*)data.data(), data.size(), digest);
+  return std::string((const char*)digest, sizeof(digest));
+}
+
+struct CheckpointFile {
+  std::string body;
+  std::map<std::string, std::string> digests; // node id -> digest of its body
+};
+
+bool write_file(const std::string& path, const CheckpointFile& f) {
+  std::string content(kMagic, sizeof(kMagic));
+  BinaryStateWriter w(content);
+  w.put_string(f.body);
+  w.put_string_map(f.digests);
+  content += sha256(content);
+
+  // a half written file never has the final name
+  std::string tmp = path + ".tmp";
+  std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+  out.write(content.data(), content.size());
+  out.close();
+  if (!out.good() || rename(tmp.c_str(), path.c_str()) != 0) {
+    remove(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool read_file(const std::string& path, CheckpointFile& f) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in.good())
+    return false;
+  std::stringstream ss;
+  ss << in.rdbuf();
+  std::string content = ss.str();
+  if (content.size() < sizeof(kMagic) + SHA256_DIGEST_LENGTH ||
+      content.compare(0, sizeof(kMagic), kMagic, sizeof(kMagic)) != 0)
+    return false;
+  std::string payload = content.substr(0, content.size() - SHA256_DIGEST_LENGTH);
+  if (sha256(payload) != content.substr(payload.size()))
+    return false;
+  std::string fields = payload.substr(sizeof(kMagic));
+  BinaryStateReader r(fields);
+  r.get_string(f.body);
+  r.get_string_map(f.digests);
+  return r.ok() && r.eof();
+}
+} // namespace
+
+MpcCheckpoint::MpcCheckpoint(MpcProtocol* protocol, const std::string& dir, size_t keep)
+    : protocol_(protocol), dir_(dir), keep_(std::max<size_t>(keep, 1)) {
+  node_id_ = protocol_->GetNetHandler()->GetCurrentNodeId();
+  mkdir(dir_.c_str(), 0700);
+}
+
+std::string MpcCheckpoint::Path(uint64_t step) const {
+  return dir_ + "/" + node_id_ + "-" + std::to_string(step) + kSuffix;
+}
+
+std::vector<std::string> MpcCheckpoint::Peers() const {
+  std::vector<std::string> peers;
+  for (auto& node : protocol_->GetNetHandler()->GetComputationNodes()) {
+    if (node.first != node_id_)
+      peers.push_back(node.first);
+  }
+  return peers;
+}
+
+std::vector<uint64_t> MpcCheckpoint::LocalSteps() const {
+  std::vector<uint64_t> steps;
+  DIR* d = opendir(dir_.c_str());
+  if (d == nullptr)
+    return steps;
+  const std::string prefix = node_id_ + "-";
+  const std::string suffix(kSuffix);
+  while (struct dirent* e = readdir(d)) {
+    std::string name(e->d_name);
+    if (name.size() <= prefix.size() + suffix.size() || name.compare(0, prefix.size(), prefix) != 0 ||
+        name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0)
+      continue;
+    std::string step = name.substr(prefix.size(), name.size() - prefix.size() - suffix.size());
+    if (!step.empty() && std::all_of(step.begin(), step.end(), ::isdigit))
+      steps.push_back(std::stoull(step));
+  }
+  closedir(d);
+  std::sort(steps.begin(), steps.end());
+  return steps;
+}
+
+bool MpcCheckpoint::Agree(bool ok, const std::string& what) {
+  auto net_io = protocol_->GetNetHandler();
+  msg_id_t msgid("checkpoint agree " + what);
+  char mine = ok ? 1 : 0;
+  auto peers = Peers();
+  for (auto& peer : peers)
+    net_io->send(peer, &mine, 1, msgid);
+  for (auto& peer : peers) {
+    char theirs = 0;
+    net_io->recv(peer, &theirs, 1, msgid);
+    ok = ok && theirs == 1;
+  }
+  return ok;
+}
+
+void MpcCheckpoint::Prune() {
+  auto steps = LocalSteps();
+  for (size_t i = 0; i + keep_ < steps.size(); i++)
+    remove(Path(steps[i]).c_str());
+}
+
+int MpcCheckpoint::Save(uint64_t step, const std::map<std::string, std::vector<std::string>>& tensors) {
+  auto net_io = protocol_->GetNetHandler();
+  const std::string tag = std::to_string(step);
+  // no op of the step is in flight anywhere after this
+  net_io->sync_with(msg_id_t("checkpoint barrier " + tag));
+
+  CheckpointFile f;
+  BinaryStateWriter w(f.body);
+  w.put_string(protocol_->Name());
+  w.put_string(node_id_);
+  w.put(step);
+  w.put<uint64_t>(tensors.size());
+  for (auto& t : tensors) {
+    w.put_string(t.first);
+    w.put_strings(t.second);
+  }
+  std::string state;
+  protocol_->SaveSessionState(state);
+  w.put_string(state);
+
+  // every file records the digests of all the parties' files of the step
+  std::string mine = sha256(f.body);
+  f.digests[node_id_] = mine;
+  msg_id_t msgid("checkpoint digests " + tag);
+  bool ok = true;
+  auto peers = Peers();
+  for (auto& peer : peers)
+    net_io->send(peer, mine.data(), mine.size(), msgid);
+  for (auto& peer : peers) {
+    std::string theirs(SHA256_DIGEST_LENGTH, 0);
+    net_io->recv(peer, &theirs[0], theirs.size(), msgid);
+    f.digests[peer] = theirs;
+  }
+
+  if (!write_file(Path(step), f)) {
+    log_error << "checkpoint: cannot write " << Path(step);
+    ok = false;
+  }
+  if (!Agree(ok, "save " + tag)) {
+    // not every party has the step, so it is no checkpoint
+    remove(Path(step).c_str());
+    log_error << "checkpoint: step " << step << " was not saved by all the parties";
+    return -1;
+  }
+  Prune();
+  log_info << "checkpoint: step " << step << " saved, " << tensors.size() << " tensors";
+  return 0;
+}
+
+int MpcCheckpoint::Restore(uint64_t& step, std::map<std::string, std::vector<std::string>>& tensors) {
+  auto net_io = protocol_->GetNetHandler();
+  auto peers = Peers();
+
+  // the steps all the parties have
+  std::vector<uint64_t> common = LocalSteps();
+  msg_id_t msgid("checkpoint steps");
+  uint64_t n = common.size();
+  for (auto& peer : peers) {
+    net_io->send(peer, (const char*)&n, sizeof(n), msgid);
+    if (n > 0)
+      net_io->send(peer, (const char*)common.data(), n * sizeof(uint64_t), msgid);
+  }
+  for (auto& peer : peers) {
+    uint64_t m = 0;
+    net_io->recv(peer, (char*)&m, sizeof(m), msgid);
+    std::vector<uint64_t> theirs(m);
+    if (m > 0)
+      net_io->recv(peer, (char*)theirs.data(), m * sizeof(uint64_t), msgid);
+    std::vector<uint64_t> both;
+    std::set_intersection(common.begin(), common.end(), theirs.begin(), theirs.end(),
+                          std::back_inserter(both));
+    common.swap(both);
+  }
+  if (common.empty()) {
+    log_info << "checkpoint: no checkpoint in common in " << dir_;
+    return 1;
+  }
+
+  // the latest one that checks out on all the parties
+  for (auto iter = common.rbegin(); iter != common.rend(); ++iter) {
+    const std::string tag = std::to_string(*iter);
+    CheckpointFile f;
+    bool ok = read_file(Path(*iter), f);
+    std::string mine = ok ? sha256(f.body) : std::string(SHA256_DIGEST_LENGTH, 0);
+    ok = ok && f.digests[node_id_] == mine;
+    if (!ok)
+      log_error << "checkpoint: " << Path(*iter) << " is damaged";
+
+    // the others must load the very files that were saved with ours
+    msg_id_t dmsgid("checkpoint restore digests " + tag);
+    for (auto& peer : peers)
+      net_io->send(peer, mine.data(), mine.size(), dmsgid);
+    for (auto& peer : peers) {
+      std::string theirs(SHA256_DIGEST_LENGTH, 0);
+      net_io->recv(peer, &theirs[0], theirs.size(), dmsgid);
+      if (ok && f.digests[peer] != theirs) {
+        log_error << "checkpoint: step " << *iter << " of " << peer << " does not match ours";
+        ok = false;
+      }
+    }
+
+    std::string protocol, node, state;
+    uint64_t saved_step = 0;
+    std::map<std::string, std::vector<std::string>> saved;
+    if (ok) {
+      BinaryStateReader r(f.body);
+      uint64_t count = 0;
+      r.get_string(protocol);
+      r.get_string(node);
+      r.get(saved_step);
+      r.get(count);
+      for (uint64_t i = 0; i < count && r.ok(); i++) {
+        std::string name;
+        r.get_string(name);
+        r.get_strings(saved[name]);
+      }
+      r.get_string(state);
+      ok = r.ok() && protocol == protocol_->Name() && node == node_id_ && saved_step == *iter;
+      // a failed agreement leaves this state half loaded, an older step or a fresh Init replaces it
+      ok = ok && protocol_->LoadSessionState(state) == 0;
+    }
+    if (Agree(ok, "restore " + tag)) {
+      step = saved_step;
+      tensors.swap(saved);
+      log_info << "checkpoint: step " << step << " restored from " << dir_;
+      return 0;
+    }
+    log_warn << "checkpoint: step " << *iter << " does not check out on all the parties";
+  }
+  return -1;
+}
+
+} // namespace rosetta
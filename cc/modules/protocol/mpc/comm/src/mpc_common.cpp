@@ -17,6 +17,8 @@
 // ==============================================================================
 #include "cc/modules/protocol/mpc/comm/include/mpc_common.h"
 
+#include <algorithm>
+#include <cassert>
 #include <vector>
 #include <unordered_map>
 #include <iostream>
@@ -107,6 +109,44 @@ bool PolyConfFactory::get_func_polys(
   }
 }
 
+bool PolyConfFactory::get_func_telescoping(
+  const std::string& func_name,
+  int precision,
+  vector<double>& break_points,
+  vector<vector<mpc_t>>& coffs) {
+  vector<ConstPolynomial>* polys = nullptr;
+  if (!get_func_polys(func_name, &polys) || polys->empty())
+    return false;
+
+  // dense coefficient rows, indexed by power
+  size_t seg_size = polys->size();
+  size_t max_power = 0;
+  vector<vector<mpc_t>> dense(seg_size, vector<mpc_t>(1, 0));
+  vector<mpc_t> power_list, coff_list;
+  for (size_t k = 0; k < seg_size; ++k) {
+    polys->at(k).get_power_list(power_list);
+    polys->at(k).get_coff_list(coff_list, precision);
+    for (size_t j = 0; j < power_list.size(); ++j) {
+      size_t p = (size_t)power_list[j];
+      if (dense[k].size() <= p)
+        dense[k].resize(p + 1, 0);
+      dense[k][p] += coff_list[j];
+    }
+    max_power = std::max(max_power, dense[k].size() - 1);
+  }
+
+  break_points.resize(seg_size - 1);
+  coffs.assign(seg_size, vector<mpc_t>(max_power + 1, 0));
+  for (size_t k = 0; k < seg_size; ++k) {
+    dense[k].resize(max_power + 1, 0);
+    for (size_t p = 0; p <= max_power; ++p)
+      coffs[k][p] = (k == 0) ? dense[k][p] : dense[k][p] - dense[k - 1][p];
+    if (k > 0)
+      break_points[k - 1] = MpcTypeToFloat(polys->at(k).get_start(precision), precision);
+  }
+  return true;
+}
+
 struct LogFuncRegistrar {
   vector<ConstPolynomial>* log_default_vec = nullptr;
   vector<ConstPolynomial>* log_v1_vec = nullptr;
@@ -197,6 +237,122 @@ struct CELogFuncRegistrar {
 
 static CELogFuncRegistrar ce_log_func_registrar;
 
+/*
+  Activations as piecewise polynomials, evaluated by PiecewisePolynomial of SecureNN, Helix and
+  PlainFixpoint. Each function is a left tail, four degree-4 segments and a right tail, the
+  tails being the asymptotes (constants, or x). Segment k covers [bp_{k-1}, bp_k).
+  The coefficients are multiples of 2^-13 and the lower ones were refitted after rounding the
+  higher ones, so that they hold for any FLOAT_PRECISION >= 13.
+  Max absolute error over x in [-120, 120], fixed point with FLOAT_PRECISION 16 (13):
+    TANH          7.7e-4 (9.6e-4)    TANH_GRAD      1.7e-3 (1.8e-3)
+    GELU          5.0e-4 (7.9e-4)    GELU_GRAD      8.6e-4 (1.2e-3)
+    SWISH         1.3e-3 (1.5e-3)    SWISH_GRAD     2.3e-3 (2.3e-3)
+    SOFTPLUS      7.8e-4 (1.0e-3)    SOFTPLUS_GRAD  7.3e-4 (1.2e-3)
+  SWISH is x * sigmoid(x) (SiLU). The secure versions add a few ulps of truncation error.
+  Note: X^4 is computed in the ring, so |x| should stay below 2^((63 - 2 * FLOAT_PRECISION) / 4),
+  that is 128 with FLOAT_PRECISION 16.
+*/
+struct ActivationFuncRegistrar {
+  vector<vector<ConstPolynomial>*> func_vecs;
+
+  void register_func(
+    const string& func_name,
+    const vector<double>& break_points,
+    const vector<vector<vector<double>>>& polys) {
+    assert(polys.size() == break_points.size() + 1);
+    auto segs = new vector<ConstPolynomial>();
+    for (size_t k = 0; k < polys.size(); ++k) {
+      // the tails are open, the bounds here are only for the readers of the tables
+      double start = (k == 0) ? -10000 : break_points[k - 1];
+      double end = (k == break_points.size()) ? 10000 : break_points[k];
+      segs->push_back(ConstPolynomial(start, end, polys[k]));
+    }
+    PolyConfFactory::func_register(func_name, segs);
+    func_vecs.push_back(segs);
+  }
+
+  ActivationFuncRegistrar() {
+    const vector<vector<vector<double>>> TANH_POLYS = {
+      {{0, -1}},
+      {{0, -0.1893310547}, {1, 0.9246826172}, {2, 0.4036865234}, {3, 0.07922363281}, {4, 0.005859375}},
+      {{0, 0.00048828125}, {1, 1.016845703}, {2, 0.07019042969}, {3, -0.2783203125}, {4, -0.09448242188}},
+      {{0, -0.00048828125}, {1, 1.016845703}, {2, -0.07019042969}, {3, -0.2783203125}, {4, 0.09448242188}},
+      {{0, 0.1893310547}, {1, 0.9246826172}, {2, -0.4036865234}, {3, 0.07922363281}, {4, -0.005859375}},
+      {{0, 1}}};
+    register_func("TANH", {-4.1, -1.5, 0, 1.5, 4.1}, TANH_POLYS);
+
+    const vector<vector<vector<double>>> TANH_GRAD_POLYS = {
+      {{0, 0}},
+      {{0, 1.35168457}, {1, 1.451416016}, {2, 0.5914306641}, {3, 0.1075439453}, {4, 0.00732421875}},
+      {{0, 0.9984130859}, {1, -0.06481933594}, {2, -1.424194336}, {3, -0.9875488281}, {4, -0.2060546875}},
+      {{0, 0.9984130859}, {1, 0.06481933594}, {2, -1.424194336}, {3, 0.9875488281}, {4, -0.2060546875}},
+      {{0, 1.35168457}, {1, -1.451416016}, {2, 0.5914306641}, {3, -0.1075439453}, {4, 0.00732421875}},
+      {{0, 0}}};
+    register_func("TANH_GRAD", {-4.6, -1.5, 0, 1.5, 4.6}, TANH_GRAD_POLYS);
+
+    const vector<vector<vector<double>>> GELU_POLYS = {
+      {{0, 0}},
+      {{0, -0.5190429688}, {1, -0.4372558594}, {2, -0.1236572266}, {3, -0.01171875}, {4, 0}},
+      {{0, 0.0003662109375}, {1, 0.5128173828}, {2, 0.4626464844}, {3, 0.1072998047}, {4, -0.001953125}},
+      {{0, 0.0003662109375}, {1, 0.4871826172}, {2, 0.4626464844}, {3, -0.1072998047}, {4, -0.001953125}},
+      {{0, -0.5190429688}, {1, 1.437255859}, {2, -0.1236572266}, {3, 0.01171875}, {4, 0}},
+      {{1, 1}}};
+    register_func("GELU", {-3.8, -1.6, 0, 1.6, 3.8}, GELU_POLYS);
+
+    const vector<vector<vector<double>>> GELU_GRAD_POLYS = {
+      {{0, 0}},
+      {{0, 0.06042480469}, {1, 0.5307617188}, {2, 0.4102783203}, {3, 0.1108398438}, {4, 0.01013183594}},
+      {{0, 0.5003662109}, {1, 0.8050537109}, {2, 0.01477050781}, {3, -0.2946777344}, {4, -0.08837890625}},
+      {{0, 0.4996337891}, {1, 0.8050537109}, {2, -0.01477050781}, {3, -0.2946777344}, {4, 0.08837890625}},
+      {{0, 0.9395751953}, {1, 0.5307617188}, {2, -0.4102783203}, {3, 0.1108398438}, {4, -0.01013183594}},
+      {{0, 1}}};
+    register_func("GELU_GRAD", {-3.9, -1.7, 0, 1.7, 3.9}, GELU_GRAD_POLYS);
+
+    const vector<vector<vector<double>>> SWISH_POLYS = {
+      {{0, 0}},
+      {{0, -0.6961669922}, {1, -0.3112792969}, {2, -0.05346679688}, {3, -0.004150390625}, {4, -0.0001220703125}},
+      {{0, 0.000732421875}, {1, 0.5153808594}, {2, 0.2999267578}, {3, 0.05639648438}, {4, 0.002685546875}},
+      {{0, 0.000732421875}, {1, 0.4846191406}, {2, 0.2999267578}, {3, -0.05639648438}, {4, 0.002685546875}},
+      {{0, -0.6960449219}, {1, 1.311279297}, {2, -0.05346679688}, {3, 0.004150390625}, {4, -0.0001220703125}},
+      {{1, 1}}};
+    register_func("SWISH", {-9.6, -2.6, 0, 2.6, 10.5}, SWISH_POLYS);
+
+    const vector<vector<vector<double>>> SWISH_GRAD_POLYS = {
+      {{0, 0}},
+      {{0, -0.2821044922}, {1, -0.09167480469}, {2, -0.01000976562}, {3, -0.0003662109375}, {4, 0}},
+      {{0, 0.5014648438}, {1, 0.5235595703}, {2, 0.05554199219}, {3, -0.05187988281}, {4, -0.01147460938}},
+      {{0, 0.4985351562}, {1, 0.5235595703}, {2, -0.05554199219}, {3, -0.05187988281}, {4, 0.01147460938}},
+      {{0, 1.187988281}, {1, -0.01330566406}, {2, -0.01293945312}, {3, 0.00244140625}, {4, -0.0001220703125}},
+      {{0, 1}}};
+    register_func("SWISH_GRAD", {-9.8, -2.8, 0, 2.8, 8.8}, SWISH_GRAD_POLYS);
+
+    const vector<vector<vector<double>>> SOFTPLUS_POLYS = {
+      {{0, 0}},
+      {{0, 0.3537597656}, {1, 0.1896972656}, {2, 0.03869628906}, {3, 0.003540039062}, {4, 0.0001220703125}},
+      {{0, 0.6934814453}, {1, 0.5061035156}, {2, 0.1413574219}, {3, 0.01550292969}, {4, 0.000244140625}},
+      {{0, 0.6934814453}, {1, 0.4938964844}, {2, 0.1413574219}, {3, -0.01550292969}, {4, 0.000244140625}},
+      {{0, 0.3537597656}, {1, 0.8103027344}, {2, 0.03869628906}, {3, -0.003540039062}, {4, 0.0001220703125}},
+      {{1, 1}}};
+    register_func("SOFTPLUS", {-8.5, -3.1, 0, 3.1, 8.5}, SOFTPLUS_POLYS);
+
+    const vector<vector<vector<double>>> SOFTPLUS_GRAD_POLYS = {
+      {{0, 0}},
+      {{0, 0.3529052734}, {1, 0.1895751953}, {2, 0.03869628906}, {3, 0.003540039062}, {4, 0.0001220703125}},
+      {{0, 0.5004882812}, {1, 0.2547607422}, {2, 0.00927734375}, {3, -0.01721191406}, {4, -0.0029296875}},
+      {{0, 0.4995117188}, {1, 0.2547607422}, {2, -0.00927734375}, {3, -0.01721191406}, {4, 0.0029296875}},
+      {{0, 0.6470947266}, {1, 0.1895751953}, {2, -0.03869628906}, {3, 0.003540039062}, {4, -0.0001220703125}},
+      {{0, 1}}};
+    register_func("SOFTPLUS_GRAD", {-8.4, -3, 0, 3, 8.4}, SOFTPLUS_GRAD_POLYS);
+  }
+  ~ActivationFuncRegistrar() {
+    for (auto segs : func_vecs)
+      delete segs;
+    func_vecs.clear();
+  }
+};
+
+static ActivationFuncRegistrar activation_func_registrar;
+
 // helpers
 // ref snn
 void EigenMatMul(
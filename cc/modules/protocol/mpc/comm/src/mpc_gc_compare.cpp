@@ -0,0 +1,97 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/comm/include/mpc_gc_compare.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+namespace rosetta {
+
+// pings for the round trip, and the payload for the bandwidth
+static const int kCalibratePings = 9;
+static const size_t kCalibrateBytes = 1 << 20;
+
+bool MpcCmpCostModel::PreferGc(size_t size) const {
+  if (mode != AUTO)
+    return mode == GC;
+  double native_ms = native_rtts * rtt_ms + native_bytes * size / bytes_per_ms;
+  double gc_ms = gc_rtts * rtt_ms + gc_bytes * size / bytes_per_ms;
+  return gc_ms < native_ms;
+}
+
+void MpcCmpCostModel::Calibrate(shared_ptr<NET_IO> net_io, const msg_id_t& msgid) {
+  int party = net_io->GetCurrentPartyId();
+  double measured[2] = {rtt_ms, bytes_per_ms};
+
+  if (party == PARTY_A) {
+    using clock = std::chrono::steady_clock;
+    vector<double> rtts;
+    char ping = 0;
+    for (int i = 0; i < kCalibratePings; ++i) {
+      auto beg = clock::now();
+      net_io->send(PARTY_B, &ping, 1, msgid);
+      net_io->recv(PARTY_B, &ping, 1, msgid);
+      rtts.push_back(std::chrono::duration<double, std::milli>(clock::now() - beg).count());
+    }
+    std::sort(rtts.begin(), rtts.end());
+    measured[0] = rtts[rtts.size() / 2];
+
+    std::string payload(kCalibrateBytes, 0);
+    auto beg = clock::now();
+    net_io->send(PARTY_B, payload.data(), payload.size(), msgid);
+    net_io->recv(PARTY_B, &ping, 1, msgid);
+    double ms = std::chrono::duration<double, std::milli>(clock::now() - beg).count() - measured[0];
+    if (ms > 0)
+      measured[1] = kCalibrateBytes / ms;
+
+    for (auto& node : net_io->GetComputationNodes()) {
+      if (node.second != PARTY_A)
+        net_io->send(node.first, (const char*)measured, sizeof(measured), msgid);
+    }
+  } else {
+    if (party == PARTY_B) {
+      char ping = 0;
+      for (int i = 0; i < kCalibratePings; ++i) {
+        net_io->recv(PARTY_A, &ping, 1, msgid);
+        net_io->send(PARTY_A, &ping, 1, msgid);
+      }
+      std::string payload(kCalibrateBytes, 0);
+      net_io->recv(PARTY_A, &payload[0], payload.size(), msgid);
+      net_io->send(PARTY_A, &ping, 1, msgid);
+    }
+    net_io->recv(PARTY_A, (char*)measured, sizeof(measured), msgid);
+  }
+
+  rtt_ms = measured[0];
+  bytes_per_ms = measured[1];
+  log_info << "comparison cost model: " << to_string();
+}
+
+std::string MpcCmpCostModel::to_string() const {
+  std::stringstream ss;
+  ss << "rtt(ms): " << rtt_ms << ", bandwidth(MB/s): " << bytes_per_ms / 1000
+     << ", gc below " << (gc_bytes > native_bytes
+                            ? (native_rtts - gc_rtts) * rtt_ms * bytes_per_ms / (gc_bytes - native_bytes)
+                            : 0)
+     << " elements";
+  return ss.str();
+}
+
+} // namespace rosetta
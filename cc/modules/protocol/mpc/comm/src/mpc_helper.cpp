@@ -19,7 +19,9 @@
 #include "cc/modules/common/include/utils/rtt_exceptions.h"
 #include "cc/modules/protocol/mpc/comm/include/mpc_helper.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <vector>
@@ -47,6 +49,10 @@ void convert_double_to_literal_str(const vector<double>& a, vector<string>& b, i
     b[i] = std::to_string(a[i]);
 }
 
+double clamp_fixpoint_epsilon(double epsilon, int precision) {
+  return std::max(epsilon, std::ldexp(1.0, -precision));
+}
+
 void convert_string_to_mpctype(const vector<std::string>& a, vector<mpc_t>& b, bool human) {
   size_t size = a.size();
   b.resize(size);
@@ -0,0 +1,233 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/comm/include/mpc_lr_serving.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_helper.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace rosetta {
+
+static double percentile(std::vector<double>& sorted, double p) {
+  if (sorted.empty())
+    return 0;
+  size_t i = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(i, sorted.size() - 1)];
+}
+
+std::string MpcLrServingStats::to_string() const {
+  std::stringstream ss;
+  ss << "requests: " << requests << ", batches: " << batches << ", mean batch: " << mean_batch
+     << ", latency(ms) p50: " << p50_ms << ", p90: " << p90_ms << ", p99: " << p99_ms
+     << ", max: " << max_ms;
+  return ss.str();
+}
+
+MpcLrServer::MpcLrServer(MpcProtocol* protocol, const MpcLrServingConfig& config)
+    : protocol_(protocol),
+      config_(config),
+      msgid_("lr serving batch pipeline"),
+      batch_msgid_("lr serving batch size") {
+  is_feature_owner_ = protocol_->GetNetHandler()->GetCurrentNodeId() == config_.feature_owner;
+  if (config_.max_batch == 0)
+    config_.max_batch = 1;
+}
+
+int MpcLrServer::LoadModel(const std::vector<double>& weights, double bias) {
+  const std::string& me = protocol_->GetNetHandler()->GetCurrentNodeId();
+  std::vector<double> w(config_.features, 0), b(1, 0);
+  if (me == config_.model_owner) {
+    if (weights.size() != config_.features) {
+      log_error << "lr serving: model has " << weights.size() << " weights, expected "
+                << config_.features;
+      return -1;
+    }
+    w = weights;
+    b[0] = bias;
+  }
+
+  auto ops = protocol_->GetOps(msgid_);
+  std::vector<std::string> sb;
+  ops->PrivateInput(config_.model_owner, w, weights_);
+  ops->PrivateInput(config_.model_owner, b, sb);
+  bias_ = sb[0];
+  loaded_ = true;
+  log_info << "lr serving: model of " << config_.features << " features loaded";
+  return 0;
+}
+
+std::future<double> MpcLrServer::Submit(const std::vector<double>& features) {
+  Request req;
+  req.features = features;
+  req.submitted = std::chrono::steady_clock::now();
+  std::future<double> result = req.result.get_future();
+
+  if (!is_feature_owner_) {
+    req.result.set_exception(
+      std::make_exception_ptr(std::logic_error("lr serving: requests go to the feature owner")));
+    return result;
+  }
+  if (features.size() != config_.features) {
+    req.result.set_exception(std::make_exception_ptr(std::invalid_argument(
+      "lr serving: request has " + std::to_string(features.size()) + " features, expected " +
+      std::to_string(config_.features))));
+    return result;
+  }
+
+  std::unique_lock<std::mutex> lck(mtx_);
+  if (stopping_) {
+    req.result.set_exception(
+      std::make_exception_ptr(std::runtime_error("lr serving: server is stopping")));
+    return result;
+  }
+  queue_.push_back(std::move(req));
+  cv_.notify_all();
+  return result;
+}
+
+void MpcLrServer::Stop() {
+  std::unique_lock<std::mutex> lck(mtx_);
+  stopping_ = true;
+  cv_.notify_all();
+}
+
+std::vector<MpcLrServer::Request> MpcLrServer::NextBatch() {
+  std::vector<Request> batch;
+  std::unique_lock<std::mutex> lck(mtx_);
+  cv_.wait(lck, [this] { return stopping_ || !queue_.empty(); });
+  if (queue_.empty())
+    return batch;
+
+  // the oldest request waits at most one window for others to join it
+  auto deadline = queue_.front().submitted + std::chrono::milliseconds(config_.batch_window_ms);
+  cv_.wait_until(lck, deadline, [this] { return stopping_ || queue_.size() >= config_.max_batch; });
+
+  size_t size = std::min(queue_.size(), config_.max_batch);
+  batch.reserve(size);
+  for (size_t i = 0; i < size; i++) {
+    batch.push_back(std::move(queue_.front()));
+    queue_.pop_front();
+  }
+  return batch;
+}
+
+int MpcLrServer::Serve() {
+  if (!loaded_) {
+    log_error << "lr serving: LoadModel must be called before Serve";
+    return -1;
+  }
+
+  auto net_io = protocol_->GetNetHandler();
+  const std::string& me = net_io->GetCurrentNodeId();
+  while (true) {
+    std::vector<Request> batch;
+    uint64_t size = 0;
+    if (is_feature_owner_) {
+      batch = NextBatch();
+      size = batch.size();
+      for (auto& node : net_io->GetComputationNodes()) {
+        if (node.first != me)
+          net_io->send(node.first, (const char*)&size, sizeof(size), batch_msgid_);
+      }
+    } else {
+      net_io->recv(config_.feature_owner, (char*)&size, sizeof(size), batch_msgid_);
+    }
+    if (size == 0)
+      break;
+
+    int ret = RunBatch(size, batch);
+    if (ret != 0)
+      return ret;
+  }
+  log_info << "lr serving: stopped, " << Stats().to_string();
+  return 0;
+}
+
+int MpcLrServer::RunBatch(size_t size, std::vector<Request>& batch) {
+  const size_t d = config_.features;
+  std::vector<double> x(size * d, 0);
+  for (size_t i = 0; i < batch.size(); i++)
+    std::copy(batch[i].features.begin(), batch[i].features.end(), x.begin() + i * d);
+
+  // z = x * w + b, then sigmoid(z), or the label z >= 0
+  auto ops = protocol_->GetOps(msgid_);
+  std::vector<std::string> sx, z, zb, y;
+  std::vector<double> out;
+  attr_type mm_attr;
+  mm_attr["m"] = std::to_string(size);
+  mm_attr["k"] = std::to_string(d);
+  mm_attr["n"] = "1";
+  attr_type reveal_attr;
+  reveal_attr["receive_parties"] = encode_reveal_node(config_.feature_owner);
+  try {
+    ops->PrivateInput(config_.feature_owner, x, sx);
+    ops->Matmul(sx, weights_, z, &mm_attr);
+    ops->Add(z, std::vector<std::string>(size, bias_), zb);
+    if (config_.label_only)
+      ops->ReluPrime(zb, y);
+    else
+      ops->Sigmoid(zb, y);
+    ops->Reveal(y, out, &reveal_attr);
+  } catch (const std::exception& e) {
+    log_error << "lr serving: batch of " << size << " failed: " << e.what();
+    for (auto& req : batch)
+      req.result.set_exception(std::current_exception());
+    return -1;
+  }
+
+  if (!is_feature_owner_)
+    return 0;
+  auto now = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lck(stats_mtx_);
+  for (size_t i = 0; i < batch.size(); i++) {
+    batch[i].result.set_value(out[i]);
+    double ms = std::chrono::duration<double, std::milli>(now - batch[i].submitted).count();
+    if (latencies_ms_.size() < kLatencyWindow)
+      latencies_ms_.push_back(ms);
+    else
+      latencies_ms_[latency_next_] = ms;
+    latency_next_ = (latency_next_ + 1) % kLatencyWindow;
+    max_ms_ = std::max(max_ms_, ms);
+  }
+  requests_ += batch.size();
+  batches_++;
+  return 0;
+}
+
+MpcLrServingStats MpcLrServer::Stats() const {
+  MpcLrServingStats stats;
+  std::vector<double> sorted;
+  {
+    std::unique_lock<std::mutex> lck(stats_mtx_);
+    sorted = latencies_ms_;
+    stats.requests = requests_;
+    stats.batches = batches_;
+    stats.max_ms = max_ms_;
+  }
+  std::sort(sorted.begin(), sorted.end());
+  if (stats.batches > 0)
+    stats.mean_batch = double(stats.requests) / stats.batches;
+  stats.p50_ms = percentile(sorted, 0.50);
+  stats.p90_ms = percentile(sorted, 0.90);
+  stats.p99_ms = percentile(sorted, 0.99);
+  return stats;
+}
+
+} // namespace rosetta
@@ -78,6 +78,86 @@ int MpcPRGObjsV2::Init(const msg_id_t& msg_id, const MpcPRGKeysV2& prg_keys) {
   return 0;
 }
 
+void MpcPRGObjsV2::SaveState(BinaryStateWriter& w) const {
+  for (auto& p : {prg, prg01, prg02, prg12, prg0, prg1, prg2})
+    p->save_state(w);
+  for (auto& m : {&prg_a0, &prg_a1}) {
+    w.put<uint64_t>(m->size());
+    for (auto iter = m->begin(); iter != m->end(); iter++) {
+      w.put_string(iter->first);
+      iter->second->save_state(w);
+    }
+  }
+}
+
+bool MpcPRGObjsV2::LoadState(BinaryStateReader& r) {
+  for (auto& p : {prg, prg01, prg02, prg12, prg0, prg1, prg2}) {
+    if (!p->load_state(r))
+      return false;
+  }
+  for (auto& m : {&prg_a0, &prg_a1}) {
+    uint64_t n = 0;
+    r.get(n);
+    m->clear();
+    for (uint64_t i = 0; i < n && r.ok(); i++) {
+      string node;
+      r.get_string(node);
+      auto p = std::make_shared<RttPRG>();
+      if (!p->load_state(r))
+        return false;
+      (*m)[node] = p;
+    }
+  }
+  return r.ok();
+}
+
+static void save_keys(BinaryStateWriter& w, const MpcPRGKeysV2& keys) {
+  for (auto& k : {&keys.key_prg, &keys.key_prg01, &keys.key_prg02, &keys.key_prg12, &keys.key_prg0,
+                  &keys.key_prg1, &keys.key_prg2})
+    w.put_string(*k);
+  w.put_string_map(keys.key_a0);
+  w.put_string_map(keys.key_a1);
+}
+
+static bool load_keys(BinaryStateReader& r, MpcPRGKeysV2& keys) {
+  for (auto& k : {&keys.key_prg, &keys.key_prg01, &keys.key_prg02, &keys.key_prg12, &keys.key_prg0,
+                  &keys.key_prg1, &keys.key_prg2})
+    r.get_string(*k);
+  r.get_string_map(keys.key_a0);
+  r.get_string_map(keys.key_a1);
+  return r.ok();
+}
+
+void MpcKeyPrgController::SaveState(BinaryStateWriter& w) {
+  std::unique_lock<std::mutex> lck(mutex_);
+  save_keys(w, keys_);
+  w.put<uint64_t>(msgid_mpc_prgs_.size());
+  for (auto iter = msgid_mpc_prgs_.begin(); iter != msgid_mpc_prgs_.end(); iter++) {
+    put_msg_id(w, iter->first);
+    iter->second->SaveState(w);
+  }
+}
+
+bool MpcKeyPrgController::LoadState(BinaryStateReader& r) {
+  std::unique_lock<std::mutex> lck(mutex_);
+  if (!load_keys(r, keys_))
+    return false;
+  uint64_t n = 0;
+  r.get(n);
+  msgid_mpc_prgs_.clear();
+  for (uint64_t i = 0; i < n && r.ok(); i++) {
+    msg_id_t msgid;
+    if (!get_msg_id(r, msgid))
+      return false;
+    auto prgobjs = std::make_shared<MpcPRGObjsV2>();
+    prgobjs->Init(msgid, keys_);
+    if (!prgobjs->LoadState(r))
+      return false;
+    msgid_mpc_prgs_[msgid] = prgobjs;
+  }
+  return r.ok();
+}
+
 void MpcKeyPrgController::Init(const MpcPRGKeysV2& keys) {
   std::unique_lock<std::mutex> lck(mutex_);
   keys_ = keys;
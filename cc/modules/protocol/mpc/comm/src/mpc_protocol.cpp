@@ -16,9 +16,12 @@
 // along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
 // ==============================================================================
 #include "cc/modules/protocol/mpc/comm/include/mpc_protocol.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_secure_debug.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_mask_store.h"
 #include "cc/modules/protocol/utility/include/util.h"
 #include "cc/modules/iowrapper/include/io_manager.h"
 #include "cc/modules/common/include/utils/rtt_logger.h"
+#include "cc/modules/common/include/utils/rtt_async_logger.h"
 
 #include <stdexcept>
 #include <string>
@@ -50,6 +53,11 @@ int MpcProtocol::Init(string logfile) {
       context_->NODE_ROLE_MAPPING = net_io_->GetComputationNodes();
       context_->SAVER_MODEL.set_local_ciphertext_mode();
       context_->RESTORE_MODEL.set_local_ciphertext_mode();
+#if ROSETTA_ENABLES_SECURE_DEBUG
+      context_->SECURE_DEBUG = std::make_shared<SecureDebugMonitor>(context_->TASK_ID);
+      tlog_warn << "Rosetta: secure-debug build, op outputs are revealed to P0 for range checks. NEVER use it in production!";
+#endif
+      context_->MASK_STORE = std::make_shared<MpcMaskStore>();
 
       InitMpcEnvironment();
       InitAesKeys();
@@ -57,6 +65,17 @@ int MpcProtocol::Init(string logfile) {
       // todo: for offline triple generation.
       OfflinePreprocess();
 
+      // a recorded run keeps its keys and PRGs, a replay takes them back, see IOWrapper::StartRecording
+      if (net_io_->Replaying()) {
+        string state;
+        if (!net_io_->ReplaySeed("session state", state) || LoadSessionState(state) != 0)
+          tlog_error << "Rosetta: the transcript has no usable session state, the replay will diverge";
+      } else if (net_io_->Recording()) {
+        string state;
+        SaveSessionState(state);
+        net_io_->RecordSeed("session state", state);
+      }
+
       is_inited_ = true;
       StartPerfStats();
     }
@@ -80,12 +99,24 @@ int MpcProtocol::Uninit() {
 
     msg_id_t msgid(context_->TASK_ID + "_this message id for synchronize P0/P1/P2 uninit");
 
-    // the following time(0) will show the sync beg/end
-    tlog_debug << __FUNCTION__ << " beg sync :" << time(0) ;
-    net_io_->sync_with(msgid);
-    tlog_debug << __FUNCTION__ << " end sync :" << time(0) ;
+    // an aborted task has lost its peers, or they are leaving too
+    if (!net_io_->Aborted()) {
+      // the following time(0) will show the sync beg/end
+      tlog_debug << __FUNCTION__ << " beg sync :" << time(0) ;
+      net_io_->sync_with(msgid);
+      tlog_debug << __FUNCTION__ << " end sync :" << time(0) ;
+    } else {
+      tlog_warn << "task " << context_->TASK_ID << " was aborted: " << net_io_->AbortReason();
+    }
+    net_io_->StopHealth();
     //IOManager::Instance()->DestroyIO();
     net_io_.reset();
+    // the keys are synchronized again by the next Init, so the task can restart
+    if (key_prg_controller_)
+      key_prg_controller_->Reset();
+    key_prg_controller_.reset();
+    gseed_.reset();
+    AsyncLogger::Get().flush();
     rosetta::restore_stdout();
     tlog_info << "Rosetta: Protocol [" << protocol_name_ << "] backend has been released." ;
     is_inited_ = false;
@@ -95,6 +126,43 @@ int MpcProtocol::Uninit() {
   return 0;
 }
 
+int MpcProtocol::SaveSessionState(std::string& state) {
+  state.clear();
+  BinaryStateWriter w(state);
+  SaveState(w);
+  return 0;
+}
+
+int MpcProtocol::LoadSessionState(const std::string& state) {
+  BinaryStateReader r(state);
+  if (!LoadState(r) || !r.eof()) {
+    tlog_error << "session state does not match protocol " << protocol_name_;
+    return -1;
+  }
+  return 0;
+}
+
+void MpcProtocol::SaveState(BinaryStateWriter& w) {
+  w.put<uint8_t>(gseed_ != nullptr);
+  if (gseed_)
+    gseed_->save_state(w);
+  w.put<uint8_t>(key_prg_controller_ != nullptr);
+  if (key_prg_controller_)
+    key_prg_controller_->SaveState(w);
+}
+
+bool MpcProtocol::LoadState(BinaryStateReader& r) {
+  // loaded in place, the internals hold the same objects
+  uint8_t has_gseed = 0, has_keys = 0;
+  r.get(has_gseed);
+  if (has_gseed && (!gseed_ || !gseed_->load_state(r)))
+    return false;
+  r.get(has_keys);
+  if (has_keys && (!key_prg_controller_ || !key_prg_controller_->LoadState(r)))
+    return false;
+  return r.ok();
+}
+
 PerfStats MpcProtocol::GetPerfStats() {
   PerfStats perf_stats;
   if (!is_inited_) {
@@ -114,6 +182,12 @@ PerfStats MpcProtocol::GetPerfStats() {
   perf_stats.s.msg_sent = net_stat.message_sent();
   perf_stats.s.msg_recv = net_stat.message_received();
 
+#if ROSETTA_ENABLES_SECURE_DEBUG
+  //! Numeric ranges
+  if (context_->SECURE_DEBUG)
+    context_->SECURE_DEBUG->Fill(perf_stats);
+#endif
+
   return perf_stats;
 }
 void MpcProtocol::StartPerfStats() {
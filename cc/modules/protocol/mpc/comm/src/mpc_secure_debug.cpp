@@ -0,0 +1,115 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/comm/include/mpc_secure_debug.h"
+
+#if ROSETTA_ENABLES_SECURE_DEBUG
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace rosetta {
+
+static const int RING_BITS = sizeof(mpc_t) * 8;
+
+static inline int bit_length(mpc_t v) {
+  int n = 0;
+  while (v != 0) {
+    v >>= 1;
+    n++;
+  }
+  return n;
+}
+
+bool SecureDebugMonitor::Check(
+  const std::string& op,
+  const msg_id_t& msgid,
+  const std::vector<mpc_t>& plain,
+  int float_precision) {
+  // |x| < 2^(RING_BITS-1-2f) <=> bit_length(|x| * 2^f) <= RING_BITS-1-f
+  const int safe_bits = RING_BITS - 1 - float_precision;
+  int max_bits = 0;
+  int lost_bits = 0;
+  uint64_t overflows = 0;
+  for (auto v : plain) {
+    signed_mpc_t s = (signed_mpc_t)v;
+    mpc_t abs_v = s < 0 ? (mpc_t)(-s) : (mpc_t)s;
+    int bits = bit_length(abs_v);
+    if (bits == 0)
+      continue;
+    max_bits = std::max(max_bits, bits);
+    lost_bits = std::max(lost_bits, float_precision - bits);
+    if (bits > safe_bits)
+      overflows++;
+  }
+
+  std::unique_lock<std::mutex> lck(mtx_);
+  float_precision_ = float_precision;
+  max_int_bits_ = std::max(max_int_bits_, max_bits - float_precision);
+
+  auto& st = stats_[op];
+  st.calls++;
+  st.overflows += overflows;
+  st.lost_bits = std::max(st.lost_bits, lost_bits);
+  if (max_bits > 0)
+    st.max_abs = std::max(st.max_abs, std::ldexp(1.0, max_bits - float_precision));
+
+  if (overflows > 0 && first_overflow_.empty()) {
+    first_overflow_ = op + " @ " + msgid.str();
+    tlog_error_(task_id_) << "[secure-debug] first overflow: " << op << " (msg_id: " << msgid.str()
+                          << ") produced " << overflows << "/" << plain.size()
+                          << " values with |x| >= 2^" << (safe_bits - float_precision)
+                          << " at FLOAT_PRECISION " << float_precision
+                          << ", suggested FLOAT_PRECISION <= " << SuggestedPrecision();
+  }
+  return overflows == 0;
+}
+
+int SecureDebugMonitor::SuggestedPrecision() const {
+  // keep one bit of margin: int_bits <= RING_BITS - 2 - 2f
+  return std::max(0, (RING_BITS - 2 - max_int_bits_) / 2);
+}
+
+void SecureDebugMonitor::Fill(PerfStats& ps) const {
+  std::unique_lock<std::mutex> lck(mtx_);
+  ps.numerics = stats_;
+  ps.first_overflow = first_overflow_;
+  if (stats_.empty())
+    return;
+
+  int suggested = SuggestedPrecision();
+  std::stringstream ss;
+  if (!first_overflow_.empty() || suggested < float_precision_) {
+    ss << "lower FLOAT_PRECISION from " << float_precision_ << " to " << suggested
+       << " or rescale inputs, the largest value seen is ~2^" << max_int_bits_;
+  } else {
+    int worst = 0;
+    for (auto& it : stats_)
+      worst = std::max(worst, it.second.lost_bits);
+    if (worst > 0 && suggested > float_precision_)
+      ss << "up to " << worst << " bits lost on small values, FLOAT_PRECISION can be raised to "
+         << suggested;
+    else
+      ss << "FLOAT_PRECISION " << float_precision_ << " is fine";
+  }
+  ps.precision_hint = ss.str();
+}
+
+} // namespace rosetta
+#endif // ROSETTA_ENABLES_SECURE_DEBUG
@@ -0,0 +1,513 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/comm/include/mpc_share_file.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_helper.h"
+#include "cc/modules/protocol/utility/include/binary_state.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <cstdio>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#error "share files hold little-endian ring words"
+#endif
+
+namespace rosetta {
+
+namespace {
+
+const char kMagic[8] = {'R', 'T', 'T', 'S', 'H', 'A', 'R', 'E'};
+const uint64_t kDataAlign = 64;
+
+struct FileCloser {
+  void operator()(FILE* f) const {
+    if (f)
+      fclose(f);
+  }
+};
+typedef std::unique_ptr<FILE, FileCloser> FilePtr;
+
+uint64_t align_up(uint64_t n) { return (n + kDataAlign - 1) / kDataAlign * kDataAlign; }
+
+size_t total_words(const MpcShareFile& file) {
+  size_t n = 0;
+  for (auto& t : file.tensors)
+    n += t.words.size();
+  return n;
+}
+
+} // namespace
+
+size_t MpcShareTensor::elements() const {
+  size_t n = 1;
+  for (auto d : shape)
+    n *= static_cast<size_t>(d);
+  return n;
+}
+
+MpcShareFile::MpcShareFile(MpcProtocol* mpc_protocol) {
+  protocol = mpc_protocol->Name();
+  precision = mpc_protocol->GetMpcContext()->FLOAT_PRECISION;
+  party_id = mpc_protocol->GetNetHandler()->GetCurrentPartyId();
+  // Helix keeps two ring words per element, the others one
+  words_per_element = protocol == "Helix" ? 2 : 1;
+}
+
+int MpcShareFile::Save(const std::string& path) const {
+  // the header has a fixed size whatever the offsets, so it is built twice:
+  // once for its size, then with the offsets of the data
+  std::vector<uint64_t> offsets(tensors.size(), 0);
+  std::string header;
+  for (int pass = 0; pass < 2; pass++) {
+    header.clear();
+    BinaryStateWriter w(header);
+    w.put_string(protocol);
+    w.put<uint32_t>(ring_bits);
+    w.put<uint32_t>(precision);
+    w.put<int32_t>(party_id);
+    w.put<uint32_t>(words_per_element);
+    w.put<uint64_t>(tensors.size());
+    for (size_t i = 0; i < tensors.size(); i++) {
+      w.put_string(tensors[i].name);
+      w.put_vector(tensors[i].shape);
+      w.put<uint64_t>(offsets[i]);
+      w.put<uint64_t>(tensors[i].words.size() * sizeof(mpc_t));
+    }
+
+    uint64_t offset = align_up(sizeof(kMagic) + sizeof(uint32_t) + sizeof(uint64_t) + header.size());
+    for (size_t i = 0; i < tensors.size(); i++) {
+      offsets[i] = offset;
+      offset = align_up(offset + tensors[i].words.size() * sizeof(mpc_t));
+    }
+  }
+
+  FilePtr f(fopen(path.c_str(), "wb"));
+  if (!f) {
+    log_error << "share file: can not open " << path << " for writing";
+    return -1;
+  }
+  uint32_t version = kVersion;
+  uint64_t header_len = header.size();
+  bool ok = fwrite(kMagic, sizeof(kMagic), 1, f.get()) == 1 &&
+    fwrite(&version, sizeof(version), 1, f.get()) == 1 &&
+    fwrite(&header_len, sizeof(header_len), 1, f.get()) == 1 &&
+    fwrite(header.data(), 1, header.size(), f.get()) == header.size();
+  for (size_t i = 0; ok && i < tensors.size(); i++) {
+    const auto& words = tensors[i].words;
+    ok = fseek(f.get(), offsets[i], SEEK_SET) == 0 &&
+      fwrite(words.data(), sizeof(mpc_t), words.size(), f.get()) == words.size();
+  }
+  // pads the data of the last tensor up to the alignment too
+  if (ok && !tensors.empty()) {
+    long end = static_cast<long>(align_up(offsets.back() + tensors.back().words.size() * sizeof(mpc_t)));
+    ok = fseek(f.get(), end - 1, SEEK_SET) == 0 && fputc(0, f.get()) != EOF;
+  }
+  if (!ok || fflush(f.get()) != 0) {
+    log_error << "share file: failed to write " << path;
+    return -1;
+  }
+  return 0;
+}
+
+int MpcShareFile::Load(const std::string& path) {
+  FilePtr f(fopen(path.c_str(), "rb"));
+  if (!f) {
+    log_error << "share file: can not open " << path;
+    return -1;
+  }
+
+  char magic[sizeof(kMagic)];
+  uint32_t version = 0;
+  uint64_t header_len = 0;
+  if (
+    fread(magic, sizeof(magic), 1, f.get()) != 1 || memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+    fread(&version, sizeof(version), 1, f.get()) != 1) {
+    log_error << "share file: " << path << " is not a share file";
+    return -1;
+  }
+  if (version != kVersion) {
+    log_error << "share file: " << path << " is of version " << version << ", expected " << kVersion;
+    return -1;
+  }
+  std::string header;
+  if (fread(&header_len, sizeof(header_len), 1, f.get()) == 1 && header_len < (1ULL << 32)) {
+    header.resize(header_len);
+    if (fread(&header[0], 1, header_len, f.get()) != header_len)
+      header.clear();
+  }
+
+  MpcShareFile file;
+  std::vector<uint64_t> offsets, lengths;
+  uint64_t count = 0;
+  BinaryStateReader r(header);
+  r.get_string(file.protocol);
+  r.get(file.ring_bits);
+  r.get(file.precision);
+  r.get(file.party_id);
+  r.get(file.words_per_element);
+  r.get(count);
+  for (uint64_t i = 0; r.ok() && i < count; i++) {
+    MpcShareTensor t;
+    uint64_t offset = 0, length = 0;
+    r.get_string(t.name);
+    r.get_vector(t.shape);
+    r.get(offset);
+    r.get(length);
+    file.tensors.push_back(std::move(t));
+    offsets.push_back(offset);
+    lengths.push_back(length);
+  }
+  if (header.empty() || !r.ok() || !r.eof()) {
+    log_error << "share file: " << path << " has a broken header";
+    return -1;
+  }
+  if (file.ring_bits != sizeof(mpc_t) * 8) {
+    log_error << "share file: " << path << " holds a ring of " << file.ring_bits << " bits, this build has "
+              << sizeof(mpc_t) * 8;
+    return -1;
+  }
+
+  for (size_t i = 0; i < file.tensors.size(); i++) {
+    auto& t = file.tensors[i];
+    size_t words = t.elements() * file.words_per_element;
+    if (lengths[i] != words * sizeof(mpc_t)) {
+      log_error << "share file: tensor " << t.name << " in " << path << " has " << lengths[i]
+                << " bytes, expected " << words * sizeof(mpc_t);
+      return -1;
+    }
+    t.words.resize(words);
+    if (
+      fseek(f.get(), static_cast<long>(offsets[i]), SEEK_SET) != 0 ||
+      fread(t.words.data(), sizeof(mpc_t), words, f.get()) != words) {
+      log_error << "share file: " << path << " is cut short in tensor " << t.name;
+      return -1;
+    }
+  }
+
+  *this = std::move(file);
+  return 0;
+}
+
+const MpcShareTensor* MpcShareFile::Find(const std::string& name) const {
+  for (auto& t : tensors) {
+    if (t.name == name)
+      return &t;
+  }
+  return nullptr;
+}
+
+int MpcShareFile::AddShares(
+  const std::string& name,
+  const std::vector<int64_t>& shape,
+  const std::vector<std::string>& shares) {
+  MpcShareTensor t;
+  t.name = name;
+  t.shape = shape;
+  if (Find(name) != nullptr || shares.size() != t.elements()) {
+    log_error << "share file: tensor " << name << " exists already or has " << shares.size()
+              << " shares, expected " << t.elements();
+    return -1;
+  }
+
+  const size_t len = words_per_element * sizeof(mpc_t);
+  t.words.resize(shares.size() * words_per_element);
+  for (size_t i = 0; i < shares.size(); i++) {
+    if (shares[i].size() != len + 1 || shares[i].back() != '#') {
+      log_error << "share file: share " << i << " of " << name << " is not a " << protocol << " share";
+      return -1;
+    }
+    memcpy(&t.words[i * words_per_element], shares[i].data(), len);
+  }
+  tensors.push_back(std::move(t));
+  return 0;
+}
+
+int MpcShareFile::GetShares(const std::string& name, std::vector<std::string>& shares) const {
+  const MpcShareTensor* t = Find(name);
+  if (t == nullptr) {
+    log_error << "share file: no tensor " << name;
+    return -1;
+  }
+
+  const size_t len = words_per_element * sizeof(mpc_t);
+  const size_t n = t->elements();
+  shares.resize(n);
+  for (size_t i = 0; i < n; i++) {
+    shares[i].resize(len + 1);
+    memcpy(&shares[i][0], &t->words[i * words_per_element], len);
+    shares[i][len] = '#';
+  }
+  return 0;
+}
+
+int MpcImportPlain(
+  MpcProtocol* protocol,
+  const std::string& owner,
+  const std::string& name,
+  const std::vector<int64_t>& shape,
+  const std::vector<double>& values,
+  MpcShareFile& file) {
+  MpcShareTensor t;
+  t.shape = shape;
+  const size_t n = t.elements();
+  std::vector<double> x(n, 0);
+  if (protocol->GetNetHandler()->GetCurrentNodeId() == owner) {
+    if (values.size() != n) {
+      log_error << "share file: " << name << " has " << values.size() << " values, expected " << n;
+      return -1;
+    }
+    x = values;
+  }
+
+  std::vector<std::string> shares;
+  protocol->GetOps(msg_id_t("share file import"))->PrivateInput(owner, x, shares);
+  return file.AddShares(name, shape, shares);
+}
+
+int MpcExportPlain(
+  MpcProtocol* protocol,
+  const MpcShareFile& file,
+  const std::vector<std::string>& receivers,
+  std::map<std::string, std::vector<double>>& plain) {
+  if (file.protocol != protocol->Name()) {
+    log_error << "share file: shares of " << file.protocol << " can not be revealed by " << protocol->Name();
+    return -1;
+  }
+
+  const std::string& me = protocol->GetNetHandler()->GetCurrentNodeId();
+  bool receiver = std::find(receivers.begin(), receivers.end(), me) != receivers.end();
+  attr_type reveal_attr;
+  reveal_attr["receive_parties"] = encode_reveal_multi_node(receivers);
+  auto ops = protocol->GetOps(msg_id_t("share file export"));
+  for (auto& t : file.tensors) {
+    std::vector<std::string> shares;
+    std::vector<double> out;
+    file.GetShares(t.name, shares);
+    ops->Reveal(shares, out, &reveal_attr);
+    if (receiver)
+      plain[t.name] = std::move(out);
+  }
+  return 0;
+}
+
+int MpcReshareHelixToSnn(shared_ptr<NET_IO> net_io, const MpcShareFile& helix, MpcShareFile& snn) {
+  if (helix.protocol != "Helix" || helix.words_per_element != 2) {
+    log_error << "share file: resharing to SecureNN takes Helix shares, not " << helix.protocol;
+    return -1;
+  }
+  const int party = net_io->GetCurrentPartyId();
+  if (helix.party_id != party) {
+    log_error << "share file: shares of P" << helix.party_id << " can not be reshared by P" << party;
+    return -1;
+  }
+
+  // x1 = A1 alone is known to P2, P0 and P1 move a fresh mask R between their shares
+  const size_t n = total_words(helix) / 2;
+  std::vector<mpc_t> mask(n, 0);
+  if (party != 2) {
+    msg_id_t msgid("share file helix to snn resharing");
+    uint32_t key[4];
+    if (party == 0) {
+      std::random_device rd;
+      for (auto& k : key)
+        k = rd();
+      net_io->send(1, (const char*)key, sizeof(key), msgid);
+    } else {
+      net_io->recv(0, (char*)key, sizeof(key), msgid);
+    }
+    RttPRG prg;
+    prg.reseed(key);
+    prg.fillRing(mask.data(), n);
+  }
+
+  snn = MpcShareFile();
+  snn.protocol = "SecureNN";
+  snn.ring_bits = helix.ring_bits;
+  snn.precision = helix.precision;
+  snn.party_id = helix.party_id;
+  snn.words_per_element = 1;
+  size_t k = 0;
+  for (auto& h : helix.tensors) {
+    MpcShareTensor t;
+    t.name = h.name;
+    t.shape = h.shape;
+    t.words.resize(h.words.size() / 2, 0);
+    for (size_t i = 0; i < t.words.size(); i++, k++) {
+      if (party == 0)
+        t.words[i] = h.words[2 * i] + h.words[2 * i + 1] + mask[k]; // deltaX + A0 + R
+      else if (party == 1)
+        t.words[i] = h.words[2 * i + 1] - mask[k]; // A1 - R
+    }
+    snn.tensors.push_back(std::move(t));
+  }
+  return 0;
+}
+
+int MpcReshareSnnToHelix(shared_ptr<NET_IO> net_io, const MpcShareFile& snn, MpcShareFile& helix) {
+  if (snn.protocol != "SecureNN" || snn.words_per_element != 1) {
+    log_error << "share file: resharing to Helix takes SecureNN shares, not " << snn.protocol;
+    return -1;
+  }
+  const int party = net_io->GetCurrentPartyId();
+  if (snn.party_id != party) {
+    log_error << "share file: shares of P" << snn.party_id << " can not be reshared by P" << party;
+    return -1;
+  }
+
+  // all tensors in one round
+  const size_t n = total_words(snn);
+  std::vector<mpc_t> x, delta(n), mask(n), other(n);
+  x.reserve(n);
+  for (auto& t : snn.tensors)
+    x.insert(x.end(), t.words.begin(), t.words.end());
+
+  msg_id_t msgid("share file snn to helix resharing");
+  if (party == 2) {
+    net_io->recv(0, delta, n, msgid); // A0
+    net_io->recv(1, mask, n, msgid); // A1
+  } else {
+    std::random_device rd;
+    uint32_t key[4] = {rd(), rd(), rd(), rd()};
+    RttPRG prg;
+    prg.reseed(key);
+    prg.fillRing(mask.data(), n);
+
+    const int peer = party == 0 ? 1 : 0;
+    std::vector<mpc_t> masked(n);
+    for (size_t i = 0; i < n; i++)
+      masked[i] = x[i] - mask[i];
+    net_io->send(2, mask, n, msgid);
+    net_io->send(peer, masked, n, msgid);
+    net_io->recv(peer, other, n, msgid);
+    for (size_t i = 0; i < n; i++)
+      delta[i] = masked[i] + other[i];
+  }
+
+  helix = MpcShareFile();
+  helix.protocol = "Helix";
+  helix.ring_bits = snn.ring_bits;
+  helix.precision = snn.precision;
+  helix.party_id = party;
+  helix.words_per_element = 2;
+  size_t k = 0;
+  for (auto& s : snn.tensors) {
+    MpcShareTensor t;
+    t.name = s.name;
+    t.shape = s.shape;
+    t.words.resize(2 * s.words.size());
+    // P0 (deltaX, A0), P1 (deltaX, A1), P2 (A0, A1)
+    for (size_t i = 0; i < s.words.size(); i++, k++) {
+      t.words[2 * i] = delta[k];
+      t.words[2 * i + 1] = mask[k];
+    }
+    helix.tensors.push_back(std::move(t));
+  }
+  return 0;
+}
+
+bool MpcReadNpy(const std::string& path, std::vector<int64_t>& shape, std::vector<double>& values) {
+  FilePtr f(fopen(path.c_str(), "rb"));
+  if (!f) {
+    log_error << "npy: can not open " << path;
+    return false;
+  }
+
+  unsigned char pre[10];
+  if (fread(pre, sizeof(pre), 1, f.get()) != 1 || memcmp(pre, "\x93NUMPY", 6) != 0) {
+    log_error << "npy: " << path << " is not a .npy file";
+    return false;
+  }
+  uint32_t header_len = pre[8] | (pre[9] << 8);
+  if (pre[6] >= 2) {
+    unsigned char more[2];
+    if (fread(more, sizeof(more), 1, f.get()) != 1)
+      return false;
+    header_len |= (more[0] << 16) | (uint32_t(more[1]) << 24);
+  }
+  std::string header(header_len, '\0');
+  if (fread(&header[0], 1, header_len, f.get()) != header_len)
+    return false;
+
+  size_t elem = 0;
+  if (header.find("'<f8'") != std::string::npos)
+    elem = 8;
+  else if (header.find("'<f4'") != std::string::npos)
+    elem = 4;
+  if (elem == 0 || header.find("'fortran_order': False") == std::string::npos) {
+    log_error << "npy: " << path << " is not a C order float64/float32 array: " << header;
+    return false;
+  }
+
+  size_t open = header.find('(', header.find("'shape'"));
+  size_t close = header.find(')', open);
+  if (open == std::string::npos || close == std::string::npos)
+    return false;
+  shape.clear();
+  std::string dims = header.substr(open + 1, close - open - 1);
+  size_t pos = 0;
+  while (pos < dims.size()) {
+    size_t comma = dims.find(',', pos);
+    std::string d = dims.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+    if (d.find_first_of("0123456789") != std::string::npos)
+      shape.push_back(std::stoll(d));
+    if (comma == std::string::npos)
+      break;
+    pos = comma + 1;
+  }
+
+  size_t n = 1;
+  for (auto d : shape)
+    n *= static_cast<size_t>(d);
+  values.resize(n);
+  if (elem == 8)
+    return fread(values.data(), sizeof(double), n, f.get()) == n;
+  std::vector<float> v(n);
+  if (fread(v.data(), sizeof(float), n, f.get()) != n)
+    return false;
+  std::copy(v.begin(), v.end(), values.begin());
+  return true;
+}
+
+bool MpcWriteNpy(const std::string& path, const std::vector<int64_t>& shape, const std::vector<double>& values) {
+  std::string dims;
+  for (auto d : shape)
+    dims += std::to_string(d) + (shape.size() == 1 ? "," : ", ");
+  if (shape.size() > 1)
+    dims.resize(dims.size() - 2);
+  std::string header = "{'descr': '<f8', 'fortran_order': False, 'shape': (" + dims + "), }";
+  // magic, version and length take 10 bytes, the data starts 64 byte aligned
+  header.append(align_up(10 + header.size() + 1) - 10 - header.size() - 1, ' ');
+  header += '\n';
+
+  FilePtr f(fopen(path.c_str(), "wb"));
+  if (!f) {
+    log_error << "npy: can not open " << path << " for writing";
+    return false;
+  }
+  unsigned char pre[10] = {0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0};
+  pre[8] = header.size() & 0xff;
+  pre[9] = (header.size() >> 8) & 0xff;
+  return fwrite(pre, sizeof(pre), 1, f.get()) == 1 &&
+    fwrite(header.data(), 1, header.size(), f.get()) == header.size() &&
+    fwrite(values.data(), sizeof(double), values.size(), f.get()) == values.size();
+}
+
+} // namespace rosetta
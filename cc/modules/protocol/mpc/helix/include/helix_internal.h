@@ -30,6 +30,7 @@ using namespace std;
 
 #include "cc/modules/common/include/utils/helper.h"
 #include "cc/modules/common/include/utils/model_tool.h"
+#include "cc/modules/common/include/utils/rtt_async_logger.h"
 #include "cc/modules/common/include/utils/simple_timer.h"
 #include "cc/modules/protocol/public/include/protocol_base.h"
 #include "cc/modules/protocol/utility/include/prg.h"
@@ -245,7 +246,7 @@ class HelixInternal {
 
   template <typename T1, typename T2>
   void Reveal_(const vector<T1>& X, vector<T2>& plain, const string& nodes) {
-    AUDIT("id:{}, P{} Reveal, input X{}", msgid.get_hex(), player, Vector<T1>(X));
+    AAUDIT("id:{}, P{} Reveal, input X{}", msgid, player, X);
     vector<string> result_nodes = io->GetResultNodes();
     vector<string> parties = decode_reveal_nodes(nodes, io->GetParty2Node(), result_nodes);
     Reveal_(X, plain, parties);
@@ -253,7 +254,7 @@ class HelixInternal {
 
   template <typename T1, typename T2>
   void Reveal_(const vector<T1>& X, vector<T2>& plain, const vector<string>& parties) {
-    AUDIT("id:{}, P{} Reveal_, input X{}", msgid.get_hex(), player, Vector<T1>(X));
+    AAUDIT("id:{}, P{} Reveal_, input X{}", msgid, player, X);
     size_t size = X.size();
     resize_vector(plain, size);
 
@@ -262,21 +263,26 @@ class HelixInternal {
     for (int i = 0; i < size; i++) {
       if (is_helper()) {
         A0[i] = X[i].s0.A0;
-        AUDIT("id:{}, P{} Reveal_, locally holds A0{}", msgid.get_hex(), player, Vector<T2>(A0));
         A1[i] = X[i].s1.A1;
-        AUDIT("id:{}, P{} Reveal_, locally holds A1{}", msgid.get_hex(), player, Vector<T2>(A1));
       } else if (is_primary()) {
         DeltaX[i] = X[i].s0.delta;
-        AUDIT("id:{}, P{} Reveal_, locally holds DeltaX{}", msgid.get_hex(), player, Vector<T2>(DeltaX));
         if (player == PARTY_0) {
           A0[i] = X[i].s1.A0;
-          AUDIT("id:{}, P{} Reveal_, locally holds A0{}", msgid.get_hex(), player, Vector<T2>(A0));
         } else {
           A1[i] = X[i].s1.A1;
-          AUDIT("id:{}, P{} Reveal_, locally holds A1{}", msgid.get_hex(), player, Vector<T2>(A1));
         }
       }
     }
+    if (is_helper()) {
+      AAUDIT("id:{}, P{} Reveal_, locally holds A0{}", msgid, player, A0);
+      AAUDIT("id:{}, P{} Reveal_, locally holds A1{}", msgid, player, A1);
+    } else if (is_primary()) {
+      AAUDIT("id:{}, P{} Reveal_, locally holds DeltaX{}", msgid, player, DeltaX);
+      if (player == PARTY_0)
+        AAUDIT("id:{}, P{} Reveal_, locally holds A0{}", msgid, player, A0);
+      else
+        AAUDIT("id:{}, P{} Reveal_, locally holds A1{}", msgid, player, A1);
+    }
 
     string node_0 = io->GetNodeId(PARTY_0);
     string node_1 = io->GetNodeId(PARTY_1);
@@ -286,61 +292,61 @@ class HelixInternal {
       if (parties[i] == node_0) {
         if (player == PARTY_0) {
           recv(node_1, A1, size);
-          AUDIT("id:{}, P{} Reveal_ P{} RECV from {}, A1{}", msgid.get_hex(), player, player, node_1, Vector<T2>(A1));
+          AAUDIT("id:{}, P{} Reveal_ P{} RECV from {}, A1{}", msgid, player, player, node_1, A1);
           plain = DeltaX + A0 + A1;
 
         } else if (player == PARTY_1) {
           send(node_0, A1, size);
-          AUDIT("id:{}, P{} Reveal_, P{} SEND to {}, A1{}", msgid.get_hex(), player, player, node_0, Vector<T2>(A1));
+          AAUDIT("id:{}, P{} Reveal_, P{} SEND to {}, A1{}", msgid, player, player, node_0, A1);
         }
       }
       else if (parties[i] == node_1) {
         if (player == PARTY_1) {
           recv(node_2, A0, size);
-          AUDIT("id:{}, P{} Reveal_, P{} RECV from {}, A0{}", msgid.get_hex(), player, player, node_2, Vector<T2>(A0));
+          AAUDIT("id:{}, P{} Reveal_, P{} RECV from {}, A0{}", msgid, player, player, node_2, A0);
           plain = DeltaX + A0 + A1;
         } else if (player == PARTY_2) {
           send(node_1, A0, size);
-          AUDIT("id:{}, P{} Reveal_, P{} SEND to {}, A0{}", msgid.get_hex(), player, player, node_1, Vector<T2>(A0));
+          AAUDIT("id:{}, P{} Reveal_, P{} SEND to {}, A0{}", msgid, player, player, node_1, A0);
         }
       }
       else if (parties[i] == node_2) {
         if (player == PARTY_2) {
           recv(node_0, DeltaX, size);
-          AUDIT("id:{}, P{} Reveal_, P{} RECV from {} DeltaX{}", msgid.get_hex(), player, player, node_0, Vector<T2>(DeltaX));
+          AAUDIT("id:{}, P{} Reveal_, P{} RECV from {} DeltaX{}", msgid, player, player, node_0, DeltaX);
           plain = DeltaX + A0 + A1;
         } else if (player == PARTY_0) {
           send(node_2, DeltaX, size);
-          AUDIT("id:{}, P{} Reveal_, P{} SEND to {} DeltaX{}", msgid.get_hex(), player, player, node_2, Vector<T2>(A0));
+          AAUDIT("id:{}, P{} Reveal_, P{} SEND to {} DeltaX{}", msgid, player, player, node_2, DeltaX);
         }
       }
       else
       {
         if (parties[i] == current_node) {
           recv(node_0, A0, size);
-          AUDIT("id:{}, P{} Reveal_, P{} RECV from {} A0{}", msgid.get_hex(), player, player, node_0, Vector<T2>(A0));
+          AAUDIT("id:{}, P{} Reveal_, P{} RECV from {} A0{}", msgid, player, player, node_0, A0);
           recv(node_1, DeltaX, size);
-          AUDIT("id:{}, P{} Reveal_, P{} RECV from {} DeltaX{}", msgid.get_hex(), player, player, node_1, Vector<T2>(DeltaX));
+          AAUDIT("id:{}, P{} Reveal_, P{} RECV from {} DeltaX{}", msgid, player, player, node_1, DeltaX);
           recv(node_2, A1, size);
-          AUDIT("id:{}, P{} Reveal_, P{} RECV from {} A1{}", msgid.get_hex(), player, player, node_2, Vector<T2>(A1));
+          AAUDIT("id:{}, P{} Reveal_, P{} RECV from {} A1{}", msgid, player, player, node_2, A1);
           plain = DeltaX + A0 + A1;
         }
         else if (player == PARTY_0) {
           send(parties[i], A0, size);
-          AUDIT("id:{}, P{} Reveal_, P{} SEND to {} A0{}", msgid.get_hex(), player, player, parties[i], Vector<T2>(A0));
+          AAUDIT("id:{}, P{} Reveal_, P{} SEND to {} A0{}", msgid, player, player, parties[i], A0);
         }
         else if (player == PARTY_1) {
           send(parties[i], DeltaX, size);
-          AUDIT("id:{}, P{} Reveal_, P{} SEND to {} DeltaX{}", msgid.get_hex(), player, player, parties[i], Vector<T2>(DeltaX));
+          AAUDIT("id:{}, P{} Reveal_, P{} SEND to {} DeltaX{}", msgid, player, player, parties[i], DeltaX);
         }
         else if (player == PARTY_2) {
           send(parties[i], A1, size);
-          AUDIT("id:{}, P{} Reveal_, P{} SEND to {} A1{}", msgid.get_hex(), player, player, parties[i], Vector<T2>(A1));
+          AAUDIT("id:{}, P{} Reveal_, P{} SEND to {} A1{}", msgid, player, player, parties[i], A1);
         }
       }
     }
 
-    AUDIT("id:{}, P{} Reveal_, output{}", msgid.get_hex(), player, Vector<T2>(plain));
+    AAUDIT("id:{}, P{} Reveal_, output{}", msgid, player, plain);
   }
 
   /**
@@ -363,7 +369,7 @@ class HelixInternal {
     assert(!node_id.empty());
     int p = io->GetPartyId(node_id);
     const string& current_node_id = io->GetCurrentNodeId();
-    AUDIT("id:{}, P{} input from P{}{}", msgid.get_hex(), player, p, Vector<T1>(X));
+    AAUDIT("id:{}, P{} input from P{}{}", msgid, player, p, X);
 
     size_t size = X.size(); // m x n
     resize_vector(shareX, size);
@@ -374,19 +380,19 @@ class HelixInternal {
     vector<T1> deltaX(size, 0);
     if (p == PARTY_0) {
       PRF02(A0, size);
-      AUDIT("id:{}, P{} input from P{}, generate A0{}", msgid.get_hex(), player, p, Vector<T1>(A0));
+      AAUDIT("id:{}, P{} input from P{}, generate A0{}", msgid, player, p, A0);
     } else if (p == PARTY_1) {
       PRF12(A1, size);
-      AUDIT("id:{}, P{} input from P{}, generate A1{}", msgid.get_hex(), player, p, Vector<T1>(A1));
+      AAUDIT("id:{}, P{} input from P{}, generate A1{}", msgid, player, p, A1);
     } else if (p == PARTY_2) {
       PRF02(A0, size);
-      AUDIT("id:{}, P{} input from P{}, generate A0{}", msgid.get_hex(), player, p, Vector<T1>(A0));
+      AAUDIT("id:{}, P{} input from P{}, generate A0{}", msgid, player, p, A0);
     } else {
       PRF_DATA_A0(node_id, A0, size);
-      AUDIT("id:{}, P{} input from P{}, generate A0{}", msgid.get_hex(), node_id, p, Vector<T1>(A0));
+      AAUDIT("id:{}, P{} input from P{}, generate A0{}", msgid, node_id, p, A0);
 
       PRF_DATA_A1(node_id, A1, size);
-      AUDIT("id:{}, P{} input from P{}, generate A1{}", msgid.get_hex(), node_id, p, Vector<T1>(A1));
+      AAUDIT("id:{}, P{} input from P{}, generate A1{}", msgid, node_id, p, A1);
     }
 
     // 2. Pi sets deltaX
@@ -395,7 +401,7 @@ class HelixInternal {
     } else if (p == PARTY_2 && player == PARTY_2) {
       A1 = X - A0;
     }
-    AUDIT("id:{}, P{} input from P{}, locally compute deltaX=X-A0-A1, deltaX{}", msgid.get_hex(), player, p, Vector<T1>(deltaX));
+    AAUDIT("id:{}, P{} input from P{}, locally compute deltaX=X-A0-A1, deltaX{}", msgid, player, p, deltaX);
     //vector<T1> deltaX = X;
     //Sub(deltaX, A0);
     //Sub(deltaX, A1);
@@ -406,31 +412,31 @@ class HelixInternal {
       if (is_primary()) {
         if (player == p) {
           send(adversary(player), deltaX, size);
-          AUDIT("id:{}, P{} input from P{}, P{} SEND to P{}, deltaX{}", msgid.get_hex(), player, p, player, adversary(player), Vector<T1>(deltaX));
+          AAUDIT("id:{}, P{} input from P{}, P{} SEND to P{}, deltaX{}", msgid, player, p, player, adversary(player), deltaX);
         } else {
           recv(adversary(player), deltaX, size);
-          AUDIT("id:{}, P{} input from P{}, P{} RECV from P{}, deltaX{}", msgid.get_hex(), player, p, player, adversary(player), Vector<T1>(deltaX));
+          AAUDIT("id:{}, P{} input from P{}, P{} RECV from P{}, deltaX{}", msgid, player, p, player, adversary(player), deltaX);
         }
       }
     } else if (p == PARTY_2) {
       // P2 sends A1 to P1
       if (is_helper()) {
         send(PARTY_1, A1, size);
-        AUDIT("id:{}, P{} input from P{}, P{} SEND to P{}, A1{}", msgid.get_hex(), player, p, player, PARTY_1, Vector<T1>(A1));
+        AAUDIT("id:{}, P{} input from P{}, P{} SEND to P{}, A1{}", msgid, player, p, player, PARTY_1, A1);
       } else if (player == PARTY_1) {
         recv(PARTY_2, A1, size);
-        AUDIT("id:{}, P{} input from P{}, P{} RECV from P{}, A1{}", msgid.get_hex(), player, p, player, PARTY_2, Vector<T1>(A1));
+        AAUDIT("id:{}, P{} input from P{}, P{} RECV from P{}, A1{}", msgid, player, p, player, PARTY_2, A1);
       }
     } else {
       if (node_id == current_node_id) {
         send(PARTY_0, deltaX, size);
-        AUDIT("id:{}, P{} input from P{}, P{} SEND to P{}, deltaX{}", msgid.get_hex(), player, p, player, PARTY_0, Vector<T1>(deltaX));
+        AAUDIT("id:{}, P{} input from P{}, P{} SEND to P{}, deltaX{}", msgid, player, p, player, PARTY_0, deltaX);
 
         send(PARTY_1, deltaX, size);
-        AUDIT("id:{}, P{} input from P{}, P{} SEND to P{}, deltaX{}", msgid.get_hex(), player, p, player, PARTY_1, Vector<T1>(deltaX));
+        AAUDIT("id:{}, P{} input from P{}, P{} SEND to P{}, deltaX{}", msgid, player, p, player, PARTY_1, deltaX);
       } else if (is_primary()) {
         recv(node_id, deltaX, size);
-        AUDIT("id:{}, P{} input from P{}, P{} RECV from {}, deltaX{}", msgid.get_hex(), player, p, player, node_id, Vector<T1>(deltaX));
+        AAUDIT("id:{}, P{} input from P{}, P{} RECV from {}, deltaX{}", msgid, player, p, player, node_id, deltaX);
       }
     }
 
@@ -448,7 +454,7 @@ class HelixInternal {
       }
     }
 
-    AUDIT("id:{}, P{} input from P{}, output shareX{}", msgid.get_hex(), player, p, Vector<T2>(shareX));
+    AAUDIT("id:{}, P{} input from P{}, output shareX{}", msgid, player, p, shareX);
   }
 
   /**
@@ -959,6 +965,9 @@ class HelixInternal {
 	 * [in] X, the variable;
 	 * [in] k, power value.
 	 * [out] Y, the resulting value.
+	 * @note: the vector<int> version takes one exponent per element and runs
+	 * bit_length(max |k|) rounds of one batched Mul, see vectorized_pow.
+	 * A negative k is computed as 1 / X^(-k) with one batched Reciprocaldiv.
    */
   void PowV2(const Share& X, const int& k, Share& Y);
   void PowV2(const vector<Share>& X, const int& common_k, vector<Share>& Y);
@@ -971,6 +980,119 @@ class HelixInternal {
   void SigmoidChebyshev(const vector<Share>& X, vector<Share>& Y);
   void Sigmoid(const vector<Share>& X, vector<Share>& Y);
 
+  /**
+   * @brief: piecewise polynomial registered as func_name, in one batched GreaterEqual for all the
+   * break points, ceil(log2(degree)) rounds for the powers of X and one batched Mul.
+   * @see PolyConfFactory::get_func_telescoping
+   */
+  void PiecewisePolynomial(const vector<Share>& X, const string& func_name, vector<Share>& Y);
+
+  /**
+   * @brief: activations and their derivatives, the tables and error bounds are in mpc_common.cpp
+   */
+  void Tanh(const vector<Share>& X, vector<Share>& Y) { PiecewisePolynomial(X, "TANH", Y); }
+  void TanhGrad(const vector<Share>& X, vector<Share>& Y) { PiecewisePolynomial(X, "TANH_GRAD", Y); }
+  void Gelu(const vector<Share>& X, vector<Share>& Y) { PiecewisePolynomial(X, "GELU", Y); }
+  void GeluGrad(const vector<Share>& X, vector<Share>& Y) { PiecewisePolynomial(X, "GELU_GRAD", Y); }
+  void Swish(const vector<Share>& X, vector<Share>& Y) { PiecewisePolynomial(X, "SWISH", Y); }
+  void SwishGrad(const vector<Share>& X, vector<Share>& Y) { PiecewisePolynomial(X, "SWISH_GRAD", Y); }
+  void Softplus(const vector<Share>& X, vector<Share>& Y) { PiecewisePolynomial(X, "SOFTPLUS", Y); }
+  void SoftplusGrad(const vector<Share>& X, vector<Share>& Y) { PiecewisePolynomial(X, "SOFTPLUS_GRAD", Y); }
+
+  /**
+   * @brief: layer normalization over the rows of a rows x cols matrix,
+   * Y = gamma * (X - mean) / sqrt(var + epsilon) + beta.
+   * (X - mean)^2 and gamma * (X - mean) share one Mul, the rows go through a single batched
+   * Rsqrt, and one more Mul with the broadcast 1/sqrt(var + epsilon) gives Y.
+   * inv_std is kept for LayerNormGrad.
+   */
+  void LayerNorm(
+    const vector<Share>& X,
+    const vector<Share>& gamma,
+    const vector<Share>& beta,
+    vector<Share>& Y,
+    vector<Share>& inv_std,
+    int rows,
+    int cols,
+    double epsilon);
+
+  /**
+   * @brief: backward of LayerNorm in three Mul rounds, with x_hat = (X - mean) * inv_std,
+   * dX = inv_std * (dY * gamma - mean(dY * gamma) - x_hat * mean(dY * gamma * x_hat)),
+   * dgamma = column sums of dY * x_hat, dbeta = column sums of dY.
+   */
+  void LayerNormGrad(
+    const vector<Share>& X,
+    const vector<Share>& gamma,
+    const vector<Share>& inv_std,
+    const vector<Share>& dY,
+    vector<Share>& dX,
+    vector<Share>& dgamma,
+    vector<Share>& dbeta,
+    int rows,
+    int cols);
+
+  /**
+   * @brief: jointly sampled randomness for differential privacy, no party learns the values.
+   * RandomBits gives fair coins, each the XOR of a private coin of P0 and one of P1 (PRF0/PRF1,
+   * then Input), b0 + b1 - 2 * b0 * b1 on unscaled shares, so all the coins of a call cost one Mul.
+   * RandomUniform gives values on the grid (k + 1/2) / 2^bits in (0, 1).
+   * RandomLaplace is the discrete Laplace of scale on the LSB grid, and RandomBinomial
+   * 2^grid_bits * (K - coins / 2) LSB with K ~ Bin(coins, 1/2), see mpc_dp.h for the parameters
+   * and the privacy guarantee. Both sample at most kDPCoinsPerRound coins a round.
+   */
+  void RandomBits(size_t size, vector<Share>& C);
+  void RandomUniform(size_t size, size_t bits, vector<Share>& U);
+  void RandomLaplace(size_t size, double scale, vector<Share>& L);
+  void RandomBinomial(size_t size, size_t coins, int grid_bits, vector<Share>& Z);
+
+  /**
+   * @brief: Y = X + noise, mechanism is "laplace" (discrete Laplace of that scale) or "gaussian"
+   * (binomial mechanism of standard deviation scale, X is rounded to its grid first)
+   */
+  void DPNoise(const vector<Share>& X, const string& mechanism, double scale, vector<Share>& Y);
+
+  /**
+   * @brief: per-example clipping, each row g becomes g * min(1, clip_norm / ||g||).
+   * With t = ||g / clip_norm||^2, g scaled before squaring, the factor is 1 + (t >= 1) * (Rsqrt(t) - 1).
+   */
+  void ClipByL2Norm(const vector<Share>& X, vector<Share>& Y, int rows, int cols, double clip_norm);
+
+  /**
+   * @brief: inverted-dropout masks, each element is kept with probability 1 - rate rounded to the
+   * grid of its uniform, and then scaled by the inverse of that probability (see dropout_keep_cells).
+   * DropoutCommonMask draws a plaintext mask from PRF, common to all parties, without communication.
+   * DropoutSharedMask keeps it secret as (keep - U >= 0) on a RandomUniform U of 8 bits, so it
+   * costs 8 RandomBits and one GreaterEqual per element.
+   */
+  void DropoutCommonMask(size_t size, double rate, vector<double>& mask);
+  void DropoutSharedMask(size_t size, double rate, vector<Share>& mask);
+
+  /**
+   * @brief: the k largest values of each row of a rows x cols matrix, descending, by the
+   * batched bitonic selection of bitonic_topk (one DReLU and one exact Mul a layer).
+   * indices gets rows x k one-hot rows of cols, 1.0 at the position of each value, by OneHot.
+   */
+  void TopK(
+    const vector<Share>& X,
+    int rows,
+    int cols,
+    int k,
+    vector<Share>& values,
+    vector<Share>& indices);
+
+  /**
+   * @brief: one-hot rows of depth for the secret integers of X, by one batched GreaterEqual
+   * of ge_j = (X >= j - 0.5), j = 0..depth, and [X == j] = ge_j - ge_(j+1).
+   * Values outside [0, depth) give all-zero rows.
+   */
+  void OneHot(const vector<Share>& X, int depth, vector<Share>& Y);
+
+  /**
+   * @brief: the index of each one-hot row of depth, sum_j j * X_j, local.
+   */
+  void OneHotToIndex(const vector<Share>& X, int depth, vector<Share>& Y);
+
   /**
 	 * @brief: secret-shared version for computing a univariate polynomial:
 	 * Y = C0 * X^P0 + C1 * X^P1 + ... + Cn * X^Pn
@@ -19,6 +19,7 @@
 #include "cc/modules/protocol/mpc/helix/include/helix_ops_impl.h"
 #include "cc/modules/protocol/utility/include/prg.h"
 #include "cc/modules/common/include/utils/rtt_logger.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_secure_debug.h"
 
 #include <string>
 #include <unordered_map>
@@ -43,4 +44,29 @@ static inline int get_attr_value(const attr_type* attr, string tag, int default_
 
 } // namespace
 
+#if ROSETTA_ENABLES_SECURE_DEBUG
+//! secure-debug only: reveals the shares to P0 and checks them against the safe fixed-point range
+static inline void helix_secure_debug_(
+  shared_ptr<HelixInternal> hi,
+  shared_ptr<ProtocolContext> context,
+  const vector<Share>& X,
+  const char* op,
+  const msg_id_t& msgid) {
+  if (!context->SECURE_DEBUG || !hi)
+    return;
+  vector<mpc_t> plain;
+  hi->Reveal(X, plain, vector<string>{context->GetNodeId(PARTY_0)});
+  if (context->GetMyRole() == PARTY_0)
+    context->SECURE_DEBUG->Check(op, msgid, plain, context->GetFixPointPrecision());
+}
+
+// every op output goes through here, as snn_encode in SecureNN
+#undef helix_convert_share_to_string
+#define helix_convert_share_to_string(a, b)                           \
+  do {                                                                \
+    helix_secure_debug_(hi, context_, a, __FUNCTION__, msg_id());     \
+    rosetta::helix::convert_share_to_string(a, b, false);             \
+  } while (0)
+#endif
+
 } // namespace rosetta
@@ -16,6 +16,10 @@
 // along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
 // ==============================================================================
 #include "helix_impl_util.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_mask_store.h"
+#include "cc/modules/common/include/utils/msg_id_mgr.h"
+
+#include <cmath>
 
 namespace rosetta {
 
@@ -59,6 +63,266 @@ int HelixOpsImpl::Sigmoid(const vector<string>& a, vector<string>& c, const attr
   return 0;
 }
 
+#define HELIX_PROTOCOL_ACTIVATION_OP(op)                                                        \
+  int HelixOpsImpl::op(const vector<string>& a, vector<string>& c, const attr_type* attr_info) { \
+    vector<Share> shareA, shareC;                                                               \
+    helix_convert_string_to_share(a, shareA);                                                   \
+    AUDIT("id:{}, " #op " input X(Share){}", _op_msg_id.get_hex(), Vector<Share>(shareA));      \
+    hi->op(shareA, shareC);                                                                     \
+    helix_convert_share_to_string(shareC, c);                                                   \
+    AUDIT("id:{}, " #op " output(Share){}", _op_msg_id.get_hex(), Vector<Share>(shareC));       \
+    return 0;                                                                                   \
+  }
+
+HELIX_PROTOCOL_ACTIVATION_OP(Tanh)
+HELIX_PROTOCOL_ACTIVATION_OP(TanhGrad)
+HELIX_PROTOCOL_ACTIVATION_OP(Gelu)
+HELIX_PROTOCOL_ACTIVATION_OP(GeluGrad)
+HELIX_PROTOCOL_ACTIVATION_OP(Swish)
+HELIX_PROTOCOL_ACTIVATION_OP(SwishGrad)
+HELIX_PROTOCOL_ACTIVATION_OP(Softplus)
+HELIX_PROTOCOL_ACTIVATION_OP(SoftplusGrad)
+
+int HelixOpsImpl::LayerNorm(
+  const vector<string>& x,
+  const vector<string>& gamma,
+  const vector<string>& beta,
+  vector<string>& y,
+  vector<string>& inv_std,
+  const attr_type* attr_info) {
+  int rows = get_attr_value(attr_info, "rows", 1);
+  int cols = get_attr_value(attr_info, "cols", x.size() / rows);
+  double epsilon = std::stod(get_attr_value(attr_info, "epsilon", string("1e-5")));
+  vector<Share> shareX, shareGamma, shareBeta, shareY, shareInvStd;
+  helix_convert_string_to_share(x, shareX);
+  helix_convert_string_to_share(gamma, shareGamma);
+  helix_convert_string_to_share(beta, shareBeta);
+  AUDIT("id:{}, LayerNorm({},{}) input X(Share){}", _op_msg_id.get_hex(), rows, cols, Vector<Share>(shareX));
+
+  hi->LayerNorm(shareX, shareGamma, shareBeta, shareY, shareInvStd, rows, cols, epsilon);
+  helix_convert_share_to_string(shareY, y);
+  helix_convert_share_to_string(shareInvStd, inv_std);
+  AUDIT("id:{}, LayerNorm({},{}) output(Share){}", _op_msg_id.get_hex(), rows, cols, Vector<Share>(shareY));
+
+  return 0;
+}
+
+int HelixOpsImpl::LayerNormGrad(
+  const vector<string>& x,
+  const vector<string>& gamma,
+  const vector<string>& inv_std,
+  const vector<string>& dy,
+  vector<string>& dx,
+  vector<string>& dgamma,
+  vector<string>& dbeta,
+  const attr_type* attr_info) {
+  int rows = get_attr_value(attr_info, "rows", 1);
+  int cols = get_attr_value(attr_info, "cols", x.size() / rows);
+  vector<Share> shareX, shareGamma, shareInvStd, shareDy, shareDx, shareDgamma, shareDbeta;
+  helix_convert_string_to_share(x, shareX);
+  helix_convert_string_to_share(gamma, shareGamma);
+  helix_convert_string_to_share(inv_std, shareInvStd);
+  helix_convert_string_to_share(dy, shareDy);
+  AUDIT("id:{}, LayerNormGrad({},{}) input dY(Share){}", _op_msg_id.get_hex(), rows, cols, Vector<Share>(shareDy));
+
+  hi->LayerNormGrad(
+    shareX, shareGamma, shareInvStd, shareDy, shareDx, shareDgamma, shareDbeta, rows, cols);
+  helix_convert_share_to_string(shareDx, dx);
+  helix_convert_share_to_string(shareDgamma, dgamma);
+  helix_convert_share_to_string(shareDbeta, dbeta);
+  AUDIT("id:{}, LayerNormGrad({},{}) output dX(Share){}", _op_msg_id.get_hex(), rows, cols, Vector<Share>(shareDx));
+
+  return 0;
+}
+
+int HelixOpsImpl::DPNoise(
+  const vector<string>& a,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  string mechanism = get_attr_value(attr_info, "mechanism", string("gaussian"));
+  string scale = get_attr_value(attr_info, "scale", string(""));
+  if (mechanism != "gaussian" && mechanism != "laplace") {
+    tlog_error << "DPNoise not supported mechanism: " << mechanism;
+    return -1;
+  }
+  if (scale.empty()) {
+    tlog_error << "DPNoise need attr scale";
+    return -1;
+  }
+  double scale_d = std::stod(scale);
+  if (!(scale_d > 0 && std::isfinite(scale_d))) {
+    tlog_error << "DPNoise scale should be positive, got " << scale;
+    return -1;
+  }
+
+  vector<Share> shareA, shareC;
+  helix_convert_string_to_share(a, shareA);
+  AUDIT("id:{}, DPNoise {}({}) input X(Share){}", _op_msg_id.get_hex(), mechanism, scale, Vector<Share>(shareA));
+
+  hi->DPNoise(shareA, mechanism, scale_d, shareC);
+  helix_convert_share_to_string(shareC, output);
+  AUDIT("id:{}, DPNoise {}({}) output Y(Share){}", _op_msg_id.get_hex(), mechanism, scale, Vector<Share>(shareC));
+
+  return 0;
+}
+
+int HelixOpsImpl::ClipByL2Norm(
+  const vector<string>& a,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  int rows = get_attr_value(attr_info, "rows", 1);
+  int cols = get_attr_value(attr_info, "cols", a.size() / rows);
+  string clip_norm = get_attr_value(attr_info, "clip_norm", string(""));
+  if (clip_norm.empty()) {
+    tlog_error << "ClipByL2Norm need attr clip_norm";
+    return -1;
+  }
+  double clip_norm_d = std::stod(clip_norm);
+  if (!(clip_norm_d > 0 && std::isfinite(clip_norm_d))) {
+    tlog_error << "ClipByL2Norm clip_norm should be positive, got " << clip_norm;
+    return -1;
+  }
+
+  vector<Share> shareA, shareC;
+  helix_convert_string_to_share(a, shareA);
+  AUDIT("id:{}, ClipByL2Norm({},{}) {} input X(Share){}", _op_msg_id.get_hex(), rows, cols, clip_norm, Vector<Share>(shareA));
+
+  hi->ClipByL2Norm(shareA, shareC, rows, cols, clip_norm_d);
+  helix_convert_share_to_string(shareC, output);
+  AUDIT("id:{}, ClipByL2Norm({},{}) {} output Y(Share){}", _op_msg_id.get_hex(), rows, cols, clip_norm, Vector<Share>(shareC));
+
+  return 0;
+}
+
+int HelixOpsImpl::Dropout(
+  const vector<string>& a,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  string rate = get_attr_value(attr_info, "rate", string(""));
+  if (rate.empty()) {
+    tlog_error << "Dropout need attr rate";
+    return -1;
+  }
+  bool common_mask = get_attr_value(attr_info, "common_mask", 0) == 1;
+
+  vector<Share> shareA, shareC;
+  helix_convert_string_to_share(a, shareA);
+  AUDIT("id:{}, Dropout({}) input X(Share){}", _op_msg_id.get_hex(), rate, Vector<Share>(shareA));
+
+  MpcMask mask;
+  mask.is_common = common_mask;
+  if (common_mask) {
+    // known mask, the product is local
+    hi->DropoutCommonMask(shareA.size(), std::stod(rate), mask.common);
+    hi->Mul(shareA, mask.common, shareC);
+  } else {
+    vector<Share> shareMask;
+    hi->DropoutSharedMask(shareA.size(), std::stod(rate), shareMask);
+    hi->Mul(shareA, shareMask, shareC);
+    helix_convert_share_to_string(shareMask, mask.share);
+  }
+  context_->MASK_STORE->Put(_op_msg_id, mask);
+  helix_convert_share_to_string(shareC, output);
+  AUDIT("id:{}, Dropout({}) output Y(Share){}", _op_msg_id.get_hex(), rate, Vector<Share>(shareC));
+
+  return 0;
+}
+
+int HelixOpsImpl::DropoutGrad(
+  const vector<string>& dy,
+  vector<string>& dx,
+  const attr_type* attr_info) {
+  string forward_op = get_attr_value(attr_info, "forward_msgid", string(""));
+  msg_id_t forward_msgid;
+  if (!forward_op.empty())
+    MsgIdMgr::Instance()->ResolveMsgId(forward_op, context_->TASK_ID, forward_msgid);
+  MpcMask mask;
+  if (forward_op.empty() || !context_->MASK_STORE->Get(forward_msgid, mask)) {
+    tlog_error << "DropoutGrad no mask of Dropout " << forward_op;
+    return -1;
+  }
+
+  vector<Share> shareDy, shareDx;
+  helix_convert_string_to_share(dy, shareDy);
+  AUDIT("id:{}, DropoutGrad input dY(Share){}", _op_msg_id.get_hex(), Vector<Share>(shareDy));
+
+  if (mask.is_common) {
+    hi->Mul(shareDy, mask.common, shareDx);
+  } else {
+    vector<Share> shareMask;
+    helix_convert_string_to_share(mask.share, shareMask);
+    hi->Mul(shareDy, shareMask, shareDx);
+  }
+  helix_convert_share_to_string(shareDx, dx);
+  AUDIT("id:{}, DropoutGrad output dX(Share){}", _op_msg_id.get_hex(), Vector<Share>(shareDx));
+
+  return 0;
+}
+
+int HelixOpsImpl::TopK(
+  const vector<string>& a,
+  vector<string>& values,
+  vector<string>& indices,
+  const attr_type* attr_info) {
+  int rows = get_attr_value(attr_info, "rows", 1);
+  int cols = get_attr_value(attr_info, "cols", a.size() / rows);
+  int k = get_attr_value(attr_info, "k", 0);
+  if (k <= 0 || k > cols) {
+    tlog_error << "TopK k should be in [1, " << cols << "], got " << k;
+    return -1;
+  }
+
+  vector<Share> shareA, shareValues, shareIndices;
+  helix_convert_string_to_share(a, shareA);
+  AUDIT("id:{}, TopK({},{}) k={} input X(Share){}", _op_msg_id.get_hex(), rows, cols, k, Vector<Share>(shareA));
+
+  hi->TopK(shareA, rows, cols, k, shareValues, shareIndices);
+  helix_convert_share_to_string(shareValues, values);
+  helix_convert_share_to_string(shareIndices, indices);
+  AUDIT("id:{}, TopK({},{}) k={} output values(Share){}", _op_msg_id.get_hex(), rows, cols, k, Vector<Share>(shareValues));
+
+  return 0;
+}
+
+int HelixOpsImpl::OneHot(const vector<string>& a, vector<string>& b, const attr_type* attr_info) {
+  int depth = get_attr_value(attr_info, "depth", 0);
+  if (depth <= 0) {
+    tlog_error << "OneHot depth should be positive, got " << depth;
+    return -1;
+  }
+
+  vector<Share> shareA, shareB;
+  helix_convert_string_to_share(a, shareA);
+  AUDIT("id:{}, OneHot({}) input X(Share){}", _op_msg_id.get_hex(), depth, Vector<Share>(shareA));
+
+  hi->OneHot(shareA, depth, shareB);
+  helix_convert_share_to_string(shareB, b);
+  AUDIT("id:{}, OneHot({}) output(Share){}", _op_msg_id.get_hex(), depth, Vector<Share>(shareB));
+
+  return 0;
+}
+
+int HelixOpsImpl::OneHotToIndex(
+  const vector<string>& a,
+  vector<string>& b,
+  const attr_type* attr_info) {
+  int depth = get_attr_value(attr_info, "depth", 0);
+  if (depth <= 0 || a.size() % depth != 0) {
+    tlog_error << "OneHotToIndex input size " << a.size() << " is not a multiple of depth " << depth;
+    return -1;
+  }
+
+  vector<Share> shareA, shareB;
+  helix_convert_string_to_share(a, shareA);
+  AUDIT("id:{}, OneHotToIndex({}) input X(Share){}", _op_msg_id.get_hex(), depth, Vector<Share>(shareA));
+
+  hi->OneHotToIndex(shareA, depth, shareB);
+  helix_convert_share_to_string(shareB, b);
+  AUDIT("id:{}, OneHotToIndex({}) output(Share){}", _op_msg_id.get_hex(), depth, Vector<Share>(shareB));
+
+  return 0;
+}
+
 int HelixOpsImpl::SigmoidCrossEntropy(
   const vector<string>& a,
   const vector<string>& b,
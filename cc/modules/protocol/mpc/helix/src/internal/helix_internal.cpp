@@ -248,38 +248,38 @@ void HelixInternal::Trunc(vector<BitShare>& X, size_t size, size_t d) {}
  * Reveal, arithmetic
  */
 void HelixInternal::Reveal(const vector<Share>& X, vector<mpc_t>& plain, const string& nodes) {
-  AUDIT("id:{}, P{} Reveal, input(Share){}",       msgid.get_hex(), player, Vector<Share>(X));
+  AAUDIT("id:{}, P{} Reveal, input(Share){}", msgid, player, X);
   Reveal_(X, plain, nodes);
-  AUDIT("id:{}, P{} Reveal, output(mpc_t, plain){}", msgid.get_hex(), player, Vector<mpc_t>(plain));
+  AAUDIT("id:{}, P{} Reveal, output(mpc_t, plain){}", msgid, player, plain);
 }
 void HelixInternal::Reveal(const vector<Share>& X, vector<double>& plain, const string& nodes) {
-  AUDIT("id:{}, P{} Reveal, input(Share){}",                 msgid.get_hex(), player, Vector<Share>(X));
+  AAUDIT("id:{}, P{} Reveal, input(Share){}", msgid, player, X);
   vector<mpc_t> mpc_plain;
   Reveal_(X, mpc_plain, nodes);
   convert_fixpoint_to_plain(mpc_plain, plain, GetMpcContext()->FLOAT_PRECISION);
-  AUDIT("id:{}, P{} Reveal, output(double, plain){}", msgid.get_hex(), player, Vector<double>(plain));
+  AAUDIT("id:{}, P{} Reveal, output(double, plain){}", msgid, player, plain);
 }
 void HelixInternal::Reveal(const vector<Share>& X, vector<mpc_t>& plain, const vector<string>& nodes) {
-  AUDIT("id:{}, P{} Reveal, input(Share){}",                 msgid.get_hex(), player, Vector<Share>(X));
+  AAUDIT("id:{}, P{} Reveal, input(Share){}", msgid, player, X);
   Reveal_(X, plain, nodes);
-  AUDIT("id:{}, P{} Reveal, output(mpc_t, plain){}", msgid.get_hex(), player, Vector<mpc_t>(plain));
+  AAUDIT("id:{}, P{} Reveal, output(mpc_t, plain){}", msgid, player, plain);
 }
 
 void HelixInternal::Reveal(const vector<Share>& X, vector<double>& plain, const vector<string>& nodes) {
-  AUDIT("id:{}, P{} Reveal, input(Share){}",                 msgid.get_hex(), player, Vector<Share>(X));
+  AAUDIT("id:{}, P{} Reveal, input(Share){}", msgid, player, X);
   vector<mpc_t> mpc_plain;
   Reveal_(X, mpc_plain, nodes);
   convert_fixpoint_to_plain(mpc_plain, plain, GetMpcContext()->FLOAT_PRECISION);
-  AUDIT("id:{}, P{} Reveal, output(double, plain){}", msgid.get_hex(), player, Vector<double>(plain));
+  AAUDIT("id:{}, P{} Reveal, output(double, plain){}", msgid, player, plain);
 }
 
 /**
  * Reveal, binary
  */
 void HelixInternal::Reveal(const vector<BitShare>& X, vector<bit_t>& plain, const string& nodes) {
-  AUDIT("id:{}, P{} Reveal, input(BitShare){}",         msgid.get_hex(), player, Vector<BitShare>(X));
+  AAUDIT("id:{}, P{} Reveal, input(BitShare){}", msgid, player, X);
   Reveal_(X, plain, nodes);
-  AUDIT("id:{}, P{} Reveal, output(bit_t){}", msgid.get_hex(), player, Vector<bit_t>(plain));
+  AAUDIT("id:{}, P{} Reveal, output(bit_t){}", msgid, player, plain);
 }
 
 void HelixInternal::SyncCiphertext(const vector<Share>& in_vec, vector<Share>& out_vec, const map<string, vector<string>>& ciphertext_nodes) {
@@ -346,7 +346,7 @@ void HelixInternal::Input(const string& node_id, const vector<double>& X, vector
  * P2: (0, 0) 
  */
 void HelixInternal::ConstCommonInput(const vector<mpc_t>& X, vector<Share>& shareX) {
-  AUDIT("id:{}, P{} ConstCommonInput input X(mpc_t){}", msgid.get_hex(), player, Vector<mpc_t>(X));
+  AAUDIT("id:{}, P{} ConstCommonInput input X(mpc_t){}", msgid, player, X);
   int ele_size = X.size();
   shareX.resize(ele_size);
   // each party sets his share
@@ -363,17 +363,17 @@ void HelixInternal::ConstCommonInput(const vector<mpc_t>& X, vector<Share>& shar
     }
   }
 
-  AUDIT("id:{}, P{} ConstCommonInput output shareX(Share){}", msgid.get_hex(), player, Vector<Share>(shareX));
+  AAUDIT("id:{}, P{} ConstCommonInput output shareX(Share){}", msgid, player, shareX);
 }
 
 void HelixInternal::ConstCommonInput(const vector<double>& X, vector<Share>& shareX) {
-  AUDIT("id:{}, P{} ConstCommonInput input X(double){}", msgid.get_hex(), player, Vector<double>(X));
+  AAUDIT("id:{}, P{} ConstCommonInput input X(double){}", msgid, player, X);
   vector<mpc_t> mpcX;
   // print_vec(X, 10, "debug calling ConstCommonInput");
   convert_plain_to_fixpoint(X, mpcX, GetMpcContext()->FLOAT_PRECISION);
   ConstCommonInput(mpcX, shareX);
 
-  AUDIT("id:{}, P{} ConstCommonInput output shareX(Share){}", msgid.get_hex(), player, Vector<Share>(shareX));
+  AAUDIT("id:{}, P{} ConstCommonInput output shareX(Share){}", msgid, player, shareX);
 }
 
 /**
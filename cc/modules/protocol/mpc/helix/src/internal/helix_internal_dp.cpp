@@ -0,0 +1,245 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include "cc/modules/protocol/mpc/helix/include/helix_internal.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_common.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_dp.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_mask_store.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <string>
+
+using namespace std;
+using namespace rosetta;
+
+namespace rosetta {
+namespace helix {
+
+// bits of the uniform compared to 1 - rate by DropoutSharedMask
+static const size_t kDropoutUniformBits = 8;
+
+void HelixInternal::RandomBits(size_t size, vector<Share>& C) {
+  // private coins of P0 and P1, as unscaled 0/1 ring elements
+  vector<bit_t> bits0, bits1;
+  PRF0(bits0, size);
+  PRF1(bits1, size);
+  vector<mpc_t> coins0(size, 0), coins1(size, 0);
+  for (size_t i = 0; i < size; i++) {
+    coins0[i] = bits0[i];
+    coins1[i] = bits1[i];
+  }
+
+  vector<Share> S0, S1, S01;
+  Input(io->GetNodeId(PARTY_0), coins0, S0);
+  Input(io->GetNodeId(PARTY_1), coins1, S1);
+  Mul(S0, S1, S01, false);
+
+  // c0 ^ c1 = c0 + c1 - 2 * c0 * c1
+  Add(S0, S1, C);
+  Sub(C, S01);
+  Sub(C, S01);
+}
+
+void HelixInternal::RandomUniform(size_t size, size_t bits, vector<Share>& U) {
+  const int float_precision = GetMpcContext()->FLOAT_PRECISION;
+  assert(bits > 0 && bits < float_precision);
+  size_t n = size * bits;
+  vector<Share> C;
+  RandomBits(n, C);
+
+  // u = sum_j c_j / 2^(j+1) + 1/2^(bits+1), exact on the ring
+  vector<mpc_t> weights(n);
+  for (size_t i = 0; i < size; i++)
+    for (size_t j = 0; j < bits; j++)
+      weights[i * bits + j] = static_cast<mpc_t>(1) << (float_precision - 1 - j);
+  vector<Share> W;
+  Mul(C, weights, W, false);
+
+  U.clear();
+  U.resize(size);
+  for (size_t i = 0; i < size; i++)
+    for (size_t j = 0; j < bits; j++)
+      Add(U[i], W[i * bits + j]);
+  Add(U, vector<mpc_t>(size, static_cast<mpc_t>(1) << (float_precision - bits - 1)));
+}
+
+void HelixInternal::RandomLaplace(size_t size, double scale, vector<Share>& L) {
+  const int uniform_bits = dp_uniform_bits(GetMpcContext()->FLOAT_PRECISION);
+  vector<uint64_t> thresholds;
+  dp_laplace_thresholds(scale, GetMpcContext()->FLOAT_PRECISION, uniform_bits, thresholds);
+  const size_t B = thresholds.size();
+  const size_t chunk = std::max<size_t>(1, kDPCoinsPerRound / (2 * B * uniform_bits));
+
+  L.clear();
+  L.resize(size);
+  for (size_t begin = 0; begin < size; begin += chunk) {
+    size_t n = std::min(chunk, size - begin);
+    // bit j of G1 (rows < n) and G2 (rows >= n), one uniform each
+    size_t m = 2 * n * B;
+    vector<Share> C;
+    RandomBits(m * uniform_bits, C);
+
+    // unscaled U = sum_k c_k * 2^k, bit = (T_j - 1 - U >= 0)
+    vector<mpc_t> weights(m * uniform_bits);
+    for (size_t k = 0; k < weights.size(); k++)
+      weights[k] = static_cast<mpc_t>(1) << (k % uniform_bits);
+    vector<Share> W, U(m);
+    Mul(C, weights, W, false);
+    for (size_t r = 0; r < m; r++)
+      for (int k = 0; k < uniform_bits; k++)
+        Add(U[r], W[r * uniform_bits + k]);
+    vector<mpc_t> bound(m);
+    for (size_t r = 0; r < m; r++)
+      bound[r] = static_cast<mpc_t>(thresholds[r % B]) - 1;
+    vector<Share> diff, bits;
+    Sub(bound, U, diff);
+    GreaterEqual(diff, vector<double>(m, 0.0), bits);
+
+    // L = G1 - G2 LSB, on the unscaled bits
+    vector<mpc_t> place(m);
+    for (size_t r = 0; r < m; r++)
+      place[r] = static_cast<mpc_t>(1) << (r % B);
+    vector<Share> P;
+    Mul(bits, place, P, false);
+    for (size_t i = 0; i < n; i++) {
+      for (size_t j = 0; j < B; j++) {
+        Add(L[begin + i], P[i * B + j]);
+        Sub(L[begin + i], P[(n + i) * B + j]);
+      }
+    }
+  }
+}
+
+void HelixInternal::RandomBinomial(size_t size, size_t coins, int grid_bits, vector<Share>& Z) {
+  const size_t chunk = std::max<size_t>(1, kDPCoinsPerRound / coins);
+
+  Z.clear();
+  Z.resize(size);
+  for (size_t begin = 0; begin < size; begin += chunk) {
+    size_t n = std::min(chunk, size - begin);
+    vector<Share> C;
+    RandomBits(n * coins, C);
+    for (size_t i = 0; i < n; i++)
+      for (size_t k = 0; k < coins; k++)
+        Add(Z[begin + i], C[i * coins + k]);
+  }
+
+  // Z = 2^grid_bits * (K - N / 2) LSB
+  Sub(Z, vector<mpc_t>(size, static_cast<mpc_t>(coins / 2)));
+  Scale(Z, grid_bits);
+}
+
+void HelixInternal::DPNoise(
+  const vector<Share>& X,
+  const string& mechanism,
+  double scale,
+  vector<Share>& Y) {
+  AUDIT("id:{}, P{} DPNoise {}({}) input X(Share){}", msgid.get_hex(), player, mechanism, scale, Vector<Share>(X));
+  size_t size = X.size();
+  vector<Share> base(X), noise;
+  if (mechanism == "laplace") {
+    RandomLaplace(size, scale, noise);
+  } else {
+    assert(mechanism == "gaussian");
+    int grid_bits = 0;
+    size_t coins = 0;
+    dp_binomial_params(scale, GetMpcContext()->FLOAT_PRECISION, grid_bits, coins);
+    RandomBinomial(size, coins, grid_bits, noise);
+    // the binomial mechanism releases values of the 2^grid_bits grid
+    if (grid_bits > 0) {
+      Trunc(base, size, grid_bits);
+      Scale(base, grid_bits);
+    }
+  }
+
+  Add(base, noise, Y);
+  AUDIT("id:{}, P{} DPNoise {}({}) output Y(Share){}", msgid.get_hex(), player, mechanism, scale, Vector<Share>(Y));
+}
+
+void HelixInternal::ClipByL2Norm(
+  const vector<Share>& X,
+  vector<Share>& Y,
+  int rows,
+  int cols,
+  double clip_norm) {
+  AUDIT("id:{}, P{} ClipByL2Norm({},{}) {} input X(Share){}", msgid.get_hex(), player, rows, cols, clip_norm, Vector<Share>(X));
+  size_t size = rows * cols;
+  assert(X.size() == size && clip_norm > 0);
+
+  // t = ||g / clip_norm||^2, scaled before squaring so that 1 / clip_norm^2 never underflows
+  int shift = 0;
+  double ratio = 1.0;
+  dp_clip_norm_split(clip_norm, shift, ratio);
+  vector<Share> reduced(X), scaled, squares, t;
+  if (shift > 0)
+    Trunc(reduced, size, shift);
+  Mul(reduced, vector<double>(size, ratio), scaled);
+  Mul(scaled, scaled, squares);
+  Sum(squares, t, rows, cols);
+
+  // factor = 1 + (t >= 1) * (clip_norm / ||g|| - 1), the comparison is unscaled
+  vector<Share> over, inv_norm, factor;
+  GreaterEqual(t, vector<double>(rows, 1.0), over);
+  Rsqrt(t, inv_norm);
+  Sub(inv_norm, vector<double>(rows, 1.0));
+  Mul(over, inv_norm, factor, false);
+  Add(factor, vector<double>(rows, 1.0));
+
+  vector<Share> factor_b(size);
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < cols; j++)
+      factor_b[i * cols + j] = factor[i];
+  Mul(X, factor_b, Y);
+  AUDIT("id:{}, P{} ClipByL2Norm({},{}) {} output Y(Share){}", msgid.get_hex(), player, rows, cols, clip_norm, Vector<Share>(Y));
+}
+
+void HelixInternal::DropoutCommonMask(size_t size, double rate, vector<double>& mask) {
+  assert(rate >= 0 && rate < 1);
+  double scale = 0;
+  const uint64_t threshold = dropout_keep_cells(rate, 16, scale);
+
+  vector<mpc_t> r;
+  PRF(r, size);
+  mask.assign(size, 0);
+  for (size_t i = 0; i < size; i++) {
+    if ((r[i] & 0xFFFF) < threshold)
+      mask[i] = scale;
+  }
+}
+
+void HelixInternal::DropoutSharedMask(size_t size, double rate, vector<Share>& mask) {
+  assert(rate >= 0 && rate < 1);
+  double scale = 0;
+  const uint64_t t = dropout_keep_cells(rate, kDropoutUniformBits, scale);
+
+  // unscaled (t / 2^bits - U >= 0), U sits mid-cell so this is exactly cell < t,
+  // times the scaled 2^bits / t with no truncation
+  vector<Share> U, diff, kept;
+  RandomUniform(size, kDropoutUniformBits, U);
+  Sub(vector<double>(size, std::ldexp(double(t), -int(kDropoutUniformBits))), U, diff);
+  GreaterEqual(diff, vector<double>(size, 0.0), kept);
+  vector<mpc_t> inv_keep(size, FloatToMpcType(scale, GetMpcContext()->FLOAT_PRECISION));
+  Mul(kept, inv_keep, mask, false);
+}
+
+} // namespace helix
+} // namespace rosetta
@@ -18,6 +18,7 @@
 
 #include "cc/modules/protocol/mpc/helix/include/helix_internal.h"
 #include "cc/modules/protocol/mpc/comm/include/mpc_common.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_pow.h"
 
 #include <iostream>
 #include <vector>
@@ -43,84 +44,31 @@ void HelixInternal::PowV2(
 
 void HelixInternal::PowV2(const vector<Share>& X, const int& k,
                           vector<Share>& Y) {
-  // cout << "vector HelixInternal::PowV3" << endl;
-  AUDIT("id:{}, P{} PowV2 input X(Share){}", msgid.get_hex(), player, Vector<Share>(X));
-  AUDIT("id:{}, P{} PowV2 input K: {}", msgid.get_hex(), player, k);
-
-  // init curr_Y to '1'
-  int vec_size = X.size();
-  vector<Share> curr_Y(vec_size);
-  vector<double> DOUBLE_ONE(vec_size, 1.0);
-  Add(curr_Y, DOUBLE_ONE);
-  if (k == 0) {
-    Y = curr_Y;
-    AUDIT("id:{}, P{} PowV2 output Y(Share){}", msgid.get_hex(), player, Vector<Share>(Y));
-
-    return;  
-  }
-  if (k == 1) {
-    Y = X;
-    AUDIT("id:{}, P{} PowV2 output Y(Share){}", msgid.get_hex(), player, Vector<Share>(Y));
-
-    return;
-  }
-
-  int curr_k = k;
-  // current value in this bit
-  int curr_bit = 0;
-  // 2's power value
-  int curr_p = 1;
-
-  vector<Share> P = X;
-  vector<Share> tmp_new_y = curr_Y;
-  vector<Share> tmp_new_P = P;
-  bool least_bit_covered = false;
-  while (curr_k != 0) {
-    curr_bit = curr_k % 2;
-    if (curr_p != 1) {
-      Mul(P, P, tmp_new_P);
-      P = tmp_new_P;
-    }
-    if (curr_bit) {
-      // LSB bit, no need to use MPC to multiply const ONE.
-      if (!least_bit_covered) {
-        curr_Y = P;
-        least_bit_covered = true;
-      } else {
-        Mul(P, curr_Y, tmp_new_y);
-        curr_Y = tmp_new_y;
-      }
-    }
-    curr_k = int(curr_k / 2);
-    curr_p++;
-  }
-  Y = curr_Y;
-  AUDIT("id:{}, P{} PowV2 output Y(Share){}", msgid.get_hex(), player, Vector<Share>(Y));
-
-  return;
+  vector<int> K(X.size(), k);
+  PowV2(X, K, Y);
 }
 
 void HelixInternal::PowV2(const vector<Share>& X, const vector<int>& k, vector<Share>& Y) {
+  AUDIT("id:{}, P{} PowV2 input X(Share){}", msgid.get_hex(), player, Vector<Share>(X));
   assert(X.size() == k.size());
-  resize_vector(Y, X.size());
   int vec_size = X.size();
-  // speedup with vectorization
-  bool is_common_k = true;
-  for(int i = 1; i < vec_size; ++i) {
-    if(k[i] != k[i-1]) {
-      is_common_k = false;
-      break;
-    }
-  }
-  if (is_common_k) {
-    // cout << "Helix common_k vector pow!" << endl;
-    PowV2(X, k[0], Y);
-    return;
-  }
-  // inefficent one 
-  for (auto i = 0; i < k.size(); ++i) {
-    PowV2(X[i], k[i], Y[i]);
-  }
+
+  // init ONE to '1'
+  vector<Share> ONE(vec_size);
+  vector<double> DOUBLE_ONE(vec_size, 1.0);
+  Add(ONE, DOUBLE_ONE);
+
+  // one batched chain for any mix of exponents, see vectorized_pow
+  vector<int64_t> K(k.begin(), k.end());
+  vectorized_pow(
+    X, K, ONE, Y,
+    [this](const vector<Share>& A, const vector<Share>& B, vector<Share>& C) {
+      Mul(A, B, C);
+    },
+    [this](const vector<Share>& A, const vector<Share>& B, vector<Share>& C) {
+      Reciprocaldiv(A, B, C);
+    });
+  AUDIT("id:{}, P{} PowV2 output Y(Share){}", msgid.get_hex(), player, Vector<Share>(Y));
 }
 
 void HelixInternal::UniPolynomial(
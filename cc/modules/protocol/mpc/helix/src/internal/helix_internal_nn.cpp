@@ -18,6 +18,7 @@
 
 #include "cc/modules/protocol/mpc/helix/include/helix_internal.h"
 #include "cc/modules/protocol/mpc/comm/include/mpc_common.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_helper.h"
 
 #include <iostream>
 #include <vector>
@@ -242,5 +243,212 @@ void HelixInternal::SigmoidCrossEntropy(const vector<Share>& logits, const vecto
   AUDIT("id:{}, P{} SigmoidCrossEntropy compute: Z=max(logit,0)-logit*label+log(1+exp(-abs(logits)), output Z(Share){}", msgid.get_hex(), player, Vector<Share>(Z));
 }
 
+void HelixInternal::PiecewisePolynomial(
+  const vector<Share>& X,
+  const string& func_name,
+  vector<Share>& Y) {
+  AUDIT("id:{}, P{} PiecewisePolynomial {} input X(Share){}", msgid.get_hex(), player, func_name, Vector<Share>(X));
+  int float_precision = GetMpcContext()->FLOAT_PRECISION;
+  vector<double> break_points;
+  vector<vector<mpc_t>> coffs;
+  if (!PolyConfFactory::get_func_telescoping(func_name, float_precision, break_points, coffs)) {
+    tlog_error << "ERROR! can not find polynomials for func " << func_name;
+    return;
+  }
+
+  size_t size = X.size();
+  size_t cmp_size = break_points.size();
+  size_t max_power = coffs[0].size() - 1;
+  Y.resize(size);
+
+  // S1: (X >= b_k) for all the break points in one GreaterEqual, 0/1 unscaled
+  vector<Share> XX;
+  vector<double> C;
+  for (size_t k = 0; k < cmp_size; ++k) {
+    XX.insert(XX.end(), X.begin(), X.end());
+    C.insert(C.end(), size, break_points[k]);
+  }
+  vector<Share> cmp;
+  if (cmp_size > 0)
+    GreaterEqual(XX, C, cmp);
+
+  // S2: powers[p - 1] = X^p, shared by all the segments
+  vector<vector<Share>> powers;
+  if (max_power >= 1)
+    Pow(X, max_power, powers);
+
+  // S3: g_k(X) locally
+  vector<Share> G(cmp_size * size);
+  for (size_t k = 0; k <= cmp_size; ++k) {
+    vector<Share> g(size);
+    vector<Share> term(size);
+    for (size_t p = 1; p <= max_power; ++p) {
+      if (coffs[k][p] == 0)
+        continue;
+      Mul(powers[p - 1], vector<mpc_t>(size, coffs[k][p]), term, false);
+      Add(g, term);
+    }
+    Trunc(g, size, float_precision);
+    Add(g, vector<mpc_t>(size, coffs[k][0]));
+    if (k == 0)
+      Y = g;
+    else
+      std::copy(g.begin(), g.end(), G.begin() + (k - 1) * size);
+  }
+
+  // S4: all the (X >= b_k) * g_k(X) in one Mul
+  if (cmp_size > 0) {
+    vector<Share> selected;
+    Mul(cmp, G, selected, false);
+    for (size_t k = 0; k < cmp_size; ++k) {
+      for (size_t i = 0; i < size; ++i)
+        Add(Y[i], selected[k * size + i]);
+    }
+  }
+
+  AUDIT("id:{}, P{} PiecewisePolynomial {} output Y(Share){}", msgid.get_hex(), player, func_name, Vector<Share>(Y));
+}
+
+// rows x cols broadcast of a per-row (or per-column) vector
+static void layer_norm_broadcast(
+  const vector<Share>& V,
+  vector<Share>& out,
+  int rows,
+  int cols,
+  bool per_row) {
+  out.resize(rows * cols);
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < cols; ++j)
+      out[i * cols + j] = per_row ? V[i] : V[j];
+}
+
+static void layer_norm_center(
+  const vector<Share>& X,
+  const vector<Share>& mean,
+  vector<Share>& centered,
+  int rows,
+  int cols) {
+  centered.resize(rows * cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      centered[i * cols + j].s0.A0 = X[i * cols + j].s0.A0 - mean[i].s0.A0;
+      centered[i * cols + j].s1.A1 = X[i * cols + j].s1.A1 - mean[i].s1.A1;
+    }
+  }
+}
+
+void HelixInternal::LayerNorm(
+  const vector<Share>& X,
+  const vector<Share>& gamma,
+  const vector<Share>& beta,
+  vector<Share>& Y,
+  vector<Share>& inv_std,
+  int rows,
+  int cols,
+  double epsilon) {
+  AUDIT("id:{}, P{} LayerNorm({},{}) input X(Share){}", msgid.get_hex(), player, rows, cols, Vector<Share>(X));
+  size_t size = rows * cols;
+  assert(X.size() == size && gamma.size() == cols && beta.size() == cols);
+
+  vector<Share> mean, centered;
+  Mean(X, mean, rows, cols);
+  layer_norm_center(X, mean, centered, rows, cols);
+
+  // (X - mean)^2 and gamma * (X - mean) in one round
+  vector<Share> gamma_b;
+  layer_norm_broadcast(gamma, gamma_b, rows, cols, false);
+  vector<Share> lhs(centered), rhs(centered);
+  lhs.insert(lhs.end(), centered.begin(), centered.end());
+  rhs.insert(rhs.end(), gamma_b.begin(), gamma_b.end());
+  vector<Share> prod;
+  Mul(lhs, rhs, prod);
+
+  vector<Share> squares(prod.begin(), prod.begin() + size);
+  vector<Share> var;
+  Mean(squares, var, rows, cols);
+  epsilon = clamp_fixpoint_epsilon(epsilon, GetMpcContext()->FLOAT_PRECISION);
+  Add(var, vector<double>(rows, epsilon));
+  Rsqrt(var, inv_std);
+
+  vector<Share> scaled(prod.begin() + size, prod.end());
+  vector<Share> inv_std_b, beta_b;
+  layer_norm_broadcast(inv_std, inv_std_b, rows, cols, true);
+  layer_norm_broadcast(beta, beta_b, rows, cols, false);
+  Mul(scaled, inv_std_b, Y);
+  Add(Y, beta_b);
+
+  AUDIT("id:{}, P{} LayerNorm({},{}) output Y(Share){}", msgid.get_hex(), player, rows, cols, Vector<Share>(Y));
+}
+
+void HelixInternal::LayerNormGrad(
+  const vector<Share>& X,
+  const vector<Share>& gamma,
+  const vector<Share>& inv_std,
+  const vector<Share>& dY,
+  vector<Share>& dX,
+  vector<Share>& dgamma,
+  vector<Share>& dbeta,
+  int rows,
+  int cols) {
+  AUDIT("id:{}, P{} LayerNormGrad({},{}) input dY(Share){}", msgid.get_hex(), player, rows, cols, Vector<Share>(dY));
+  size_t size = rows * cols;
+  assert(X.size() == size && dY.size() == size && gamma.size() == cols && inv_std.size() == rows);
+
+  vector<Share> mean, centered;
+  Mean(X, mean, rows, cols);
+  layer_norm_center(X, mean, centered, rows, cols);
+  vector<Share> gamma_b, inv_std_b;
+  layer_norm_broadcast(gamma, gamma_b, rows, cols, false);
+  layer_norm_broadcast(inv_std, inv_std_b, rows, cols, true);
+
+  // R1: x_hat = (X - mean) * inv_std, dx_hat = dY * gamma
+  vector<Share> lhs(centered), rhs(inv_std_b);
+  lhs.insert(lhs.end(), dY.begin(), dY.end());
+  rhs.insert(rhs.end(), gamma_b.begin(), gamma_b.end());
+  vector<Share> prod;
+  Mul(lhs, rhs, prod);
+  vector<Share> x_hat(prod.begin(), prod.begin() + size);
+  vector<Share> dx_hat(prod.begin() + size, prod.end());
+
+  // R2: dx_hat * x_hat, dY * x_hat, inv_std * dx_hat, inv_std * x_hat
+  lhs = dx_hat;
+  lhs.insert(lhs.end(), dY.begin(), dY.end());
+  lhs.insert(lhs.end(), dx_hat.begin(), dx_hat.end());
+  lhs.insert(lhs.end(), x_hat.begin(), x_hat.end());
+  rhs = x_hat;
+  rhs.insert(rhs.end(), x_hat.begin(), x_hat.end());
+  rhs.insert(rhs.end(), inv_std_b.begin(), inv_std_b.end());
+  rhs.insert(rhs.end(), inv_std_b.begin(), inv_std_b.end());
+  Mul(lhs, rhs, prod);
+  vector<Share> dx_hat_x_hat(prod.begin(), prod.begin() + size);
+  vector<Share> dy_x_hat(prod.begin() + size, prod.begin() + 2 * size);
+
+  vector<Share> mean_dx_hat, mean_dx_hat_x_hat;
+  Mean(dx_hat, mean_dx_hat, rows, cols);
+  Mean(dx_hat_x_hat, mean_dx_hat_x_hat, rows, cols);
+  AddN(dy_x_hat, dgamma, rows, cols);
+  AddN(dY, dbeta, rows, cols);
+
+  // R3: inv_std * mean(dx_hat) per row, inv_std * x_hat * mean(dx_hat * x_hat)
+  vector<Share> m2_b;
+  layer_norm_broadcast(mean_dx_hat_x_hat, m2_b, rows, cols, true);
+  lhs = inv_std;
+  lhs.insert(lhs.end(), prod.begin() + 3 * size, prod.end());
+  rhs = mean_dx_hat;
+  rhs.insert(rhs.end(), m2_b.begin(), m2_b.end());
+  vector<Share> corr;
+  Mul(lhs, rhs, corr);
+
+  dX.assign(prod.begin() + 2 * size, prod.begin() + 3 * size);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      Sub(dX[i * cols + j], corr[i]);
+      Sub(dX[i * cols + j], corr[rows + i * cols + j]);
+    }
+  }
+
+  AUDIT("id:{}, P{} LayerNormGrad({},{}) output dX(Share){}", msgid.get_hex(), player, rows, cols, Vector<Share>(dX));
+}
+
 } // namespace helix
 } // namespace rosetta
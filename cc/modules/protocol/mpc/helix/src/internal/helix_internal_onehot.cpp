@@ -0,0 +1,73 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include "cc/modules/protocol/mpc/helix/include/helix_internal.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_common.h"
+
+#include <vector>
+#include <cassert>
+
+using namespace std;
+using namespace rosetta;
+
+namespace rosetta {
+namespace helix {
+
+void HelixInternal::OneHot(const vector<Share>& X, int depth, vector<Share>& Y) {
+  AUDIT("id:{}, P{} OneHot({}) input X(Share){}", msgid.get_hex(), player, depth, Vector<Share>(X));
+  assert(depth > 0);
+  size_t size = X.size();
+  size_t width = depth + 1;
+
+  // ge_j = (X >= j - 0.5) for j = 0..depth, all in one comparison batch
+  vector<Share> rep(size * width), ge;
+  vector<double> shift(size * width);
+  for (size_t i = 0; i < size; i++) {
+    for (size_t j = 0; j < width; j++) {
+      rep[i * width + j] = X[i];
+      shift[i * width + j] = j - 0.5;
+    }
+  }
+  GreaterEqual(rep, shift, ge);
+
+  // the comparison bits are unscaled, lift the differences to fixed-point without truncation
+  vector<Share> eq(size * depth);
+  for (size_t i = 0; i < size; i++)
+    for (int j = 0; j < depth; j++)
+      Sub(ge[i * width + j], ge[i * width + j + 1], eq[i * depth + j]);
+  Mul(eq, vector<mpc_t>(eq.size(), FloatToMpcType(1, GetMpcContext()->FLOAT_PRECISION)), Y, false);
+  AUDIT("id:{}, P{} OneHot({}) output Y(Share){}", msgid.get_hex(), player, depth, Vector<Share>(Y));
+}
+
+void HelixInternal::OneHotToIndex(const vector<Share>& X, int depth, vector<Share>& Y) {
+  AUDIT("id:{}, P{} OneHotToIndex({}) input X(Share){}", msgid.get_hex(), player, depth, Vector<Share>(X));
+  assert(depth > 0 && X.size() % depth == 0);
+  int rows = X.size() / depth;
+
+  // public integer weights, so the products stay exact without truncation
+  vector<mpc_t> weights(X.size());
+  for (size_t i = 0; i < X.size(); i++)
+    weights[i] = i % depth;
+  vector<Share> weighted;
+  Mul(X, weights, weighted, false);
+  Sum(weighted, Y, rows, depth);
+  AUDIT("id:{}, P{} OneHotToIndex({}) output Y(Share){}", msgid.get_hex(), player, depth, Vector<Share>(Y));
+}
+
+} // namespace helix
+} // namespace rosetta
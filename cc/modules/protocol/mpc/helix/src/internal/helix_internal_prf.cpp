@@ -57,13 +57,9 @@ void _PRF(vector<T>& A, size_t size, std::shared_ptr<RttPRG> prg) {
   }
 #else
   if (sizeof(T) == sizeof(bit_t)) {
-    for (int i = 0; i < size; i++) {
-      A[i] = prg->getBit();
-    }
+    prg->fillBits((uint8_t*)A.data(), size);
   } else if (sizeof(T) == sizeof(mpc_t)) {
-    for (int i = 0; i < size; i++) {
-      A[i] = prg->get64Bits();
-    }
+    prg->fillRing(A.data(), size);
   }
 #endif
 }
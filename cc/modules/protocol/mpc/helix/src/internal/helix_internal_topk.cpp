@@ -0,0 +1,79 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include "cc/modules/protocol/mpc/helix/include/helix_internal.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_common.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_topk.h"
+
+#include <vector>
+#include <cassert>
+
+using namespace std;
+using namespace rosetta;
+
+namespace rosetta {
+namespace helix {
+
+void HelixInternal::TopK(
+  const vector<Share>& X,
+  int rows,
+  int cols,
+  int k,
+  vector<Share>& values,
+  vector<Share>& indices) {
+  AUDIT("id:{}, P{} TopK({},{}) k={} input X(Share){}", msgid.get_hex(), player, rows, cols, k, Vector<Share>(X));
+  assert(X.size() == rows * cols && k > 0 && k <= cols);
+
+  vector<double> fidx(cols);
+  for (int j = 0; j < cols; j++)
+    fidx[j] = j;
+  vector<Share> idx, pads;
+  ConstCommonInput(fidx, idx);
+  ConstCommonInput(vector<double>{kBitonicTopKPad, -1.0}, pads);
+
+  // hi = b + (a >= b) * (a - b), lo = a + b - hi; the comparison bit is unscaled, so no truncation
+  auto cswap = [&](vector<Share>& A, vector<Share>& B, vector<Share>& IA, vector<Share>& IB) {
+    size_t n = A.size();
+    vector<Share> diff, idiff, ge;
+    Sub(A, B, diff);
+    Sub(IA, IB, idiff);
+    DReLU(diff, ge);
+
+    vector<Share> lhs(ge), rhs(diff), prod;
+    lhs.insert(lhs.end(), ge.begin(), ge.end());
+    rhs.insert(rhs.end(), idiff.begin(), idiff.end());
+    Mul(lhs, rhs, prod, false);
+
+    for (size_t i = 0; i < n; i++) {
+      Share a_i = A[i], ia_i = IA[i];
+      Add(B[i], prod[i], A[i]);
+      Sub(a_i, prod[i], B[i]);
+      Add(IB[i], prod[n + i], IA[i]);
+      Sub(ia_i, prod[n + i], IB[i]);
+    }
+  };
+
+  vector<Share> top_idx;
+  bitonic_topk(X, idx, pads[0], pads[1], rows, cols, k, values, top_idx, cswap);
+
+  OneHot(top_idx, cols, indices);
+  AUDIT("id:{}, P{} TopK({},{}) k={} output values(Share){}", msgid.get_hex(), player, rows, cols, k, Vector<Share>(values));
+}
+
+} // namespace helix
+} // namespace rosetta
@@ -35,7 +35,7 @@ using namespace rosetta::helix;
   string logfile = "log/" + get_file_name(__FILENAME__) + "-" + to_string(partyid) + ".log"; \
     Logger::Get().log_to_stdout(false);                                                             \
   Logger::Get().set_filename(logfile);                                           \
-  Logger::Get().set_level(3);                                           \
+  rosetta::set_log_level(3);                                            \
   string node_id;                                                                     \
   string config_json;                                                                 \
   rosetta_old_conf_parse(node_id, config_json, partyid, "CONFIG.json");               \
@@ -0,0 +1,65 @@
+
+#include <iostream>
+#include <vector>
+using namespace std;
+
+#include "emp-tool/emp-tool.h"
+using namespace emp;
+
+#include "cc/modules/protocol/utility/include/aes_ctr.h"
+using rosetta::RttAesCtr;
+
+// throughput of the AES-CTR engine behind RttPRG and the SecureNN AESObject, emp PRG as baseline
+void testAesCtr() {
+  emp::block blk;
+  memcpy(&blk, fix_key, sizeof(blk));
+  PRG prg(&blk);
+  RttAesCtr ctr(fix_key);
+
+  for (long long length = 2; length <= 8192 * 8; length *= 2) {
+    long long times = 1024 * 1024 * 2 / length;
+    vector<block> data(length + 1);
+    char* data2 = (char*)data.data();
+
+    auto start = clock_start();
+    for (int i = 0; i < times; ++i)
+      prg.random_data(data2, length * 16);
+    double emp_interval = time_from(start);
+
+    start = clock_start();
+    for (int i = 0; i < times; ++i)
+      ctr.fill(data2, length * 16);
+    double ctr_interval = time_from(start);
+
+    cout << "block size " << length << " :\tEMP PRG "
+         << (length * times * 128) / (emp_interval + 0.0) * 1e6 * 1e-9 << " Gbps,\tAES-CTR "
+         << (length * times * 128) / (ctr_interval + 0.0) * 1e6 * 1e-9 << " Gbps ("
+         << (length * times * 16) / (ctr_interval + 0.0) * 1e6 * 1e-9 << " GB/s)\n";
+  }
+
+  // the typed fills, per output element
+  const size_t n = 1 << 24;
+  vector<uint8_t> small(n);
+  vector<uint64_t> ring(n);
+
+  auto start = clock_start();
+  ctr.fill_bits(small.data(), n);
+  double interval = time_from(start);
+  cout << "fill_bits:\t" << n / interval << " M values/s\n";
+
+  start = clock_start();
+  ctr.fill_ring(ring.data(), n);
+  interval = time_from(start);
+  cout << "fill_ring(uint64_t):\t" << n / interval << " M values/s, "
+       << n * sizeof(uint64_t) / interval * 1e-3 << " GB/s\n";
+
+  start = clock_start();
+  ctr.fill_mod(small.data(), n, 127, 1);
+  interval = time_from(start);
+  cout << "fill_mod(127, nonzero):\t" << n / interval << " M values/s\n";
+}
+
+int main(int argc, char* argv[]) {
+  testAesCtr();
+  return 0;
+}
@@ -0,0 +1,72 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include "cc/modules/protocol/mpc/comm/include/mpc_gc_compare.h"
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_impl.h"
+
+namespace rosetta {
+namespace ot2pc {
+
+/**
+ * DReLU of two-party additive shares as a garbled circuit, in two rounds.
+ *
+ * A2Y: P0 garbles, with free-XOR and half-gates, and its COT Delta as the
+ * global offset (its lsb is 1, the point-and-permute bit). P1 gets the labels
+ * of its share bits from the same COTs.
+ * The circuit is the ripple-carry MSB of x0 + x1, with l - 1 ANDs.
+ * Y2A: the output is opened to P1 masked by a random bit r of P0, and the
+ * masked bit is turned back into an arithmetic share with one more COT
+ * (Gilboa with a single bit).
+ *
+ * Semi-honest, like the rest of OT2PC. P2, if any, gets zero shares.
+ */
+class GcCompare : public MpcGcCompare {
+ public:
+  //! the base OTs and epochs come from an OT2PC instance, or a state of its own
+  GcCompare(shared_ptr<NET_IO> net_io, shared_ptr<Ot2pcState> state);
+
+  int DReLU(
+    const msg_id_t& msgid,
+    const vector<mpc_t>& x,
+    vector<mpc_t>& y,
+    int float_precision);
+
+ private:
+  // one chunk of elements, whose first AND gate is number gates of this call
+  void Garble(
+    TripleGenerator& gen,
+    uint64_t epoch,
+    size_t gates,
+    const vector<mpc_t>& x,
+    vector<mpc_t>& y,
+    int float_precision);
+  void Evaluate(
+    TripleGenerator& gen,
+    uint64_t epoch,
+    size_t gates,
+    const vector<mpc_t>& x,
+    vector<mpc_t>& y);
+
+ private:
+  shared_ptr<NET_IO> net_io_ = nullptr;
+  shared_ptr<Ot2pcState> state_ = nullptr;
+};
+
+} // namespace ot2pc
+} // namespace rosetta
@@ -0,0 +1,84 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+#include "cc/modules/protocol/mpc/comm/include/mpc_protocol.h"
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_triple.h"
+
+#include <map>
+#include <mutex>
+
+namespace rosetta {
+
+/**
+ * State shared by all the ops of one OT2PC instance: the base OT keys and,
+ * per message id, how many triple generators have been made so far.
+ */
+struct Ot2pcState {
+  ot2pc::BaseOtKeys keys;
+  bool ready = false;
+
+  uint64_t NextEpoch(const msg_id_t& msgid) {
+    std::unique_lock<std::mutex> lck(mtx_);
+    return epochs_[msgid.str()]++;
+  }
+
+ private:
+  std::mutex mtx_;
+  std::map<string, uint64_t> epochs_;
+};
+
+/**
+ * OT2PC is a dealer-free two-party arithmetic backend.
+ *
+ * P0 and P1 hold additive shares over the ring of mpc_t. Multiplication and
+ * matmul triples are made between the two parties with IKNP OT extension and
+ * Gilboa's multiplication, so no third party or trusted dealer is needed.
+ * Products are truncated locally, as in SecureML.
+ *
+ * Comparisons, ReluPrime and Relu run as garbled circuits (ot2pc::GcCompare)
+ * over the same OT extension. Besides them, only the linear ops, Mul, Square
+ * and Matmul are supported for now.
+ */
+class Ot2pcProtocol : public MpcProtocol {
+ public:
+  Ot2pcProtocol(const string& task_id="") : MpcProtocol("OT2PC", 2, task_id) {
+    state_ = std::make_shared<Ot2pcState>();
+  }
+
+  shared_ptr<ProtocolOps> GetOps(const msg_id_t& msgid);
+
+  //! @attention! internal use, for cpp test cases
+  shared_ptr<Ot2pcState> GetState() { return state_; }
+
+ protected:
+  //! the base OTs of both directions, once per instance, and the garbled-circuit comparison
+  int OfflinePreprocess();
+
+ private:
+  shared_ptr<Ot2pcState> state_ = nullptr;
+};
+
+class Ot2pcProtocolFactory : public IProtocolFactory {
+ public:
+  Ot2pcProtocolFactory() {}
+
+ public:
+  shared_ptr<ProtocolBase> Create(const string& task_id="") { return std::make_shared<Ot2pcProtocol>(task_id); }
+};
+
+} // namespace rosetta
@@ -0,0 +1,104 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cc/modules/protocol/public/include/protocol_base.h"
+#include "cc/modules/protocol/public/include/protocol_ops.h"
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_impl.h"
+
+namespace rosetta {
+
+/**
+ * Ops of the OT2PC backend. Shares use the secure-text encoding of SecureNN,
+ * literal strings are public constants. Every op that needs triples makes
+ * them with its own generator, on its own channels.
+ */
+class Ot2pcOpsImpl : public ProtocolOps {
+ public:
+  Ot2pcOpsImpl(
+    const msg_id_t& msg_id,
+    shared_ptr<ProtocolContext> context,
+    shared_ptr<NET_IO> net_io,
+    shared_ptr<Ot2pcState> state);
+  ~Ot2pcOpsImpl() = default;
+
+  int TfToSecure(const vector<string>& in, vector<string>& out, const attr_type* attr_info = nullptr);
+  int SecureToTf(const vector<string>& in, vector<string>& out, const attr_type* attr_info = nullptr);
+  int RandSeed(std::string op_seed, string& out_str);
+
+  int PrivateInput(const string& node_id, const vector<double>& in_x, vector<string>& out_x);
+  int PublicInput(const string& node_id, const vector<double>& in_x, vector<string>& out_x);
+  int Broadcast(const string& from_node, const string& msg, string& result);
+  int Broadcast(const string& from_node, const char* msg, char* result, size_t size);
+
+  //////////////////////////////////    math ops   //////////////////////////////////
+  int Add(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Sub(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Mul(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Matmul(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+
+  int Square(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Negative(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+
+  // comparisons and Relu run as garbled circuits, see GcCompare
+  int Less(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int LessEqual(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Greater(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int GreaterEqual(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Relu(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int ReluPrime(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+
+  int Reveal(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Reveal(const vector<string>& a, vector<double>& output, const attr_type* attr_info = nullptr);
+
+ private:
+  // shares from secure text, or a public constant (held by P0) from literal numbers
+  int Decode(const vector<string>& a, vector<mpc_t>& sa, bool is_const = false);
+  int Encode(const vector<mpc_t>& sa, vector<string>& a);
+
+  // the operand is a public constant, by attr tag or by its literal text
+  bool IsConst(const vector<string>& a, const attr_type* attr, const char* tag) const;
+
+  void Truncate(vector<mpc_t>& a) const;
+  // opens x - u and y - v at once, for Beaver
+  void Open(const vector<mpc_t>& e, const vector<mpc_t>& f, vector<mpc_t>& E, vector<mpc_t>& F);
+  // shares of x * y, not truncated
+  void BeaverMul(const vector<mpc_t>& x, const vector<mpc_t>& y, vector<mpc_t>& z);
+  // shares of (x >= 0), scaled
+  int DReLU(const vector<mpc_t>& x, vector<mpc_t>& y);
+  // (a >= b), or (b >= a) when swapped, or the complement of either
+  int Compare(
+    const vector<string>& a,
+    const vector<string>& b,
+    vector<string>& output,
+    const attr_type* attr_info,
+    bool swap,
+    bool negate);
+  ot2pc::TripleGenerator& Triples();
+
+ private:
+  int party_ = -1;
+  shared_ptr<NET_IO> net_io_ = nullptr;
+  shared_ptr<Ot2pcState> state_ = nullptr;
+  std::unique_ptr<ot2pc::TripleGenerator> triples_;
+};
+
+} // namespace rosetta
@@ -0,0 +1,123 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include "cc/modules/protocol/mpc/comm/include/mpc_defines.h"
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_netio.h"
+
+#include "emp-ot/emp-ot.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rosetta {
+namespace ot2pc {
+
+/**
+ * The results of the 128 base OTs in each direction, run once per protocol
+ * instance. Every TripleGenerator derives fresh IKNP seeds from them.
+ */
+struct BaseOtKeys {
+  // the peer is the COT receiver: base OT choices and the chosen keys
+  bool s[128];
+  emp::block k_s[128];
+  // the peer is the COT sender: both base OT keys
+  emp::block k0[128];
+  emp::block k1[128];
+
+  //! runs the base OTs with the peer, P0 and P1 both call this
+  void Setup(shared_ptr<NET_IO> net_io, const string& msgid_tag);
+};
+
+/**
+ * Dealer-free multiplication and matmul triples between P0 and P1.
+ *
+ * Each party draws its own shares a_p and b_p. The cross terms a_0 * b_1 and
+ * a_1 * b_0 come from Gilboa's multiplication over IKNP correlated OT: one COT
+ * per bit y_i of the receiver's value, with which the receiver gets either
+ * r or r + x * 2^i and the sender keeps -r. The two directions run on their
+ * own channels, in parallel.
+ *
+ * The epoch tells apart the generators of one op across runs. Both parties
+ * must pass the same (msgid, epoch), and never the same one twice.
+ */
+class TripleGenerator {
+ public:
+  TripleGenerator(
+    shared_ptr<NET_IO> net_io,
+    const BaseOtKeys& keys,
+    const msg_id_t& msgid,
+    uint64_t epoch);
+  ~TripleGenerator();
+
+  //! shares of c = a * b, element-wise, of the given size
+  void Beaver(size_t size, vector<mpc_t>& a, vector<mpc_t>& b, vector<mpc_t>& c);
+
+  //! shares of C = A * B, with A (m x k), B (k x n) and C (m x n), row-major
+  void MatMul(
+    size_t m,
+    size_t k,
+    size_t n,
+    vector<mpc_t>& A,
+    vector<mpc_t>& B,
+    vector<mpc_t>& C);
+
+  //! bytes sent by this generator, over both channels
+  size_t BytesSent() const { return send_io_->counter + recv_io_->counter; }
+
+  // x_l * y_l for L instances of len elements: x_l comes from get_x on the
+  // sender, y_l from get_y on the receiver, each share is passed to put_share.
+  // Only the low bits of y_l are used, one COT each.
+  void GilboaSend(
+    size_t L,
+    size_t len,
+    const std::function<const mpc_t*(size_t)>& get_x,
+    const std::function<void(size_t, const mpc_t*)>& put_share,
+    size_t bits = sizeof(mpc_t) * 8);
+  void GilboaRecv(
+    size_t L,
+    size_t len,
+    const std::function<mpc_t(size_t)>& get_y,
+    const std::function<void(size_t, const mpc_t*)>& put_share,
+    size_t bits = sizeof(mpc_t) * 8);
+
+  // the COTs and channels of each direction, for protocols built on top (garbled circuits)
+  emp::IKNP<Ot2pcNetIO>* SendOt() { return send_ot_.get(); }
+  emp::IKNP<Ot2pcNetIO>* RecvOt() { return recv_ot_.get(); }
+  Ot2pcNetIO* SendIO() { return send_io_.get(); }
+  Ot2pcNetIO* RecvIO() { return recv_io_.get(); }
+
+ private:
+  void Expand(const emp::block& seed, size_t len, mpc_t* out);
+
+ private:
+  int party_ = 0;
+  emp::PRG prg_;
+  emp::CCRH ccrh_;
+  std::unique_ptr<Ot2pcNetIO> send_io_; // I am the COT sender
+  std::unique_ptr<Ot2pcNetIO> recv_io_; // I am the COT receiver
+  std::unique_ptr<emp::IKNP<Ot2pcNetIO>> send_ot_;
+  std::unique_ptr<emp::IKNP<Ot2pcNetIO>> recv_ot_;
+  uint64_t send_ctr_ = 0;
+  uint64_t recv_ctr_ = 0;
+};
+
+} // namespace ot2pc
+} // namespace rosetta
@@ -0,0 +1,205 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_gc.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace emp;
+
+namespace rosetta {
+namespace ot2pc {
+
+static const size_t kBits = sizeof(mpc_t) * 8;
+// elements garbled at a time, to bound the labels in memory
+static const size_t kChunkElements = 1 << 14;
+
+// the tweaks of the two halves of AND gate g, apart from the ones of Gilboa (high word 0)
+static inline block gate_tweak(uint64_t epoch, size_t g, int half) {
+  return makeBlock(2 * epoch + 1, 2 * g + half);
+}
+
+GcCompare::GcCompare(shared_ptr<NET_IO> net_io, shared_ptr<Ot2pcState> state)
+    : net_io_(net_io), state_(state) {
+  // one COT and one label per input bit, two ciphertexts per AND, and the Y2A COT
+  cost_model_.gc_rtts = 2;
+  cost_model_.gc_bytes = 2 * sizeof(block) * kBits + 2 * sizeof(block) * (kBits - 1) +
+    sizeof(block) + sizeof(mpc_t) + 1;
+}
+
+int GcCompare::DReLU(
+  const msg_id_t& msgid,
+  const vector<mpc_t>& x,
+  vector<mpc_t>& y,
+  int float_precision) {
+  y.assign(x.size(), 0);
+  if (!state_->ready || x.empty())
+    return 0;
+
+  msg_id_t gc_msgid(msgid.str() + "-gc");
+  uint64_t epoch = state_->NextEpoch(gc_msgid);
+  TripleGenerator gen(net_io_, state_->keys, gc_msgid, epoch);
+  bool garbler = net_io_->GetCurrentPartyId() == PARTY_A;
+  vector<mpc_t> cx, cy;
+  for (size_t beg = 0; beg < x.size(); beg += kChunkElements) {
+    size_t end = std::min(x.size(), beg + kChunkElements);
+    cx.assign(x.begin() + beg, x.begin() + end);
+    size_t gates = beg * (kBits - 1);
+    if (garbler)
+      Garble(gen, epoch, gates, cx, cy, float_precision);
+    else
+      Evaluate(gen, epoch, gates, cx, cy);
+    std::copy(cy.begin(), cy.end(), y.begin() + beg);
+  }
+  return 0;
+}
+
+void GcCompare::Garble(
+  TripleGenerator& gen,
+  uint64_t epoch,
+  size_t gates,
+  const vector<mpc_t>& x,
+  vector<mpc_t>& y,
+  int float_precision) {
+  size_t n = x.size();
+  y.resize(n);
+  CCRH ccrh;
+  PRG prg;
+  const block delta = gen.SendOt()->Delta;
+
+  // zero labels of P1's bits (by COT) and of mine, and the labels of my bits for P1
+  vector<block> B0(n * kBits), A0(n * kBits), A(n * kBits);
+  gen.SendOt()->send_cot(B0.data(), B0.size());
+  prg.random_block(A0.data(), A0.size());
+  for (size_t e = 0; e < n; ++e) {
+    for (size_t i = 0; i < kBits; ++i) {
+      size_t w = e * kBits + i;
+      A[w] = ((x[e] >> i) & 1) ? A0[w] ^ delta : A0[w];
+    }
+  }
+
+  // half-gates AND of the zero labels a0 and b0, two ciphertexts to the table
+  vector<block> tables(2 * n * (kBits - 1));
+  size_t g = 0;
+  auto and_gate = [&](const block& a0, const block& b0) {
+    bool pa = getLSB(a0), pb = getLSB(b0);
+    block ha0 = ccrh.H(a0 ^ gate_tweak(epoch, gates + g, 0));
+    block ha1 = ccrh.H(a0 ^ delta ^ gate_tweak(epoch, gates + g, 0));
+    block hb0 = ccrh.H(b0 ^ gate_tweak(epoch, gates + g, 1));
+    block hb1 = ccrh.H(b0 ^ delta ^ gate_tweak(epoch, gates + g, 1));
+    block tg = ha0 ^ ha1;
+    if (pb)
+      tg = tg ^ delta;
+    block te = hb0 ^ hb1 ^ a0;
+    block wg = pa ? ha0 ^ tg : ha0;
+    block we = pb ? hb0 ^ te ^ a0 : hb0;
+    tables[2 * g] = tg;
+    tables[2 * g + 1] = te;
+    g++;
+    return wg ^ we;
+  };
+
+  // ripple carry: c1 = a0 & b0, c(i+1) = ((ai ^ ci) & (bi ^ ci)) ^ ci, msb = a ^ b ^ c
+  vector<mpc_t> r(n);
+  vector<uint8_t> decode(n);
+  prg.random_data(r.data(), n * sizeof(mpc_t));
+  for (size_t e = 0; e < n; ++e) {
+    const block* a0 = &A0[e * kBits];
+    const block* b0 = &B0[e * kBits];
+    block c0 = and_gate(a0[0], b0[0]);
+    for (size_t i = 1; i < kBits - 1; ++i)
+      c0 = and_gate(a0[i] ^ c0, b0[i] ^ c0) ^ c0;
+    block msb0 = a0[kBits - 1] ^ b0[kBits - 1] ^ c0;
+    r[e] &= 1;
+    decode[e] = getLSB(msb0) ^ r[e];
+  }
+
+  Ot2pcNetIO* io = gen.SendIO();
+  io->send_block(A.data(), A.size());
+  io->send_block(tables.data(), tables.size());
+  io->send_data(decode.data(), decode.size());
+  io->flush();
+
+  // Y2A: P1 holds e = msb ^ r, and msb = r + e * (1 - 2r)
+  vector<mpc_t> coef(n);
+  for (size_t e = 0; e < n; ++e)
+    coef[e] = (mpc_t(1) - 2 * r[e]) << float_precision;
+  gen.GilboaSend(
+    n, 1, [&](size_t l) { return &coef[l]; },
+    [&](size_t l, const mpc_t* s) {
+      mpc_t msb = (r[l] << float_precision) + s[0];
+      y[l] = (mpc_t(1) << float_precision) - msb;
+    },
+    1);
+}
+
+void GcCompare::Evaluate(
+  TripleGenerator& gen,
+  uint64_t epoch,
+  size_t gates,
+  const vector<mpc_t>& x,
+  vector<mpc_t>& y) {
+  size_t n = x.size();
+  y.resize(n);
+  CCRH ccrh;
+
+  // the labels of my bits by COT, then P0's labels, the tables and the decode bits
+  vector<block> B(n * kBits), A(n * kBits), tables(2 * n * (kBits - 1));
+  std::unique_ptr<bool[]> bits(new bool[n * kBits]);
+  for (size_t e = 0; e < n; ++e)
+    for (size_t i = 0; i < kBits; ++i)
+      bits[e * kBits + i] = (x[e] >> i) & 1;
+  gen.RecvOt()->recv_cot(B.data(), bits.get(), B.size());
+
+  vector<uint8_t> decode(n);
+  Ot2pcNetIO* io = gen.RecvIO();
+  io->recv_block(A.data(), A.size());
+  io->recv_block(tables.data(), tables.size());
+  io->recv_data(decode.data(), decode.size());
+
+  size_t g = 0;
+  auto and_gate = [&](const block& a, const block& b) {
+    block wg = ccrh.H(a ^ gate_tweak(epoch, gates + g, 0));
+    block we = ccrh.H(b ^ gate_tweak(epoch, gates + g, 1));
+    if (getLSB(a))
+      wg = wg ^ tables[2 * g];
+    if (getLSB(b))
+      we = we ^ tables[2 * g + 1] ^ a;
+    g++;
+    return wg ^ we;
+  };
+
+  vector<mpc_t> masked(n);
+  for (size_t e = 0; e < n; ++e) {
+    const block* a = &A[e * kBits];
+    const block* b = &B[e * kBits];
+    block c = and_gate(a[0], b[0]);
+    for (size_t i = 1; i < kBits - 1; ++i)
+      c = and_gate(a[i] ^ c, b[i] ^ c) ^ c;
+    block msb = a[kBits - 1] ^ b[kBits - 1] ^ c;
+    masked[e] = getLSB(msb) ^ decode[e];
+  }
+
+  // Y2A, the share of 1 - msb is the negated Gilboa share
+  gen.GilboaRecv(
+    n, 1, [&](size_t l) { return masked[l]; }, [&](size_t l, const mpc_t* s) { y[l] = -s[0]; }, 1);
+}
+
+} // namespace ot2pc
+} // namespace rosetta
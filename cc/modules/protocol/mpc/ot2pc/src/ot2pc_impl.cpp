@@ -0,0 +1,53 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_impl.h"
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_ops_impl.h"
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_gc.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <chrono>
+#include <string>
+using namespace std;
+
+namespace rosetta {
+
+int Ot2pcProtocol::OfflinePreprocess() {
+  // there is no other comparison, so garbled circuits are always used
+  auto gc = std::make_shared<ot2pc::GcCompare>(net_io_, state_);
+  gc->CostModel().mode = MpcCmpCostModel::GC;
+  context_->GC_COMPARE = gc;
+
+  int my_party_id = net_io_->GetCurrentPartyId();
+  if (my_party_id != PARTY_A && my_party_id != PARTY_B) {
+    tlog_warn << "OT2PC is a 2PC protocol, there is no seat for " << context_->NODE_ID;
+    return 0;
+  }
+
+  auto beg = std::chrono::steady_clock::now();
+  state_->keys.Setup(net_io_, context_->TASK_ID + "-base-ot");
+  state_->ready = true;
+  auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - beg);
+  tlog_info << "OT2PC: base OTs of both directions done in " << elapsed.count() << " ms";
+  return 0;
+}
+
+shared_ptr<ProtocolOps> Ot2pcProtocol::GetOps(const msg_id_t& msgid) {
+  return make_shared<Ot2pcOpsImpl>(msgid, context_, net_io_, state_);
+}
+
+} // namespace rosetta
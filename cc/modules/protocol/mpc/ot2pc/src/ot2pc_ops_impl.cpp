@@ -0,0 +1,545 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_ops_impl.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_helper.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_gc_compare.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+#include "cc/modules/common/include/utils/str_type_convert.h"
+#include "cc/modules/common/include/utils/secure_encoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#define GET_ATTR_TAG(attr_info_ptr, tag) \
+  attr_info_ptr && attr_info_ptr->count(tag) > 0 && attr_info_ptr->at(tag) == "1"
+
+#define ot2pc_decode(a, sa)                                                      \
+  do {                                                                           \
+    if (0 != Decode(a, sa)) {                                                    \
+      log_error << "OT2PC decode failed! In " << __FUNCTION__ << "#" << __LINE__; \
+      return -1;                                                                 \
+    }                                                                            \
+  } while (0)
+
+#define ot2pc_encode(sa, a)                                                      \
+  do {                                                                           \
+    if (0 != Encode(sa, a)) {                                                    \
+      log_error << "OT2PC encode failed! In " << __FUNCTION__ << "#" << __LINE__; \
+      return -1;                                                                 \
+    }                                                                            \
+  } while (0)
+
+// a seat is only taken by P0 and P1
+#define ot2pc_check_party()                                                      \
+  do {                                                                           \
+    if (!state_->ready) {                                                        \
+      log_error << "OT2PC is a 2PC protocol, " << context_->NODE_ID << " has no seat! In " << __FUNCTION__; \
+      return -1;                                                                 \
+    }                                                                            \
+  } while (0)
+
+namespace rosetta {
+
+Ot2pcOpsImpl::Ot2pcOpsImpl(
+  const msg_id_t& msg_id,
+  shared_ptr<ProtocolContext> context,
+  shared_ptr<NET_IO> net_io,
+  shared_ptr<Ot2pcState> state)
+    : ProtocolOps(msg_id, context), net_io_(net_io), state_(state) {
+  party_ = context_->GetMyRole();
+}
+
+int Ot2pcOpsImpl::Decode(const vector<string>& a, vector<mpc_t>& sa, bool is_const) {
+  sa.resize(a.size());
+  if (a.empty())
+    return 0;
+
+  if (!is_const && rosetta::convert::is_secure_text(a[0])) {
+    for (size_t i = 0; i < a.size(); ++i) {
+      memcpy((char*)&sa[i], a[i].data(), sizeof(mpc_t));
+    }
+    return 0;
+  }
+
+  // a public constant, as a share held by P0
+  vector<double> da(a.size());
+  if (rosetta::convert::is_binary_double(a[0])) {
+    for (size_t i = 0; i < a.size(); ++i) {
+      memcpy(&da[i], a[i].data(), sizeof(double));
+    }
+  } else {
+    rosetta::convert::from_double_str(a, da);
+  }
+  convert_double_to_mpctype(da, sa, context_->FLOAT_PRECISION);
+  if (party_ != PARTY_A)
+    std::fill(sa.begin(), sa.end(), 0);
+  return 0;
+}
+
+int Ot2pcOpsImpl::Encode(const vector<mpc_t>& sa, vector<string>& a) {
+  return rosetta::convert::encoder::encode_to_secure(sa, a);
+}
+
+bool Ot2pcOpsImpl::IsConst(const vector<string>& a, const attr_type* attr, const char* tag) const {
+  if (GET_ATTR_TAG(attr, tag))
+    return true;
+  return !a.empty() && !rosetta::convert::is_secure_text(a[0]);
+}
+
+void Ot2pcOpsImpl::Truncate(vector<mpc_t>& a) const {
+  // SecureML local truncation, off by at most one LSB with overwhelming probability
+  int power = context_->FLOAT_PRECISION;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (party_ == PARTY_A)
+      a[i] = static_cast<mpc_t>(static_cast<signed_mpc_t>(a[i]) >> power);
+    else
+      a[i] = -static_cast<mpc_t>(static_cast<signed_mpc_t>(-a[i]) >> power);
+  }
+}
+
+void Ot2pcOpsImpl::Open(
+  const vector<mpc_t>& e,
+  const vector<mpc_t>& f,
+  vector<mpc_t>& E,
+  vector<mpc_t>& F) {
+  int peer = 1 - party_;
+  vector<mpc_t> mine(e), theirs(e.size() + f.size());
+  mine.insert(mine.end(), f.begin(), f.end());
+  net_io_->send(peer, mine, mine.size(), msg_id());
+  net_io_->recv(peer, theirs, theirs.size(), msg_id());
+
+  E.resize(e.size());
+  F.resize(f.size());
+  for (size_t i = 0; i < e.size(); ++i)
+    E[i] = mine[i] + theirs[i];
+  for (size_t i = 0; i < f.size(); ++i)
+    F[i] = mine[e.size() + i] + theirs[e.size() + i];
+}
+
+void Ot2pcOpsImpl::BeaverMul(const vector<mpc_t>& x, const vector<mpc_t>& y, vector<mpc_t>& z) {
+  // z = w + e * v + u * f + e * f, with e = x - u and f = y - v opened
+  size_t size = x.size();
+  vector<mpc_t> u, v, w, e(size), f(size), E, F;
+  Triples().Beaver(size, u, v, w);
+  for (size_t i = 0; i < size; ++i) {
+    e[i] = x[i] - u[i];
+    f[i] = y[i] - v[i];
+  }
+  Open(e, f, E, F);
+  z.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    z[i] = w[i] + E[i] * v[i] + u[i] * F[i];
+    if (party_ == PARTY_A)
+      z[i] += E[i] * F[i];
+  }
+}
+
+int Ot2pcOpsImpl::DReLU(const vector<mpc_t>& x, vector<mpc_t>& y) {
+  if (!context_->GC_COMPARE) {
+    log_error << "OT2PC: no garbled-circuit comparison set up";
+    return -1;
+  }
+  return context_->GC_COMPARE->DReLU(msg_id(), x, y, context_->FLOAT_PRECISION);
+}
+
+int Ot2pcOpsImpl::Compare(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info,
+  bool swap,
+  bool negate) {
+  ot2pc_check_party();
+  vector<mpc_t> sa, sb, d, c;
+  if (0 != Decode(a, sa, IsConst(a, attr_info, "lh_is_const")) ||
+      0 != Decode(b, sb, IsConst(b, attr_info, "rh_is_const"))) {
+    log_error << "OT2PC decode failed! In " << __FUNCTION__;
+    return -1;
+  }
+  if (sb.size() == 1 && sa.size() > 1)
+    sb.resize(sa.size(), sb[0]);
+
+  // (lhs >= rhs) of the, maybe swapped, operands, or its complement
+  d.resize(sa.size());
+  for (size_t i = 0; i < sa.size(); ++i)
+    d[i] = swap ? sb[i] - sa[i] : sa[i] - sb[i];
+  if (0 != DReLU(d, c))
+    return -1;
+  if (negate) {
+    mpc_t one = party_ == PARTY_A ? (mpc_t(1) << context_->FLOAT_PRECISION) : 0;
+    for (size_t i = 0; i < c.size(); ++i)
+      c[i] = one - c[i];
+  }
+  ot2pc_encode(c, output);
+  return 0;
+}
+
+ot2pc::TripleGenerator& Ot2pcOpsImpl::Triples() {
+  if (!triples_) {
+    uint64_t epoch = state_->NextEpoch(msg_id());
+    triples_.reset(new ot2pc::TripleGenerator(net_io_, state_->keys, msg_id(), epoch));
+  }
+  return *triples_;
+}
+
+int Ot2pcOpsImpl::TfToSecure(
+  const vector<string>& in,
+  vector<string>& out,
+  const attr_type* attr_info) {
+  vector<mpc_t> sa;
+  ot2pc_decode(in, sa);
+  ot2pc_encode(sa, out);
+  return 0;
+}
+
+int Ot2pcOpsImpl::SecureToTf(
+  const vector<string>& in,
+  vector<string>& out,
+  const attr_type* attr_info) {
+  vector<mpc_t> sa;
+  vector<double> da;
+  ot2pc_decode(in, sa);
+  convert_mpctype_to_double(sa, da, context_->FLOAT_PRECISION);
+  rosetta::convert::to_binary_str<double>(da, out);
+  return 0;
+}
+
+int Ot2pcOpsImpl::RandSeed(std::string op_seed, string& out_str) {
+  std::random_device rd;
+  mpc_t seed = ((mpc_t)rd() << 32) | rd();
+  rosetta::convert::to_binary_str(seed, out_str);
+  return 0;
+}
+
+int Ot2pcOpsImpl::PrivateInput(
+  const string& node_id,
+  const vector<double>& in_x,
+  vector<string>& out_x) {
+  tlog_debug << "----> OT2PC PrivateInput from " << node_id;
+  ot2pc_check_party();
+  int owner = net_io_->GetPartyId(node_id);
+  if (owner != PARTY_A && owner != PARTY_B) {
+    log_error << "OT2PC PrivateInput: " << node_id << " is neither P0 nor P1";
+    return -1;
+  }
+
+  // the owner keeps x - r and hands r to the peer
+  size_t size = in_x.size();
+  vector<mpc_t> sa(size);
+  if (owner == party_) {
+    vector<mpc_t> r(size);
+    emp::PRG prg;
+    prg.random_data(r.data(), size * sizeof(mpc_t));
+    convert_double_to_mpctype(in_x, sa, context_->FLOAT_PRECISION);
+    for (size_t i = 0; i < size; ++i)
+      sa[i] -= r[i];
+    net_io_->send(1 - party_, r, size, msg_id());
+  } else {
+    net_io_->recv(owner, sa, size, msg_id());
+  }
+  ot2pc_encode(sa, out_x);
+  return 0;
+}
+
+int Ot2pcOpsImpl::PublicInput(
+  const string& node_id,
+  const vector<double>& in_x,
+  vector<string>& out_x) {
+  convert_double_to_literal_str(in_x, out_x, context_->FLOAT_PRECISION);
+  return 0;
+}
+
+int Ot2pcOpsImpl::Broadcast(const string& from_node, const string& msg, string& result) {
+  result.resize(msg.size());
+  return Broadcast(from_node, msg.data(), &result[0], msg.size());
+}
+
+int Ot2pcOpsImpl::Broadcast(
+  const string& from_node,
+  const char* msg,
+  char* result,
+  size_t size) {
+  const string& me = net_io_->GetCurrentNodeId();
+  if (from_node == me) {
+    for (auto& node : net_io_->GetComputationNodes()) {
+      if (node.first != me)
+        net_io_->send(node.first, msg, size, msg_id());
+    }
+    memcpy(result, msg, size);
+  } else {
+    net_io_->recv(from_node, result, size, msg_id());
+  }
+  return 0;
+}
+
+int Ot2pcOpsImpl::Add(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> OT2PC Add";
+  vector<mpc_t> sa, sb;
+  ot2pc_decode(a, sa);
+  ot2pc_decode(b, sb);
+  for (size_t i = 0; i < sa.size(); ++i)
+    sa[i] += sb[i];
+  ot2pc_encode(sa, output);
+  return 0;
+}
+
+int Ot2pcOpsImpl::Sub(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> OT2PC Sub";
+  vector<mpc_t> sa, sb;
+  ot2pc_decode(a, sa);
+  ot2pc_decode(b, sb);
+  for (size_t i = 0; i < sa.size(); ++i)
+    sa[i] -= sb[i];
+  ot2pc_encode(sa, output);
+  return 0;
+}
+
+int Ot2pcOpsImpl::Negative(const vector<string>& a, vector<string>& output, const attr_type* attr_info) {
+  tlog_debug << "----> OT2PC Negative";
+  vector<mpc_t> sa;
+  ot2pc_decode(a, sa);
+  for (size_t i = 0; i < sa.size(); ++i)
+    sa[i] = -sa[i];
+  ot2pc_encode(sa, output);
+  return 0;
+}
+
+int Ot2pcOpsImpl::Mul(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> OT2PC Mul";
+  ot2pc_check_party();
+  bool a_const = IsConst(a, attr_info, "lh_is_const");
+  bool b_const = IsConst(b, attr_info, "rh_is_const");
+  size_t size = a.size();
+  vector<mpc_t> sa, sb, sc(size);
+
+  if (a_const || b_const) {
+    // a share times a public constant is local
+    vector<double> da, db;
+    if (a_const) {
+      rosetta::convert::from_double_str(a, da);
+      convert_double_to_mpctype(da, sa, context_->FLOAT_PRECISION);
+    } else {
+      ot2pc_decode(a, sa);
+    }
+    if (b_const && !a_const) {
+      rosetta::convert::from_double_str(b, db);
+      convert_double_to_mpctype(db, sb, context_->FLOAT_PRECISION);
+    } else {
+      ot2pc_decode(b, sb);
+    }
+    for (size_t i = 0; i < size; ++i)
+      sc[i] = sa[i] * sb[i];
+  } else {
+    ot2pc_decode(a, sa);
+    ot2pc_decode(b, sb);
+    BeaverMul(sa, sb, sc);
+  }
+  Truncate(sc);
+  ot2pc_encode(sc, output);
+  tlog_debug << "OT2PC Mul ok. <----";
+  return 0;
+}
+
+int Ot2pcOpsImpl::Square(const vector<string>& a, vector<string>& output, const attr_type* attr_info) {
+  tlog_debug << "----> OT2PC Square";
+  return Mul(a, a, output, attr_info);
+}
+
+int Ot2pcOpsImpl::Matmul(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> OT2PC Matmul";
+  ot2pc_check_party();
+  if (!(attr_info && attr_info->count("m") > 0 && attr_info->count("n") > 0 && attr_info->count("k") > 0)) {
+    log_error << "please fill m, k, n for OT2PC Matmul(x, y, m, n, k, transpose_a, transpose_b) ";
+    return -1;
+  }
+  size_t m = std::stoull(attr_info->at("m"));
+  size_t k = std::stoull(attr_info->at("k"));
+  size_t n = std::stoull(attr_info->at("n"));
+  bool transpose_a = GET_ATTR_TAG(attr_info, "transpose_a");
+  bool transpose_b = GET_ATTR_TAG(attr_info, "transpose_b");
+
+  // transposing a share is local, so both inputs are made row-major first
+  vector<mpc_t> ta, tb, sa(m * k), sb(k * n);
+  ot2pc_decode(a, ta);
+  ot2pc_decode(b, tb);
+  for (size_t i = 0; i < m; ++i)
+    for (size_t kk = 0; kk < k; ++kk)
+      sa[i * k + kk] = transpose_a ? ta[kk * m + i] : ta[i * k + kk];
+  for (size_t kk = 0; kk < k; ++kk)
+    for (size_t j = 0; j < n; ++j)
+      sb[kk * n + j] = transpose_b ? tb[j * k + kk] : tb[kk * n + j];
+
+  vector<mpc_t> U, V, W, e(m * k), f(k * n), E, F;
+  Triples().MatMul(m, k, n, U, V, W);
+  for (size_t i = 0; i < m * k; ++i)
+    e[i] = sa[i] - U[i];
+  for (size_t i = 0; i < k * n; ++i)
+    f[i] = sb[i] - V[i];
+  Open(e, f, E, F);
+
+  // Z = W + E * V + U * F (+ E * F on P0)
+  vector<mpc_t> sc(W);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t kk = 0; kk < k; ++kk) {
+      mpc_t e_ik = E[i * k + kk];
+      mpc_t u_ik = U[i * k + kk];
+      mpc_t ef_ik = party_ == PARTY_A ? e_ik : 0;
+      for (size_t j = 0; j < n; ++j)
+        sc[i * n + j] += e_ik * V[kk * n + j] + (u_ik + ef_ik) * F[kk * n + j];
+    }
+  }
+  Truncate(sc);
+  ot2pc_encode(sc, output);
+  tlog_debug << "OT2PC Matmul ok. <----";
+  return 0;
+}
+
+int Ot2pcOpsImpl::Less(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> OT2PC Less";
+  return Compare(a, b, output, attr_info, false, true);
+}
+
+int Ot2pcOpsImpl::LessEqual(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> OT2PC LessEqual";
+  return Compare(a, b, output, attr_info, true, false);
+}
+
+int Ot2pcOpsImpl::Greater(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> OT2PC Greater";
+  return Compare(a, b, output, attr_info, true, true);
+}
+
+int Ot2pcOpsImpl::GreaterEqual(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> OT2PC GreaterEqual";
+  return Compare(a, b, output, attr_info, false, false);
+}
+
+int Ot2pcOpsImpl::ReluPrime(const vector<string>& a, vector<string>& output, const attr_type* attr_info) {
+  tlog_debug << "----> OT2PC ReluPrime";
+  ot2pc_check_party();
+  vector<mpc_t> sa, sb;
+  ot2pc_decode(a, sa);
+  if (0 != DReLU(sa, sb))
+    return -1;
+  ot2pc_encode(sb, output);
+  return 0;
+}
+
+int Ot2pcOpsImpl::Relu(const vector<string>& a, vector<string>& output, const attr_type* attr_info) {
+  tlog_debug << "----> OT2PC Relu";
+  ot2pc_check_party();
+  vector<mpc_t> sa, sb, sc;
+  ot2pc_decode(a, sa);
+  if (0 != DReLU(sa, sb))
+    return -1;
+  BeaverMul(sa, sb, sc);
+  Truncate(sc);
+  ot2pc_encode(sc, output);
+  tlog_debug << "OT2PC Relu ok. <----";
+  return 0;
+}
+
+int Ot2pcOpsImpl::Reveal(
+  const vector<string>& a,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  vector<double> dvalues;
+  int ret = Reveal(a, dvalues, attr_info);
+  output.resize(dvalues.size());
+  for (size_t i = 0; i < dvalues.size(); ++i) {
+    output[i] = std::to_string(dvalues[i]);
+  }
+  return ret;
+}
+
+int Ot2pcOpsImpl::Reveal(
+  const vector<string>& a,
+  vector<double>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> OT2PC Reveal";
+  string parties = attr_info ? attr_info->at("receive_parties") : "";
+  vector<string> result_nodes = net_io_->GetResultNodes();
+  vector<string> nodes = decode_reveal_nodes(parties, net_io_->GetParty2Node(), result_nodes);
+
+  size_t size = a.size();
+  vector<mpc_t> sa(size, 0), out(size, 0);
+  const string& me = net_io_->GetCurrentNodeId();
+  bool holds_share = party_ == PARTY_A || party_ == PARTY_B;
+  if (holds_share) {
+    ot2pc_decode(a, sa);
+    for (auto& node : nodes) {
+      if (node != me)
+        net_io_->send(node, sa, size, msg_id());
+    }
+  }
+
+  if (std::find(nodes.begin(), nodes.end(), me) != nodes.end()) {
+    out = sa;
+    vector<mpc_t> other(size);
+    for (int p = PARTY_A; p <= PARTY_B; ++p) {
+      if (p == party_)
+        continue;
+      net_io_->recv(net_io_->GetNodeId(p), other, size, msg_id());
+      for (size_t i = 0; i < size; ++i)
+        out[i] += other[i];
+    }
+  }
+
+  convert_mpctype_to_double(out, output, context_->FLOAT_PRECISION);
+  tlog_debug << "OT2PC Reveal ok. <----";
+  return 0;
+}
+
+} // namespace rosetta
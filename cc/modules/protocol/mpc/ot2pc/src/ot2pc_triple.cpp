@@ -0,0 +1,242 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_triple.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+using namespace std;
+using namespace emp;
+
+namespace rosetta {
+namespace ot2pc {
+
+// Gilboa messages of one COT batch, in ring elements
+static const size_t kMaxChunkElements = 1 << 20;
+
+void BaseOtKeys::Setup(shared_ptr<NET_IO> net_io, const string& msgid_tag) {
+  int party = net_io->GetCurrentPartyId();
+  Ot2pcNetIO io(net_io, msgid_tag);
+  OTCO<Ot2pcNetIO> base_ot(&io);
+  PRG prg;
+
+  // P0 runs the base OTs of its COT receiver side first, P1 the other side
+  auto as_sender = [&]() {
+    prg.random_block(k0, 128);
+    prg.random_block(k1, 128);
+    base_ot.send(k0, k1, 128);
+  };
+  auto as_receiver = [&]() {
+    prg.random_bool(s, 128);
+    // lsb(Delta) = 1, the point-and-permute bit of the garbled circuits
+    s[0] = true;
+    base_ot.recv(k_s, s, 128);
+  };
+  if (party == PARTY_A) {
+    as_sender();
+    as_receiver();
+  } else {
+    as_receiver();
+    as_sender();
+  }
+}
+
+TripleGenerator::TripleGenerator(
+  shared_ptr<NET_IO> net_io,
+  const BaseOtKeys& keys,
+  const msg_id_t& msgid,
+  uint64_t epoch) {
+  party_ = net_io->GetCurrentPartyId();
+  int peer = 1 - party_;
+  string tag = msgid.str() + "-" + to_string(epoch);
+  send_io_.reset(new Ot2pcNetIO(net_io, tag + "-cot-P" + to_string(party_)));
+  recv_io_.reset(new Ot2pcNetIO(net_io, tag + "-cot-P" + to_string(peer)));
+
+  // fresh IKNP seeds for this (msgid, epoch), so that no PRG stream is ever reused
+  block tweak = makeBlock(msgid.to_uint64(), epoch);
+  block k_s[128], k0[128], k1[128];
+  for (int i = 0; i < 128; ++i) {
+    k_s[i] = ccrh_.H(keys.k_s[i] ^ tweak);
+    k0[i] = ccrh_.H(keys.k0[i] ^ tweak);
+    k1[i] = ccrh_.H(keys.k1[i] ^ tweak);
+  }
+  send_ot_.reset(new IKNP<Ot2pcNetIO>(send_io_.get()));
+  send_ot_->setup_send(keys.s, k_s);
+  recv_ot_.reset(new IKNP<Ot2pcNetIO>(recv_io_.get()));
+  recv_ot_->setup_recv(k0, k1);
+}
+
+TripleGenerator::~TripleGenerator() {
+  send_ot_.reset();
+  recv_ot_.reset();
+}
+
+void TripleGenerator::Expand(const block& seed, size_t len, mpc_t* out) {
+  if (len * sizeof(mpc_t) <= sizeof(block)) {
+    memcpy(out, &seed, len * sizeof(mpc_t));
+    return;
+  }
+  PRG prg(&seed);
+  prg.random_data(out, len * sizeof(mpc_t));
+}
+
+void TripleGenerator::GilboaSend(
+  size_t L,
+  size_t len,
+  const std::function<const mpc_t*(size_t)>& get_x,
+  const std::function<void(size_t, const mpc_t*)>& put_share,
+  size_t bits) {
+  size_t chunk = std::max<size_t>(1, kMaxChunkElements / (bits * len));
+  vector<block> K;
+  vector<mpc_t> d, r0(len), r1(len), share(len);
+  for (size_t beg = 0; beg < L; beg += chunk) {
+    size_t cL = std::min(chunk, L - beg);
+    size_t cots = cL * bits;
+    K.resize(cots);
+    d.resize(cots * len);
+    send_ot_->send_cot(K.data(), cots);
+
+    for (size_t l = 0; l < cL; ++l) {
+      const mpc_t* x = get_x(beg + l);
+      std::fill(share.begin(), share.end(), 0);
+      for (size_t i = 0; i < bits; ++i) {
+        size_t t = l * bits + i;
+        block tweak = makeBlock(0, send_ctr_ + t);
+        Expand(ccrh_.H(K[t] ^ tweak), len, r0.data());
+        Expand(ccrh_.H(K[t] ^ send_ot_->Delta ^ tweak), len, r1.data());
+        mpc_t* dt = d.data() + t * len;
+        for (size_t e = 0; e < len; ++e) {
+          dt[e] = r0[e] - r1[e] + (x[e] << i);
+          share[e] -= r0[e];
+        }
+      }
+      put_share(beg + l, share.data());
+    }
+    send_io_->send_data(d.data(), d.size() * sizeof(mpc_t));
+    send_ctr_ += cots;
+  }
+  send_io_->flush();
+}
+
+void TripleGenerator::GilboaRecv(
+  size_t L,
+  size_t len,
+  const std::function<mpc_t(size_t)>& get_y,
+  const std::function<void(size_t, const mpc_t*)>& put_share,
+  size_t bits) {
+  size_t chunk = std::max<size_t>(1, kMaxChunkElements / (bits * len));
+  vector<block> M;
+  vector<mpc_t> d, r(len), share(len);
+  std::unique_ptr<bool[]> choices(new bool[chunk * bits]);
+  for (size_t beg = 0; beg < L; beg += chunk) {
+    size_t cL = std::min(chunk, L - beg);
+    size_t cots = cL * bits;
+    for (size_t l = 0; l < cL; ++l) {
+      mpc_t y = get_y(beg + l);
+      for (size_t i = 0; i < bits; ++i)
+        choices[l * bits + i] = (y >> i) & 1;
+    }
+    M.resize(cots);
+    d.resize(cots * len);
+    recv_ot_->recv_cot(M.data(), choices.get(), cots);
+    recv_io_->recv_data(d.data(), d.size() * sizeof(mpc_t));
+
+    for (size_t l = 0; l < cL; ++l) {
+      std::fill(share.begin(), share.end(), 0);
+      for (size_t i = 0; i < bits; ++i) {
+        size_t t = l * bits + i;
+        Expand(ccrh_.H(M[t] ^ makeBlock(0, recv_ctr_ + t)), len, r.data());
+        const mpc_t* dt = d.data() + t * len;
+        bool bit = choices[t];
+        for (size_t e = 0; e < len; ++e)
+          share[e] += bit ? r[e] + dt[e] : r[e];
+      }
+      put_share(beg + l, share.data());
+    }
+    recv_ctr_ += cots;
+  }
+}
+
+void TripleGenerator::Beaver(size_t size, vector<mpc_t>& a, vector<mpc_t>& b, vector<mpc_t>& c) {
+  a.resize(size);
+  b.resize(size);
+  c.resize(size);
+  prg_.random_data(a.data(), size * sizeof(mpc_t));
+  prg_.random_data(b.data(), size * sizeof(mpc_t));
+  for (size_t i = 0; i < size; ++i)
+    c[i] = a[i] * b[i];
+
+  // c += <a_me * b_peer> + <a_peer * b_me>
+  vector<mpc_t> cs(size), cr(size);
+  std::thread sender([&]() {
+    GilboaSend(
+      size, 1, [&](size_t l) { return &a[l]; },
+      [&](size_t l, const mpc_t* s) { cs[l] = s[0]; });
+  });
+  GilboaRecv(
+    size, 1, [&](size_t l) { return b[l]; }, [&](size_t l, const mpc_t* s) { cr[l] = s[0]; });
+  sender.join();
+
+  for (size_t i = 0; i < size; ++i)
+    c[i] += cs[i] + cr[i];
+}
+
+void TripleGenerator::MatMul(
+  size_t m,
+  size_t k,
+  size_t n,
+  vector<mpc_t>& A,
+  vector<mpc_t>& B,
+  vector<mpc_t>& C) {
+  A.resize(m * k);
+  B.resize(k * n);
+  prg_.random_data(A.data(), A.size() * sizeof(mpc_t));
+  prg_.random_data(B.data(), B.size() * sizeof(mpc_t));
+  C.assign(m * n, 0);
+  for (size_t i = 0; i < m; ++i)
+    for (size_t kk = 0; kk < k; ++kk)
+      for (size_t j = 0; j < n; ++j)
+        C[i * n + j] += A[i * k + kk] * B[kk * n + j];
+
+  // instance l = (kk, j) multiplies the column A[:, kk] by B[kk][j], into C[:, j]
+  vector<mpc_t> At(k * m), Cs(m * n, 0), Cr(m * n, 0);
+  for (size_t i = 0; i < m; ++i)
+    for (size_t kk = 0; kk < k; ++kk)
+      At[kk * m + i] = A[i * k + kk];
+  auto put = [&](vector<mpc_t>& acc) {
+    return [&acc, m, n](size_t l, const mpc_t* s) {
+      size_t j = l % n;
+      for (size_t i = 0; i < m; ++i)
+        acc[i * n + j] += s[i];
+    };
+  };
+
+  std::thread sender([&]() {
+    GilboaSend(k * n, m, [&](size_t l) { return &At[(l / n) * m]; }, put(Cs));
+  });
+  GilboaRecv(k * n, m, [&](size_t l) { return B[l]; }, put(Cr));
+  sender.join();
+
+  for (size_t i = 0; i < m * n; ++i)
+    C[i] += Cs[i] + Cr[i];
+}
+
+} // namespace ot2pc
+} // namespace rosetta
@@ -0,0 +1,221 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/utility/include/_test_common.h"
+#include "cc/modules/protocol/utility/include/version_compat_utils.h"
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_impl.h"
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_ops_impl.h"
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_gc.h"
+#include "cc/modules/iowrapper/include/io_manager.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_helper.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <chrono>
+
+using namespace rosetta;
+
+/**
+ * Throughput of the OT2PC triples on loopback.
+ *
+ * P0 and P1 make element-wise and matmul triples of a few sizes, check them
+ * by opening, and print triples/s and the bytes each party sent. Then the same
+ * for the garbled-circuit DReLU. P2 of the config only connects. At the end
+ * Mul, Matmul, Relu and Less go through the ops.
+ *
+ * usage: protocol_mpc_ot2pc_tests_ot2pc_triple_bench
+ */
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point beg) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+}
+
+// opens the shares of a, b and c, and counts the wrong products
+size_t check_open(
+  shared_ptr<NET_IO> net_io,
+  const msg_id_t& msgid,
+  const vector<mpc_t>& a,
+  const vector<mpc_t>& b,
+  const vector<mpc_t>& c,
+  const std::function<vector<mpc_t>(const vector<mpc_t>&, const vector<mpc_t>&)>& mul) {
+  int peer = 1 - net_io->GetCurrentPartyId();
+  vector<mpc_t> mine(a), theirs(a.size() + b.size() + c.size());
+  mine.insert(mine.end(), b.begin(), b.end());
+  mine.insert(mine.end(), c.begin(), c.end());
+  net_io->send(peer, mine, mine.size(), msgid);
+  net_io->recv(peer, theirs, theirs.size(), msgid);
+
+  vector<mpc_t> A(a.size()), B(b.size()), C(c.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    A[i] = a[i] + theirs[i];
+  for (size_t i = 0; i < b.size(); ++i)
+    B[i] = b[i] + theirs[a.size() + i];
+  for (size_t i = 0; i < c.size(); ++i)
+    C[i] = c[i] + theirs[a.size() + b.size() + i];
+
+  vector<mpc_t> want = mul(A, B);
+  size_t errors = 0;
+  for (size_t i = 0; i < C.size(); ++i)
+    errors += want[i] != C[i];
+  return errors;
+}
+
+void bench_beaver(shared_ptr<NET_IO> net_io, shared_ptr<Ot2pcState> state, size_t size) {
+  msg_id_t msgid("ot2pc bench beaver " + to_string(size));
+  vector<mpc_t> a, b, c;
+  auto beg = std::chrono::steady_clock::now();
+  ot2pc::TripleGenerator gen(net_io, state->keys, msgid, 0);
+  gen.Beaver(size, a, b, c);
+  double elapsed = seconds_since(beg);
+
+  size_t errors = check_open(net_io, msgid, a, b, c, [](const vector<mpc_t>& A, const vector<mpc_t>& B) {
+    vector<mpc_t> C(A.size());
+    for (size_t i = 0; i < A.size(); ++i)
+      C[i] = A[i] * B[i];
+    return C;
+  });
+  cout << "P" << net_io->GetCurrentPartyId() << " beaver " << size << ": " << elapsed << " s, "
+       << size / elapsed << " triples/s, " << gen.BytesSent() / 1048576.0 << " MB sent, errors: " << errors
+       << endl;
+}
+
+void bench_matmul(shared_ptr<NET_IO> net_io, shared_ptr<Ot2pcState> state, size_t m, size_t k, size_t n) {
+  string shape = to_string(m) + "x" + to_string(k) + "x" + to_string(n);
+  msg_id_t msgid("ot2pc bench matmul " + shape);
+  vector<mpc_t> A, B, C;
+  auto beg = std::chrono::steady_clock::now();
+  ot2pc::TripleGenerator gen(net_io, state->keys, msgid, 0);
+  gen.MatMul(m, k, n, A, B, C);
+  double elapsed = seconds_since(beg);
+
+  size_t errors = check_open(net_io, msgid, A, B, C, [&](const vector<mpc_t>& X, const vector<mpc_t>& Y) {
+    vector<mpc_t> Z(m * n, 0);
+    for (size_t i = 0; i < m; ++i)
+      for (size_t kk = 0; kk < k; ++kk)
+        for (size_t j = 0; j < n; ++j)
+          Z[i * n + j] += X[i * k + kk] * Y[kk * n + j];
+    return Z;
+  });
+  cout << "P" << net_io->GetCurrentPartyId() << " matmul " << shape << ": " << elapsed << " s, "
+       << 1 / elapsed << " triples/s (" << m * k * n / elapsed << " mults/s), "
+       << gen.BytesSent() / 1048576.0 << " MB sent, errors: " << errors << endl;
+}
+
+void bench_drelu(shared_ptr<NET_IO> net_io, shared_ptr<Ot2pcState> state, size_t size) {
+  msg_id_t msgid("ot2pc bench drelu " + to_string(size));
+  const int fp = FLOAT_PRECISION_DEFAULT;
+  int party = net_io->GetCurrentPartyId();
+
+  // x = x0 + x1 with |x| < 2^40, P0 draws both and hands x1 over
+  vector<mpc_t> x(size), x1(size), y;
+  emp::PRG prg;
+  if (party == PARTY_A) {
+    prg.random_data(x.data(), size * sizeof(mpc_t));
+    prg.random_data(x1.data(), size * sizeof(mpc_t));
+    for (size_t i = 0; i < size; ++i)
+      x[i] = static_cast<mpc_t>(static_cast<signed_mpc_t>(x[i]) >> 24) - x1[i];
+    net_io->send(PARTY_B, x1, size, msgid);
+  } else {
+    net_io->recv(PARTY_A, x, size, msgid);
+  }
+
+  ot2pc::GcCompare gc(net_io, state);
+  auto beg = std::chrono::steady_clock::now();
+  gc.DReLU(msgid, x, y, fp);
+  double elapsed = seconds_since(beg);
+
+  size_t errors = check_open(net_io, msgid, x, vector<mpc_t>(), y, [&](const vector<mpc_t>& X, const vector<mpc_t>&) {
+    vector<mpc_t> Y(X.size());
+    for (size_t i = 0; i < X.size(); ++i)
+      Y[i] = static_cast<signed_mpc_t>(X[i]) >= 0 ? (mpc_t(1) << fp) : 0;
+    return Y;
+  });
+  cout << "P" << party << " drelu " << size << ": " << elapsed << " s, " << size / elapsed
+       << " cmps/s, errors: " << errors << endl;
+}
+
+void check_ops(Ot2pcProtocol* proto, const string& node_id_0, const string& node_id_1) {
+  auto ops = proto->GetOps(msg_id_t("ot2pc bench ops"));
+  vector<double> x = {-1.5, 0.25, 2.0, 3.0}, y = {2.0, -4.0, 0.5, 1.0};
+  vector<string> sx, sy, sz, sm;
+  ops->PrivateInput(node_id_0, x, sx);
+  ops->PrivateInput(node_id_1, y, sy);
+  ops->Mul(sx, sy, sz);
+
+  attr_type mm_attr;
+  mm_attr["m"] = "2";
+  mm_attr["k"] = "2";
+  mm_attr["n"] = "2";
+  ops->Matmul(sx, sy, sm, &mm_attr);
+
+  vector<string> sr, sl;
+  ops->Relu(sx, sr);
+  ops->Less(sx, sy, sl);
+
+  attr_type reveal_attr;
+  reveal_attr["receive_parties"] = encode_reveal_node(node_id_0);
+  vector<double> z, mm, r, l;
+  ops->Reveal(sz, z, &reveal_attr);
+  ops->Reveal(sm, mm, &reveal_attr);
+  ops->Reveal(sr, r, &reveal_attr);
+  ops->Reveal(sl, l, &reveal_attr);
+  if (proto->GetNetHandler()->GetCurrentNodeId() == node_id_0) {
+    cout << "Mul:    " << z[0] << " " << z[1] << " " << z[2] << " " << z[3]
+         << " (expected -3 -1 1 3)" << endl;
+    cout << "Matmul: " << mm[0] << " " << mm[1] << " " << mm[2] << " " << mm[3]
+         << " (expected -2.875 6.25 5.5 -5)" << endl;
+    cout << "Relu:   " << r[0] << " " << r[1] << " " << r[2] << " " << r[3]
+         << " (expected 0 0.25 2 3)" << endl;
+    cout << "Less:   " << l[0] << " " << l[1] << " " << l[2] << " " << l[3]
+         << " (expected 1 0 0 0)" << endl;
+  }
+}
+
+} // namespace
+
+static void run(int partyid) {
+  string logfile = "log/mpc_ot2pc_triple_bench-" + to_string(partyid);
+  Logger::Get().log_to_stdout(false);
+  Logger::Get().set_filename(logfile + "-backend.log");
+  string node_id, config_json;
+  rosetta_old_conf_parse(node_id, config_json, partyid, "CONFIG.json");
+  IOManager::Instance()->CreateChannel("", node_id, config_json);
+
+  Ot2pcProtocol* proto = new Ot2pcProtocol();
+  proto->Init(logfile + "-console.log");
+  shared_ptr<NET_IO> net_io = proto->GetNetHandler();
+  string node_id_0 = net_io->GetNodeId(0);
+  string node_id_1 = net_io->GetNodeId(1);
+
+  if (partyid == PARTY_A || partyid == PARTY_B) {
+    auto state = proto->GetState();
+    for (size_t size : {1 << 10, 1 << 14, 1 << 17})
+      bench_beaver(net_io, state, size);
+    bench_matmul(net_io, state, 16, 16, 16);
+    bench_matmul(net_io, state, 64, 64, 64);
+    bench_matmul(net_io, state, 128, 256, 1);
+    for (size_t size : {1 << 10, 1 << 14, 1 << 16})
+      bench_drelu(net_io, state, size);
+    check_ops(proto, node_id_0, node_id_1);
+  }
+
+  proto->Uninit();
+  delete proto;
+}
+
+RUN_MPC_TEST(run);
@@ -0,0 +1,53 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+#include "cc/modules/protocol/mpc/comm/include/mpc_protocol.h"
+
+namespace rosetta {
+
+/**
+ * PlainFixpoint is a single-process, INSECURE reference backend.
+ *
+ * It keeps every value as the plaintext ring element (mpc_t) that the
+ * shares of a real MPC backend would reconstruct to, and runs the same
+ * fixed-point pipeline as SecureNN: FLOAT_PRECISION encoding, truncation
+ * after each multiplication and the approximation polynomials registered
+ * in PolyConfFactory. No network is needed, so it can be used to debug
+ * numerical issues and to diff intermediate tensors against a real run.
+ */
+class PlainFixpointProtocol : public MpcProtocol {
+ public:
+  PlainFixpointProtocol(const string& task_id="") : MpcProtocol("PlainFixpoint", 1, task_id) {}
+
+  int Init() { return Init(""); }
+  int Init(std::string logfile);
+  int Uninit();
+
+  shared_ptr<ProtocolOps> GetOps(const msg_id_t& msgid);
+  PerfStats GetPerfStats();
+};
+
+class PlainFixpointProtocolFactory : public IProtocolFactory {
+ public:
+  PlainFixpointProtocolFactory() {}
+
+ public:
+  shared_ptr<ProtocolBase> Create(const string& task_id="") { return std::make_shared<PlainFixpointProtocol>(task_id); }
+};
+
+} // namespace rosetta
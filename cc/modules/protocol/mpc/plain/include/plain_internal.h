@@ -0,0 +1,193 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+#include "cc/modules/protocol/mpc/comm/include/mpc_common.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace rosetta {
+namespace plain {
+
+using std::string;
+using std::vector;
+
+/**
+ * @brief Plaintext fixed-point kernels of the PlainFixpoint backend.
+ *
+ * Every input/output is the reconstructed ring value, in Z_{2^L}, of what
+ * SecureNN would hold as shares. Each routine follows the sequence of
+ * local operations and truncations of its SnnInternal counterpart, with
+ * the two-party truncation replaced by an exact arithmetic shift.
+ */
+class PlainInternal {
+ public:
+  explicit PlainInternal(int float_precision) : float_precision_(float_precision) {}
+
+  mpc_t One() const { return FloatToMpcType(1, float_precision_); }
+  mpc_t Encode(double a) const { return FloatToMpcType(a, float_precision_); }
+  double Decode(mpc_t a) const { return MpcTypeToFloat(a, float_precision_); }
+  void Encode(const vector<double>& a, vector<mpc_t>& b) const;
+  void Encode(const vector<string>& a, vector<mpc_t>& b) const;
+  void Decode(const vector<mpc_t>& a, vector<double>& b) const;
+
+  mpc_t Truncate(mpc_t a, size_t power) const {
+    return static_cast<mpc_t>(static_cast<signed_mpc_t>(a) >> power);
+  }
+  mpc_t Truncate(mpc_t a) const { return Truncate(a, float_precision_); }
+  // 1.0 if a >= 0 else 0, in fixed-point
+  mpc_t ReluPrime(mpc_t a) const { return static_cast<signed_mpc_t>(a) >= 0 ? One() : 0; }
+
+  //////////////////////////////////    math ops   //////////////////////////////////
+  void Add(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c);
+  void Sub(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c);
+  void Negative(const vector<mpc_t>& a, vector<mpc_t>& b);
+  void Mul(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c);
+  void Mul(const vector<mpc_t>& a, double const_b, vector<mpc_t>& c);
+  void Square(const vector<mpc_t>& a, vector<mpc_t>& c);
+  // secret numerator and public denominator, via scaled reciprocal
+  void Division(const vector<mpc_t>& a, const vector<double>& b, vector<mpc_t>& c);
+  // bit-wise long division, sign(a/b) * floor(|a| * 2^f / |b|)
+  void Division(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c);
+  void Floordivision(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c);
+  void Floordiv(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) { Floordivision(a, b, c); }
+  void Pow(const vector<mpc_t>& a, const vector<int64_t>& n, vector<mpc_t>& c);
+  void PowConst(const vector<mpc_t>& a, int64_t k, vector<mpc_t>& c);
+  void MatMul(
+    const vector<mpc_t>& a,
+    const vector<mpc_t>& b,
+    vector<mpc_t>& c,
+    size_t rows,
+    size_t common_dim,
+    size_t columns,
+    bool transpose_a,
+    bool transpose_b);
+  void Exp(const vector<mpc_t>& a, vector<mpc_t>& c);
+  void Rsqrt(const vector<mpc_t>& a, vector<mpc_t>& c);
+  void Sqrt(const vector<mpc_t>& a, vector<mpc_t>& c);
+  void Log(const vector<mpc_t>& a, vector<mpc_t>& c);
+  void Log1p(const vector<mpc_t>& a, vector<mpc_t>& c);
+  void HLog(const vector<mpc_t>& a, vector<mpc_t>& c);
+
+  //////////////////////////////////    compare ops   //////////////////////////////////
+  void Less(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c);
+  void LessEqual(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c);
+  void Greater(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c);
+  void GreaterEqual(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c);
+  void Equal(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c);
+  void NotEqual(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c);
+
+  //////////////////////////////////    reduce ops   //////////////////////////////////
+  void Max(const vector<mpc_t>& a, vector<mpc_t>& b, size_t rows, size_t cols);
+  void Min(const vector<mpc_t>& a, vector<mpc_t>& b, size_t rows, size_t cols);
+  void Mean(const vector<mpc_t>& a, vector<mpc_t>& b, size_t rows, size_t cols);
+  void Sum(const vector<mpc_t>& a, vector<mpc_t>& b, size_t rows, size_t cols);
+  void AddN(const vector<mpc_t>& a, vector<mpc_t>& b, size_t rows, size_t cols);
+
+  //////////////////////////////////    nn ops   //////////////////////////////////
+  void Abs(const vector<mpc_t>& a, vector<mpc_t>& b);
+  void AbsPrime(const vector<mpc_t>& a, vector<mpc_t>& b);
+  void Relu(const vector<mpc_t>& a, vector<mpc_t>& b);
+  void ReluPrime(const vector<mpc_t>& a, vector<mpc_t>& b);
+  void Sigmoid(const vector<mpc_t>& a, vector<mpc_t>& b);
+  // telescoping form of a registered piecewise polynomial, as the secure protocols evaluate it
+  void PiecewisePolynomial(const vector<mpc_t>& a, const string& func_name, vector<mpc_t>& b);
+  void Tanh(const vector<mpc_t>& a, vector<mpc_t>& b) { PiecewisePolynomial(a, "TANH", b); }
+  void TanhGrad(const vector<mpc_t>& a, vector<mpc_t>& b) { PiecewisePolynomial(a, "TANH_GRAD", b); }
+  void Gelu(const vector<mpc_t>& a, vector<mpc_t>& b) { PiecewisePolynomial(a, "GELU", b); }
+  void GeluGrad(const vector<mpc_t>& a, vector<mpc_t>& b) { PiecewisePolynomial(a, "GELU_GRAD", b); }
+  void Swish(const vector<mpc_t>& a, vector<mpc_t>& b) { PiecewisePolynomial(a, "SWISH", b); }
+  void SwishGrad(const vector<mpc_t>& a, vector<mpc_t>& b) { PiecewisePolynomial(a, "SWISH_GRAD", b); }
+  void Softplus(const vector<mpc_t>& a, vector<mpc_t>& b) { PiecewisePolynomial(a, "SOFTPLUS", b); }
+  void SoftplusGrad(const vector<mpc_t>& a, vector<mpc_t>& b) { PiecewisePolynomial(a, "SOFTPLUS_GRAD", b); }
+  void SigmoidCrossEntropy(const vector<mpc_t>& logits, const vector<mpc_t>& labels, vector<mpc_t>& b);
+  void Softmax(const vector<mpc_t>& a, vector<mpc_t>& b, size_t rows, size_t cols);
+  void LayerNorm(
+    const vector<mpc_t>& x,
+    const vector<mpc_t>& gamma,
+    const vector<mpc_t>& beta,
+    vector<mpc_t>& y,
+    vector<mpc_t>& inv_std,
+    size_t rows,
+    size_t cols,
+    double epsilon);
+  void LayerNormGrad(
+    const vector<mpc_t>& x,
+    const vector<mpc_t>& gamma,
+    const vector<mpc_t>& inv_std,
+    const vector<mpc_t>& dy,
+    vector<mpc_t>& dx,
+    vector<mpc_t>& dgamma,
+    vector<mpc_t>& dbeta,
+    size_t rows,
+    size_t cols);
+  // same discrete Laplace / binomial noise as the secure backends, from a local generator
+  void DPNoise(const vector<mpc_t>& a, const string& mechanism, double scale, vector<mpc_t>& b);
+  void ClipByL2Norm(
+    const vector<mpc_t>& a,
+    vector<mpc_t>& b,
+    size_t rows,
+    size_t cols,
+    double clip_norm);
+  // 1 / (1 - rate) with probability 1 - rate, else 0, from the local generator
+  void DropoutMask(size_t size, double rate, vector<double>& mask);
+  // same selection network as the secure TopK, indices as one-hot rows of cols
+  void TopK(
+    const vector<mpc_t>& a,
+    size_t rows,
+    size_t cols,
+    size_t k,
+    vector<mpc_t>& values,
+    vector<mpc_t>& indices);
+  // rows of depth, 1.0 at the nearest integer of each value, zero outside [0, depth)
+  void OneHot(const vector<mpc_t>& a, size_t depth, vector<mpc_t>& b);
+  void OneHotToIndex(const vector<mpc_t>& a, size_t depth, vector<mpc_t>& b);
+
+  //////////////////////////////////    sort ops   //////////////////////////////////
+  // the compare-exchange pairs of a bitonic sorting network of n = 2^k, in order,
+  // ascending: the smaller value goes to the first of each pair
+  static void BitonicNetwork(size_t n, vector<std::pair<size_t, size_t>>& pairs);
+  // sorts a in place, r gets 1.0 for every compare-exchange of the network that swapped
+  void Sort(vector<mpc_t>& a, bool descending, vector<mpc_t>& r);
+  // replays the swaps r of Sort on the rows of a (rows x cols), or undoes them
+  void Permutation(vector<mpc_t>& a, const vector<mpc_t>& r, size_t cols, bool inverse);
+
+  //////////////////////////////////    logical ops   //////////////////////////////////
+  void AND(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c);
+  void OR(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c);
+  void XOR(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c);
+  void NOT(const vector<mpc_t>& a, vector<mpc_t>& b);
+
+ private:
+  // sum_i coff_i * x^power_i, coefficients already scaled by CoffUp
+  void UniPolynomial(
+    const vector<mpc_t>& a,
+    const vector<mpc_t>& power_list,
+    const vector<mpc_t>& coff_list,
+    vector<mpc_t>& b);
+  // geometric with independent bits, bit j set when a uniform_bits uniform is below thresholds[j]
+  mpc_t RandomGeometric(const vector<uint64_t>& thresholds, int uniform_bits);
+
+ private:
+  int float_precision_;
+  std::mt19937_64 rng_{std::random_device{}()};
+};
+
+} // namespace plain
+} // namespace rosetta
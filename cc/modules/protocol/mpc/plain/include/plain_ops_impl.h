@@ -0,0 +1,157 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "cc/modules/protocol/public/include/protocol_base.h"
+#include "cc/modules/protocol/public/include/protocol_ops.h"
+#include "cc/modules/protocol/mpc/plain/include/plain_internal.h"
+
+namespace rosetta {
+
+/**
+ * Ops of the PlainFixpoint backend. Values are carried with the same
+ * secure-text encoding as SecureNN shares, but hold the whole ring element.
+ */
+class PlainFixpointOpsImpl : public ProtocolOps {
+ public:
+  PlainFixpointOpsImpl(const msg_id_t& msg_id, shared_ptr<ProtocolContext> context);
+  ~PlainFixpointOpsImpl() = default;
+
+  int TfToSecure(const vector<string>& in, vector<string>& out, const attr_type* attr_info = nullptr);
+  int SecureToTf(const vector<string>& in, vector<string>& out, const attr_type* attr_info = nullptr);
+  int RandSeed(std::string op_seed, string& out_str);
+
+  int PrivateInput(const string& node_id, const vector<double>& in_x, vector<string>& out_x);
+  int PublicInput(const string& node_id, const vector<double>& in_x, vector<string>& out_x);
+  int Broadcast(const string& from_node, const string& msg, string& result);
+  int Broadcast(const string& from_node, const char* msg, char* result, size_t size);
+  int ConditionalReveal(
+    vector<string>& in_vec,
+    vector<string>& out_cipher_vec,
+    vector<double>& out_plain_vec);
+
+  //////////////////////////////////    math ops   //////////////////////////////////
+  int Add(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Sub(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Mul(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Div(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Reciprocaldiv(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Truediv(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Floordiv(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+
+  int Less(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int LessEqual(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Equal(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int NotEqual(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Greater(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int GreaterEqual(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+
+  int Pow(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Matmul(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+
+  int Square(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Negative(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Abs(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int AbsPrime(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Log(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Log1p(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int HLog(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+
+  int Max(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Min(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Mean(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Sum(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int AddN(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+
+  ////////////////////////////////// nn ops //////////////////////////////////
+  int Relu(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int ReluPrime(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Sigmoid(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int SigmoidCrossEntropy(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Tanh(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int TanhGrad(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Gelu(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int GeluGrad(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Swish(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int SwishGrad(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Softplus(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int SoftplusGrad(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+
+  int LayerNorm(
+    const vector<string>& x,
+    const vector<string>& gamma,
+    const vector<string>& beta,
+    vector<string>& y,
+    vector<string>& inv_std,
+    const attr_type* attr_info = nullptr);
+  int LayerNormGrad(
+    const vector<string>& x,
+    const vector<string>& gamma,
+    const vector<string>& inv_std,
+    const vector<string>& dy,
+    vector<string>& dx,
+    vector<string>& dgamma,
+    vector<string>& dbeta,
+    const attr_type* attr_info = nullptr);
+  int DPNoise(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int ClipByL2Norm(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Dropout(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int DropoutGrad(const vector<string>& dy, vector<string>& dx, const attr_type* attr_info = nullptr);
+  int TopK(
+    const vector<string>& a,
+    vector<string>& values,
+    vector<string>& indices,
+    const attr_type* attr_info = nullptr);
+  int OneHot(const vector<string>& a, vector<string>& b, const attr_type* attr_info = nullptr);
+  int OneHotToIndex(const vector<string>& a, vector<string>& b, const attr_type* attr_info = nullptr);
+
+  int Sort(vector<string>& A, const attr_type* attr_info = nullptr);
+  int Sort(vector<string>& A, vector<string>& R, const attr_type* attr_info = nullptr);
+  int Permutation(vector<string>& A, const vector<string>& R, const attr_type* attr_info = nullptr);
+  int InversePermutation(vector<string>& A, const vector<string>& R, const attr_type* attr_info = nullptr);
+
+  int Sqrt(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Rsqrt(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Invert(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Exp(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Softmax(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+
+  ////////////////////////////////// training ops //////////////////////////////////
+  int Reveal(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Reveal(const vector<string>& a, vector<double>& output, const attr_type* attr_info = nullptr);
+
+  ////////////////////////////////// logical ops //////////////////////////////////
+  int AND(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int OR(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int XOR(const vector<string>& a, const vector<string>& b, vector<string>& output, const attr_type* attr_info = nullptr);
+  int NOT(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+
+ private:
+  int Decode(const vector<string>& a, vector<mpc_t>& sa);
+  int Encode(const vector<mpc_t>& sa, vector<string>& a);
+  // Permutation and InversePermutation, the swaps of Sort replayed or undone
+  int PermutationOf(vector<string>& A, const vector<string>& R, const attr_type* attr_info, bool inverse);
+
+ private:
+  shared_ptr<plain::PlainInternal> internal_ = nullptr;
+};
+
+} // namespace rosetta
@@ -0,0 +1,100 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/plain/include/plain_impl.h"
+#include "cc/modules/protocol/mpc/plain/include/plain_ops_impl.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_secure_debug.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_mask_store.h"
+#include "cc/modules/protocol/utility/include/util.h"
+#include "cc/modules/iowrapper/include/io_manager.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <string>
+#include <vector>
+using namespace std;
+
+namespace rosetta {
+
+int PlainFixpointProtocol::Init(string logfile) {
+#if NDEBUG
+  if (logfile != "")
+    rosetta::redirect_stdout(logfile);
+#endif
+
+  std::unique_lock<std::mutex> lck(status_mtx_);
+  if (is_inited_)
+    return 0;
+
+  // The fixed-point precision is left as the context has it, so one set
+  // before Init (SetFloatPrecision) is the one the ops use.
+  // An IO may have been set up by the caller; only node identity is taken
+  // from it, nothing is ever sent. Otherwise run as a standalone P0.
+  if (IOManager::Instance()->HasIOWrapper(context_->TASK_ID)) {
+    net_io_ = IOManager::Instance()->GetIOWrapper(context_->TASK_ID);
+    context_->NODE_ID = net_io_->GetCurrentNodeId();
+    context_->ROLE_ID = net_io_->GetPartyId(context_->NODE_ID);
+    context_->NODE_ROLE_MAPPING = net_io_->GetComputationNodes();
+  } else {
+    context_->NODE_ID = "P0";
+    context_->ROLE_ID = 0;
+    context_->NODE_ROLE_MAPPING = {{"P0", 0}};
+  }
+  context_->SAVER_MODEL.set_local_ciphertext_mode();
+  context_->RESTORE_MODEL.set_local_ciphertext_mode();
+#if ROSETTA_ENABLES_SECURE_DEBUG
+  context_->SECURE_DEBUG = std::make_shared<SecureDebugMonitor>(context_->TASK_ID);
+#endif
+  context_->MASK_STORE = std::make_shared<MpcMaskStore>();
+
+  is_inited_ = true;
+  perf_stats_.start_perf_stats();
+
+  tlog_info << "Rosetta: Protocol [" << protocol_name_ << "] backend initialization succeeded! task: "
+            << context_->TASK_ID << ", node id: " << context_->NODE_ID;
+  return 0;
+}
+
+int PlainFixpointProtocol::Uninit() {
+  std::unique_lock<std::mutex> lck(status_mtx_);
+  if (is_inited_) {
+    net_io_.reset();
+    rosetta::restore_stdout();
+    is_inited_ = false;
+    tlog_info << "Rosetta: Protocol [" << protocol_name_ << "] backend has been released.";
+  }
+  return 0;
+}
+
+shared_ptr<ProtocolOps> PlainFixpointProtocol::GetOps(const msg_id_t& msgid) {
+  return make_shared<PlainFixpointOpsImpl>(msgid, context_);
+}
+
+PerfStats PlainFixpointProtocol::GetPerfStats() {
+  PerfStats perf_stats;
+  if (!is_inited_) {
+    return perf_stats;
+  }
+  perf_stats.s = perf_stats_.get_perf_stats();
+  perf_stats.name = Name() + " " + context_->NODE_ID;
+#if ROSETTA_ENABLES_SECURE_DEBUG
+  if (context_->SECURE_DEBUG)
+    context_->SECURE_DEBUG->Fill(perf_stats);
+#endif
+  return perf_stats;
+}
+
+} // namespace rosetta
@@ -0,0 +1,858 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/plain/include/plain_internal.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+#include "cc/modules/common/include/utils/str_type_convert.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_topk.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_helper.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_dp.h"
+
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace rosetta {
+namespace plain {
+
+// wide enough to hold |a| << FLOAT_PRECISION without overflow in the long division
+#if ROSETTA_MPC_128
+typedef uint128_t wide_mpc_t;
+#else
+typedef unsigned __int128 wide_mpc_t;
+#endif
+
+void PlainInternal::Encode(const vector<double>& a, vector<mpc_t>& b) const {
+  b.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    b[i] = Encode(a[i]);
+}
+
+void PlainInternal::Encode(const vector<string>& a, vector<mpc_t>& b) const {
+  vector<double> da(a.size());
+  rosetta::convert::from_double_str(a, da);
+  Encode(da, b);
+}
+
+void PlainInternal::Decode(const vector<mpc_t>& a, vector<double>& b) const {
+  b.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    b[i] = Decode(a[i]);
+}
+
+//////////////////////////////////    math ops   //////////////////////////////////
+void PlainInternal::Add(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+  c.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    c[i] = a[i] + b[i];
+}
+
+void PlainInternal::Sub(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+  c.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    c[i] = a[i] - b[i];
+}
+
+void PlainInternal::Negative(const vector<mpc_t>& a, vector<mpc_t>& b) {
+  b.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    b[i] = 0 - a[i];
+}
+
+void PlainInternal::Mul(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+  c.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    c[i] = Truncate(a[i] * b[i]);
+}
+
+void PlainInternal::Mul(const vector<mpc_t>& a, double const_b, vector<mpc_t>& c) {
+  mpc_t b = Encode(const_b);
+  c.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    c[i] = Truncate(a[i] * b);
+}
+
+void PlainInternal::Square(const vector<mpc_t>& a, vector<mpc_t>& c) {
+  Mul(a, a, c);
+}
+
+void PlainInternal::Division(const vector<mpc_t>& a, const vector<double>& b, vector<mpc_t>& c) {
+  size_t size = a.size();
+  c.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    // big constant denominators are scaled up first, exactly as SecureNN does
+    double inv_b = 1.0 / b[i];
+    size_t power = float_precision_;
+    double abs_v = std::abs(b[i]);
+    if (abs_v > 1) {
+      size_t shift = ceil(log2(abs_v));
+      inv_b = inv_b * (1 << shift);
+      power = shift + float_precision_;
+    }
+    c[i] = Truncate(a[i] * Encode(inv_b), power);
+  }
+}
+
+void PlainInternal::Division(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+  size_t size = a.size();
+  c.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    bool neg_a = static_cast<signed_mpc_t>(a[i]) < 0;
+    bool neg_b = static_cast<signed_mpc_t>(b[i]) < 0;
+    mpc_t abs_a = neg_a ? 0 - a[i] : a[i];
+    mpc_t abs_b = neg_b ? 0 - b[i] : b[i];
+    if (abs_b == 0) {
+      log_warn << "PlainFixpoint Division by zero, set quotient as 0.";
+      c[i] = 0;
+      continue;
+    }
+    // the restoring division of SecureNN yields exactly floor(|a| * 2^f / |b|)
+    mpc_t q = static_cast<mpc_t>(((wide_mpc_t)abs_a << float_precision_) / abs_b);
+    c[i] = (neg_a != neg_b) ? 0 - q : q;
+  }
+}
+
+void PlainInternal::Floordivision(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+  size_t size = a.size();
+  c.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    signed_mpc_t sa = static_cast<signed_mpc_t>(a[i]);
+    signed_mpc_t sb = static_cast<signed_mpc_t>(b[i]);
+    if (sb == 0) {
+      log_warn << "PlainFixpoint Floordivision by zero, set quotient as 0.";
+      c[i] = 0;
+      continue;
+    }
+    signed_mpc_t q = sa / sb;
+    if ((sa % sb != 0) && ((sa < 0) != (sb < 0)))
+      q -= 1;
+    c[i] = static_cast<mpc_t>(q) << float_precision_;
+  }
+}
+
+void PlainInternal::PowConst(const vector<mpc_t>& a, int64_t k, vector<mpc_t>& c) {
+  size_t size = a.size();
+  c.resize(size);
+  if (k == 0) {
+    c.assign(size, One());
+    return;
+  }
+  if (k == 1) {
+    c = a;
+    return;
+  }
+
+  // square-and-multiply, same multiplication order as SecureNN
+  int64_t curr_k = k;
+  int curr_p = 1;
+  bool least_bit_covered = false;
+  vector<mpc_t> P = a;
+  vector<mpc_t> curr_Y(size, One());
+  while (curr_k != 0) {
+    if (curr_p != 1)
+      Mul(P, P, P);
+    if (curr_k % 2) {
+      if (!least_bit_covered) {
+        curr_Y = P;
+        least_bit_covered = true;
+      } else {
+        Mul(P, curr_Y, curr_Y);
+      }
+    }
+    curr_k = curr_k / 2;
+    curr_p++;
+  }
+  c = curr_Y;
+}
+
+void PlainInternal::Pow(const vector<mpc_t>& a, const vector<int64_t>& n, vector<mpc_t>& c) {
+  size_t size = a.size();
+  assert(a.size() == n.size());
+  c.resize(size);
+
+  bool is_common_k = true;
+  for (size_t i = 1; i < size; ++i) {
+    if (n[i] != n[i - 1]) {
+      is_common_k = false;
+      break;
+    }
+  }
+  if (is_common_k) {
+    PowConst(a, size > 0 ? n[0] : 0, c);
+    return;
+  }
+
+  vector<mpc_t> va(1), vc(1);
+  for (size_t i = 0; i < size; ++i) {
+    va[0] = a[i];
+    PowConst(va, n[i], vc);
+    c[i] = vc[0];
+  }
+}
+
+void PlainInternal::MatMul(
+  const vector<mpc_t>& a,
+  const vector<mpc_t>& b,
+  vector<mpc_t>& c,
+  size_t rows,
+  size_t common_dim,
+  size_t columns,
+  bool transpose_a,
+  bool transpose_b) {
+  c.resize(rows * columns);
+  EigenMatMul(a, b, c, rows, common_dim, columns, transpose_a, transpose_b);
+  for (size_t i = 0; i < c.size(); ++i)
+    c[i] = Truncate(c[i]);
+}
+
+// exp(x) ~ (1 + x/500)^500
+void PlainInternal::Exp(const vector<mpc_t>& a, vector<mpc_t>& c) {
+  vector<mpc_t> m;
+  Mul(a, 0.002, m);
+  for (size_t i = 0; i < m.size(); ++i)
+    m[i] += One();
+  PowConst(m, 500, c);
+}
+
+void PlainInternal::Rsqrt(const vector<mpc_t>& a, vector<mpc_t>& c) {
+  const int sqrt_nr_iters = 3;
+  size_t size = a.size();
+  vector<mpc_t> y(size), t0(size), t1(size);
+
+  // initial guess: 2.2 * exp(-(x/2 + 0.2)) + 0.2 - x/1024
+  Mul(a, 0.5, y);
+  for (size_t i = 0; i < size; ++i)
+    y[i] = 0 - (y[i] + Encode(0.2));
+  Exp(y, t0);
+  Mul(t0, 2.2, y);
+  Mul(a, 0.0009765625, t1);
+  for (size_t i = 0; i < size; ++i)
+    y[i] = y[i] + Encode(0.2) - t1[i];
+
+  // Newton-Raphson: y = y * (3 - x * y^2) / 2
+  for (int iter = 0; iter < sqrt_nr_iters; ++iter) {
+    Mul(y, y, t1);
+    Mul(t1, a, t0);
+    for (size_t i = 0; i < size; ++i)
+      t0[i] = 0 - t0[i] + Encode(3);
+    Mul(t0, y, t1);
+    Mul(t1, 0.5, y);
+  }
+
+  Abs(y, c);
+}
+
+void PlainInternal::Sqrt(const vector<mpc_t>& a, vector<mpc_t>& c) {
+  vector<mpc_t> r;
+  Rsqrt(a, r);
+  Mul(a, r, c);
+}
+
+void PlainInternal::UniPolynomial(
+  const vector<mpc_t>& a,
+  const vector<mpc_t>& power_list,
+  const vector<mpc_t>& coff_list,
+  vector<mpc_t>& b) {
+  size_t size = a.size();
+  std::unordered_map<int, vector<mpc_t>> pow_cache;
+  pow_cache[1] = a;
+
+  b.assign(size, 0);
+  vector<mpc_t> term(size);
+  for (size_t k = 0; k < power_list.size(); ++k) {
+    int curr_k = power_list[k];
+    if (curr_k == 0) {
+      for (size_t i = 0; i < size; ++i)
+        b[i] += coff_list[k];
+      continue;
+    }
+    if (curr_k == 1) {
+      term = a;
+    } else if (pow_cache.find(curr_k - 1) != pow_cache.end()) {
+      Mul(a, pow_cache[curr_k - 1], term);
+      pow_cache[curr_k] = term;
+    } else {
+      PowConst(a, curr_k, term);
+    }
+    for (size_t i = 0; i < size; ++i)
+      b[i] += Truncate(term[i] * coff_list[k]);
+  }
+}
+
+void PlainInternal::Log(const vector<mpc_t>& a, vector<mpc_t>& c) {
+  size_t size = a.size();
+  c.assign(size, 0);
+
+  vector<ConstPolynomial>* log_v2_p = nullptr;
+  if (!PolyConfFactory::get_func_polys("LOG_V2", &log_v2_p) || log_v2_p->empty()) {
+    log_error << "can not find polynomials for func LOG_V2";
+    return;
+  }
+
+  vector<mpc_t> power_list, coff_list, poly_res;
+  for (auto& seg : *log_v2_p) {
+    mpc_t seg_init = seg.get_start(float_precision_);
+    mpc_t seg_end = seg.get_end(float_precision_);
+    seg.get_power_list(power_list);
+    seg.get_coff_list(coff_list, float_precision_);
+    UniPolynomial(a, power_list, coff_list, poly_res);
+    for (size_t i = 0; i < size; ++i) {
+      // x >= start && !(x >= end), segments are [start, end)
+      mpc_t in_seg = Truncate(ReluPrime(a[i] - seg_init) * (One() - ReluPrime(a[i] - seg_end)));
+      c[i] += Truncate(in_seg * CoffDown(poly_res[i]));
+    }
+  }
+}
+
+void PlainInternal::Log1p(const vector<mpc_t>& a, vector<mpc_t>& c) {
+  vector<mpc_t> a_plus_one(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    a_plus_one[i] = a[i] + One();
+  Log(a_plus_one, c);
+}
+
+// x = 2^m * r, r in [0.5, 1), ln(x) = m * ln(2) + ln(r)
+void PlainInternal::HLog(const vector<mpc_t>& a, vector<mpc_t>& c) {
+  size_t size = a.size();
+  const int LEN = 8 * sizeof(mpc_t);
+  const mpc_t HALF = Encode(0.5);
+  const mpc_t TWO = Encode(2);
+
+  vector<mpc_t> curr_x = a;
+  vector<mpc_t> curr_power(size, 0);
+  for (size_t j = 0; j < size; ++j) {
+    // scale down integer part
+    for (int i = 0; i < LEN - float_precision_; ++i) {
+      mpc_t cmp = ReluPrime(curr_x[j] - One());
+      mpc_t multiplier = One() + Truncate((HALF - One()) * cmp);
+      curr_x[j] = Truncate(curr_x[j] * multiplier);
+      curr_power[j] += cmp;
+    }
+    // scale up fractional part
+    for (int i = 0; i < float_precision_; ++i) {
+      mpc_t cmp = ReluPrime(curr_x[j] - HALF);
+      mpc_t multiplier = TWO + Truncate((One() - TWO) * cmp);
+      curr_x[j] = Truncate(curr_x[j] * multiplier);
+      curr_power[j] += (cmp - One());
+    }
+  }
+
+  vector<ConstPolynomial>* log_hd_p = nullptr;
+  if (!PolyConfFactory::get_func_polys("LOG_HD", &log_hd_p) || log_hd_p->empty()) {
+    log_error << "can not find polynomials for func LOG_HD";
+    c.assign(size, 0);
+    return;
+  }
+  vector<mpc_t> power_list, coff_list, basic_val;
+  log_hd_p->at(0).get_power_list(power_list);
+  log_hd_p->at(0).get_coff_list(coff_list, float_precision_);
+  UniPolynomial(curr_x, power_list, coff_list, basic_val);
+
+  c.resize(size);
+  mpc_t LN_2 = Encode(0.693147181);
+  for (size_t i = 0; i < size; ++i)
+    c[i] = Truncate(curr_power[i] * LN_2) + CoffDown(basic_val[i]);
+}
+
+//////////////////////////////////    compare ops   //////////////////////////////////
+void PlainInternal::Less(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+  c.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    c[i] = One() - ReluPrime(a[i] - b[i]);
+}
+
+void PlainInternal::LessEqual(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+  c.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    c[i] = ReluPrime(b[i] - a[i]);
+}
+
+void PlainInternal::Greater(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+  c.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    c[i] = One() - ReluPrime(b[i] - a[i]);
+}
+
+void PlainInternal::GreaterEqual(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+  c.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    c[i] = ReluPrime(a[i] - b[i]);
+}
+
+void PlainInternal::Equal(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+  c.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    c[i] = (a[i] == b[i]) ? One() : 0;
+}
+
+void PlainInternal::NotEqual(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+  c.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    c[i] = (a[i] != b[i]) ? One() : 0;
+}
+
+//////////////////////////////////    reduce ops   //////////////////////////////////
+void PlainInternal::Max(const vector<mpc_t>& a, vector<mpc_t>& b, size_t rows, size_t cols) {
+  b.resize(rows);
+  for (size_t i = 0; i < rows; ++i) {
+    signed_mpc_t v = static_cast<signed_mpc_t>(a[i * cols]);
+    for (size_t j = 1; j < cols; ++j)
+      v = std::max(v, static_cast<signed_mpc_t>(a[i * cols + j]));
+    b[i] = static_cast<mpc_t>(v);
+  }
+}
+
+void PlainInternal::Min(const vector<mpc_t>& a, vector<mpc_t>& b, size_t rows, size_t cols) {
+  b.resize(rows);
+  for (size_t i = 0; i < rows; ++i) {
+    signed_mpc_t v = static_cast<signed_mpc_t>(a[i * cols]);
+    for (size_t j = 1; j < cols; ++j)
+      v = std::min(v, static_cast<signed_mpc_t>(a[i * cols + j]));
+    b[i] = static_cast<mpc_t>(v);
+  }
+}
+
+void PlainInternal::Mean(const vector<mpc_t>& a, vector<mpc_t>& b, size_t rows, size_t cols) {
+  Sum(a, b, rows, cols);
+  mpc_t inv_cols = Encode(1.0 / cols);
+  for (size_t i = 0; i < rows; ++i)
+    b[i] = Truncate(b[i] * inv_cols);
+}
+
+void PlainInternal::Sum(const vector<mpc_t>& a, vector<mpc_t>& b, size_t rows, size_t cols) {
+  b.resize(rows);
+  for (size_t i = 0; i < rows; ++i) {
+    mpc_t v = 0;
+    for (size_t j = 0; j < cols; ++j)
+      v += a[i * cols + j];
+    b[i] = v;
+  }
+}
+
+void PlainInternal::AddN(const vector<mpc_t>& a, vector<mpc_t>& b, size_t rows, size_t cols) {
+  b.resize(cols);
+  for (size_t i = 0; i < cols; ++i) {
+    mpc_t v = 0;
+    for (size_t j = 0; j < rows; ++j)
+      v += a[j * cols + i];
+    b[i] = v;
+  }
+}
+
+//////////////////////////////////    nn ops   //////////////////////////////////
+void PlainInternal::Abs(const vector<mpc_t>& a, vector<mpc_t>& b) {
+  vector<mpc_t> sign;
+  AbsPrime(a, sign);
+  Mul(sign, a, b);
+}
+
+void PlainInternal::AbsPrime(const vector<mpc_t>& a, vector<mpc_t>& b) {
+  b.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    b[i] = ReluPrime(a[i]) ? One() : Encode(-1);
+}
+
+void PlainInternal::Relu(const vector<mpc_t>& a, vector<mpc_t>& b) {
+  vector<mpc_t> cmp;
+  ReluPrime(a, cmp);
+  Mul(a, cmp, b);
+}
+
+void PlainInternal::ReluPrime(const vector<mpc_t>& a, vector<mpc_t>& b) {
+  b.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    b[i] = ReluPrime(a[i]);
+}
+
+// 5-piece linear approximation, evaluated as SecureNN's telescoping sum
+void PlainInternal::Sigmoid(const vector<mpc_t>& a, vector<mpc_t>& b) {
+  const mpc_t a1 = Encode(0.02776), b1 = Encode(0.145);
+  const mpc_t a2 = Encode(0.17), b2 = Encode(0.5);
+  const mpc_t a3 = Encode(0.02776), b3 = Encode(0.85498);
+  const mpc_t C[4] = {Encode(-5), Encode(-2.5), Encode(2.5), Encode(5)};
+  const mpc_t A[4] = {0 - a1, a1 - a2, a2 - a3, a3};
+  const mpc_t B[4] = {0 - b1, b1 - b2, b2 - b3, b3 - One()};
+
+  size_t size = a.size();
+  b.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    mpc_t out = One();
+    for (int seg = 0; seg < 4; ++seg) {
+      mpc_t cmp = ReluPrime(C[seg] - a[i]);
+      mpc_t linear = Truncate(A[seg] * a[i]) + B[seg];
+      out += Truncate(cmp * linear);
+    }
+    b[i] = out;
+  }
+}
+
+void PlainInternal::PiecewisePolynomial(
+  const vector<mpc_t>& a,
+  const string& func_name,
+  vector<mpc_t>& b) {
+  size_t size = a.size();
+  vector<double> break_points;
+  vector<vector<mpc_t>> coffs;
+  if (!PolyConfFactory::get_func_telescoping(func_name, float_precision_, break_points, coffs)) {
+    log_error << "can not find polynomials for func " << func_name;
+    b.assign(size, 0);
+    return;
+  }
+
+  size_t max_power = coffs[0].size() - 1;
+  b.resize(size);
+  vector<mpc_t> powers(max_power + 1);
+  for (size_t i = 0; i < size; ++i) {
+    if (max_power > 0)
+      powers[1] = a[i];
+    for (size_t p = 2; p <= max_power; ++p) {
+      size_t d = 1;
+      while (2 * d < p)
+        d *= 2;
+      powers[p] = Truncate(powers[p - d] * powers[d]);
+    }
+    mpc_t out = 0;
+    for (size_t k = 0; k < coffs.size(); ++k) {
+      mpc_t g = 0;
+      for (size_t p = 1; p <= max_power; ++p)
+        g += coffs[k][p] * powers[p];
+      g = Truncate(g) + coffs[k][0];
+      if (k == 0)
+        out = g;
+      else
+        out += Truncate(ReluPrime(a[i] - Encode(break_points[k - 1])) * g);
+    }
+    b[i] = out;
+  }
+}
+
+void PlainInternal::LayerNorm(
+  const vector<mpc_t>& x,
+  const vector<mpc_t>& gamma,
+  const vector<mpc_t>& beta,
+  vector<mpc_t>& y,
+  vector<mpc_t>& inv_std,
+  size_t rows,
+  size_t cols,
+  double epsilon) {
+  size_t size = rows * cols;
+  vector<mpc_t> mean, squares(size), scaled(size), var;
+  Mean(x, mean, rows, cols);
+  for (size_t i = 0; i < size; ++i) {
+    mpc_t centered = x[i] - mean[i / cols];
+    squares[i] = Truncate(centered * centered);
+    scaled[i] = Truncate(centered * gamma[i % cols]);
+  }
+  Mean(squares, var, rows, cols);
+  mpc_t eps = Encode(clamp_fixpoint_epsilon(epsilon, float_precision_));
+  for (size_t i = 0; i < rows; ++i)
+    var[i] += eps;
+  Rsqrt(var, inv_std);
+
+  y.resize(size);
+  for (size_t i = 0; i < size; ++i)
+    y[i] = Truncate(scaled[i] * inv_std[i / cols]) + beta[i % cols];
+}
+
+void PlainInternal::LayerNormGrad(
+  const vector<mpc_t>& x,
+  const vector<mpc_t>& gamma,
+  const vector<mpc_t>& inv_std,
+  const vector<mpc_t>& dy,
+  vector<mpc_t>& dx,
+  vector<mpc_t>& dgamma,
+  vector<mpc_t>& dbeta,
+  size_t rows,
+  size_t cols) {
+  size_t size = rows * cols;
+  vector<mpc_t> mean;
+  Mean(x, mean, rows, cols);
+
+  vector<mpc_t> x_hat(size), dx_hat(size), dx_hat_x_hat(size), dy_x_hat(size);
+  for (size_t i = 0; i < size; ++i) {
+    x_hat[i] = Truncate((x[i] - mean[i / cols]) * inv_std[i / cols]);
+    dx_hat[i] = Truncate(dy[i] * gamma[i % cols]);
+    dx_hat_x_hat[i] = Truncate(dx_hat[i] * x_hat[i]);
+    dy_x_hat[i] = Truncate(dy[i] * x_hat[i]);
+  }
+
+  vector<mpc_t> mean_dx_hat, mean_dx_hat_x_hat;
+  Mean(dx_hat, mean_dx_hat, rows, cols);
+  Mean(dx_hat_x_hat, mean_dx_hat_x_hat, rows, cols);
+  AddN(dy_x_hat, dgamma, rows, cols);
+  AddN(dy, dbeta, rows, cols);
+
+  dx.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    mpc_t r = inv_std[i / cols];
+    mpc_t r_x_hat = Truncate(r * x_hat[i]);
+    dx[i] = Truncate(r * dx_hat[i]) - Truncate(r * mean_dx_hat[i / cols]) -
+      Truncate(r_x_hat * mean_dx_hat_x_hat[i / cols]);
+  }
+}
+
+mpc_t PlainInternal::RandomGeometric(const vector<uint64_t>& thresholds, int uniform_bits) {
+  mpc_t g = 0;
+  for (size_t j = 0; j < thresholds.size(); ++j) {
+    if ((rng_() >> (64 - uniform_bits)) < thresholds[j])
+      g |= static_cast<mpc_t>(1) << j;
+  }
+  return g;
+}
+
+// discrete Laplace / binomial mechanism, see mpc_dp.h
+void PlainInternal::DPNoise(
+  const vector<mpc_t>& a,
+  const string& mechanism,
+  double scale,
+  vector<mpc_t>& b) {
+  b.resize(a.size());
+  if (mechanism == "laplace") {
+    const int uniform_bits = dp_uniform_bits(float_precision_);
+    vector<uint64_t> thresholds;
+    dp_laplace_thresholds(scale, float_precision_, uniform_bits, thresholds);
+    for (size_t i = 0; i < a.size(); ++i)
+      b[i] = a[i] + RandomGeometric(thresholds, uniform_bits) - RandomGeometric(thresholds, uniform_bits);
+    return;
+  }
+
+  int grid_bits = 0;
+  size_t coins = 0;
+  dp_binomial_params(scale, float_precision_, grid_bits, coins);
+  for (size_t i = 0; i < a.size(); ++i) {
+    mpc_t k = 0;
+    for (size_t c = 0; c < coins; c += 64) {
+      uint64_t r = rng_();
+      if (coins - c < 64)
+        r &= (static_cast<uint64_t>(1) << (coins - c)) - 1;
+      k += __builtin_popcountll(r);
+    }
+    b[i] = (Truncate(a[i], grid_bits) << grid_bits) + ((k - coins / 2) << grid_bits);
+  }
+}
+
+void PlainInternal::ClipByL2Norm(
+  const vector<mpc_t>& a,
+  vector<mpc_t>& b,
+  size_t rows,
+  size_t cols,
+  double clip_norm) {
+  size_t size = rows * cols;
+  int shift = 0;
+  double ratio = 1.0;
+  dp_clip_norm_split(clip_norm, shift, ratio);
+  mpc_t ratio_fp = Encode(ratio);
+
+  // t = ||g / clip_norm||^2, scaled before squaring
+  vector<mpc_t> squares(size), t, inv_norm;
+  for (size_t i = 0; i < size; ++i) {
+    mpc_t scaled = Truncate(Truncate(a[i], shift) * ratio_fp);
+    squares[i] = Truncate(scaled * scaled);
+  }
+  Sum(squares, t, rows, cols);
+  Rsqrt(t, inv_norm);
+
+  // factor = 1 + (t >= 1) * (clip_norm / ||g|| - 1)
+  b.resize(size);
+  for (size_t i = 0; i < rows; ++i) {
+    mpc_t factor = One() + Truncate(ReluPrime(t[i] - One()) * (inv_norm[i] - One()));
+    for (size_t j = 0; j < cols; ++j)
+      b[i * cols + j] = Truncate(a[i * cols + j] * factor);
+  }
+}
+
+void PlainInternal::DropoutMask(size_t size, double rate, vector<double>& mask) {
+  const double keep = 1.0 - rate;
+  std::bernoulli_distribution kept(keep);
+  mask.resize(size);
+  for (size_t i = 0; i < size; ++i)
+    mask[i] = kept(rng_) ? 1.0 / keep : 0.0;
+}
+
+void PlainInternal::TopK(
+  const vector<mpc_t>& a,
+  size_t rows,
+  size_t cols,
+  size_t k,
+  vector<mpc_t>& values,
+  vector<mpc_t>& indices) {
+  vector<mpc_t> idx(cols);
+  for (size_t j = 0; j < cols; ++j)
+    idx[j] = Encode(j);
+
+  // hi = b + (a >= b) * (a - b), lo = a + b - hi
+  auto cswap = [&](vector<mpc_t>& A, vector<mpc_t>& B, vector<mpc_t>& IA, vector<mpc_t>& IB) {
+    for (size_t i = 0; i < A.size(); ++i) {
+      mpc_t ge = ReluPrime(A[i] - B[i]);
+      mpc_t d = Truncate(ge * (A[i] - B[i]));
+      mpc_t di = Truncate(ge * (IA[i] - IB[i]));
+      mpc_t a_i = A[i], ia_i = IA[i];
+      A[i] = B[i] + d;
+      B[i] = a_i - d;
+      IA[i] = IB[i] + di;
+      IB[i] = ia_i - di;
+    }
+  };
+
+  vector<mpc_t> top_idx;
+  bitonic_topk(a, idx, Encode(kBitonicTopKPad), Encode(-1), rows, cols, k, values, top_idx, cswap);
+
+  OneHot(top_idx, cols, indices);
+}
+
+void PlainInternal::OneHot(const vector<mpc_t>& a, size_t depth, vector<mpc_t>& b) {
+  b.resize(a.size() * depth);
+  mpc_t half = Encode(0.5);
+  for (size_t i = 0; i < a.size(); ++i) {
+    for (size_t j = 0; j < depth; ++j) {
+      mpc_t x = a[i] - Encode(j);
+      b[i * depth + j] = ReluPrime(x + half) - ReluPrime(x - half);
+    }
+  }
+}
+
+void PlainInternal::OneHotToIndex(const vector<mpc_t>& a, size_t depth, vector<mpc_t>& b) {
+  b.assign(a.size() / depth, 0);
+  for (size_t i = 0; i < b.size(); ++i)
+    for (size_t j = 1; j < depth; ++j)
+      b[i] += static_cast<mpc_t>(j) * a[i * depth + j];
+}
+
+// max(x, 0) - x * z + log(1 + exp(-|x|)), the last term via LOG_CE
+void PlainInternal::SigmoidCrossEntropy(
+  const vector<mpc_t>& logits,
+  const vector<mpc_t>& labels,
+  vector<mpc_t>& b) {
+  size_t size = logits.size();
+  b.resize(size);
+
+  vector<ConstPolynomial>* log_ce_p = nullptr;
+  if (!PolyConfFactory::get_func_polys("LOG_CE", &log_ce_p) || log_ce_p->empty()) {
+    log_error << "can not find polynomials for func LOG_CE";
+    b.assign(size, 0);
+    return;
+  }
+  vector<mpc_t> power_list, coff_list;
+  log_ce_p->at(0).get_power_list(power_list);
+  log_ce_p->at(0).get_coff_list(coff_list, float_precision_);
+  mpc_t upper = log_ce_p->at(0).get_end(float_precision_);
+
+  vector<mpc_t> abs_x(size), log_part;
+  vector<mpc_t> no_clip(size);
+  for (size_t i = 0; i < size; ++i) {
+    mpc_t max_bit = ReluPrime(logits[i]);
+    mpc_t sign = Truncate(Encode(2) * max_bit) - One();
+    abs_x[i] = Truncate(sign * logits[i]);
+    no_clip[i] = Truncate(ReluPrime(upper - logits[i]) * ReluPrime(logits[i] + upper));
+    b[i] = Truncate(max_bit * logits[i]) - Truncate(labels[i] * logits[i]);
+  }
+  UniPolynomial(abs_x, power_list, coff_list, log_part);
+  const mpc_t LOWER_CLIP = Encode(0.0003);
+  for (size_t i = 0; i < size; ++i)
+    b[i] += LOWER_CLIP + Truncate((log_part[i] - LOWER_CLIP) * no_clip[i]);
+}
+
+// exp(x - max(x)) / sum(exp(x - max(x))) along each row
+void PlainInternal::BitonicNetwork(size_t n, vector<std::pair<size_t, size_t>>& pairs) {
+  pairs.clear();
+  for (size_t s = 2; s <= n; s <<= 1) {
+    for (size_t t = s >> 1; t > 0; t >>= 1) {
+      for (size_t i = 0; i < n; ++i) {
+        size_t l = i ^ t;
+        if (l <= i)
+          continue;
+        if ((i & s) == 0)
+          pairs.emplace_back(i, l);
+        else
+          pairs.emplace_back(l, i);
+      }
+    }
+  }
+}
+
+void PlainInternal::Sort(vector<mpc_t>& a, bool descending, vector<mpc_t>& r) {
+  vector<std::pair<size_t, size_t>> pairs;
+  BitonicNetwork(a.size(), pairs);
+  r.resize(pairs.size());
+  for (size_t t = 0; t < pairs.size(); ++t) {
+    mpc_t& x = a[pairs[t].first];
+    mpc_t& y = a[pairs[t].second];
+    bool swap = descending ? static_cast<signed_mpc_t>(x) < static_cast<signed_mpc_t>(y)
+                           : static_cast<signed_mpc_t>(x) > static_cast<signed_mpc_t>(y);
+    if (swap)
+      std::swap(x, y);
+    r[t] = swap ? One() : 0;
+  }
+}
+
+void PlainInternal::Permutation(vector<mpc_t>& a, const vector<mpc_t>& r, size_t cols, bool inverse) {
+  vector<std::pair<size_t, size_t>> pairs;
+  BitonicNetwork(a.size() / cols, pairs);
+  // every compare-exchange is its own inverse, so the swaps are undone in reverse order
+  for (size_t n = 0; n < pairs.size(); ++n) {
+    size_t t = inverse ? pairs.size() - 1 - n : n;
+    if (r[t] == 0)
+      continue;
+    for (size_t j = 0; j < cols; ++j)
+      std::swap(a[pairs[t].first * cols + j], a[pairs[t].second * cols + j]);
+  }
+}
+
+void PlainInternal::Softmax(const vector<mpc_t>& a, vector<mpc_t>& b, size_t rows, size_t cols) {
+  vector<mpc_t> row_max, shifted(a.size()), exps, row_sum, denominator(a.size());
+  Max(a, row_max, rows, cols);
+  for (size_t i = 0; i < rows; ++i)
+    for (size_t j = 0; j < cols; ++j)
+      shifted[i * cols + j] = a[i * cols + j] - row_max[i];
+  Exp(shifted, exps);
+  Sum(exps, row_sum, rows, cols);
+  for (size_t i = 0; i < rows; ++i)
+    for (size_t j = 0; j < cols; ++j)
+      denominator[i * cols + j] = row_sum[i];
+  Division(exps, denominator, b);
+}
+
+//////////////////////////////////    logical ops   //////////////////////////////////
+void PlainInternal::AND(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+  Mul(a, b, c);
+}
+
+void PlainInternal::OR(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+  vector<mpc_t> prod;
+  Mul(a, b, prod);
+  c.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    c[i] = a[i] + b[i] - prod[i];
+}
+
+void PlainInternal::XOR(const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+  vector<mpc_t> prod;
+  Mul(a, b, prod);
+  c.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    c[i] = a[i] + b[i] - (prod[i] << 1);
+}
+
+void PlainInternal::NOT(const vector<mpc_t>& a, vector<mpc_t>& b) {
+  b.resize(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    b[i] = One() - a[i];
+}
+
+} // namespace plain
+} // namespace rosetta
@@ -0,0 +1,716 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/plain/include/plain_ops_impl.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_helper.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+#include "cc/modules/common/include/utils/str_type_convert.h"
+#include "cc/modules/common/include/utils/secure_encoder.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_secure_debug.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_mask_store.h"
+#include "cc/modules/common/include/utils/msg_id_mgr.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#define GET_ATTR_TAG(attr_info_ptr, tag) \
+  attr_info_ptr && attr_info_ptr->count(tag) > 0 && attr_info_ptr->at(tag) == "1"
+
+#define plain_decode(a, sa)                                                      \
+  do {                                                                           \
+    if (0 != Decode(a, sa)) {                                                    \
+      log_error << "PlainFixpoint decode failed! In " << __FUNCTION__ << "#" << __LINE__; \
+      return -1;                                                                 \
+    }                                                                            \
+  } while (0)
+
+#if ROSETTA_ENABLES_SECURE_DEBUG
+// values are already in the clear, so no reveal is needed here
+#define plain_secure_debug(sa)                                                   \
+  do {                                                                           \
+    if (context_->SECURE_DEBUG)                                                  \
+      context_->SECURE_DEBUG->Check(__FUNCTION__, msg_id(), sa, context_->GetFixPointPrecision()); \
+  } while (0)
+#else
+#define plain_secure_debug(sa) (void)0
+#endif
+
+#define plain_encode(sa, a)                                                      \
+  do {                                                                           \
+    plain_secure_debug(sa);                                                      \
+    if (0 != Encode(sa, a)) {                                                    \
+      log_error << "PlainFixpoint encode failed! In " << __FUNCTION__ << "#" << __LINE__; \
+      return -1;                                                                 \
+    }                                                                            \
+  } while (0)
+
+/**
+ * Binary OP(s), either side may be a literal constant
+ */
+#define PLAIN_PROTOCOL_BINARY_OP(op)                                                              \
+  int PlainFixpointOpsImpl::op(                                                                   \
+    const vector<string>& a, const vector<string>& b, vector<string>& c, const attr_type* attr) { \
+    tlog_debug << "----> PlainFixpoint " #op;                                                     \
+    vector<mpc_t> sa, sb, sc;                                                                     \
+    if (GET_ATTR_TAG(attr, "lh_is_const"))                                                        \
+      internal_->Encode(a, sa);                                                                   \
+    else                                                                                          \
+      plain_decode(a, sa);                                                                        \
+    if (GET_ATTR_TAG(attr, "rh_is_const"))                                                        \
+      internal_->Encode(b, sb);                                                                   \
+    else                                                                                          \
+      plain_decode(b, sb);                                                                        \
+    internal_->op(sa, sb, sc);                                                                    \
+    plain_encode(sc, c);                                                                          \
+    tlog_debug << "PlainFixpoint " #op " ok. <----";                                              \
+    return 0;                                                                                     \
+  }
+
+#define PLAIN_PROTOCOL_UNARY_OP(op)                                                                \
+  int PlainFixpointOpsImpl::op(const vector<string>& a, vector<string>& c, const attr_type* attr) { \
+    tlog_debug << "----> PlainFixpoint " #op;                                                      \
+    vector<mpc_t> sa, sc;                                                                          \
+    plain_decode(a, sa);                                                                           \
+    internal_->op(sa, sc);                                                                         \
+    plain_encode(sc, c);                                                                           \
+    tlog_debug << "PlainFixpoint " #op " ok. <----";                                               \
+    return 0;                                                                                      \
+  }
+
+#define PLAIN_PROTOCOL_REDUCE_OP(op)                                                               \
+  int PlainFixpointOpsImpl::op(const vector<string>& a, vector<string>& c, const attr_type* attr) { \
+    tlog_debug << "----> PlainFixpoint " #op;                                                      \
+    if (!(attr && attr->count("rows") > 0 && attr->count("cols") > 0)) {                           \
+      tlog_error << "please fill rows, cols for PlainFixpoint " #op;                               \
+      return -1;                                                                                   \
+    }                                                                                              \
+    size_t rows = std::stoull(attr->at("rows"));                                                   \
+    size_t cols = std::stoull(attr->at("cols"));                                                   \
+    vector<mpc_t> sa, sc;                                                                          \
+    plain_decode(a, sa);                                                                           \
+    internal_->op(sa, sc, rows, cols);                                                             \
+    plain_encode(sc, c);                                                                           \
+    tlog_debug << "PlainFixpoint " #op " ok. <----";                                               \
+    return 0;                                                                                      \
+  }
+
+namespace rosetta {
+
+PlainFixpointOpsImpl::PlainFixpointOpsImpl(const msg_id_t& msg_id, shared_ptr<ProtocolContext> context)
+    : ProtocolOps(msg_id, context) {
+  internal_ = make_shared<plain::PlainInternal>(context_->GetFixPointPrecision());
+}
+
+int PlainFixpointOpsImpl::Decode(const vector<string>& a, vector<mpc_t>& sa) {
+  if (a.empty()) {
+    sa.clear();
+    return 0;
+  }
+
+  if (rosetta::convert::is_secure_text(a[0])) {
+    sa.resize(a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+      memcpy((char*)&sa[i], a[i].data(), sizeof(mpc_t));
+    }
+  } else if (rosetta::convert::is_binary_double(a[0])) {
+    vector<double> da(a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+      memcpy(&da[i], a[i].data(), sizeof(double));
+    }
+    internal_->Encode(da, sa);
+  } else {
+    // literal numbers are whole values here, not halves as in SecureNN
+    internal_->Encode(a, sa);
+  }
+  return 0;
+}
+
+int PlainFixpointOpsImpl::Encode(const vector<mpc_t>& sa, vector<string>& a) {
+  return rosetta::convert::encoder::encode_to_secure(sa, a);
+}
+
+int PlainFixpointOpsImpl::TfToSecure(
+  const vector<string>& in,
+  vector<string>& out,
+  const attr_type* attr_info) {
+  vector<mpc_t> sa;
+  internal_->Encode(in, sa);
+  plain_encode(sa, out);
+  return 0;
+}
+
+int PlainFixpointOpsImpl::SecureToTf(
+  const vector<string>& in,
+  vector<string>& out,
+  const attr_type* attr_info) {
+  vector<mpc_t> sa;
+  vector<double> da;
+  plain_decode(in, sa);
+  internal_->Decode(sa, da);
+  rosetta::convert::to_binary_str<double>(da, out);
+  return 0;
+}
+
+int PlainFixpointOpsImpl::RandSeed(std::string op_seed, string& out_str) {
+  std::random_device rd;
+  mpc_t seed = ((mpc_t)rd() << 32) | rd();
+  rosetta::convert::to_binary_str(seed, out_str);
+  return 0;
+}
+
+int PlainFixpointOpsImpl::PrivateInput(
+  const string& node_id,
+  const vector<double>& in_x,
+  vector<string>& out_x) {
+  tlog_debug << "----> PlainFixpoint PrivateInput from " << node_id;
+  vector<mpc_t> sa;
+  internal_->Encode(in_x, sa);
+  plain_encode(sa, out_x);
+  return 0;
+}
+
+int PlainFixpointOpsImpl::PublicInput(
+  const string& node_id,
+  const vector<double>& in_x,
+  vector<string>& out_x) {
+  convert_double_to_literal_str(in_x, out_x, context_->GetFixPointPrecision());
+  return 0;
+}
+
+int PlainFixpointOpsImpl::Broadcast(const string& from_node, const string& msg, string& result) {
+  result = msg;
+  return 0;
+}
+
+int PlainFixpointOpsImpl::Broadcast(
+  const string& from_node,
+  const char* msg,
+  char* result,
+  size_t size) {
+  memcpy(result, msg, size);
+  return 0;
+}
+
+int PlainFixpointOpsImpl::ConditionalReveal(
+  vector<string>& in_vec,
+  vector<string>& out_cipher_vec,
+  vector<double>& out_plain_vec) {
+  const SaverModel& save_model = context_->SAVER_MODEL;
+  if (save_model.is_local_ciphertext_mode() || save_model.is_ciphertext_mode()) {
+    out_cipher_vec = in_vec;
+    out_plain_vec.clear();
+    return 0;
+  }
+
+  // the single process owns every node, so the plaintext model always lands here
+  vector<mpc_t> sa;
+  plain_decode(in_vec, sa);
+  internal_->Decode(sa, out_plain_vec);
+  out_cipher_vec.clear();
+  return 0;
+}
+
+PLAIN_PROTOCOL_BINARY_OP(Add)
+PLAIN_PROTOCOL_BINARY_OP(Sub)
+PLAIN_PROTOCOL_BINARY_OP(Mul)
+PLAIN_PROTOCOL_BINARY_OP(Floordiv)
+PLAIN_PROTOCOL_BINARY_OP(Less)
+PLAIN_PROTOCOL_BINARY_OP(LessEqual)
+PLAIN_PROTOCOL_BINARY_OP(Equal)
+PLAIN_PROTOCOL_BINARY_OP(NotEqual)
+PLAIN_PROTOCOL_BINARY_OP(Greater)
+PLAIN_PROTOCOL_BINARY_OP(GreaterEqual)
+PLAIN_PROTOCOL_BINARY_OP(AND)
+PLAIN_PROTOCOL_BINARY_OP(OR)
+PLAIN_PROTOCOL_BINARY_OP(XOR)
+
+int PlainFixpointOpsImpl::Div(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint Div";
+  vector<mpc_t> sa, sb, sc;
+  if (GET_ATTR_TAG(attr_info, "lh_is_const"))
+    internal_->Encode(a, sa);
+  else
+    plain_decode(a, sa);
+
+  if (GET_ATTR_TAG(attr_info, "rh_is_const")) {
+    // constant denominator is turned into a (scaled) multiplication, as in SecureNN
+    vector<double> db;
+    rosetta::convert::from_double_str(b, db);
+    internal_->Division(sa, db, sc);
+  } else {
+    plain_decode(b, sb);
+    internal_->Division(sa, sb, sc);
+  }
+  plain_encode(sc, output);
+  tlog_debug << "PlainFixpoint Div ok. <----";
+  return 0;
+}
+
+int PlainFixpointOpsImpl::Truediv(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  return Div(a, b, output, attr_info);
+}
+
+int PlainFixpointOpsImpl::Reciprocaldiv(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  return Div(a, b, output, attr_info);
+}
+
+int PlainFixpointOpsImpl::Pow(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint Pow";
+  vector<mpc_t> sa, sc;
+  plain_decode(a, sa);
+
+  //! @attention: only support const b, as SecureNN
+  vector<int64_t> n(a.size(), 0);
+  if (b.size() == 1) {
+    n.assign(a.size(), std::stoll(b[0]));
+  } else {
+    rosetta::convert::from_int_str(b, n);
+  }
+  internal_->Pow(sa, n, sc);
+  plain_encode(sc, output);
+  tlog_debug << "PlainFixpoint Pow ok. <----";
+  return 0;
+}
+
+int PlainFixpointOpsImpl::Matmul(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint Matmul";
+  if (!(attr_info && attr_info->count("m") > 0 && attr_info->count("n") > 0 && attr_info->count("k") > 0)) {
+    log_error << "please fill m, k, n for PlainFixpoint Matmul(x, y, m, n, k, transpose_a, transpose_b) ";
+    return -1;
+  }
+  int m = std::stoi(attr_info->at("m"));
+  int k = std::stoi(attr_info->at("k"));
+  int n = std::stoi(attr_info->at("n"));
+  bool transpose_a = GET_ATTR_TAG(attr_info, "transpose_a");
+  bool transpose_b = GET_ATTR_TAG(attr_info, "transpose_b");
+
+  vector<mpc_t> sa, sb, sc;
+  plain_decode(a, sa);
+  plain_decode(b, sb);
+  internal_->MatMul(sa, sb, sc, m, k, n, transpose_a, transpose_b);
+  plain_encode(sc, output);
+  tlog_debug << "PlainFixpoint Matmul ok. <----";
+  return 0;
+}
+
+int PlainFixpointOpsImpl::LayerNorm(
+  const vector<string>& x,
+  const vector<string>& gamma,
+  const vector<string>& beta,
+  vector<string>& y,
+  vector<string>& inv_std,
+  const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint LayerNorm";
+  if (!(attr_info && attr_info->count("rows") > 0 && attr_info->count("cols") > 0)) {
+    log_error << "please fill rows, cols for PlainFixpoint LayerNorm(x, gamma, beta, rows, cols, epsilon) ";
+    return -1;
+  }
+  size_t rows = std::stoull(attr_info->at("rows"));
+  size_t cols = std::stoull(attr_info->at("cols"));
+  double epsilon = attr_info->count("epsilon") > 0 ? std::stod(attr_info->at("epsilon")) : 1e-5;
+
+  vector<mpc_t> sx, sgamma, sbeta, sy, sinv_std;
+  plain_decode(x, sx);
+  plain_decode(gamma, sgamma);
+  plain_decode(beta, sbeta);
+  internal_->LayerNorm(sx, sgamma, sbeta, sy, sinv_std, rows, cols, epsilon);
+  plain_encode(sy, y);
+  plain_encode(sinv_std, inv_std);
+  tlog_debug << "PlainFixpoint LayerNorm ok. <----";
+  return 0;
+}
+
+int PlainFixpointOpsImpl::LayerNormGrad(
+  const vector<string>& x,
+  const vector<string>& gamma,
+  const vector<string>& inv_std,
+  const vector<string>& dy,
+  vector<string>& dx,
+  vector<string>& dgamma,
+  vector<string>& dbeta,
+  const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint LayerNormGrad";
+  if (!(attr_info && attr_info->count("rows") > 0 && attr_info->count("cols") > 0)) {
+    log_error << "please fill rows, cols for PlainFixpoint LayerNormGrad(x, gamma, inv_std, dy, rows, cols) ";
+    return -1;
+  }
+  size_t rows = std::stoull(attr_info->at("rows"));
+  size_t cols = std::stoull(attr_info->at("cols"));
+
+  vector<mpc_t> sx, sgamma, sinv_std, sdy, sdx, sdgamma, sdbeta;
+  plain_decode(x, sx);
+  plain_decode(gamma, sgamma);
+  plain_decode(inv_std, sinv_std);
+  plain_decode(dy, sdy);
+  internal_->LayerNormGrad(sx, sgamma, sinv_std, sdy, sdx, sdgamma, sdbeta, rows, cols);
+  plain_encode(sdx, dx);
+  plain_encode(sdgamma, dgamma);
+  plain_encode(sdbeta, dbeta);
+  tlog_debug << "PlainFixpoint LayerNormGrad ok. <----";
+  return 0;
+}
+
+int PlainFixpointOpsImpl::DPNoise(
+  const vector<string>& a,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint DPNoise";
+  if (!(attr_info && attr_info->count("scale") > 0)) {
+    log_error << "please fill scale for PlainFixpoint DPNoise(x, mechanism, scale) ";
+    return -1;
+  }
+  string mechanism = attr_info->count("mechanism") > 0 ? attr_info->at("mechanism") : "gaussian";
+  if (mechanism != "gaussian" && mechanism != "laplace") {
+    log_error << "PlainFixpoint DPNoise not supported mechanism: " << mechanism;
+    return -1;
+  }
+  double scale = std::stod(attr_info->at("scale"));
+  if (!(scale > 0 && std::isfinite(scale))) {
+    log_error << "PlainFixpoint DPNoise scale should be positive, got " << scale;
+    return -1;
+  }
+
+  vector<mpc_t> sa, sb;
+  plain_decode(a, sa);
+  internal_->DPNoise(sa, mechanism, scale, sb);
+  plain_encode(sb, output);
+  tlog_debug << "PlainFixpoint DPNoise ok. <----";
+  return 0;
+}
+
+int PlainFixpointOpsImpl::ClipByL2Norm(
+  const vector<string>& a,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint ClipByL2Norm";
+  if (!(attr_info && attr_info->count("rows") > 0 && attr_info->count("cols") > 0 &&
+        attr_info->count("clip_norm") > 0)) {
+    log_error << "please fill rows, cols, clip_norm for PlainFixpoint ClipByL2Norm(x, rows, cols, clip_norm) ";
+    return -1;
+  }
+  size_t rows = std::stoull(attr_info->at("rows"));
+  size_t cols = std::stoull(attr_info->at("cols"));
+  double clip_norm = std::stod(attr_info->at("clip_norm"));
+  if (!(clip_norm > 0 && std::isfinite(clip_norm))) {
+    log_error << "PlainFixpoint ClipByL2Norm clip_norm should be positive, got " << clip_norm;
+    return -1;
+  }
+
+  vector<mpc_t> sa, sb;
+  plain_decode(a, sa);
+  internal_->ClipByL2Norm(sa, sb, rows, cols, clip_norm);
+  plain_encode(sb, output);
+  tlog_debug << "PlainFixpoint ClipByL2Norm ok. <----";
+  return 0;
+}
+
+int PlainFixpointOpsImpl::Dropout(
+  const vector<string>& a,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint Dropout";
+  if (!(attr_info && attr_info->count("rate") > 0)) {
+    log_error << "please fill rate for PlainFixpoint Dropout(x, rate, common_mask) ";
+    return -1;
+  }
+  double rate = std::stod(attr_info->at("rate"));
+
+  // nothing to hide here, the mask is always kept as a common one
+  vector<mpc_t> sa, sb(a.size());
+  plain_decode(a, sa);
+  MpcMask mask;
+  internal_->DropoutMask(sa.size(), rate, mask.common);
+  for (size_t i = 0; i < sa.size(); ++i)
+    sb[i] = internal_->Truncate(sa[i] * internal_->Encode(mask.common[i]));
+  context_->MASK_STORE->Put(_op_msg_id, mask);
+  plain_encode(sb, output);
+  tlog_debug << "PlainFixpoint Dropout ok. <----";
+  return 0;
+}
+
+int PlainFixpointOpsImpl::DropoutGrad(
+  const vector<string>& dy,
+  vector<string>& dx,
+  const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint DropoutGrad";
+  msg_id_t forward_msgid;
+  if (attr_info && attr_info->count("forward_msgid") > 0)
+    MsgIdMgr::Instance()->ResolveMsgId(attr_info->at("forward_msgid"), context_->TASK_ID, forward_msgid);
+  MpcMask mask;
+  if (!(attr_info && attr_info->count("forward_msgid") > 0 &&
+        context_->MASK_STORE->Get(forward_msgid, mask))) {
+    log_error << "PlainFixpoint DropoutGrad no mask of the Dropout op in forward_msgid";
+    return -1;
+  }
+
+  vector<mpc_t> sdy, sdx(dy.size());
+  plain_decode(dy, sdy);
+  for (size_t i = 0; i < sdy.size(); ++i)
+    sdx[i] = internal_->Truncate(sdy[i] * internal_->Encode(mask.common[i]));
+  plain_encode(sdx, dx);
+  tlog_debug << "PlainFixpoint DropoutGrad ok. <----";
+  return 0;
+}
+
+int PlainFixpointOpsImpl::TopK(
+  const vector<string>& a,
+  vector<string>& values,
+  vector<string>& indices,
+  const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint TopK";
+  if (!(attr_info && attr_info->count("rows") > 0 && attr_info->count("cols") > 0 &&
+        attr_info->count("k") > 0)) {
+    log_error << "please fill rows, cols, k for PlainFixpoint TopK(x, rows, cols, k) ";
+    return -1;
+  }
+  size_t rows = std::stoull(attr_info->at("rows"));
+  size_t cols = std::stoull(attr_info->at("cols"));
+  size_t k = std::stoull(attr_info->at("k"));
+  if (k == 0 || k > cols) {
+    log_error << "PlainFixpoint TopK k should be in [1, " << cols << "], got " << k;
+    return -1;
+  }
+
+  vector<mpc_t> sa, svalues, sindices;
+  plain_decode(a, sa);
+  internal_->TopK(sa, rows, cols, k, svalues, sindices);
+  plain_encode(svalues, values);
+  plain_encode(sindices, indices);
+  tlog_debug << "PlainFixpoint TopK ok. <----";
+  return 0;
+}
+
+int PlainFixpointOpsImpl::OneHot(const vector<string>& a, vector<string>& b, const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint OneHot";
+  if (!(attr_info && attr_info->count("depth") > 0)) {
+    log_error << "please fill depth for PlainFixpoint OneHot(x, depth) ";
+    return -1;
+  }
+  size_t depth = std::stoull(attr_info->at("depth"));
+  if (depth == 0) {
+    log_error << "PlainFixpoint OneHot depth should be positive";
+    return -1;
+  }
+
+  vector<mpc_t> sa, sb;
+  plain_decode(a, sa);
+  internal_->OneHot(sa, depth, sb);
+  plain_encode(sb, b);
+  tlog_debug << "PlainFixpoint OneHot ok. <----";
+  return 0;
+}
+
+int PlainFixpointOpsImpl::OneHotToIndex(
+  const vector<string>& a,
+  vector<string>& b,
+  const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint OneHotToIndex";
+  if (!(attr_info && attr_info->count("depth") > 0)) {
+    log_error << "please fill depth for PlainFixpoint OneHotToIndex(x, depth) ";
+    return -1;
+  }
+  size_t depth = std::stoull(attr_info->at("depth"));
+  if (depth == 0 || a.size() % depth != 0) {
+    log_error << "PlainFixpoint OneHotToIndex input size " << a.size() << " is not a multiple of depth " << depth;
+    return -1;
+  }
+
+  vector<mpc_t> sa, sb;
+  plain_decode(a, sa);
+  internal_->OneHotToIndex(sa, depth, sb);
+  plain_encode(sb, b);
+  tlog_debug << "PlainFixpoint OneHotToIndex ok. <----";
+  return 0;
+}
+
+PLAIN_PROTOCOL_UNARY_OP(Square)
+PLAIN_PROTOCOL_UNARY_OP(Negative)
+PLAIN_PROTOCOL_UNARY_OP(Abs)
+PLAIN_PROTOCOL_UNARY_OP(AbsPrime)
+PLAIN_PROTOCOL_UNARY_OP(Log)
+PLAIN_PROTOCOL_UNARY_OP(Log1p)
+PLAIN_PROTOCOL_UNARY_OP(HLog)
+PLAIN_PROTOCOL_UNARY_OP(Relu)
+PLAIN_PROTOCOL_UNARY_OP(ReluPrime)
+PLAIN_PROTOCOL_UNARY_OP(Sigmoid)
+PLAIN_PROTOCOL_UNARY_OP(Tanh)
+PLAIN_PROTOCOL_UNARY_OP(TanhGrad)
+PLAIN_PROTOCOL_UNARY_OP(Gelu)
+PLAIN_PROTOCOL_UNARY_OP(GeluGrad)
+PLAIN_PROTOCOL_UNARY_OP(Swish)
+PLAIN_PROTOCOL_UNARY_OP(SwishGrad)
+PLAIN_PROTOCOL_UNARY_OP(Softplus)
+PLAIN_PROTOCOL_UNARY_OP(SoftplusGrad)
+PLAIN_PROTOCOL_UNARY_OP(Sqrt)
+PLAIN_PROTOCOL_UNARY_OP(Rsqrt)
+PLAIN_PROTOCOL_UNARY_OP(Exp)
+PLAIN_PROTOCOL_UNARY_OP(NOT)
+
+PLAIN_PROTOCOL_REDUCE_OP(Max)
+PLAIN_PROTOCOL_REDUCE_OP(Min)
+PLAIN_PROTOCOL_REDUCE_OP(Mean)
+PLAIN_PROTOCOL_REDUCE_OP(Sum)
+PLAIN_PROTOCOL_REDUCE_OP(AddN)
+PLAIN_PROTOCOL_REDUCE_OP(Softmax)
+
+int PlainFixpointOpsImpl::Invert(
+  const vector<string>& a,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  vector<mpc_t> sa, sc;
+  plain_decode(a, sa);
+  vector<mpc_t> one(sa.size(), internal_->One());
+  internal_->Division(one, sa, sc);
+  plain_encode(sc, output);
+  return 0;
+}
+
+int PlainFixpointOpsImpl::SigmoidCrossEntropy(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint SigmoidCrossEntropy";
+  vector<mpc_t> sa, sb, sc;
+  plain_decode(a, sa);
+  plain_decode(b, sb);
+  internal_->SigmoidCrossEntropy(sa, sb, sc);
+  plain_encode(sc, output);
+  tlog_debug << "PlainFixpoint SigmoidCrossEntropy ok. <----";
+  return 0;
+}
+
+int PlainFixpointOpsImpl::Sort(vector<string>& A, const attr_type* attr_info) {
+  vector<string> R;
+  return Sort(A, R, attr_info);
+}
+
+int PlainFixpointOpsImpl::Sort(vector<string>& A, vector<string>& R, const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint Sort";
+  if (A.empty() || (A.size() & (A.size() - 1)) != 0) {
+    log_error << "PlainFixpoint Sort input size should be a power of 2, got " << A.size();
+    return -1;
+  }
+
+  vector<mpc_t> sa, sr;
+  plain_decode(A, sa);
+  internal_->Sort(sa, GET_ATTR_TAG(attr_info, "descending"), sr);
+  plain_encode(sa, A);
+  plain_encode(sr, R);
+  tlog_debug << "PlainFixpoint Sort ok. <----";
+  return 0;
+}
+
+int PlainFixpointOpsImpl::PermutationOf(
+  vector<string>& A,
+  const vector<string>& R,
+  const attr_type* attr_info,
+  bool inverse) {
+  size_t cols = 1;
+  if (attr_info && attr_info->count("cols") > 0)
+    cols = std::stoull(attr_info->at("cols"));
+  size_t rows = cols == 0 ? 0 : A.size() / cols;
+  if (rows == 0 || rows * cols != A.size() || (rows & (rows - 1)) != 0) {
+    log_error << "PlainFixpoint Permutation takes 2^k rows of " << cols << ", got " << A.size() << " values";
+    return -1;
+  }
+  vector<std::pair<size_t, size_t>> pairs;
+  plain::PlainInternal::BitonicNetwork(rows, pairs);
+  if (R.size() != pairs.size()) {
+    log_error << "PlainFixpoint Permutation of " << rows << " rows takes the " << pairs.size()
+              << " swaps of their Sort, got " << R.size();
+    return -1;
+  }
+
+  vector<mpc_t> sa, sr;
+  plain_decode(A, sa);
+  plain_decode(R, sr);
+  internal_->Permutation(sa, sr, cols, inverse);
+  plain_encode(sa, A);
+  return 0;
+}
+
+int PlainFixpointOpsImpl::Permutation(vector<string>& A, const vector<string>& R, const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint Permutation";
+  int ret = PermutationOf(A, R, attr_info, false);
+  tlog_debug << "PlainFixpoint Permutation ok. <----";
+  return ret;
+}
+
+int PlainFixpointOpsImpl::InversePermutation(
+  vector<string>& A,
+  const vector<string>& R,
+  const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint InversePermutation";
+  int ret = PermutationOf(A, R, attr_info, true);
+  tlog_debug << "PlainFixpoint InversePermutation ok. <----";
+  return ret;
+}
+
+int PlainFixpointOpsImpl::Reveal(
+  const vector<string>& a,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  vector<double> dvalues;
+  Reveal(a, dvalues, attr_info);
+  output.resize(dvalues.size());
+  for (size_t i = 0; i < dvalues.size(); ++i) {
+    output[i] = std::to_string(dvalues[i]);
+  }
+  return 0;
+}
+
+int PlainFixpointOpsImpl::Reveal(
+  const vector<string>& a,
+  vector<double>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> PlainFixpoint Reveal";
+  // every receive_parties setting resolves to this single process
+  vector<mpc_t> sa;
+  plain_decode(a, sa);
+  internal_->Decode(sa, output);
+  AUDIT("id:{}, P{} Reveal, output{}", _op_msg_id.get_hex(), context_->GetMyRole(), Vector<double>(output));
+  tlog_debug << "PlainFixpoint Reveal ok. <----";
+  return 0;
+}
+
+} // namespace rosetta
@@ -0,0 +1,112 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if !__SIZEOF_INT128__
+#error the Shamir backend needs a compiler with unsigned __int128
+#endif
+
+namespace rosetta {
+namespace shamir {
+
+/**
+ * The prime field GF(p), p = 2^127 - 1.
+ *
+ * Fixed-point values x are encoded as round(x * 2^f) mod p, negatives in the
+ * upper half. The field is large enough for a product of two encoded values
+ * (|x * y| < 2^(kValueBits - 2f)) plus a statistical mask of kSigma bits,
+ * so that truncation never wraps around p.
+ */
+typedef unsigned __int128 field_t;
+typedef __int128 signed_field_t;
+
+static const field_t kPrime = (field_t(1) << 127) - 1;
+// bound of a product before truncation, and the statistical security of the masks
+static const int kValueBits = 80;
+static const int kSigma = 40;
+
+inline field_t fadd(field_t a, field_t b) {
+  field_t s = a + b;
+  return s >= kPrime ? s - kPrime : s;
+}
+
+inline field_t fsub(field_t a, field_t b) {
+  return a >= b ? a - b : a + kPrime - b;
+}
+
+inline field_t fneg(field_t a) {
+  return a == 0 ? 0 : kPrime - a;
+}
+
+inline field_t fmul(field_t a, field_t b) {
+  // 254-bit product from 64-bit limbs, then 2^127 = 1 (mod p)
+  uint64_t a0 = (uint64_t)a, a1 = (uint64_t)(a >> 64);
+  uint64_t b0 = (uint64_t)b, b1 = (uint64_t)(b >> 64);
+  field_t p00 = (field_t)a0 * b0;
+  field_t mid = (field_t)a0 * b1 + (field_t)a1 * b0;
+  field_t p11 = (field_t)a1 * b1;
+  field_t lo = p00 + (mid << 64);
+  field_t hi = p11 + (mid >> 64) + (lo < p00 ? 1 : 0);
+  field_t r = (lo & kPrime) + ((hi << 1) | (lo >> 127));
+  r = (r & kPrime) + (r >> 127);
+  return r >= kPrime ? r - kPrime : r;
+}
+
+inline field_t fpow(field_t a, field_t e) {
+  field_t r = 1;
+  while (e) {
+    if (e & 1)
+      r = fmul(r, a);
+    a = fmul(a, a);
+    e >>= 1;
+  }
+  return r;
+}
+
+inline field_t finv(field_t a) {
+  return fpow(a, kPrime - 2);
+}
+
+//! a square root of a quadratic residue, p = 3 (mod 4)
+inline field_t fsqrt(field_t a) {
+  return fpow(a, (kPrime + 1) >> 2);
+}
+
+inline field_t from_signed(signed_field_t v) {
+  return v >= 0 ? field_t(v) % kPrime : fneg(field_t(-v) % kPrime);
+}
+
+inline signed_field_t to_signed(field_t a) {
+  return a > (kPrime >> 1) ? -signed_field_t(kPrime - a) : signed_field_t(a);
+}
+
+inline field_t encode_fixed(double x, int float_precision) {
+  return from_signed((signed_field_t)std::llround(std::ldexp(x, float_precision)));
+}
+
+inline double decode_fixed(field_t a, int float_precision) {
+  return std::ldexp((double)to_signed(a), -float_precision);
+}
+
+} // namespace shamir
+} // namespace rosetta
@@ -0,0 +1,61 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+#include "cc/modules/protocol/mpc/comm/include/mpc_protocol.h"
+#include "cc/modules/protocol/mpc/shamir/include/shamir_internal.h"
+
+namespace rosetta {
+
+/**
+ * Shamir is an n-party backend with an honest majority.
+ *
+ * Values are shared with polynomials of degree t = (n - 1) / 2 over
+ * GF(2^127 - 1), one point per computation party, so any t parties learn
+ * nothing and any t + 1 can reconstruct. There is no fixed number of parties:
+ * they are the COMPUTATION_NODES of the network config, and data and result
+ * nodes may be any others.
+ *
+ * Linear ops are local. Mul and Matmul cost one open of the masked local
+ * product, which is also the truncation. Comparisons take about ten rounds
+ * (see ShamirInternal). Only semi-honest security is claimed.
+ */
+class ShamirProtocol : public MpcProtocol {
+ public:
+  ShamirProtocol(const string& task_id="") : MpcProtocol("Shamir", 3, task_id) {
+    params_ = std::make_shared<shamir::ShamirParams>();
+  }
+
+  shared_ptr<ProtocolOps> GetOps(const msg_id_t& msgid);
+
+ protected:
+  //! the points and interpolation coefficients of the computation parties
+  int OfflinePreprocess();
+
+ private:
+  shared_ptr<shamir::ShamirParams> params_ = nullptr;
+};
+
+class ShamirProtocolFactory : public IProtocolFactory {
+ public:
+  ShamirProtocolFactory() {}
+
+ public:
+  shared_ptr<ProtocolBase> Create(const string& task_id="") { return std::make_shared<ShamirProtocol>(task_id); }
+};
+
+} // namespace rosetta
@@ -0,0 +1,122 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include "cc/modules/protocol/public/include/protocol_base.h"
+#include "cc/modules/protocol/mpc/shamir/include/shamir_field.h"
+#include "cc/modules/protocol/utility/include/prg.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace rosetta {
+namespace shamir {
+
+/**
+ * The public parameters of one Shamir instance: n computation parties,
+ * polynomials of degree t = (n - 1) / 2, and party j at the point j + 1.
+ */
+struct ShamirParams {
+  int n = 0;
+  int t = 0;
+  int party = -1; // -1 on nodes that only give inputs or get results
+  // x_j^k of party j, k <= 2t
+  vector<vector<field_t>> powers;
+  // Lagrange coefficients at 0 over all n points, for any degree below n
+  vector<field_t> lambda;
+
+  void Init(int parties, int my_party);
+  bool IsComputation() const { return party >= 0; }
+};
+
+/**
+ * The protocols of the Shamir backend, on field elements.
+ *
+ * Semi-honest with an honest majority (n >= 2t + 1):
+ * - Mul without truncation reshares the local degree-2t product (GRR), one round.
+ * - Truncate opens x + 2^k + r, with r = 2^m * r_hi + r_lo summed from random
+ *   contributions of all parties, and takes the public high part minus r_hi
+ *   (Catrina-Saxena). A degree-2t input gets a random degree-2t sharing of 0,
+ *   so that Mul + Truncate is a single open. The result is off by at most n LSBs.
+ * - DReLU is the exact MSB of x + 2^(l-1) (Catrina-de Hoogh): random bits by
+ *   the square root of an opened square, one open, and a log-depth bitwise
+ *   comparison.
+ */
+class ShamirInternal {
+ public:
+  ShamirInternal(
+    const msg_id_t& msgid,
+    shared_ptr<NET_IO> net_io,
+    const ShamirParams& params,
+    int float_precision);
+
+  const msg_id_t& msg_id() const { return msgid_; }
+
+  //! shares of the owner's values, on every computation party. The owner may be any node.
+  void Input(const string& owner, const vector<field_t>& values, size_t size, vector<field_t>& shares);
+
+  //! the values of the shares, on the given nodes (computation parties or not)
+  void Reveal(const vector<field_t>& shares, size_t size, const vector<string>& nodes, vector<field_t>& values);
+
+  //! opens the shares (of any degree below n) to all computation parties
+  void Open(const vector<field_t>& shares, vector<field_t>& values);
+
+  //! c = a * b, without truncation
+  void Mul(const vector<field_t>& a, const vector<field_t>& b, vector<field_t>& c);
+
+  //! the degree-2t product h, back to degree t
+  void Reduce(const vector<field_t>& h, vector<field_t>& c);
+
+  //! a / 2^float_precision, for a of degree t, or of degree 2t (a local product)
+  void Truncate(const vector<field_t>& a, vector<field_t>& c, bool high_degree);
+
+  //! shares of count random bits
+  void RandBits(size_t count, vector<field_t>& bits);
+
+  //! shares of (c < r) for public c and shared r, both of bits bits, r given by its bits
+  void BitLessThan(const vector<field_t>& c, const vector<field_t>& r_bits, int bits, vector<field_t>& lt);
+
+  //! shares of (x >= 0), scaled by 2^float_precision
+  void DReLU(const vector<field_t>& x, vector<field_t>& y);
+
+ private:
+  // shares of the secrets, as shares[party][i]
+  void Share(const vector<field_t>& secrets, int degree, vector<vector<field_t>>& shares);
+  // every party shares its own secrets, and everyone gets the shares of their sums
+  void JointShare(
+    const vector<field_t>& low_secrets,
+    const vector<field_t>& high_secrets,
+    vector<field_t>& low_sum,
+    vector<field_t>& high_sum);
+  // to[j] goes to party j, from[j] comes from party j, all at once
+  void Exchange(const vector<vector<field_t>>& to, vector<vector<field_t>>& from);
+
+  field_t RandomElement();
+  field_t RandomBits(int bits);
+
+ private:
+  msg_id_t msgid_;
+  shared_ptr<NET_IO> net_io_ = nullptr;
+  const ShamirParams& params_;
+  int float_precision_ = 0;
+  RttPRG prg_;
+};
+
+} // namespace shamir
+} // namespace rosetta
@@ -0,0 +1,43 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/shamir/include/shamir_impl.h"
+#include "cc/modules/protocol/mpc/shamir/include/shamir_ops_impl.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <string>
+using namespace std;
+
+namespace rosetta {
+
+int ShamirProtocol::OfflinePreprocess() {
+  parties_ = net_io_->GetComputationNodes().size();
+  params_->Init(parties_, net_io_->GetCurrentPartyId());
+  if (parties_ < 3) {
+    tlog_error << "Shamir needs at least 3 computation nodes for an honest majority, got " << parties_;
+    return -1;
+  }
+  tlog_info << "Shamir: " << parties_ << " parties, threshold " << params_->t
+            << (params_->IsComputation() ? "" : ", this node only gives inputs or gets results");
+  return 0;
+}
+
+shared_ptr<ProtocolOps> ShamirProtocol::GetOps(const msg_id_t& msgid) {
+  return make_shared<ShamirOpsImpl>(msgid, context_, net_io_, params_);
+}
+
+} // namespace rosetta
@@ -0,0 +1,360 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/shamir/include/shamir_internal.h"
+#include "cc/modules/common/include/utils/generate_key.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace rosetta {
+namespace shamir {
+
+// the comparison input, at the fixed-point scale, has |x| < 2^(kCmpBits - 1)
+static const int kCmpBits = 64;
+
+void ShamirParams::Init(int parties, int my_party) {
+  n = parties;
+  t = (n - 1) / 2;
+  party = my_party;
+
+  powers.assign(n, vector<field_t>(2 * t + 1, 1));
+  for (int j = 0; j < n; ++j)
+    for (int k = 1; k <= 2 * t; ++k)
+      powers[j][k] = fmul(powers[j][k - 1], field_t(j + 1));
+
+  lambda.assign(n, 1);
+  for (int i = 0; i < n; ++i) {
+    field_t num = 1, den = 1;
+    for (int j = 0; j < n; ++j) {
+      if (j == i)
+        continue;
+      num = fmul(num, field_t(j + 1));
+      den = fmul(den, fsub(field_t(j + 1), field_t(i + 1)));
+    }
+    lambda[i] = fmul(num, finv(den));
+  }
+}
+
+ShamirInternal::ShamirInternal(
+  const msg_id_t& msgid,
+  shared_ptr<NET_IO> net_io,
+  const ShamirParams& params,
+  int float_precision)
+    : msgid_(msgid),
+      net_io_(net_io),
+      params_(params),
+      float_precision_(float_precision),
+      prg_(gen_key_str()) {}
+
+field_t ShamirInternal::RandomElement() {
+  field_t v = 0;
+  prg_.randomDatas(&v, sizeof(v));
+  v &= kPrime;
+  return v == kPrime ? 0 : v;
+}
+
+field_t ShamirInternal::RandomBits(int bits) {
+  field_t v = 0;
+  prg_.randomDatas(&v, sizeof(v));
+  return v & ((field_t(1) << bits) - 1);
+}
+
+void ShamirInternal::Share(const vector<field_t>& secrets, int degree, vector<vector<field_t>>& shares) {
+  size_t size = secrets.size();
+  shares.assign(params_.n, vector<field_t>(size));
+  vector<field_t> coef(degree + 1);
+  for (size_t i = 0; i < size; ++i) {
+    coef[0] = secrets[i];
+    for (int k = 1; k <= degree; ++k)
+      coef[k] = RandomElement();
+    for (int j = 0; j < params_.n; ++j) {
+      field_t s = coef[0];
+      for (int k = 1; k <= degree; ++k)
+        s = fadd(s, fmul(coef[k], params_.powers[j][k]));
+      shares[j][i] = s;
+    }
+  }
+}
+
+void ShamirInternal::Exchange(const vector<vector<field_t>>& to, vector<vector<field_t>>& from) {
+  int me = params_.party;
+  from.resize(params_.n);
+  for (int j = 0; j < params_.n; ++j) {
+    if (j != me)
+      net_io_->send(j, to[j], to[j].size(), msgid_);
+  }
+  for (int j = 0; j < params_.n; ++j) {
+    if (j == me) {
+      from[j] = to[j];
+    } else {
+      from[j].resize(to[j].size());
+      net_io_->recv(j, from[j], from[j].size(), msgid_);
+    }
+  }
+}
+
+void ShamirInternal::JointShare(
+  const vector<field_t>& low_secrets,
+  const vector<field_t>& high_secrets,
+  vector<field_t>& low_sum,
+  vector<field_t>& high_sum) {
+  size_t nl = low_secrets.size(), nh = high_secrets.size();
+  vector<vector<field_t>> low, high, to(params_.n), from;
+  Share(low_secrets, params_.t, low);
+  Share(high_secrets, 2 * params_.t, high);
+  for (int j = 0; j < params_.n; ++j) {
+    to[j] = low[j];
+    to[j].insert(to[j].end(), high[j].begin(), high[j].end());
+  }
+  Exchange(to, from);
+
+  low_sum.assign(nl, 0);
+  high_sum.assign(nh, 0);
+  for (int j = 0; j < params_.n; ++j) {
+    for (size_t i = 0; i < nl; ++i)
+      low_sum[i] = fadd(low_sum[i], from[j][i]);
+    for (size_t i = 0; i < nh; ++i)
+      high_sum[i] = fadd(high_sum[i], from[j][nl + i]);
+  }
+}
+
+void ShamirInternal::Input(
+  const string& owner,
+  const vector<field_t>& values,
+  size_t size,
+  vector<field_t>& shares) {
+  shares.assign(size, 0);
+  bool is_owner = net_io_->GetCurrentNodeId() == owner;
+  if (is_owner) {
+    vector<vector<field_t>> all;
+    Share(values, params_.t, all);
+    for (int j = 0; j < params_.n; ++j) {
+      if (j == params_.party)
+        shares = all[j];
+      else
+        net_io_->send(j, all[j], size, msgid_);
+    }
+  } else if (params_.IsComputation()) {
+    net_io_->recv(owner, shares, size, msgid_);
+  }
+}
+
+void ShamirInternal::Reveal(
+  const vector<field_t>& shares,
+  size_t size,
+  const vector<string>& nodes,
+  vector<field_t>& values) {
+  const string& me = net_io_->GetCurrentNodeId();
+  if (params_.IsComputation()) {
+    for (auto& node : nodes) {
+      if (node != me)
+        net_io_->send(node, shares, size, msgid_);
+    }
+  }
+
+  values.assign(size, 0);
+  if (std::find(nodes.begin(), nodes.end(), me) == nodes.end())
+    return;
+  vector<field_t> other(size);
+  for (int j = 0; j < params_.n; ++j) {
+    const vector<field_t>* s = &shares;
+    if (j != params_.party) {
+      net_io_->recv(j, other, size, msgid_);
+      s = &other;
+    }
+    for (size_t i = 0; i < size; ++i)
+      values[i] = fadd(values[i], fmul(params_.lambda[j], (*s)[i]));
+  }
+}
+
+void ShamirInternal::Open(const vector<field_t>& shares, vector<field_t>& values) {
+  vector<vector<field_t>> to(params_.n, shares), from;
+  Exchange(to, from);
+  values.assign(shares.size(), 0);
+  for (int j = 0; j < params_.n; ++j)
+    for (size_t i = 0; i < shares.size(); ++i)
+      values[i] = fadd(values[i], fmul(params_.lambda[j], from[j][i]));
+}
+
+void ShamirInternal::Reduce(const vector<field_t>& h, vector<field_t>& c) {
+  // GRR: everyone reshares its point of the product, and interpolates the reshares
+  vector<vector<field_t>> to, from;
+  Share(h, params_.t, to);
+  Exchange(to, from);
+  c.assign(h.size(), 0);
+  for (int j = 0; j < params_.n; ++j)
+    for (size_t i = 0; i < h.size(); ++i)
+      c[i] = fadd(c[i], fmul(params_.lambda[j], from[j][i]));
+}
+
+void ShamirInternal::Mul(const vector<field_t>& a, const vector<field_t>& b, vector<field_t>& c) {
+  vector<field_t> h(a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    h[i] = fmul(a[i], b[i]);
+  Reduce(h, c);
+}
+
+void ShamirInternal::Truncate(const vector<field_t>& a, vector<field_t>& c, bool high_degree) {
+  size_t size = a.size();
+  const int m = float_precision_;
+
+  // my parts of r_lo < 2^m and r_hi < 2^(k + sigma - m), and of a random sharing of 0
+  vector<field_t> mine(2 * size), zeros(high_degree ? size : 0, 0), r, z;
+  for (size_t i = 0; i < size; ++i) {
+    mine[i] = RandomBits(m);
+    mine[size + i] = RandomBits(kValueBits + kSigma - m);
+  }
+  JointShare(mine, zeros, r, z);
+
+  // c = a + 2^k + r_lo + 2^m * r_hi, opened as an integer below p
+  const field_t shift = field_t(1) << kValueBits;
+  vector<field_t> masked(size), opened;
+  for (size_t i = 0; i < size; ++i) {
+    field_t v = fadd(fadd(a[i], r[i]), fmul(field_t(1) << m, r[size + i]));
+    if (high_degree)
+      v = fadd(v, z[i]);
+    // a public constant is added by every party
+    masked[i] = fadd(v, shift);
+  }
+  Open(masked, opened);
+
+  c.resize(size);
+  const field_t unshift = field_t(1) << (kValueBits - m);
+  for (size_t i = 0; i < size; ++i)
+    c[i] = fsub(fsub(opened[i] >> m, r[size + i]), unshift);
+}
+
+void ShamirInternal::RandBits(size_t count, vector<field_t>& bits) {
+  // b = (a / sqrt(a^2) + 1) / 2 for a random a, a^2 opened from a degree-2t product
+  vector<field_t> mine(count), zeros(count, 0), a, z, sq;
+  for (size_t i = 0; i < count; ++i)
+    mine[i] = RandomElement();
+  JointShare(mine, zeros, a, z);
+  vector<field_t> h(count);
+  for (size_t i = 0; i < count; ++i)
+    h[i] = fadd(fmul(a[i], a[i]), z[i]);
+  Open(h, sq);
+
+  static const field_t inv_root_exp = (kPrime - 1) - ((kPrime + 1) >> 2);
+  static const field_t inv2 = (kPrime + 1) >> 1;
+  bits.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    // a = 0 happens with probability 2^-127
+    field_t inv_root = sq[i] == 0 ? 1 : fpow(sq[i], inv_root_exp);
+    bits[i] = fmul(fadd(fmul(a[i], inv_root), 1), inv2);
+  }
+}
+
+void ShamirInternal::BitLessThan(
+  const vector<field_t>& c,
+  const vector<field_t>& r_bits,
+  int bits,
+  vector<field_t>& lt) {
+  size_t size = c.size();
+
+  // per bit, from the least significant one: eq = (c_j == r_j), lt = (c_j < r_j)
+  vector<vector<field_t>> eq(size, vector<field_t>(bits)), less(size, vector<field_t>(bits));
+  for (size_t i = 0; i < size; ++i) {
+    for (int j = 0; j < bits; ++j) {
+      field_t r = r_bits[i * bits + j];
+      bool cj = (c[i] >> j) & 1;
+      eq[i][j] = cj ? r : fsub(1, r);
+      less[i][j] = cj ? 0 : r;
+    }
+  }
+
+  // merge (hi, lo) neighbours: eq = eq_hi * eq_lo, lt = lt_hi + eq_hi * lt_lo
+  int segments = bits;
+  while (segments > 1) {
+    int pairs = segments / 2;
+    vector<field_t> x, y, xy;
+    x.reserve(2 * size * pairs);
+    y.reserve(2 * size * pairs);
+    for (size_t i = 0; i < size; ++i) {
+      for (int p = 0; p < pairs; ++p) {
+        x.push_back(eq[i][2 * p + 1]);
+        y.push_back(eq[i][2 * p]);
+        x.push_back(eq[i][2 * p + 1]);
+        y.push_back(less[i][2 * p]);
+      }
+    }
+    Mul(x, y, xy);
+
+    int next = (segments + 1) / 2;
+    size_t k = 0;
+    for (size_t i = 0; i < size; ++i) {
+      for (int p = 0; p < pairs; ++p) {
+        field_t lt_hi = less[i][2 * p + 1];
+        eq[i][p] = xy[k++];
+        less[i][p] = fadd(lt_hi, xy[k++]);
+      }
+      if (segments % 2) {
+        eq[i][pairs] = eq[i][segments - 1];
+        less[i][pairs] = less[i][segments - 1];
+      }
+    }
+    segments = next;
+  }
+
+  lt.resize(size);
+  for (size_t i = 0; i < size; ++i)
+    lt[i] = less[i][0];
+}
+
+void ShamirInternal::DReLU(const vector<field_t>& x, vector<field_t>& y) {
+  size_t size = x.size();
+  const int m = kCmpBits - 1;
+
+  // r = 2^m * r_hi + sum_j 2^j r_j, with the r_j shared bits
+  vector<field_t> r_bits, mine(size), none, r_hi, unused;
+  RandBits(size * m, r_bits);
+  for (size_t i = 0; i < size; ++i)
+    mine[i] = RandomBits(kSigma + 1);
+  JointShare(mine, none, r_hi, unused);
+
+  // a = x + 2^m is in [0, 2^(m+1)), and x >= 0 iff its bit m is set
+  const field_t two_m = field_t(1) << m;
+  vector<field_t> r_lo(size, 0), masked(size), opened;
+  for (size_t i = 0; i < size; ++i) {
+    for (int j = m - 1; j >= 0; --j)
+      r_lo[i] = fadd(fadd(r_lo[i], r_lo[i]), r_bits[i * m + j]);
+    masked[i] = fadd(fadd(fadd(x[i], two_m), r_lo[i]), fmul(two_m, r_hi[i]));
+  }
+  Open(masked, opened);
+
+  vector<field_t> c_lo(size), u;
+  for (size_t i = 0; i < size; ++i)
+    c_lo[i] = opened[i] & (two_m - 1);
+  BitLessThan(c_lo, r_bits, m, u);
+
+  // a mod 2^m = c_lo - r_lo + 2^m * u, and bit m = (a - a mod 2^m) / 2^m
+  const field_t inv_two_m = finv(two_m);
+  const field_t one = field_t(1) << float_precision_;
+  y.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    field_t a = fadd(x[i], two_m);
+    field_t a_lo = fadd(fsub(c_lo[i], r_lo[i]), fmul(two_m, u[i]));
+    field_t msb = fmul(fsub(a, a_lo), inv_two_m);
+    y[i] = fmul(msb, one);
+  }
+}
+
+} // namespace shamir
+} // namespace rosetta
@@ -0,0 +1,424 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/mpc/shamir/include/shamir_ops_impl.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_helper.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+#include "cc/modules/common/include/utils/str_type_convert.h"
+#include "cc/modules/common/include/utils/secure_encoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace rosetta::shamir;
+
+#define GET_ATTR_TAG(attr_info_ptr, tag) \
+  attr_info_ptr && attr_info_ptr->count(tag) > 0 && attr_info_ptr->at(tag) == "1"
+
+#define shamir_decode(a, sa)                                                      \
+  do {                                                                            \
+    if (0 != Decode(a, sa)) {                                                     \
+      log_error << "Shamir decode failed! In " << __FUNCTION__ << "#" << __LINE__; \
+      return -1;                                                                  \
+    }                                                                             \
+  } while (0)
+
+#define shamir_encode(sa, a)                                                      \
+  do {                                                                            \
+    if (0 != Encode(sa, a)) {                                                     \
+      log_error << "Shamir encode failed! In " << __FUNCTION__ << "#" << __LINE__; \
+      return -1;                                                                  \
+    }                                                                             \
+  } while (0)
+
+namespace rosetta {
+
+ShamirOpsImpl::ShamirOpsImpl(
+  const msg_id_t& msg_id,
+  shared_ptr<ProtocolContext> context,
+  shared_ptr<NET_IO> net_io,
+  shared_ptr<ShamirParams> params)
+    : ProtocolOps(msg_id, context),
+      net_io_(net_io),
+      params_(params),
+      internal_(msg_id, net_io, *params, context->FLOAT_PRECISION) {}
+
+int ShamirOpsImpl::Decode(const vector<string>& a, vector<field_t>& sa, bool is_const) {
+  sa.resize(a.size());
+  if (a.empty())
+    return 0;
+
+  if (!is_const && rosetta::convert::is_secure_text(a[0])) {
+    for (size_t i = 0; i < a.size(); ++i) {
+      memcpy((char*)&sa[i], a[i].data(), sizeof(field_t));
+    }
+    return 0;
+  }
+
+  // a public constant, the same on every party
+  vector<double> da(a.size());
+  if (rosetta::convert::is_binary_double(a[0])) {
+    for (size_t i = 0; i < a.size(); ++i) {
+      memcpy(&da[i], a[i].data(), sizeof(double));
+    }
+  } else {
+    rosetta::convert::from_double_str(a, da);
+  }
+  for (size_t i = 0; i < a.size(); ++i)
+    sa[i] = encode_fixed(da[i], context_->FLOAT_PRECISION);
+  return 0;
+}
+
+int ShamirOpsImpl::Encode(const vector<field_t>& sa, vector<string>& a) {
+  return rosetta::convert::encoder::encode_to_secure(sa, a);
+}
+
+bool ShamirOpsImpl::IsConst(const vector<string>& a, const attr_type* attr, const char* tag) const {
+  if (GET_ATTR_TAG(attr, tag))
+    return true;
+  return !a.empty() && !rosetta::convert::is_secure_text(a[0]);
+}
+
+bool ShamirOpsImpl::Idle(size_t size, vector<string>& output) {
+  if (params_->IsComputation())
+    return false;
+  Encode(vector<field_t>(size, 0), output);
+  return true;
+}
+
+int ShamirOpsImpl::TfToSecure(
+  const vector<string>& in,
+  vector<string>& out,
+  const attr_type* attr_info) {
+  vector<field_t> sa;
+  shamir_decode(in, sa);
+  shamir_encode(sa, out);
+  return 0;
+}
+
+int ShamirOpsImpl::SecureToTf(
+  const vector<string>& in,
+  vector<string>& out,
+  const attr_type* attr_info) {
+  vector<field_t> sa;
+  shamir_decode(in, sa);
+  vector<double> da(sa.size());
+  for (size_t i = 0; i < sa.size(); ++i)
+    da[i] = decode_fixed(sa[i], context_->FLOAT_PRECISION);
+  rosetta::convert::to_binary_str<double>(da, out);
+  return 0;
+}
+
+int ShamirOpsImpl::RandSeed(std::string op_seed, string& out_str) {
+  std::random_device rd;
+  mpc_t seed = ((mpc_t)rd() << 32) | rd();
+  rosetta::convert::to_binary_str(seed, out_str);
+  return 0;
+}
+
+int ShamirOpsImpl::PrivateInput(
+  const string& node_id,
+  const vector<double>& in_x,
+  vector<string>& out_x) {
+  tlog_debug << "----> Shamir PrivateInput from " << node_id;
+  size_t size = in_x.size();
+  vector<field_t> values(size, 0), shares;
+  if (net_io_->GetCurrentNodeId() == node_id) {
+    for (size_t i = 0; i < size; ++i)
+      values[i] = encode_fixed(in_x[i], context_->FLOAT_PRECISION);
+  }
+  internal_.Input(node_id, values, size, shares);
+  shamir_encode(shares, out_x);
+  return 0;
+}
+
+int ShamirOpsImpl::PublicInput(
+  const string& node_id,
+  const vector<double>& in_x,
+  vector<string>& out_x) {
+  convert_double_to_literal_str(in_x, out_x, context_->FLOAT_PRECISION);
+  return 0;
+}
+
+int ShamirOpsImpl::Broadcast(const string& from_node, const string& msg, string& result) {
+  result.resize(msg.size());
+  return Broadcast(from_node, msg.data(), &result[0], msg.size());
+}
+
+int ShamirOpsImpl::Broadcast(
+  const string& from_node,
+  const char* msg,
+  char* result,
+  size_t size) {
+  const string& me = net_io_->GetCurrentNodeId();
+  if (from_node == me) {
+    for (auto& node : net_io_->GetComputationNodes()) {
+      if (node.first != me)
+        net_io_->send(node.first, msg, size, msg_id());
+    }
+    memcpy(result, msg, size);
+  } else {
+    net_io_->recv(from_node, result, size, msg_id());
+  }
+  return 0;
+}
+
+int ShamirOpsImpl::Add(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> Shamir Add";
+  vector<field_t> sa, sb;
+  shamir_decode(a, sa);
+  shamir_decode(b, sb);
+  for (size_t i = 0; i < sa.size(); ++i)
+    sa[i] = fadd(sa[i], sb[i]);
+  shamir_encode(sa, output);
+  return 0;
+}
+
+int ShamirOpsImpl::Sub(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> Shamir Sub";
+  vector<field_t> sa, sb;
+  shamir_decode(a, sa);
+  shamir_decode(b, sb);
+  for (size_t i = 0; i < sa.size(); ++i)
+    sa[i] = fsub(sa[i], sb[i]);
+  shamir_encode(sa, output);
+  return 0;
+}
+
+int ShamirOpsImpl::Negative(const vector<string>& a, vector<string>& output, const attr_type* attr_info) {
+  tlog_debug << "----> Shamir Negative";
+  vector<field_t> sa;
+  shamir_decode(a, sa);
+  for (size_t i = 0; i < sa.size(); ++i)
+    sa[i] = fneg(sa[i]);
+  shamir_encode(sa, output);
+  return 0;
+}
+
+int ShamirOpsImpl::Mul(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> Shamir Mul";
+  if (Idle(a.size(), output))
+    return 0;
+  bool a_const = IsConst(a, attr_info, "lh_is_const");
+  bool b_const = IsConst(b, attr_info, "rh_is_const");
+  vector<field_t> sa, sb, sc;
+  if (0 != Decode(a, sa, a_const) || 0 != Decode(b, sb, b_const)) {
+    log_error << "Shamir decode failed! In " << __FUNCTION__;
+    return -1;
+  }
+
+  // by a constant the product stays of degree t, else it is of degree 2t
+  vector<field_t> h(sa.size());
+  for (size_t i = 0; i < sa.size(); ++i)
+    h[i] = fmul(sa[i], sb[i]);
+  internal_.Truncate(h, sc, !(a_const || b_const));
+  shamir_encode(sc, output);
+  tlog_debug << "Shamir Mul ok. <----";
+  return 0;
+}
+
+int ShamirOpsImpl::Square(const vector<string>& a, vector<string>& output, const attr_type* attr_info) {
+  tlog_debug << "----> Shamir Square";
+  return Mul(a, a, output, attr_info);
+}
+
+int ShamirOpsImpl::Matmul(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> Shamir Matmul";
+  if (!(attr_info && attr_info->count("m") > 0 && attr_info->count("n") > 0 && attr_info->count("k") > 0)) {
+    log_error << "please fill m, k, n for Shamir Matmul(x, y, m, n, k, transpose_a, transpose_b) ";
+    return -1;
+  }
+  size_t m = std::stoull(attr_info->at("m"));
+  size_t k = std::stoull(attr_info->at("k"));
+  size_t n = std::stoull(attr_info->at("n"));
+  bool transpose_a = GET_ATTR_TAG(attr_info, "transpose_a");
+  bool transpose_b = GET_ATTR_TAG(attr_info, "transpose_b");
+  if (Idle(m * n, output))
+    return 0;
+
+  vector<field_t> sa, sb, sc;
+  shamir_decode(a, sa);
+  shamir_decode(b, sb);
+
+  // the local products sum up to a degree-2t share of the product
+  vector<field_t> h(m * n, 0);
+  for (size_t i = 0; i < m; ++i) {
+    for (size_t kk = 0; kk < k; ++kk) {
+      field_t a_ik = transpose_a ? sa[kk * m + i] : sa[i * k + kk];
+      for (size_t j = 0; j < n; ++j) {
+        field_t b_kj = transpose_b ? sb[j * k + kk] : sb[kk * n + j];
+        h[i * n + j] = fadd(h[i * n + j], fmul(a_ik, b_kj));
+      }
+    }
+  }
+  internal_.Truncate(h, sc, true);
+  shamir_encode(sc, output);
+  tlog_debug << "Shamir Matmul ok. <----";
+  return 0;
+}
+
+int ShamirOpsImpl::Compare(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info,
+  bool swap,
+  bool negate) {
+  if (Idle(a.size(), output))
+    return 0;
+  vector<field_t> sa, sb, d, c;
+  if (0 != Decode(a, sa, IsConst(a, attr_info, "lh_is_const")) ||
+      0 != Decode(b, sb, IsConst(b, attr_info, "rh_is_const"))) {
+    log_error << "Shamir decode failed! In " << __FUNCTION__;
+    return -1;
+  }
+  if (sb.size() == 1 && sa.size() > 1)
+    sb.resize(sa.size(), sb[0]);
+
+  // (lhs >= rhs) of the, maybe swapped, operands, or its complement
+  d.resize(sa.size());
+  for (size_t i = 0; i < sa.size(); ++i)
+    d[i] = swap ? fsub(sb[i], sa[i]) : fsub(sa[i], sb[i]);
+  internal_.DReLU(d, c);
+  if (negate) {
+    field_t one = field_t(1) << context_->FLOAT_PRECISION;
+    for (size_t i = 0; i < c.size(); ++i)
+      c[i] = fsub(one, c[i]);
+  }
+  shamir_encode(c, output);
+  return 0;
+}
+
+int ShamirOpsImpl::Less(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> Shamir Less";
+  return Compare(a, b, output, attr_info, false, true);
+}
+
+int ShamirOpsImpl::LessEqual(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> Shamir LessEqual";
+  return Compare(a, b, output, attr_info, true, false);
+}
+
+int ShamirOpsImpl::Greater(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> Shamir Greater";
+  return Compare(a, b, output, attr_info, true, true);
+}
+
+int ShamirOpsImpl::GreaterEqual(
+  const vector<string>& a,
+  const vector<string>& b,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> Shamir GreaterEqual";
+  return Compare(a, b, output, attr_info, false, false);
+}
+
+int ShamirOpsImpl::ReluPrime(const vector<string>& a, vector<string>& output, const attr_type* attr_info) {
+  tlog_debug << "----> Shamir ReluPrime";
+  if (Idle(a.size(), output))
+    return 0;
+  vector<field_t> sa, sb;
+  shamir_decode(a, sa);
+  internal_.DReLU(sa, sb);
+  shamir_encode(sb, output);
+  return 0;
+}
+
+int ShamirOpsImpl::Relu(const vector<string>& a, vector<string>& output, const attr_type* attr_info) {
+  tlog_debug << "----> Shamir Relu";
+  if (Idle(a.size(), output))
+    return 0;
+  vector<field_t> sa, sb, h, sc;
+  shamir_decode(a, sa);
+  internal_.DReLU(sa, sb);
+  h.resize(sa.size());
+  for (size_t i = 0; i < sa.size(); ++i)
+    h[i] = fmul(sa[i], sb[i]);
+  internal_.Truncate(h, sc, true);
+  shamir_encode(sc, output);
+  tlog_debug << "Shamir Relu ok. <----";
+  return 0;
+}
+
+int ShamirOpsImpl::Reveal(
+  const vector<string>& a,
+  vector<string>& output,
+  const attr_type* attr_info) {
+  vector<double> dvalues;
+  int ret = Reveal(a, dvalues, attr_info);
+  output.resize(dvalues.size());
+  for (size_t i = 0; i < dvalues.size(); ++i) {
+    output[i] = std::to_string(dvalues[i]);
+  }
+  return ret;
+}
+
+int ShamirOpsImpl::Reveal(
+  const vector<string>& a,
+  vector<double>& output,
+  const attr_type* attr_info) {
+  tlog_debug << "----> Shamir Reveal";
+  string parties = attr_info ? attr_info->at("receive_parties") : "";
+  vector<string> result_nodes = net_io_->GetResultNodes();
+  vector<string> nodes = decode_reveal_nodes(parties, net_io_->GetParty2Node(), result_nodes);
+
+  size_t size = a.size();
+  vector<field_t> sa(size, 0), values;
+  if (params_->IsComputation())
+    shamir_decode(a, sa);
+  internal_.Reveal(sa, size, nodes, values);
+
+  output.resize(size);
+  for (size_t i = 0; i < size; ++i)
+    output[i] = decode_fixed(values[i], context_->FLOAT_PRECISION);
+  tlog_debug << "Shamir Reveal ok. <----";
+  return 0;
+}
+
+} // namespace rosetta
@@ -0,0 +1,130 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/utility/include/_test_common.h"
+#include "cc/modules/protocol/mpc/shamir/include/shamir_impl.h"
+#include "cc/modules/protocol/mpc/shamir/include/shamir_ops_impl.h"
+#include "cc/modules/iowrapper/include/io_manager.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_helper.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+using namespace rosetta;
+
+/**
+ * Five computation parties on loopback, any two of which may collude.
+ *
+ * The parties are forked, one process each, since the io manager is one per
+ * process. The network config is written here, with five nodes on 127.0.0.1.
+ * P0 and P3 give the inputs, P4 gets the results and prints them with the
+ * expected values.
+ *
+ * usage: protocol_mpc_shamir_tests_shamir_5party
+ */
+
+namespace {
+
+const int kParties = 5;
+const int kBasePort = 14120;
+
+string five_party_config() {
+  stringstream ss;
+  ss << "{\n  \"NODE_INFO\": [\n";
+  for (int i = 0; i < kParties; i++) {
+    ss << "    {\"NAME\": \"Party" << i << "\", \"HOST\": \"127.0.0.1\", \"PORT\": " << kBasePort + i
+       << ", \"NODE_ID\": \"P" << i << "\"}" << (i + 1 < kParties ? ",\n" : "\n");
+  }
+  ss << "  ],\n  \"DATA_NODES\": [\"P0\", \"P3\"],\n  \"COMPUTATION_NODES\": {";
+  for (int i = 0; i < kParties; i++)
+    ss << "\"P" << i << "\": " << i << (i + 1 < kParties ? ", " : "");
+  ss << "},\n  \"RESULT_NODES\": [\"P4\"]\n}\n";
+  return ss.str();
+}
+
+void print(const string& name, const vector<double>& got, const string& want) {
+  cout << name << ": ";
+  for (auto v : got)
+    cout << v << " ";
+  cout << " (expected " << want << ")" << endl;
+}
+
+} // namespace
+
+static void run(int partyid) {
+  string logfile = "log/mpc_shamir_5party-" + to_string(partyid);
+  Logger::Get().log_to_stdout(false);
+  Logger::Get().set_filename(logfile + "-backend.log");
+  string node_id = "P" + to_string(partyid);
+  IOManager::Instance()->CreateChannel("", node_id, five_party_config());
+
+  ShamirProtocol* proto = new ShamirProtocol();
+  proto->Init(logfile + "-console.log");
+  auto ops = proto->GetOps(msg_id_t("shamir 5party ops"));
+
+  vector<double> x = {-1.5, 0.5, 2, 3}, y = {2, 0.5, -1, 3};
+  vector<string> sx, sy, sa, sm, smm, sl, sr;
+  ops->PrivateInput("P0", x, sx);
+  ops->PrivateInput("P3", y, sy);
+  ops->Add(sx, sy, sa);
+  ops->Mul(sx, sy, sm);
+  attr_type mm_attr;
+  mm_attr["m"] = "2";
+  mm_attr["k"] = "2";
+  mm_attr["n"] = "2";
+  ops->Matmul(sx, sy, smm, &mm_attr);
+  ops->Less(sx, sy, sl);
+  ops->Relu(sx, sr);
+
+  attr_type reveal_attr;
+  reveal_attr["receive_parties"] = encode_reveal_node("P4");
+  vector<double> a, m, mm, l, r;
+  ops->Reveal(sa, a, &reveal_attr);
+  ops->Reveal(sm, m, &reveal_attr);
+  ops->Reveal(smm, mm, &reveal_attr);
+  ops->Reveal(sl, l, &reveal_attr);
+  ops->Reveal(sr, r, &reveal_attr);
+  if (partyid == kParties - 1) {
+    print("Add", a, "0.5 1 1 6");
+    print("Mul", m, "-3 0.25 -2 9");
+    print("Matmul", mm, "-3.5 0.75 1 10");
+    print("Less", l, "1 0 0 0");
+    print("Relu", r, "0 0.5 2 3");
+  }
+
+  proto->Uninit();
+  delete proto;
+}
+
+int main(int argc, char* argv[]) {
+  vector<pid_t> pids;
+  for (int i = 0; i < kParties - 1; i++) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      cerr << "error in fork P" << i << "!" << endl;
+      exit(1);
+    }
+    if (pid == 0) {
+      run(i);
+      return 0;
+    }
+    pids.push_back(pid);
+  }
+  run(kParties - 1);
+  for (auto pid : pids)
+    waitpid(pid, nullptr, 0);
+  printf("%d mock nodes run to the end.\n", kParties);
+  return 0;
+}
@@ -69,6 +69,9 @@ public:
 
   void set_keys(const AESKeyStringsV2& ks) { keys = ks; }
   int init_aes(int pid, const msg_id_t& msg_id);
+
+  void SaveState(BinaryStateWriter& w) const;
+  bool LoadState(BinaryStateReader& r);
 };
 
 // controller to manage keys and prg-objects for a protocol.
@@ -92,6 +95,10 @@ class SnnAesobjectsController {
 
   void Init(int party_id, const AESKeyStringsV2& keys);
   void Reset();
+
+  //! the keys and every AES object position, for checkpoints. LoadState replaces all of them.
+  void SaveState(BinaryStateWriter& w);
+  bool LoadState(BinaryStateReader& r);
 };
 
 } // namespace snn
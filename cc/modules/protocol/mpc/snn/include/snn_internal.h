@@ -364,6 +364,15 @@ class SnnInternal {
   */
   void PolynomialPowConst(const mpc_t& shared_X, mpc_t common_k, mpc_t& shared_Y);
   void PolynomialPowConst(const vector<mpc_t>& shared_X, mpc_t common_k, vector<mpc_t>& shared_Y);
+  /*
+	@brief: X[i]^K[i] with a public exponent per element,
+			in bit_length(max |K|) rounds of one batched DotProduct,
+			plus one Reciprocaldivision for the negative exponents.
+  */
+  void PowVectorized(
+    const vector<mpc_t>& shared_X,
+    const vector<int64_t>& common_K,
+    vector<mpc_t>& shared_Y);
   void PolynomialLocalConstMul(
     const vector<mpc_t>& shared_X,
     mpc_t common_V,
@@ -451,6 +460,122 @@ class SnnInternal {
    */
   int SigmoidChebyshevPolyMPC(const vector<mpc_t>& a, vector<mpc_t>& b);
 
+  /**
+   * @brief piecewise polynomial registered as func_name, in one batched ReluPrime for all the
+   * break points, ceil(log2(degree)) rounds for the powers of X and one batched DotProduct.
+   * @see PolyConfFactory::get_func_telescoping
+   */
+  int PiecewisePolynomial(const vector<mpc_t>& a, const string& func_name, vector<mpc_t>& b);
+
+  /**
+   * @brief activations and their derivatives, the tables and error bounds are in mpc_common.cpp
+   */
+  int Tanh(const vector<mpc_t>& a, vector<mpc_t>& b) { return PiecewisePolynomial(a, "TANH", b); }
+  int TanhGrad(const vector<mpc_t>& a, vector<mpc_t>& b) { return PiecewisePolynomial(a, "TANH_GRAD", b); }
+  int Gelu(const vector<mpc_t>& a, vector<mpc_t>& b) { return PiecewisePolynomial(a, "GELU", b); }
+  int GeluGrad(const vector<mpc_t>& a, vector<mpc_t>& b) { return PiecewisePolynomial(a, "GELU_GRAD", b); }
+  int Swish(const vector<mpc_t>& a, vector<mpc_t>& b) { return PiecewisePolynomial(a, "SWISH", b); }
+  int SwishGrad(const vector<mpc_t>& a, vector<mpc_t>& b) { return PiecewisePolynomial(a, "SWISH_GRAD", b); }
+  int Softplus(const vector<mpc_t>& a, vector<mpc_t>& b) { return PiecewisePolynomial(a, "SOFTPLUS", b); }
+  int SoftplusGrad(const vector<mpc_t>& a, vector<mpc_t>& b) {
+    return PiecewisePolynomial(a, "SOFTPLUS_GRAD", b);
+  }
+
+  /**
+   * @brief layer normalization over the rows of a rows x cols matrix,
+   * Y = gamma * (X - mean) / sqrt(var + epsilon) + beta. (X - mean)^2 and gamma * (X - mean) share
+   * one DotProduct, the rows go through a single batched Rsqrt, and one more DotProduct with the
+   * broadcast 1/sqrt(var + epsilon) gives Y. inv_std is kept for LayerNormGrad.
+   */
+  int LayerNorm(
+    const vector<mpc_t>& x,
+    const vector<mpc_t>& gamma,
+    const vector<mpc_t>& beta,
+    vector<mpc_t>& y,
+    vector<mpc_t>& inv_std,
+    size_t rows,
+    size_t cols,
+    double epsilon);
+
+  /**
+   * @brief backward of LayerNorm in three DotProduct rounds, with x_hat = (X - mean) * inv_std,
+   * dX = inv_std * (dY * gamma - mean(dY * gamma) - x_hat * mean(dY * gamma * x_hat)),
+   * dgamma = column sums of dY * x_hat, dbeta = column sums of dY.
+   */
+  int LayerNormGrad(
+    const vector<mpc_t>& x,
+    const vector<mpc_t>& gamma,
+    const vector<mpc_t>& inv_std,
+    const vector<mpc_t>& dy,
+    vector<mpc_t>& dx,
+    vector<mpc_t>& dgamma,
+    vector<mpc_t>& dbeta,
+    size_t rows,
+    size_t cols);
+
+  /**
+   * @brief jointly sampled randomness for differential privacy, no party learns the values.
+   * RandomBits gives fair coins, each the XOR of a private coin of P0 and one of P1 (drawn from
+   * their aes_indep), b0 + b1 - 2 * b0 * b1, so all the coins of a call cost a single DotProduct.
+   * RandomUniform gives values on the grid (k + 1/2) / 2^bits in (0, 1).
+   * RandomLaplace is the discrete Laplace of scale on the LSB grid, and RandomBinomial
+   * 2^grid_bits * (K - coins / 2) LSB with K ~ Bin(coins, 1/2), see mpc_dp.h for the parameters
+   * and the privacy guarantee. Both sample at most kDPCoinsPerRound coins a round.
+   */
+  int RandomBits(size_t size, vector<mpc_t>& c);
+  int RandomUniform(size_t size, size_t bits, vector<mpc_t>& u);
+  int RandomLaplace(size_t size, double scale, vector<mpc_t>& l);
+  int RandomBinomial(size_t size, size_t coins, int grid_bits, vector<mpc_t>& z);
+
+  /**
+   * @brief b = a + noise, mechanism is "laplace" (discrete Laplace of that scale) or "gaussian"
+   * (binomial mechanism of standard deviation scale, a is rounded to its grid first)
+   */
+  int DPNoise(const vector<mpc_t>& a, const string& mechanism, double scale, vector<mpc_t>& b);
+
+  /**
+   * @brief per-example clipping, each row g becomes g * min(1, clip_norm / ||g||).
+   * With t = ||g / clip_norm||^2, g scaled before squaring, the factor is
+   * 1 + (t >= 1) * (Rsqrt(t) - 1); Rsqrt is accurate while ||g|| stays within about 30 * clip_norm.
+   */
+  int ClipByL2Norm(const vector<mpc_t>& a, vector<mpc_t>& b, size_t rows, size_t cols, double clip_norm);
+
+  /**
+   * @brief inverted-dropout masks, each element is kept with probability 1 - rate rounded to the
+   * grid of its uniform, and then scaled by the inverse of that probability (see dropout_keep_cells).
+   * DropoutCommonMask draws a plaintext mask known to P0 and P1 from aes_common, 16 bits per element,
+   * without communication. DropoutSharedMask keeps the mask secret: (u <= keep) on a jointly
+   * sampled RandomUniform u of 8 bits, so it costs 8 RandomBits and one ReluPrime per element.
+   */
+  int DropoutCommonMask(size_t size, double rate, vector<double>& mask);
+  int DropoutSharedMask(size_t size, double rate, vector<mpc_t>& mask);
+
+  /**
+   * @brief the k largest values of each row of a rows x cols matrix, descending, by the
+   * batched bitonic selection of bitonic_topk (one ReluPrime and one DotProduct a layer).
+   * indices gets rows x k one-hot rows of cols, 1.0 at the position of each value,
+   * from the selected positions by OneHot.
+   */
+  int TopK(
+    const vector<mpc_t>& a,
+    size_t rows,
+    size_t cols,
+    size_t k,
+    vector<mpc_t>& values,
+    vector<mpc_t>& indices);
+
+  /**
+   * @brief one-hot rows of depth for the secret integers of a, by one batched ReluPrime of
+   * ge_j = (a - j + 0.5 >= 0), j = 0..depth, and [a == j] = ge_j - ge_(j+1).
+   * Non-integers round to the nearest, values outside [0, depth) give all-zero rows.
+   */
+  int OneHot(const vector<mpc_t>& a, size_t depth, vector<mpc_t>& b);
+
+  /**
+   * @brief the index of each one-hot row of depth, sum_j j * a_j, local.
+   */
+  int OneHotToIndex(const vector<mpc_t>& a, size_t depth, vector<mpc_t>& b);
+
   /*       basic drelu-ops    */
   ///////////  private-compare /////////
   int PrivateCompare(
@@ -225,6 +225,43 @@ class SnnProtocolOps : public ProtocolOps {
     vector<string>& output,
     const attr_type* attr_info = nullptr);
 
+  int Tanh(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int TanhGrad(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Gelu(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int GeluGrad(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Swish(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int SwishGrad(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Softplus(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int SoftplusGrad(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+
+  int LayerNorm(
+    const vector<string>& x,
+    const vector<string>& gamma,
+    const vector<string>& beta,
+    vector<string>& y,
+    vector<string>& inv_std,
+    const attr_type* attr_info = nullptr);
+  int LayerNormGrad(
+    const vector<string>& x,
+    const vector<string>& gamma,
+    const vector<string>& inv_std,
+    const vector<string>& dy,
+    vector<string>& dx,
+    vector<string>& dgamma,
+    vector<string>& dbeta,
+    const attr_type* attr_info = nullptr);
+  int DPNoise(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int ClipByL2Norm(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int Dropout(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
+  int DropoutGrad(const vector<string>& dy, vector<string>& dx, const attr_type* attr_info = nullptr);
+  int TopK(
+    const vector<string>& a,
+    vector<string>& values,
+    vector<string>& indices,
+    const attr_type* attr_info = nullptr);
+  int OneHot(const vector<string>& a, vector<string>& b, const attr_type* attr_info = nullptr);
+  int OneHotToIndex(const vector<string>& a, vector<string>& b, const attr_type* attr_info = nullptr);
+
   int Reveal(const vector<string>& a, vector<string>& output, const attr_type* attr_info = nullptr);
   int Reveal(const vector<string>& a, vector<double>& output, const attr_type* attr_info = nullptr);
 
@@ -35,6 +35,10 @@ protected:
   // offline triples generation when mpc protocol initializing.
   virtual int OfflinePreprocess();
 
+  // the AES objects and the cached triples follow the base state
+  void SaveState(BinaryStateWriter& w);
+  bool LoadState(BinaryStateReader& r);
+
  private:
   int InitAesKeys();
   void InitMpcEnvironment();
@@ -78,6 +78,10 @@ public:
     return 1;
   }
 
+  //! the cached triples, for checkpoints. LoadState replaces them.
+  void SaveState(BinaryStateWriter& w);
+  bool LoadState(BinaryStateReader& r);
+
   // clang-format off
   int64_t bytes_sent() const noexcept { return bytes_sent_.load(); }
   int64_t bytes_received() const noexcept { return bytes_received_.load(); }
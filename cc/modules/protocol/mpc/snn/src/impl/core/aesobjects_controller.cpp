@@ -112,6 +112,72 @@ int AESObjectsV2::init_aes(int pid, const msg_id_t& msg_id) {
   return 0;
 }
 
+void AESObjectsV2::SaveState(BinaryStateWriter& w) const {
+  for (auto& o : {aes_randseed, aes_common, aes_indep, aes_a_1, aes_a_2, aes_b_1, aes_b_2, aes_c_1})
+    o->SaveState(w);
+  w.put<uint64_t>(aes_data.size());
+  for (auto iter = aes_data.begin(); iter != aes_data.end(); iter++) {
+    w.put_string(iter->first);
+    iter->second->SaveState(w);
+  }
+}
+
+bool AESObjectsV2::LoadState(BinaryStateReader& r) {
+  for (auto& o : {aes_randseed, aes_common, aes_indep, aes_a_1, aes_a_2, aes_b_1, aes_b_2, aes_c_1}) {
+    if (!o->LoadState(r))
+      return false;
+  }
+  uint64_t n = 0;
+  r.get(n);
+  aes_data.clear();
+  for (uint64_t i = 0; i < n && r.ok(); i++) {
+    string node;
+    r.get_string(node);
+    auto o = std::make_shared<AESObject>();
+    if (!o->LoadState(r))
+      return false;
+    aes_data[node] = o;
+  }
+  return r.ok();
+}
+
+void SnnAesobjectsController::SaveState(BinaryStateWriter& w) {
+  std::unique_lock<std::mutex> lck(mutex_);
+  for (auto& k : {&keys_.key_0, &keys_.key_a, &keys_.key_b, &keys_.key_c, &keys_.key_ab,
+                  &keys_.key_ac, &keys_.key_bc, &keys_.key_cd})
+    w.put_string(*k);
+  w.put_string_map(keys_.key_data);
+  w.put(party_id_);
+  w.put<uint64_t>(msgid_mpc_aesobj_.size());
+  for (auto iter = msgid_mpc_aesobj_.begin(); iter != msgid_mpc_aesobj_.end(); iter++) {
+    put_msg_id(w, iter->first);
+    iter->second->SaveState(w);
+  }
+}
+
+bool SnnAesobjectsController::LoadState(BinaryStateReader& r) {
+  std::unique_lock<std::mutex> lck(mutex_);
+  for (auto& k : {&keys_.key_0, &keys_.key_a, &keys_.key_b, &keys_.key_c, &keys_.key_ab,
+                  &keys_.key_ac, &keys_.key_bc, &keys_.key_cd})
+    r.get_string(*k);
+  r.get_string_map(keys_.key_data);
+  r.get(party_id_);
+  uint64_t n = 0;
+  r.get(n);
+  msgid_mpc_aesobj_.clear();
+  for (uint64_t i = 0; i < n && r.ok(); i++) {
+    msg_id_t msgid;
+    if (!get_msg_id(r, msgid))
+      return false;
+    auto aesobjs = std::make_shared<AESObjectsV2>(keys_);
+    aesobjs->init_aes(party_id_, msgid);
+    if (!aesobjs->LoadState(r))
+      return false;
+    msgid_mpc_aesobj_[msgid] = aesobjs;
+  }
+  return r.ok();
+}
+
 void SnnAesobjectsController::Init(
   int party_id,
   const AESKeyStringsV2& keys) {
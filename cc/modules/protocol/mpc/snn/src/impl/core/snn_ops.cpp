@@ -23,6 +23,10 @@
 #include "cc/modules/common/include/utils/perf_stats.h"
 #include "cc/modules/protocol/mpc/comm/include/mpc_helper.h"
 #include "cc/modules/common/include/utils/secure_encoder.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_secure_debug.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_mask_store.h"
+#include "cc/modules/common/include/utils/msg_id_mgr.h"
+#include <cmath>
 #include <string>
 
 
@@ -85,6 +89,26 @@ static inline int snn_encode_(const MpcVec& sa, StrVec& a) {
   return 0;
 }
 
+#if ROSETTA_ENABLES_SECURE_DEBUG
+//! secure-debug only: reveals the shares to P0 and checks them against the safe fixed-point range
+static inline void snn_secure_debug_(
+  shared_ptr<SnnInternal> internal,
+  shared_ptr<ProtocolContext> context,
+  const MpcVec& sa,
+  const char* op,
+  const msg_id_t& msgid) {
+  if (!context->SECURE_DEBUG)
+    return;
+  MpcVec plain;
+  internal->Reconstruct2PC(sa, plain, PARTY_A);
+  if (context->GetMyRole() == PARTY_A)
+    context->SECURE_DEBUG->Check(op, msgid, plain, context->FLOAT_PRECISION);
+}
+#define snn_secure_debug(sa) snn_secure_debug_(internal_, context_, sa, __FUNCTION__, msg_id())
+#else
+#define snn_secure_debug(sa) (void)0
+#endif
+
 //! maybe more actions here
 #define snn_decode(a, sa, precision)                                                      \
   do {                                                                                    \
@@ -97,6 +121,7 @@ static inline int snn_encode_(const MpcVec& sa, StrVec& a) {
 
 #define snn_encode(sa, a)                                                                 \
   do {                                                                                    \
+    snn_secure_debug(sa);                                                                 \
     if (0 != snn_encode_(sa, a)) {                                                        \
       log_error << "rosetta::convert::encoder::encode failed! In " << __FUNCTION__ << "#" \
                 << __LINE__ ;                                                      \
@@ -427,6 +452,250 @@ SNN_PROTOCOLL_UNARY_OP(Log1p)
 SNN_PROTOCOLL_UNARY_OP(Relu)
 SNN_PROTOCOLL_UNARY_OP(ReluPrime)
 SNN_PROTOCOLL_UNARY_OP(Sigmoid)
+SNN_PROTOCOLL_UNARY_OP(Tanh)
+SNN_PROTOCOLL_UNARY_OP(TanhGrad)
+SNN_PROTOCOLL_UNARY_OP(Gelu)
+SNN_PROTOCOLL_UNARY_OP(GeluGrad)
+SNN_PROTOCOLL_UNARY_OP(Swish)
+SNN_PROTOCOLL_UNARY_OP(SwishGrad)
+SNN_PROTOCOLL_UNARY_OP(Softplus)
+SNN_PROTOCOLL_UNARY_OP(SoftplusGrad)
+
+int SnnProtocolOps::LayerNorm(
+  const vector<string>& x,
+  const vector<string>& gamma,
+  const vector<string>& beta,
+  vector<string>& y,
+  vector<string>& inv_std,
+  const attr_type* attr_info) {
+  tlog_debug << "----> SnnLayerNorm";
+  if (!attr_info || attr_info->count("rows") == 0 || attr_info->count("cols") == 0) {
+    log_error << "please fill rows, cols for SnnLayerNorm(x, gamma, beta, rows, cols, epsilon) ";
+    return -1;
+  }
+  size_t rows = std::stoull(attr_info->at("rows"));
+  size_t cols = std::stoull(attr_info->at("cols"));
+  double epsilon = attr_info->count("epsilon") > 0 ? std::stod(attr_info->at("epsilon")) : 1e-5;
+
+  int float_precision = context_->FLOAT_PRECISION;
+  vector<mpc_t> shareX, shareGamma, shareBeta, shareY, shareInvStd;
+  snn_decode(x, shareX, float_precision);
+  snn_decode(gamma, shareGamma, float_precision);
+  snn_decode(beta, shareBeta, float_precision);
+  int ret = internal_->LayerNorm(shareX, shareGamma, shareBeta, shareY, shareInvStd, rows, cols, epsilon);
+  snn_encode(shareY, y);
+  snn_encode(shareInvStd, inv_std);
+  tlog_debug << "SnnLayerNorm ok. <----";
+  return ret;
+}
+
+int SnnProtocolOps::LayerNormGrad(
+  const vector<string>& x,
+  const vector<string>& gamma,
+  const vector<string>& inv_std,
+  const vector<string>& dy,
+  vector<string>& dx,
+  vector<string>& dgamma,
+  vector<string>& dbeta,
+  const attr_type* attr_info) {
+  tlog_debug << "----> SnnLayerNormGrad";
+  if (!attr_info || attr_info->count("rows") == 0 || attr_info->count("cols") == 0) {
+    log_error << "please fill rows, cols for SnnLayerNormGrad(x, gamma, inv_std, dy, rows, cols) ";
+    return -1;
+  }
+  size_t rows = std::stoull(attr_info->at("rows"));
+  size_t cols = std::stoull(attr_info->at("cols"));
+
+  int float_precision = context_->FLOAT_PRECISION;
+  vector<mpc_t> shareX, shareGamma, shareInvStd, shareDy, shareDx, shareDgamma, shareDbeta;
+  snn_decode(x, shareX, float_precision);
+  snn_decode(gamma, shareGamma, float_precision);
+  snn_decode(inv_std, shareInvStd, float_precision);
+  snn_decode(dy, shareDy, float_precision);
+  int ret = internal_->LayerNormGrad(
+    shareX, shareGamma, shareInvStd, shareDy, shareDx, shareDgamma, shareDbeta, rows, cols);
+  snn_encode(shareDx, dx);
+  snn_encode(shareDgamma, dgamma);
+  snn_encode(shareDbeta, dbeta);
+  tlog_debug << "SnnLayerNormGrad ok. <----";
+  return ret;
+}
+
+int SnnProtocolOps::DPNoise(const vector<string>& a, vector<string>& output, const attr_type* attr_info) {
+  tlog_debug << "----> SnnDPNoise";
+  if (!attr_info || attr_info->count("scale") == 0) {
+    log_error << "please fill scale for SnnDPNoise(x, mechanism, scale) ";
+    return -1;
+  }
+  string mechanism = attr_info->count("mechanism") > 0 ? attr_info->at("mechanism") : "gaussian";
+  double scale = std::stod(attr_info->at("scale"));
+  if (!(scale > 0 && std::isfinite(scale))) {
+    log_error << "SnnDPNoise scale should be positive, got " << scale;
+    return -1;
+  }
+
+  vector<mpc_t> shareA, shareC;
+  snn_decode(a, shareA, context_->FLOAT_PRECISION);
+  int ret = internal_->DPNoise(shareA, mechanism, scale, shareC);
+  snn_encode(shareC, output);
+  tlog_debug << "SnnDPNoise ok. <----";
+  return ret;
+}
+
+int SnnProtocolOps::ClipByL2Norm(const vector<string>& a, vector<string>& output, const attr_type* attr_info) {
+  tlog_debug << "----> SnnClipByL2Norm";
+  if (!attr_info || attr_info->count("rows") == 0 || attr_info->count("cols") == 0 ||
+      attr_info->count("clip_norm") == 0) {
+    log_error << "please fill rows, cols, clip_norm for SnnClipByL2Norm(x, rows, cols, clip_norm) ";
+    return -1;
+  }
+  size_t rows = std::stoull(attr_info->at("rows"));
+  size_t cols = std::stoull(attr_info->at("cols"));
+  double clip_norm = std::stod(attr_info->at("clip_norm"));
+  if (!(clip_norm > 0 && std::isfinite(clip_norm))) {
+    log_error << "SnnClipByL2Norm clip_norm should be positive, got " << clip_norm;
+    return -1;
+  }
+
+  vector<mpc_t> shareA, shareC;
+  snn_decode(a, shareA, context_->FLOAT_PRECISION);
+  int ret = internal_->ClipByL2Norm(shareA, shareC, rows, cols, clip_norm);
+  snn_encode(shareC, output);
+  tlog_debug << "SnnClipByL2Norm ok. <----";
+  return ret;
+}
+
+int SnnProtocolOps::Dropout(const vector<string>& a, vector<string>& output, const attr_type* attr_info) {
+  tlog_debug << "----> SnnDropout";
+  if (!attr_info || attr_info->count("rate") == 0) {
+    log_error << "please fill rate for SnnDropout(x, rate, common_mask) ";
+    return -1;
+  }
+  double rate = std::stod(attr_info->at("rate"));
+  bool common_mask = GET_ATTR_TAG(attr_info, "common_mask");
+
+  vector<mpc_t> shareA, shareC;
+  snn_decode(a, shareA, context_->FLOAT_PRECISION);
+  MpcMask mask;
+  mask.is_common = common_mask;
+  if (common_mask) {
+    // known mask, the product is local
+    internal_->DropoutCommonMask(shareA.size(), rate, mask.common);
+    internal_->DotProduct(mask.common, shareA, shareC);
+  } else {
+    vector<mpc_t> shareMask;
+    internal_->DropoutSharedMask(shareA.size(), rate, shareMask);
+    internal_->DotProduct(shareA, shareMask, shareC);
+    // kept as is, the mask is not an op output for secure-debug checks
+    if (0 != snn_encode_(shareMask, mask.share)) {
+      log_error << "SnnDropout encode mask failed!";
+      return -1;
+    }
+  }
+  context_->MASK_STORE->Put(_op_msg_id, mask);
+  snn_encode(shareC, output);
+  tlog_debug << "SnnDropout ok. <----";
+  return 0;
+}
+
+int SnnProtocolOps::DropoutGrad(const vector<string>& dy, vector<string>& dx, const attr_type* attr_info) {
+  tlog_debug << "----> SnnDropoutGrad";
+  if (!attr_info || attr_info->count("forward_msgid") == 0) {
+    log_error << "please fill forward_msgid for SnnDropoutGrad(dy, forward_msgid) ";
+    return -1;
+  }
+  msg_id_t forward_msgid;
+  MsgIdMgr::Instance()->ResolveMsgId(attr_info->at("forward_msgid"), context_->TASK_ID, forward_msgid);
+  MpcMask mask;
+  if (!context_->MASK_STORE->Get(forward_msgid, mask)) {
+    log_error << "SnnDropoutGrad no mask of Dropout " << attr_info->at("forward_msgid");
+    return -1;
+  }
+
+  vector<mpc_t> shareDy, shareDx;
+  snn_decode(dy, shareDy, context_->FLOAT_PRECISION);
+  if (mask.is_common) {
+    internal_->DotProduct(mask.common, shareDy, shareDx);
+  } else {
+    vector<mpc_t> shareMask;
+    snn_decode(mask.share, shareMask, context_->FLOAT_PRECISION);
+    internal_->DotProduct(shareDy, shareMask, shareDx);
+  }
+  snn_encode(shareDx, dx);
+  tlog_debug << "SnnDropoutGrad ok. <----";
+  return 0;
+}
+
+int SnnProtocolOps::TopK(
+  const vector<string>& a,
+  vector<string>& values,
+  vector<string>& indices,
+  const attr_type* attr_info) {
+  tlog_debug << "----> SnnTopK";
+  if (!attr_info || attr_info->count("rows") == 0 || attr_info->count("cols") == 0 ||
+      attr_info->count("k") == 0) {
+    log_error << "please fill rows, cols, k for SnnTopK(x, rows, cols, k) ";
+    return -1;
+  }
+  size_t rows = std::stoull(attr_info->at("rows"));
+  size_t cols = std::stoull(attr_info->at("cols"));
+  size_t k = std::stoull(attr_info->at("k"));
+  if (k == 0 || k > cols) {
+    log_error << "SnnTopK k should be in [1, " << cols << "], got " << k;
+    return -1;
+  }
+
+  vector<mpc_t> shareA, shareValues, shareIndices;
+  snn_decode(a, shareA, context_->FLOAT_PRECISION);
+  int ret = internal_->TopK(shareA, rows, cols, k, shareValues, shareIndices);
+  snn_encode(shareValues, values);
+  snn_encode(shareIndices, indices);
+  tlog_debug << "SnnTopK ok. <----";
+  return ret;
+}
+
+int SnnProtocolOps::OneHot(const vector<string>& a, vector<string>& b, const attr_type* attr_info) {
+  tlog_debug << "----> SnnOneHot";
+  if (!attr_info || attr_info->count("depth") == 0) {
+    log_error << "please fill depth for SnnOneHot(x, depth) ";
+    return -1;
+  }
+  size_t depth = std::stoull(attr_info->at("depth"));
+  if (depth == 0) {
+    log_error << "SnnOneHot depth should be positive";
+    return -1;
+  }
+
+  vector<mpc_t> shareA, shareB;
+  snn_decode(a, shareA, context_->FLOAT_PRECISION);
+  int ret = internal_->OneHot(shareA, depth, shareB);
+  snn_encode(shareB, b);
+  tlog_debug << "SnnOneHot ok. <----";
+  return ret;
+}
+
+int SnnProtocolOps::OneHotToIndex(
+  const vector<string>& a,
+  vector<string>& b,
+  const attr_type* attr_info) {
+  tlog_debug << "----> SnnOneHotToIndex";
+  if (!attr_info || attr_info->count("depth") == 0) {
+    log_error << "please fill depth for SnnOneHotToIndex(x, depth) ";
+    return -1;
+  }
+  size_t depth = std::stoull(attr_info->at("depth"));
+  if (depth == 0 || a.size() % depth != 0) {
+    log_error << "SnnOneHotToIndex input size " << a.size() << " is not a multiple of depth " << depth;
+    return -1;
+  }
+
+  vector<mpc_t> shareA, shareB;
+  snn_decode(a, shareA, context_->FLOAT_PRECISION);
+  int ret = internal_->OneHotToIndex(shareA, depth, shareB);
+  snn_encode(shareB, b);
+  tlog_debug << "SnnOneHotToIndex ok. <----";
+  return ret;
+}
 
 SNN_PROTOCOLL_REDUCE_OP(Max)
 SNN_PROTOCOLL_REDUCE_OP(Min)
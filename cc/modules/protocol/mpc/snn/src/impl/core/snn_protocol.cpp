@@ -21,6 +21,9 @@
 #include "cc/modules/common/include/utils/rtt_logger.h"
 #include "cc/modules/common/include/utils/generate_key.h"
 #include "cc/modules/protocol/mpc/snn/src/internal/snn_helper.h"
+#if ROSETTA_ENABLES_PROTOCOL_MPC_OT2PC
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_gc.h"
+#endif
 // #include "cc/modules/protocol/mpc/snn/include/snn_opsets.h"
 
 #include <iostream>
@@ -51,6 +54,29 @@ shared_ptr<snn::SnnInternal> SnnProtocol::GetInternal(const msg_id_t& msgid) {
   return make_shared<snn::SnnInternal>(msgid, GetMpcContext(), gseed_, GetNetHandler());
 }
 
+void SnnProtocol::SaveState(BinaryStateWriter& w) {
+  MpcProtocol::SaveState(w);
+  w.put<uint8_t>(aes_controller_ != nullptr);
+  if (aes_controller_)
+    aes_controller_->SaveState(w);
+  w.put<uint8_t>(triple_generator_ != nullptr);
+  if (triple_generator_)
+    triple_generator_->SaveState(w);
+}
+
+bool SnnProtocol::LoadState(BinaryStateReader& r) {
+  if (!MpcProtocol::LoadState(r))
+    return false;
+  uint8_t has_aes = 0, has_triples = 0;
+  r.get(has_aes);
+  if (has_aes && (!aes_controller_ || !aes_controller_->LoadState(r)))
+    return false;
+  r.get(has_triples);
+  if (has_triples && (!triple_generator_ || !triple_generator_->LoadState(r)))
+    return false;
+  return r.ok();
+}
+
 void SnnProtocol::InitMpcEnvironment() {
   snn_init_once_calls();
 }
@@ -60,6 +86,18 @@ int SnnProtocol::OfflinePreprocess() {
 
   triple_generator_ = make_shared<SnnTripleGenerator>(GetNetHandler());
   triple_generator_->pre_gen();
+
+#if ROSETTA_ENABLES_PROTOCOL_MPC_OT2PC
+  // the garbled-circuit ReluPrime, picked by the measured link where it is cheaper
+  auto state = make_shared<Ot2pcState>();
+  if (context_->ROLE_ID == PARTY_A || context_->ROLE_ID == PARTY_B) {
+    state->keys.Setup(net_io_, context_->TASK_ID + "-snn-gc-base-ot");
+    state->ready = true;
+  }
+  auto gc = make_shared<ot2pc::GcCompare>(net_io_, state);
+  gc->CostModel().Calibrate(net_io_, msg_id_t(context_->TASK_ID + "-snn-gc-calibrate"));
+  context_->GC_COMPARE = gc;
+#endif
   return 0;
 }
 
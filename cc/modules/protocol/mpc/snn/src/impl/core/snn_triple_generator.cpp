@@ -46,6 +46,54 @@ int SnnTripleGenerator::pre_gen() {
   return 0;
 }
 
+void SnnTripleGenerator::SaveState(BinaryStateWriter& w) {
+  {
+    std::unique_lock<std::mutex> lck(mul_cache_lck);
+    w.put_vector(mul_triple_cache.a);
+    w.put_vector(mul_triple_cache.b);
+    w.put_vector(mul_triple_cache.c);
+  }
+  std::unique_lock<std::mutex> lck(matmul_cache_lck);
+  w.put<uint64_t>(matmul_triple_cache.size());
+  for (auto& kv : matmul_triple_cache) {
+    w.put_string(kv.first);
+    w.put<uint64_t>(kv.second.size());
+    for (auto& t : kv.second) {
+      w.put_vector(t.a);
+      w.put_vector(t.b);
+      w.put_vector(t.c);
+    }
+  }
+}
+
+bool SnnTripleGenerator::LoadState(BinaryStateReader& r) {
+  {
+    std::unique_lock<std::mutex> lck(mul_cache_lck);
+    r.get_vector(mul_triple_cache.a);
+    r.get_vector(mul_triple_cache.b);
+    r.get_vector(mul_triple_cache.c);
+  }
+  std::unique_lock<std::mutex> lck(matmul_cache_lck);
+  uint64_t n = 0;
+  r.get(n);
+  matmul_triple_cache.clear();
+  for (uint64_t i = 0; i < n && r.ok(); i++) {
+    string key;
+    uint64_t count = 0;
+    r.get_string(key);
+    r.get(count);
+    auto& triples = matmul_triple_cache[key];
+    for (uint64_t j = 0; j < count && r.ok(); j++) {
+      ShareTriple t;
+      r.get_vector(t.a);
+      r.get_vector(t.b);
+      r.get_vector(t.c);
+      triples.push_back(t);
+    }
+  }
+  return r.ok();
+}
+
 int SnnTripleGenerator::get_mul_triple(const msg_id_t& op_msg_id, int size, vector<mpc_t>& triple_a, vector<mpc_t>& triple_b, vector<mpc_t>& triple_c){
   tlog_debug << "SnnTripleGenerator::get_mul_triple() :" << op_msg_id.str() << " size:" << size;
   if( size >= max_batch_size) {
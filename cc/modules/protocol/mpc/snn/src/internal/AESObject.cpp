@@ -38,27 +38,57 @@ AESObject::AESObject(const char* filename) {
   Init(str);
 }
 void AESObject::Init(const std::string& key) {
-  int len = key.length();
-  char* common_aes_key = new char[len + 1];
-  memset(common_aes_key, 0, len + 1);
-  strcpy(common_aes_key, key.c_str());
-  AES_set_encrypt_key((unsigned char*)common_aes_key, 256, &aes_key);
-  delete []common_aes_key;
+  // the key files hold keys of any length, the engine keys with SHA256(key)
+  ctr_.reseed_from(key);
+  rCounter = -1;
+  randomBitCounter = 0;
+  random8BitCounter = 0;
+  random64BitCounter = 0;
 }
 __m128i AESObject::newRandomNumber() {
   rCounter++;
-  if (rCounter % RANDOM_COMPUTE == 0) // generate more random seeds
-  {
-    __m128i tempSecComp[RANDOM_COMPUTE];
-    for (int i = 0; i < RANDOM_COMPUTE; i++) {
-      // not exactly counter mode - (rcounter+i,rcouter+i,rcounter+i,rcounter+i)
-      tempSecComp[i] = _mm_set1_epi32(rCounter + i);
-    }
-    AES_ecb_encrypt_chunk_in_out(tempSecComp, pseudoRandomString, RANDOM_COMPUTE, &aes_key);
+  if (rCounter % RANDOM_COMPUTE == 0) { // generate more random blocks
+    refillAt = ctr_.position();
+    ctr_.fill(pseudoRandomString, sizeof(pseudoRandomString));
   }
   return pseudoRandomString[rCounter % RANDOM_COMPUTE];
 }
 
+void AESObject::SaveState(rosetta::BinaryStateWriter& w) const {
+  ctr_.save_state(w);
+  w.put(refillAt);
+  w.put(rCounter);
+  w.put(randomBitNumber);
+  w.put(randomBitCounter);
+  w.put(random8BitNumber);
+  w.put(random8BitCounter);
+  w.put(random64BitNumber);
+  w.put(random64BitCounter);
+}
+
+bool AESObject::LoadState(rosetta::BinaryStateReader& r) {
+  if (!ctr_.load_state(r))
+    return false;
+  r.get(refillAt);
+  r.get(rCounter);
+  r.get(randomBitNumber);
+  r.get(randomBitCounter);
+  r.get(random8BitNumber);
+  r.get(random8BitCounter);
+  r.get(random64BitNumber);
+  r.get(random64BitCounter);
+  if (!r.ok())
+    return false;
+  // the blocks are drawn again instead of saved
+  if (rCounter != (unsigned long)-1) {
+    rosetta::RttAesCtr::Position now = ctr_.position();
+    ctr_.seek(refillAt);
+    ctr_.fill(pseudoRandomString, sizeof(pseudoRandomString));
+    ctr_.seek(now);
+  }
+  return true;
+}
+
 mpc_t AESObject::get64Bits() {
   mpc_t ret;
 
@@ -233,3 +263,44 @@ void AESObject::AES_random_shuffle(vector<small_mpc_t>& vec, size_t begin_offset
     swap(first[i], first[AES_random(i + 1)]);
   }
 }
+
+void AESObject::fillRandom(void* buf, size_t len) { ctr_.fill(buf, len); }
+
+void AESObject::fillBits(small_mpc_t* out, size_t n) { ctr_.fill_bits(out, n); }
+
+void AESObject::fillRing(mpc_t* out, size_t n) { ctr_.fill_ring(out, n); }
+
+void AESObject::fillModPrime(small_mpc_t* out, size_t n) { ctr_.fill_mod(out, n, PRIME_NUMBER); }
+
+void AESObject::fillNonZeroModPrime(small_mpc_t* out, size_t n) {
+  ctr_.fill_mod(out, n, PRIME_NUMBER, 1);
+}
+
+void AESObject::AES_random_shuffle_batch(vector<small_mpc_t>& vec, size_t segments, size_t dim) {
+  if (dim < 2)
+    return;
+
+  // one 32-bit word per Fisher-Yates step, rejections (p < dim/2^32) draw extra words
+  size_t steps = segments * (dim - 1);
+  vector<uint32_t> rnd(steps);
+  fillRandom(rnd.data(), steps * sizeof(uint32_t));
+
+  size_t k = 0;
+  for (size_t s = 0; s < segments; ++s) {
+    small_mpc_t* first = vec.data() + s * dim;
+    for (size_t i = dim - 1; i > 0; --i) {
+      // Lemire: j = (x * bound) >> 32, unbiased after rejecting the low word below 2^32 % bound
+      uint32_t bound = (uint32_t)(i + 1);
+      uint64_t m = (uint64_t)rnd[k++] * bound;
+      if ((uint32_t)m < bound) {
+        uint32_t t = (uint32_t)(-bound) % bound;
+        while ((uint32_t)m < t) {
+          uint32_t x;
+          fillRandom(&x, sizeof(x));
+          m = (uint64_t)x * bound;
+        }
+      }
+      std::swap(first[i], first[m >> 32]);
+    }
+  }
+}
@@ -22,14 +22,16 @@
 #include "cc/modules/protocol/mpc/snn/src/internal/snn_helper.h"
 
 #include "cc/modules/protocol/mpc/snn/src/internal/TedKrovetzAesNiWrapperC.h"
+#include "cc/modules/protocol/utility/include/aes_ctr.h"
 
 class AESObject {
  private:
  public:
-  // AES variables
+  // AES variables, RANDOM_COMPUTE blocks are drawn from the counter-mode engine at a time
+  rosetta::RttAesCtr ctr_;
   __m128i pseudoRandomString[RANDOM_COMPUTE];
   unsigned long rCounter = -1;
-  AES_KEY_TED aes_key;
+  rosetta::RttAesCtr::Position refillAt; // where pseudoRandomString was drawn from
 
   // Extraction variables
   __m128i randomBitNumber{0};
@@ -51,6 +53,10 @@ class AESObject {
   explicit AESObject() = default;
   void Init(const std::string& key);
 
+  // The whole state, so that a loaded object goes on with the same values
+  void SaveState(rosetta::BinaryStateWriter& w) const;
+  bool LoadState(rosetta::BinaryStateReader& r);
+
   // Randomness functions
   mpc_t get64Bits();
   small_mpc_t get8Bits();
@@ -61,4 +67,14 @@ class AESObject {
   small_mpc_t randNonZeroModPrime();
   mpc_t randModuloOdd();
   void AES_random_shuffle(vector<small_mpc_t>& vec, size_t begin_offset, size_t end_offset);
+
+  // Bulk randomness, straight from the engine without going through the per-value counters
+  void fillRandom(void* buf, size_t len);
+  void fillBits(small_mpc_t* out, size_t n);
+  void fillRing(mpc_t* out, size_t n);
+  void fillModPrime(small_mpc_t* out, size_t n);
+  void fillNonZeroModPrime(small_mpc_t* out, size_t n);
+  // Shuffles each of the `segments` consecutive blocks of `dim` elements of vec,
+  // with all indices drawn from one bulk fill (Lemire's bounded sampling)
+  void AES_random_shuffle_batch(vector<small_mpc_t>& vec, size_t segments, size_t dim);
 };
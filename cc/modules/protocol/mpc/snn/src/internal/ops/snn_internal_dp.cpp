@@ -0,0 +1,235 @@
+#include "cc/modules/protocol/mpc/snn/include/snn_internal.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_dp.h"
+#include "cc/modules/common/include/utils/str_type_convert.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rosetta {
+namespace snn {
+
+int SnnInternal::RandomBits(size_t size, vector<mpc_t>& c) {
+  tlog_debug << "RandomBits ...";
+  const int float_precision = GetMpcContext()->FLOAT_PRECISION;
+
+  // P0's coins shared as (c, 0), P1's as (0, c), both scaled to 1.0
+  vector<mpc_t> coin_a(size, 0), coin_b(size, 0);
+  if (PRIMARY) {
+    vector<small_mpc_t> coins(size);
+    aes_indep->fillBits(coins.data(), size);
+    vector<mpc_t>& mine = (partyNum == PARTY_A) ? coin_a : coin_b;
+    for (size_t i = 0; i < size; ++i)
+      mine[i] = static_cast<mpc_t>(coins[i]) << float_precision;
+  }
+  vector<mpc_t> both(size, 0);
+  DotProduct(coin_a, coin_b, both);
+
+  // c0 ^ c1 = c0 + c1 - 2 * c0 * c1
+  c.assign(size, 0);
+  if (PRIMARY) {
+    for (size_t i = 0; i < size; ++i)
+      c[i] = coin_a[i] + coin_b[i] - 2 * both[i];
+  }
+
+  tlog_debug << "RandomBits ok.";
+  return 0;
+}
+
+int SnnInternal::RandomUniform(size_t size, size_t bits, vector<mpc_t>& u) {
+  tlog_debug << "RandomUniform ...";
+  const int float_precision = GetMpcContext()->FLOAT_PRECISION;
+  assert(bits > 0 && bits < float_precision);
+  vector<mpc_t> c;
+  RandomBits(size * bits, c);
+
+  // u = sum_j c_j / 2^(j+1) + 1/2^(bits+1)
+  u.assign(size, 0);
+  if (PRIMARY) {
+    for (size_t i = 0; i < size; ++i) {
+      mpc_t acc = 0;
+      for (size_t j = 0; j < bits; ++j)
+        acc += c[i * bits + j] << (bits - 1 - j);
+      Truncate(acc, bits, PARTY_A, PARTY_B, partyNum);
+      if (partyNum == PARTY_A)
+        acc += static_cast<mpc_t>(1) << (float_precision - bits - 1);
+      u[i] = acc;
+    }
+  }
+
+  tlog_debug << "RandomUniform ok.";
+  return 0;
+}
+
+int SnnInternal::RandomLaplace(size_t size, double scale, vector<mpc_t>& l) {
+  tlog_debug << "RandomLaplace ...";
+  const int float_precision = GetMpcContext()->FLOAT_PRECISION;
+  const int uniform_bits = dp_uniform_bits(float_precision);
+  vector<uint64_t> thresholds;
+  dp_laplace_thresholds(scale, float_precision, uniform_bits, thresholds);
+  const size_t B = thresholds.size();
+  const size_t chunk = std::max<size_t>(1, kDPCoinsPerRound / (2 * B * uniform_bits));
+
+  l.assign(size, 0);
+  for (size_t begin = 0; begin < size; begin += chunk) {
+    size_t n = std::min(chunk, size - begin);
+    // bit j of G1 (rows < n) and G2 (rows >= n), one uniform each
+    size_t m = 2 * n * B;
+    vector<mpc_t> c;
+    RandomBits(m * uniform_bits, c);
+
+    // bit = (T_j - 1 - U >= 0), with U * 2^precision = sum_k c_k * 2^k
+    vector<mpc_t> diff(m, 0), bit(m, 0);
+    if (PRIMARY) {
+      for (size_t r = 0; r < m; ++r) {
+        mpc_t acc = 0;
+        for (int k = 0; k < uniform_bits; ++k)
+          acc += c[r * uniform_bits + k] << k;
+        if (partyNum == PARTY_A)
+          diff[r] = (static_cast<mpc_t>(thresholds[r % B]) - 1) << float_precision;
+        diff[r] -= acc;
+      }
+    }
+    ReluPrime(diff, bit);
+
+    // l = G1 - G2 LSB, the bits are scaled by 2^precision so the truncation is exact
+    if (PRIMARY) {
+      for (size_t i = 0; i < n; ++i) {
+        mpc_t acc = 0;
+        for (size_t j = 0; j < B; ++j)
+          acc += (bit[i * B + j] - bit[(n + i) * B + j]) << j;
+        Truncate(acc, float_precision, PARTY_A, PARTY_B, partyNum);
+        l[begin + i] = acc;
+      }
+    }
+  }
+
+  tlog_debug << "RandomLaplace ok.";
+  return 0;
+}
+
+int SnnInternal::RandomBinomial(size_t size, size_t coins, int grid_bits, vector<mpc_t>& z) {
+  tlog_debug << "RandomBinomial ...";
+  const int float_precision = GetMpcContext()->FLOAT_PRECISION;
+  const size_t chunk = std::max<size_t>(1, kDPCoinsPerRound / coins);
+
+  z.assign(size, 0);
+  for (size_t begin = 0; begin < size; begin += chunk) {
+    size_t n = std::min(chunk, size - begin);
+    vector<mpc_t> c;
+    RandomBits(n * coins, c);
+
+    // z = 2^grid_bits * (K - N / 2) LSB
+    if (PRIMARY) {
+      for (size_t i = 0; i < n; ++i) {
+        mpc_t acc = 0;
+        for (size_t k = 0; k < coins; ++k)
+          acc += c[i * coins + k];
+        if (partyNum == PARTY_A)
+          acc -= static_cast<mpc_t>(coins / 2) << float_precision;
+        if (grid_bits >= float_precision)
+          acc <<= grid_bits - float_precision;
+        else
+          Truncate(acc, float_precision - grid_bits, PARTY_A, PARTY_B, partyNum);
+        z[begin + i] = acc;
+      }
+    }
+  }
+
+  tlog_debug << "RandomBinomial ok.";
+  return 0;
+}
+
+int SnnInternal::DPNoise(
+  const vector<mpc_t>& a,
+  const string& mechanism,
+  double scale,
+  vector<mpc_t>& b) {
+  tlog_debug << "DPNoise " << mechanism << " ...";
+  AUDIT("id:{}, P{} DPNoise {}({}), input X(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), mechanism, scale, Vector<mpc_t>(a));
+  size_t size = a.size();
+  vector<mpc_t> base(a), noise;
+  if (mechanism == "gaussian") {
+    int grid_bits = 0;
+    size_t coins = 0;
+    dp_binomial_params(scale, GetMpcContext()->FLOAT_PRECISION, grid_bits, coins);
+    RandomBinomial(size, coins, grid_bits, noise);
+    // the binomial mechanism releases values of the 2^grid_bits grid
+    if (PRIMARY && grid_bits > 0) {
+      for (size_t i = 0; i < size; ++i) {
+        Truncate(base[i], grid_bits, PARTY_A, PARTY_B, partyNum);
+        base[i] <<= grid_bits;
+      }
+    }
+  } else if (mechanism == "laplace") {
+    RandomLaplace(size, scale, noise);
+  } else {
+    tlog_error << "DPNoise not supported mechanism: " << mechanism;
+    return -1;
+  }
+  Add(base, noise, b);
+
+  AUDIT("id:{}, P{} DPNoise {}({}), output Y(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), mechanism, scale, Vector<mpc_t>(b));
+  tlog_debug << "DPNoise ok.";
+  return 0;
+}
+
+int SnnInternal::ClipByL2Norm(
+  const vector<mpc_t>& a,
+  vector<mpc_t>& b,
+  size_t rows,
+  size_t cols,
+  double clip_norm) {
+  tlog_debug << "ClipByL2Norm ...";
+  AUDIT("id:{}, P{} ClipByL2Norm({},{}) {}, input X(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), rows, cols, clip_norm, Vector<mpc_t>(a));
+  assert(a.size() == rows * cols && clip_norm > 0);
+  const int float_precision = GetMpcContext()->FLOAT_PRECISION;
+  const mpc_t one = FloatToMpcType(1, float_precision);
+
+  // t = ||g / clip_norm||^2, scaled before squaring so that 1 / clip_norm^2 never underflows
+  int shift = 0;
+  double ratio = 1.0;
+  dp_clip_norm_split(clip_norm, shift, ratio);
+  vector<mpc_t> reduced(a), scaled(a.size(), 0);
+  if (PRIMARY && shift > 0) {
+    for (size_t i = 0; i < a.size(); ++i)
+      Truncate(reduced[i], shift, PARTY_A, PARTY_B, partyNum);
+  }
+  DotProduct(vector<double>(a.size(), ratio), reduced, scaled);
+  vector<mpc_t> squares(a.size(), 0), t(rows, 0);
+  DotProduct(scaled, scaled, squares);
+  Sum(squares, t, rows, cols);
+
+  vector<mpc_t> shifted(t), over(rows, 0), inv_norm(rows, 0);
+  if (partyNum == PARTY_A) {
+    for (size_t i = 0; i < rows; ++i)
+      shifted[i] -= one;
+  }
+  ReluPrime(shifted, over);
+  Rsqrt(t, inv_norm);
+
+  // factor = 1 + (t >= 1) * (clip_norm / ||g|| - 1)
+  if (partyNum == PARTY_A) {
+    for (size_t i = 0; i < rows; ++i)
+      inv_norm[i] -= one;
+  }
+  vector<mpc_t> factor(rows, 0);
+  DotProduct(over, inv_norm, factor);
+  if (partyNum == PARTY_A) {
+    for (size_t i = 0; i < rows; ++i)
+      factor[i] += one;
+  }
+
+  vector<mpc_t> factor_b(a.size());
+  for (size_t i = 0; i < rows; ++i)
+    for (size_t j = 0; j < cols; ++j)
+      factor_b[i * cols + j] = factor[i];
+  b.resize(a.size());
+  DotProduct(a, factor_b, b);
+
+  AUDIT("id:{}, P{} ClipByL2Norm({},{}) {}, output Y(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), rows, cols, clip_norm, Vector<mpc_t>(b));
+  tlog_debug << "ClipByL2Norm ok.";
+  return 0;
+}
+
+} // namespace snn
+} // namespace rosetta
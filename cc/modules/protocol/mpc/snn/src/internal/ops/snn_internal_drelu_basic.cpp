@@ -34,6 +34,10 @@ int SnnInternal::PrivateCompare(
     if (PARALLEL) {
       // I have removed the parallel for private compare, by yyl, 2020.03.12
     } else {
+      // all the nonzero multipliers in one bulk draw
+      vector<small_mpc_t> masks(sizeLong);
+      aes_common->fillNonZeroModPrime(masks.data(), sizeLong);
+
       // Check the security of the first if condition
       for (size_t index2 = 0; index2 < size; ++index2) {
         if (beta[index2] == 1 and r[index2] != MINUS_ONE)
@@ -50,7 +54,7 @@ int SnnInternal::PrivateCompare(
             if (partyNum == PARTY_A)
               c[index3] = subtractModPrime((k != 0), c[index3]);
 
-            c[index3] = multiplyModPrime(c[index3], aes_common->randNonZeroModPrime());
+            c[index3] = multiplyModPrime(c[index3], masks[index3]);
           }
         } else {
           // Single for loop
@@ -77,11 +81,12 @@ int SnnInternal::PrivateCompare(
               c[index3] = addModPrime(c[index3], tempM);
             }
 
-            c[index3] = multiplyModPrime(c[index3], aes_common->randNonZeroModPrime());
+            c[index3] = multiplyModPrime(c[index3], masks[index3]);
           }
         }
-        aes_common->AES_random_shuffle(c, index2 * dim, (index2 + 1) * dim);
       }
+      // shuffle every dim-sized block at once, P0 and P1 draw the same permutations
+      aes_common->AES_random_shuffle_batch(c, size, dim);
     }
     sendVector<small_mpc_t>(c, PARTY, sizeLong);
     AUDIT("id:{}, P{} PrivateCompare SEND to P{}(small_mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), PARTY, Vector<small_mpc_t>(c));
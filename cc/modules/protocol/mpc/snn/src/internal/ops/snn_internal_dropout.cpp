@@ -0,0 +1,57 @@
+#include "cc/modules/protocol/mpc/snn/include/snn_internal.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_mask_store.h"
+
+#include <cmath>
+
+namespace rosetta {
+namespace snn {
+
+// bits of each uniform the secret mask is compared with
+static const size_t kDropoutUniformBits = 8;
+
+int SnnInternal::DropoutCommonMask(size_t size, double rate, vector<double>& mask) {
+  tlog_debug << "DropoutCommonMask ...";
+  assert(rate >= 0 && rate < 1);
+  double scale = 0;
+  const uint64_t threshold = dropout_keep_cells(rate, 16, scale);
+
+  mask.assign(size, 0);
+  if (PRIMARY) {
+    vector<uint16_t> r(size);
+    aes_common->fillRandom(r.data(), size * sizeof(uint16_t));
+    for (size_t i = 0; i < size; ++i) {
+      if (r[i] < threshold)
+        mask[i] = scale;
+    }
+  }
+
+  tlog_debug << "DropoutCommonMask ok.";
+  return 0;
+}
+
+int SnnInternal::DropoutSharedMask(size_t size, double rate, vector<mpc_t>& mask) {
+  tlog_debug << "DropoutSharedMask ...";
+  assert(rate >= 0 && rate < 1);
+  double scale = 0;
+  const uint64_t t = dropout_keep_cells(rate, kDropoutUniformBits, scale);
+
+  // keep where t / 2^bits - u >= 0, u sits mid-cell so this is exactly cell < t
+  vector<mpc_t> u, kept(size, 0);
+  RandomUniform(size, kDropoutUniformBits, u);
+  vector<mpc_t> diff(size, 0);
+  if (PRIMARY) {
+    mpc_t fp_keep = FloatToMpcType(std::ldexp(double(t), -int(kDropoutUniformBits)), GetMpcContext()->FLOAT_PRECISION);
+    for (size_t i = 0; i < size; ++i)
+      diff[i] = (partyNum == PARTY_A) ? fp_keep - u[i] : -u[i];
+  }
+  ReluPrime(diff, kept);
+
+  mask.resize(size);
+  DotProduct(vector<double>(size, scale), kept, mask);
+
+  tlog_debug << "DropoutSharedMask ok.";
+  return 0;
+}
+
+} // namespace snn
+} // namespace rosetta
@@ -1,5 +1,6 @@
 #include "cc/modules/protocol/mpc/snn/include/snn_internal.h"
 #include "cc/modules/common/include/utils/str_type_convert.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_pow.h"
 #include <thread>
 
 using std::thread;
@@ -117,53 +118,11 @@ void SnnInternal::PolynomialPowConst(
   mpc_t common_k,
   vector<mpc_t>& shared_Y) {
   tlog_debug << "UniPolynomialPowConst  ...";
-  AUDIT("id:{}, P{} UniPolynomialPowConst, input X(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), Vector<mpc_t>(shared_Y));
+  AUDIT("id:{}, P{} UniPolynomialPowConst, input X(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), Vector<mpc_t>(shared_X));
   AUDIT("id:{}, P{} UniPolynomialPowConst, input K(mpc_t): {}", msg_id().get_hex(), context_->GetMyRole(), common_k);
-  // cout << "DEBUG new mpc_pow_const" << endl;
   int vec_size = shared_X.size();
-  shared_Y.resize(vec_size);
-  // init curr_Y to '1'
-  vector<mpc_t> curr_Y(vec_size, FloatToMpcType(1.0 / 2, GetMpcContext()->FLOAT_PRECISION));
-
-  if (common_k == 0) {
-    shared_Y = curr_Y;
-    return;
-  }
-  if (common_k == 1) {
-    shared_Y = shared_X;
-    return;
-  }
-
-  int curr_k = common_k;
-  // current value in this bit
-  int curr_bit = 0;
-  // 2's power value
-  int curr_p = 1;
-
-  vector<mpc_t> P = shared_X;
-  vector<mpc_t> tmp_new_y = curr_Y;
-  vector<mpc_t> tmp_new_P = P;
-  bool least_bit_covered = false;
-  while (curr_k != 0) {
-    curr_bit = curr_k % 2;
-    if (curr_p != 1) {
-      DotProduct(P, P, tmp_new_P);
-      P = tmp_new_P;
-    }
-    if (curr_bit) {
-      // LSB bit, no need to use MPC to multiply const ONE.
-      if (!least_bit_covered) {
-        curr_Y = P;
-        least_bit_covered = true;
-      } else {
-        DotProduct(P, curr_Y, tmp_new_y);
-        curr_Y = tmp_new_y;
-      }
-    }
-    curr_k = int(curr_k / 2);
-    curr_p++;
-  }
-  shared_Y = curr_Y;
+  vector<int64_t> K(vec_size, (int64_t)(signed_mpc_t)common_k);
+  PowVectorized(shared_X, K, shared_Y);
 
   AUDIT("id:{}, P{} UniPolynomialConst, output(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), Vector<mpc_t>(shared_Y));
   tlog_debug << "UniPolynomialConst  ok.";
@@ -199,6 +158,22 @@ void SnnInternal::PolynomialLocalConstMul(
   tlog_debug << "PolynomialLocalConstMul  ok.";
 }
 
+void SnnInternal::PowVectorized(
+  const vector<mpc_t>& shared_X,
+  const vector<int64_t>& common_K,
+  vector<mpc_t>& shared_Y) {
+  // '1' is shared as 1/2 + 1/2 by P0 and P1
+  vector<mpc_t> ONE(shared_X.size(), FloatToMpcType(1.0 / 2, GetMpcContext()->FLOAT_PRECISION));
+  vectorized_pow(
+    shared_X, common_K, ONE, shared_Y,
+    [this](const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+      DotProduct(a, b, c);
+    },
+    [this](const vector<mpc_t>& a, const vector<mpc_t>& b, vector<mpc_t>& c) {
+      Reciprocaldivision(a, b, c);
+    });
+}
+
 int SnnInternal::PowV1(const vector<mpc_t>& x, size_t n, vector<mpc_t>& y) {
   size_t size = x.size();
   vector<int64_t> vn(size, (int64_t)n);
@@ -211,26 +186,8 @@ int SnnInternal::Pow(const vector<mpc_t>& x, vector<int64_t> n, vector<mpc_t>& y
   size_t size = x.size();
   assert(x.size() == n.size());
   assert(x.size() == size);
-  // auto poly = GetSnnOpInner(Polynomial);
-
-  // Added in V0.2.1 to support vectorization
-  bool is_common_k = true;
-  for (int i = 1; i < size; ++i) {
-    if (n[i] != n[i - 1]) {
-      is_common_k = false;
-      break;
-    }
-  }
-
-  if (is_common_k) {
-    // cout << "DEBUG; common k" << endl;
-    PolynomialPowConst(x, n[0], y);
-    return 0;
-  }
-
-  for (auto i = 0; i < size; i++) {
-    PolynomialPowConst(x[i], n[i], y[i]);
-  }
+  // one batched chain for any mix of exponents, see vectorized_pow
+  PowVectorized(x, n, y);
 
   AUDIT("id:{}, P{} Pow, output n(int64_t){}", msg_id().get_hex(), context_->GetMyRole(), Vector<int64_t>(n));
   AUDIT("id:{}, P{} Pow, output y(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), Vector<mpc_t>(y));
@@ -1,5 +1,7 @@
 #include "cc/modules/protocol/mpc/snn/include/snn_internal.h"
 #include "cc/modules/common/include/utils/str_type_convert.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_gc_compare.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_helper.h"
 
 
 namespace rosetta {
@@ -54,6 +56,15 @@ int SnnInternal::ReluPrime(const vector<mpc_t>& a, vector<mpc_t>& b) {
   AUDIT("id:{}, P{} ReluPrime, input X(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), Vector<mpc_t>(a));
 
   size_t size = a.size();
+  // in constant rounds, on links where that beats ShareConvert + ComputeMSB
+  auto gc = context_->GC_COMPARE;
+  if (gc && gc->CostModel().PreferGc(size)) {
+    gc->DReLU(msg_id(), a, b, GetMpcContext()->FLOAT_PRECISION);
+    AUDIT("id:{}, P{} ReluPrime(gc), output Y(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), Vector<mpc_t>(b));
+    tlog_debug << "ReluPrime ok.";
+    return 0;
+  }
+
   vector<mpc_t> twoA(size, 0);
   mpc_t j = 0;
 
@@ -623,5 +634,235 @@ int SnnInternal::SigmoidChebyshevPolyMPC(const vector<mpc_t>& a, vector<mpc_t>&
   return 0;
 }
 
+int SnnInternal::PiecewisePolynomial(
+  const vector<mpc_t>& a,
+  const string& func_name,
+  vector<mpc_t>& b) {
+  tlog_debug << "PiecewisePolynomial " << func_name << " ...";
+  AUDIT("id:{}, P{} PiecewisePolynomial {}, input X(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), func_name, Vector<mpc_t>(a));
+  const int float_precision = GetMpcContext()->FLOAT_PRECISION;
+  vector<double> break_points;
+  vector<vector<mpc_t>> coffs;
+  if (!PolyConfFactory::get_func_telescoping(func_name, float_precision, break_points, coffs)) {
+    tlog_error << "can not find polynomials for func " << func_name;
+    return -1;
+  }
+
+  size_t size = a.size();
+  size_t cmp_size = break_points.size();
+  size_t max_power = coffs[0].size() - 1;
+  b.assign(size, 0);
+
+  // S1: (X >= b_k) for all the break points in one ReluPrime
+  vector<mpc_t> shifted(cmp_size * size);
+  for (size_t k = 0; k < cmp_size; ++k) {
+    mpc_t point = FloatToMpcType(break_points[k], float_precision);
+    for (size_t i = 0; i < size; ++i) {
+      shifted[k * size + i] = a[i];
+      if (partyNum == PARTY_A)
+        shifted[k * size + i] -= point;
+    }
+  }
+  vector<mpc_t> cmp(cmp_size * size);
+  if (cmp_size > 0)
+    ReluPrime(shifted, cmp);
+
+  // S2: X^1..X^max_power, shared by all the segments. X^(c+d) = X^c * X^d with d a power of 2.
+  vector<vector<mpc_t>> powers(max_power + 1);
+  if (max_power >= 1)
+    powers[1] = a;
+  for (size_t d = 1; d < max_power; d *= 2) {
+    size_t top = std::min(2 * d, max_power);
+    vector<mpc_t> lhs, rhs;
+    for (size_t c = 1; c + d <= top; ++c) {
+      lhs.insert(lhs.end(), powers[c].begin(), powers[c].end());
+      rhs.insert(rhs.end(), powers[d].begin(), powers[d].end());
+    }
+    vector<mpc_t> prod(lhs.size());
+    DotProduct(lhs, rhs, prod);
+    for (size_t c = 1; c + d <= top; ++c)
+      powers[c + d].assign(prod.begin() + (c - 1) * size, prod.begin() + c * size);
+  }
+
+  // S3: g_k(X) locally, then all the (X >= b_k) * g_k(X) in one DotProduct
+  vector<mpc_t> g(cmp_size * size);
+  if (PRIMARY) {
+    for (size_t k = 0; k <= cmp_size; ++k) {
+      for (size_t i = 0; i < size; ++i) {
+        mpc_t acc = 0;
+        for (size_t p = 1; p <= max_power; ++p)
+          acc += coffs[k][p] * powers[p][i];
+        Truncate(acc, float_precision, PARTY_A, PARTY_B, partyNum);
+        if (partyNum == PARTY_A)
+          acc += coffs[k][0];
+        if (k == 0)
+          b[i] = acc;
+        else
+          g[(k - 1) * size + i] = acc;
+      }
+    }
+  }
+  if (cmp_size > 0) {
+    vector<mpc_t> selected(cmp_size * size);
+    DotProduct(cmp, g, selected);
+    if (PRIMARY) {
+      for (size_t k = 0; k < cmp_size; ++k)
+        for (size_t i = 0; i < size; ++i)
+          b[i] += selected[k * size + i];
+    }
+  }
+
+  AUDIT("id:{}, P{} PiecewisePolynomial {}, output Y(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), func_name, Vector<mpc_t>(b));
+  tlog_debug << "PiecewisePolynomial " << func_name << " ok.";
+  return 0;
+}
+
+// rows x cols broadcast of a per-row (or per-column) vector
+static void layer_norm_broadcast(
+  const vector<mpc_t>& v,
+  vector<mpc_t>& out,
+  size_t rows,
+  size_t cols,
+  bool per_row) {
+  out.resize(rows * cols);
+  for (size_t i = 0; i < rows; ++i)
+    for (size_t j = 0; j < cols; ++j)
+      out[i * cols + j] = per_row ? v[i] : v[j];
+}
+
+int SnnInternal::LayerNorm(
+  const vector<mpc_t>& x,
+  const vector<mpc_t>& gamma,
+  const vector<mpc_t>& beta,
+  vector<mpc_t>& y,
+  vector<mpc_t>& inv_std,
+  size_t rows,
+  size_t cols,
+  double epsilon) {
+  tlog_debug << "LayerNorm ...";
+  AUDIT("id:{}, P{} LayerNorm({},{}), input X(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), rows, cols, Vector<mpc_t>(x));
+  size_t size = rows * cols;
+  assert(x.size() == size && gamma.size() == cols && beta.size() == cols);
+
+  vector<mpc_t> mean(rows, 0), centered(size, 0);
+  Mean(x, mean, rows, cols);
+  if (PRIMARY) {
+    for (size_t i = 0; i < rows; ++i)
+      for (size_t j = 0; j < cols; ++j)
+        centered[i * cols + j] = x[i * cols + j] - mean[i];
+  }
+
+  // (X - mean)^2 and gamma * (X - mean) in one round
+  vector<mpc_t> gamma_b;
+  layer_norm_broadcast(gamma, gamma_b, rows, cols, false);
+  vector<mpc_t> lhs(centered), rhs(centered);
+  lhs.insert(lhs.end(), centered.begin(), centered.end());
+  rhs.insert(rhs.end(), gamma_b.begin(), gamma_b.end());
+  vector<mpc_t> prod(2 * size);
+  DotProduct(lhs, rhs, prod);
+
+  vector<mpc_t> squares(prod.begin(), prod.begin() + size);
+  vector<mpc_t> var(rows, 0);
+  Mean(squares, var, rows, cols);
+  epsilon = clamp_fixpoint_epsilon(epsilon, GetMpcContext()->FLOAT_PRECISION);
+  Add(var, vector<double>(rows, epsilon), var);
+  inv_std.resize(rows);
+  Rsqrt(var, inv_std);
+
+  vector<mpc_t> scaled(prod.begin() + size, prod.end());
+  vector<mpc_t> inv_std_b;
+  layer_norm_broadcast(inv_std, inv_std_b, rows, cols, true);
+  y.resize(size);
+  DotProduct(scaled, inv_std_b, y);
+  if (PRIMARY) {
+    for (size_t i = 0; i < size; ++i)
+      y[i] += beta[i % cols];
+  }
+
+  AUDIT("id:{}, P{} LayerNorm({},{}), output Y(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), rows, cols, Vector<mpc_t>(y));
+  tlog_debug << "LayerNorm ok.";
+  return 0;
+}
+
+int SnnInternal::LayerNormGrad(
+  const vector<mpc_t>& x,
+  const vector<mpc_t>& gamma,
+  const vector<mpc_t>& inv_std,
+  const vector<mpc_t>& dy,
+  vector<mpc_t>& dx,
+  vector<mpc_t>& dgamma,
+  vector<mpc_t>& dbeta,
+  size_t rows,
+  size_t cols) {
+  tlog_debug << "LayerNormGrad ...";
+  AUDIT("id:{}, P{} LayerNormGrad({},{}), input dY(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), rows, cols, Vector<mpc_t>(dy));
+  size_t size = rows * cols;
+  assert(x.size() == size && dy.size() == size && gamma.size() == cols && inv_std.size() == rows);
+
+  vector<mpc_t> mean(rows, 0), centered(size, 0);
+  Mean(x, mean, rows, cols);
+  if (PRIMARY) {
+    for (size_t i = 0; i < rows; ++i)
+      for (size_t j = 0; j < cols; ++j)
+        centered[i * cols + j] = x[i * cols + j] - mean[i];
+  }
+  vector<mpc_t> gamma_b, inv_std_b;
+  layer_norm_broadcast(gamma, gamma_b, rows, cols, false);
+  layer_norm_broadcast(inv_std, inv_std_b, rows, cols, true);
+
+  // R1: x_hat = (X - mean) * inv_std, dx_hat = dY * gamma
+  vector<mpc_t> lhs(centered), rhs(inv_std_b);
+  lhs.insert(lhs.end(), dy.begin(), dy.end());
+  rhs.insert(rhs.end(), gamma_b.begin(), gamma_b.end());
+  vector<mpc_t> prod(lhs.size());
+  DotProduct(lhs, rhs, prod);
+  vector<mpc_t> x_hat(prod.begin(), prod.begin() + size);
+  vector<mpc_t> dx_hat(prod.begin() + size, prod.end());
+
+  // R2: dx_hat * x_hat, dY * x_hat, inv_std * dx_hat, inv_std * x_hat
+  lhs = dx_hat;
+  lhs.insert(lhs.end(), dy.begin(), dy.end());
+  lhs.insert(lhs.end(), dx_hat.begin(), dx_hat.end());
+  lhs.insert(lhs.end(), x_hat.begin(), x_hat.end());
+  rhs = x_hat;
+  rhs.insert(rhs.end(), x_hat.begin(), x_hat.end());
+  rhs.insert(rhs.end(), inv_std_b.begin(), inv_std_b.end());
+  rhs.insert(rhs.end(), inv_std_b.begin(), inv_std_b.end());
+  prod.resize(lhs.size());
+  DotProduct(lhs, rhs, prod);
+  vector<mpc_t> dx_hat_x_hat(prod.begin(), prod.begin() + size);
+  vector<mpc_t> dy_x_hat(prod.begin() + size, prod.begin() + 2 * size);
+
+  vector<mpc_t> mean_dx_hat(rows, 0), mean_dx_hat_x_hat(rows, 0);
+  Mean(dx_hat, mean_dx_hat, rows, cols);
+  Mean(dx_hat_x_hat, mean_dx_hat_x_hat, rows, cols);
+  AddN(dy_x_hat, dgamma, rows, cols);
+  AddN(dy, dbeta, rows, cols);
+
+  // R3: inv_std * mean(dx_hat) per row, inv_std * x_hat * mean(dx_hat * x_hat)
+  vector<mpc_t> m2_b;
+  layer_norm_broadcast(mean_dx_hat_x_hat, m2_b, rows, cols, true);
+  lhs = inv_std;
+  lhs.insert(lhs.end(), prod.begin() + 3 * size, prod.end());
+  rhs = mean_dx_hat;
+  rhs.insert(rhs.end(), m2_b.begin(), m2_b.end());
+  vector<mpc_t> corr(lhs.size());
+  DotProduct(lhs, rhs, corr);
+
+  dx.assign(size, 0);
+  if (PRIMARY) {
+    for (size_t i = 0; i < rows; ++i) {
+      for (size_t j = 0; j < cols; ++j) {
+        size_t idx = i * cols + j;
+        dx[idx] = prod[2 * size + idx] - corr[i] - corr[rows + idx];
+      }
+    }
+  }
+
+  AUDIT("id:{}, P{} LayerNormGrad({},{}), output dX(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), rows, cols, Vector<mpc_t>(dx));
+  tlog_debug << "LayerNormGrad ok.";
+  return 0;
+}
+
 }//snn
 }//rosetta
@@ -0,0 +1,55 @@
+#include "cc/modules/protocol/mpc/snn/include/snn_internal.h"
+
+namespace rosetta {
+namespace snn {
+
+int SnnInternal::OneHot(const vector<mpc_t>& a, size_t depth, vector<mpc_t>& b) {
+  tlog_debug << "OneHot ...";
+  AUDIT("id:{}, P{} OneHot({}), input X(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), depth, Vector<mpc_t>(a));
+  assert(depth > 0);
+  const int float_precision = GetMpcContext()->FLOAT_PRECISION;
+  size_t size = a.size();
+  size_t width = depth + 1;
+
+  // ge_j = (a - j + 0.5 >= 0) for j = 0..depth, all in one comparison batch
+  vector<mpc_t> shifted(size * width), ge(size * width, 0);
+  for (size_t i = 0; i < size; ++i) {
+    for (size_t j = 0; j < width; ++j) {
+      shifted[i * width + j] = a[i];
+      if (partyNum == PARTY_A)
+        shifted[i * width + j] -= FloatToMpcType(j - 0.5, float_precision);
+    }
+  }
+  ReluPrime(shifted, ge);
+
+  b.resize(size * depth);
+  for (size_t i = 0; i < size; ++i)
+    for (size_t j = 0; j < depth; ++j)
+      b[i * depth + j] = ge[i * width + j] - ge[i * width + j + 1];
+
+  AUDIT("id:{}, P{} OneHot({}), output Y(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), depth, Vector<mpc_t>(b));
+  tlog_debug << "OneHot ok.";
+  return 0;
+}
+
+int SnnInternal::OneHotToIndex(const vector<mpc_t>& a, size_t depth, vector<mpc_t>& b) {
+  tlog_debug << "OneHotToIndex ...";
+  AUDIT("id:{}, P{} OneHotToIndex({}), input X(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), depth, Vector<mpc_t>(a));
+  assert(depth > 0 && a.size() % depth == 0);
+  size_t rows = a.size() / depth;
+
+  // public integer weights, so the products stay exact without truncation
+  b.assign(rows, 0);
+  if (PRIMARY) {
+    for (size_t i = 0; i < rows; ++i)
+      for (size_t j = 1; j < depth; ++j)
+        b[i] += static_cast<mpc_t>(j) * a[i * depth + j];
+  }
+
+  AUDIT("id:{}, P{} OneHotToIndex({}), output Y(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), depth, Vector<mpc_t>(b));
+  tlog_debug << "OneHotToIndex ok.";
+  return 0;
+}
+
+} // namespace snn
+} // namespace rosetta
@@ -0,0 +1,64 @@
+#include "cc/modules/protocol/mpc/snn/include/snn_internal.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_topk.h"
+
+namespace rosetta {
+namespace snn {
+
+int SnnInternal::TopK(
+  const vector<mpc_t>& a,
+  size_t rows,
+  size_t cols,
+  size_t k,
+  vector<mpc_t>& values,
+  vector<mpc_t>& indices) {
+  tlog_debug << "TopK ...";
+  AUDIT("id:{}, P{} TopK({},{}) k={}, input X(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), rows, cols, k, Vector<mpc_t>(a));
+  assert(a.size() == rows * cols && k > 0 && k <= cols);
+  const int float_precision = GetMpcContext()->FLOAT_PRECISION;
+
+  // public constants, held by PARTY_A
+  vector<mpc_t> idx(cols, 0);
+  mpc_t pad = 0, pad_idx = 0;
+  if (partyNum == PARTY_A) {
+    for (size_t j = 0; j < cols; ++j)
+      idx[j] = FloatToMpcType(j, float_precision);
+    pad = FloatToMpcType(kBitonicTopKPad, float_precision);
+    pad_idx = FloatToMpcType(-1, float_precision);
+  }
+
+  // hi = b + (a >= b) * (a - b), lo = a + b - hi, the indices follow with the same bit
+  auto cswap = [&](vector<mpc_t>& A, vector<mpc_t>& B, vector<mpc_t>& IA, vector<mpc_t>& IB) {
+    size_t n = A.size();
+    vector<mpc_t> diff(n), ge(n, 0);
+    for (size_t i = 0; i < n; ++i)
+      diff[i] = A[i] - B[i];
+    ReluPrime(diff, ge);
+
+    vector<mpc_t> lhs(ge), rhs(diff), prod(2 * n, 0);
+    lhs.insert(lhs.end(), ge.begin(), ge.end());
+    rhs.resize(2 * n);
+    for (size_t i = 0; i < n; ++i)
+      rhs[n + i] = IA[i] - IB[i];
+    DotProduct(lhs, rhs, prod);
+
+    for (size_t i = 0; i < n; ++i) {
+      mpc_t a_i = A[i], ia_i = IA[i];
+      A[i] = B[i] + prod[i];
+      B[i] = a_i - prod[i];
+      IA[i] = IB[i] + prod[n + i];
+      IB[i] = ia_i - prod[n + i];
+    }
+  };
+
+  vector<mpc_t> top_idx;
+  bitonic_topk(a, idx, pad, pad_idx, rows, cols, k, values, top_idx, cswap);
+
+  OneHot(top_idx, cols, indices);
+
+  AUDIT("id:{}, P{} TopK({},{}) k={}, output values(mpc_t){}", msg_id().get_hex(), context_->GetMyRole(), rows, cols, k, Vector<mpc_t>(values));
+  tlog_debug << "TopK ok.";
+  return 0;
+}
+
+} // namespace snn
+} // namespace rosetta
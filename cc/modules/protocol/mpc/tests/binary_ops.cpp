@@ -123,6 +123,23 @@ void run(int partyid) {
 
     snn_binary_f_rh_const(Pow);
 
+    // negative exponents go through the reciprocal of the positive power
+    {
+      string tag("Pow");
+      vector<double> NegPow_B = {2.0, -4.0, 0.5, 3.0, 1.5};
+      vector<double> NegPow_N = {-1, -2, 3, -3, 0};
+      vector<double> NegPow_X = {0.5, 0.0625, 0.125, 1.0 / 27, 1.0};
+      vector<string> strB, literalN;
+      mpc_proto->GetOps(msgid)->PrivateInput(node_id_0, NegPow_B, strB);
+      convert_double_to_literal_str(NegPow_N, literalN, float_precision);
+      attr_type attr;
+      attr["rh_is_const"] = "1";
+      mpc_proto->GetOps(msgid)->Pow(strB, literalN, strZ, &attr);
+      vector<double> Z;
+      mpc_proto->GetOps(msgid)->Reveal(strZ, Z, &reveal_attr);
+      AROUND_EQUAL_T(Z, NegPow_X, 0.01, tag + "(private,negative const)" + "=P" + std::to_string(partyid));
+    }
+
     /***********    basic compare binary ops  ***********/
     snn_binary_f(Equal);
     snn_binary_f(NotEqual);
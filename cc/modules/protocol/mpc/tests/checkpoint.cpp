@@ -0,0 +1,109 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+// only for disable vscode warnings
+#ifndef PROTOCOL_MPC_TEST
+#define PROTOCOL_MPC_TEST_SNN 1
+#endif
+
+#include "cc/modules/protocol/mpc/tests/test.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_checkpoint.h"
+
+#include <cstring>
+
+/**
+ * Checkpoint and resume of a toy training loop on loopback.
+ *
+ * The first session trains for kSteps steps and saves a checkpoint after step
+ * kSaveAt. The task is then torn down, started again and restored from it. The
+ * steps after kSaveAt must reveal bit-identical weights in both sessions.
+ *
+ * usage: protocol_mpc_tests_<proto>_checkpoint
+ */
+
+namespace {
+
+const uint64_t kSteps = 6;
+const uint64_t kSaveAt = 3;
+
+// w -= (sigmoid(x * w) - y) * x, elementwise, with the ops of one msg id like a graph
+void train_step(shared_ptr<ProtocolOps> ops, map<string, vector<string>>& t) {
+  vector<string> z, s, g, gw, w;
+  ops->Mul(t["x"], t["w"], z);
+  ops->Sigmoid(z, s);
+  ops->Sub(s, t["y"], g);
+  ops->Mul(g, t["x"], gw);
+  ops->Sub(t["w"], gw, w);
+  t["w"].swap(w);
+}
+
+} // namespace
+
+static void run(int partyid) {
+  const string dir = "log/mpc_tests_checkpoint";
+  vector<double> X = {0.5, -1.0, 1.5, 2.0, -0.25, 0.75, -2.0, 1.0};
+  vector<double> Y = {1, 0, 1, 1, 0, 1, 0, 1};
+  vector<double> W(X.size(), 0.1);
+  vector<vector<double>> first(kSteps + 1);
+
+  // 1. train and save
+  {
+    PROTOCOL_MPC_TEST_INIT(partyid);
+    MpcCheckpoint checkpoint(mpc_proto, dir);
+    for (auto step : checkpoint.LocalSteps())
+      remove((dir + "/" + node_id + "-" + to_string(step) + ".ckpt").c_str());
+
+    auto ops = mpc_proto->GetOps(msg_id_t("checkpoint train step"));
+    map<string, vector<string>> t;
+    ops->PrivateInput(node_id_0, X, t["x"]);
+    ops->PrivateInput(node_id_1, Y, t["y"]);
+    ops->PrivateInput(node_id_2, W, t["w"]);
+    for (uint64_t step = 1; step <= kSteps; step++) {
+      train_step(ops, t);
+      ops->Reveal(t["w"], first[step], &reveal_attr);
+      if (step == kSaveAt && checkpoint.Save(step, t) != 0)
+        cout << "[checkpoint save] P" << partyid << " => ***Error***" << endl;
+    }
+    PROTOCOL_MPC_TEST_UNINIT(partyid);
+  }
+
+  // 2. restart, restore and go on
+  {
+    PROTOCOL_MPC_TEST_INIT(partyid);
+    MpcCheckpoint checkpoint(mpc_proto, dir);
+    auto ops = mpc_proto->GetOps(msg_id_t("checkpoint train step"));
+    map<string, vector<string>> t;
+    uint64_t step = 0;
+    if (checkpoint.Restore(step, t) != 0 || step != kSaveAt) {
+      cout << "[checkpoint restore] P" << partyid << " => ***Error*** step " << step << endl;
+    } else {
+      bool same = true;
+      vector<double> w;
+      for (step = kSaveAt + 1; step <= kSteps; step++) {
+        train_step(ops, t);
+        ops->Reveal(t["w"], w, &reveal_attr);
+        same = same && w.size() == first[step].size() &&
+          memcmp(w.data(), first[step].data(), w.size() * sizeof(double)) == 0;
+      }
+      cout << "[checkpoint resume] P" << partyid << (same ? " => Pass." : " => ***Error*** not bit-identical")
+           << endl;
+    }
+    PROTOCOL_MPC_TEST_UNINIT(partyid);
+  }
+}
+
+RUN_MPC_TEST(run);
@@ -71,6 +71,42 @@ void run(int partyid) {
   mpc_proto->GetOps(msgid)->Reveal(out_str, c, &reveal_attr);
   SIMPLE_AROUND_EQUAL_T(c, RsqrtExpect, "Rsqrt=P"+std::to_string(partyid));
 
+  // clip_norm 100, 1 / clip_norm^2 is below the fixed-point LSB
+  vector<double> G = {300, 400, 30, 40};
+  vector<double> ClipExpect = {60, 80, 30, 40};
+  vector<string> input_str_g;
+  mpc_proto->GetOps(msgid)->PrivateInput(node_id_0, G, input_str_g);
+  attr_type clip_attr;
+  clip_attr["rows"] = "2";
+  clip_attr["cols"] = "2";
+  clip_attr["clip_norm"] = "100";
+  mpc_proto->GetOps(msgid)->ClipByL2Norm(input_str_g, out_str, &clip_attr);
+  mpc_proto->GetOps(msgid)->Reveal(out_str, c, &reveal_attr);
+  AROUND_EQUAL_T(c, ClipExpect, 1.0, "ClipByL2Norm=P"+std::to_string(partyid));
+
+  // noise on zeros, E|x| = scale for the Laplace, the standard deviation is scale for the Gaussian
+  vector<double> Zeros(500, 0.0);
+  vector<string> input_str_z;
+  mpc_proto->GetOps(msgid)->PrivateInput(node_id_0, Zeros, input_str_z);
+  attr_type dp_attr;
+  dp_attr["scale"] = "0.5";
+  dp_attr["mechanism"] = "laplace";
+  mpc_proto->GetOps(msgid)->DPNoise(input_str_z, out_str, &dp_attr);
+  mpc_proto->GetOps(msgid)->Reveal(out_str, c, &reveal_attr);
+  vector<double> LaplaceStat(1, 0.0);
+  for (size_t i = 0; i < c.size(); i++)
+    LaplaceStat[0] += std::fabs(c[i]) / c.size();
+  AROUND_EQUAL_T(LaplaceStat, vector<double>(1, 0.5), 0.1, "DPNoise(laplace)=P"+std::to_string(partyid));
+
+  dp_attr["mechanism"] = "gaussian";
+  mpc_proto->GetOps(msgid)->DPNoise(input_str_z, out_str, &dp_attr);
+  mpc_proto->GetOps(msgid)->Reveal(out_str, c, &reveal_attr);
+  vector<double> GaussianStat(1, 0.0);
+  for (size_t i = 0; i < c.size(); i++)
+    GaussianStat[0] += c[i] * c[i] / c.size();
+  GaussianStat[0] = std::sqrt(GaussianStat[0]);
+  AROUND_EQUAL_T(GaussianStat, vector<double>(1, 0.5), 0.1, "DPNoise(gaussian)=P"+std::to_string(partyid));
+
   log_info << "-------  end of contributed-ops test ------";
   PROTOCOL_MPC_TEST_UNINIT(partyid);
 }
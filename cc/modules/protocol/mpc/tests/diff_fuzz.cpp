@@ -0,0 +1,646 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+// only for disable vscode warnings
+#ifndef PROTOCOL_MPC_TEST
+#define PROTOCOL_MPC_TEST_SNN 1
+#endif
+
+#include "cc/modules/protocol/mpc/tests/test.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_helper.h"
+#include "cc/modules/protocol/mpc/plain/include/plain_impl.h"
+
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <sys/stat.h>
+
+/**
+ * Cross-protocol differential fuzzing.
+ *
+ * Every round generates random inputs, shapes, input owners and const flags
+ * for each op in the table below, runs the op on the protocol under test and
+ * on the in-process PlainFixpoint backend, and checks both against a double
+ * precision reference with a per-op error budget. A failing case is shrunk
+ * to the single element (or row, or dot product) that is off and re-run, so
+ * the report is a minimal reproducer. An op that throws or returns an error
+ * fails the run like a mismatch, reported with its name, seed, round and
+ * inputs, so ctest fails on either.
+ *
+ * The three parties are forked over loopback, like the other tests in this
+ * directory. All of them draw the same inputs from the same seed and reveal
+ * results to everyone, so the shrinking steps stay in lockstep.
+ *
+ * usage: protocol_mpc_tests_<proto>_diff_fuzz [rounds] [seed] [op,op,...] [first_round]
+ *   the base port is taken from ROSETTA_DIFF_FUZZ_PORT (default 32300).
+ *   to reproduce a reported case: <bin> 1 <seed> <op> <round>
+ */
+
+namespace {
+
+enum class FuzzKind { UNARY, BINARY, REDUCE, MATMUL };
+
+struct FuzzDomain {
+  double lo;
+  double hi;
+  double min_abs; // values with a smaller magnitude are pushed out to +-min_abs
+  double grid; // if > 0, values are rounded to multiples of grid
+};
+
+using FuzzRunFunc = std::function<int(
+  ProtocolOps*,
+  const vector<string>&,
+  const vector<string>&,
+  vector<string>&,
+  const attr_type*)>;
+
+struct FuzzOp {
+  string name;
+  FuzzKind kind;
+  FuzzDomain a;
+  FuzzDomain b;
+  bool lh_const; // the left operand may be passed as a literal
+  bool rh_const; // the right operand may be passed as a literal
+  bool rh_const_only; // the right operand must be a literal (eg. Pow)
+  bool ties; // generate b == a for some elements
+  double abs_err;
+  double rel_err;
+  std::function<double(double, double)> ref;
+  std::function<double(const vector<double>&)> reduce_ref;
+  FuzzRunFunc run;
+  int degree; // how many inputs multiply into one value before truncation, 0 for linear ops
+};
+
+struct FuzzCase {
+  vector<double> a;
+  vector<double> b;
+  bool lh_const = false;
+  bool rh_const = false;
+  string owner_a;
+  string owner_b;
+  int rows = 0, cols = 0;
+  int m = 0, k = 0, n = 0;
+  bool transpose_a = false, transpose_b = false;
+};
+
+#define FUZZ_BINARY(op)                                                                  \
+  [](ProtocolOps* ops, const vector<string>& a, const vector<string>& b, vector<string>& c, \
+     const attr_type* attr) { return ops->op(a, b, c, attr); }
+#define FUZZ_UNARY(op)                                                                   \
+  [](ProtocolOps* ops, const vector<string>& a, const vector<string>&, vector<string>& c,  \
+     const attr_type* attr) { return ops->op(a, c, attr); }
+
+const FuzzDomain kNone = {0, 0, 0, 0};
+const FuzzDomain kWide = {-1000, 1000, 0, 0};
+const FuzzDomain kHundred = {-100, 100, 0, 0};
+const FuzzDomain kDenominator = {-100, 100, 0.1, 0};
+const FuzzDomain kCompare = {-100, 100, 0, 1.0 / 64};
+const FuzzDomain kSign = {-100, 100, 1.0 / 64, 0};
+const FuzzDomain kBit = {0, 1, 0, 1};
+
+double sigmoid(double x) { return 1.0 / (1.0 + std::exp(-x)); }
+
+// The domains are the ranges each op is documented (and unit tested) to
+// support, eg. Log for [0.0001, 10] in API_DOC.md; the generator deliberately
+// hits their end points. fuzz_domain narrows them further to what the
+// fixed-point encoding of the protocol can hold. Budgets follow the
+// tolerances of the hand-written tests in this directory.
+vector<FuzzOp> fuzz_ops() {
+  vector<FuzzOp> ops = {
+    {"Add", FuzzKind::BINARY, kWide, kWide, true, true, false, false, 1e-2, 0,
+     [](double a, double b) { return a + b; }, nullptr, FUZZ_BINARY(Add)},
+    {"Sub", FuzzKind::BINARY, kWide, kWide, true, true, false, false, 1e-2, 0,
+     [](double a, double b) { return a - b; }, nullptr, FUZZ_BINARY(Sub)},
+    {"Mul", FuzzKind::BINARY, kHundred, kHundred, true, true, false, false, 5e-2, 1e-3,
+     [](double a, double b) { return a * b; }, nullptr, FUZZ_BINARY(Mul), 2},
+    {"Div", FuzzKind::BINARY, kHundred, kDenominator, true, true, false, false, 5e-2, 1e-2,
+     [](double a, double b) { return a / b; }, nullptr, FUZZ_BINARY(Div), 2},
+    {"Truediv", FuzzKind::BINARY, kHundred, kDenominator, true, true, false, false, 5e-2, 1e-2,
+     [](double a, double b) { return a / b; }, nullptr, FUZZ_BINARY(Truediv), 2},
+    {"Reciprocaldiv", FuzzKind::BINARY, kHundred, kDenominator, false, false, false, false, 1e-1, 1e-2,
+     [](double a, double b) { return a / b; }, nullptr, FUZZ_BINARY(Reciprocaldiv), 2},
+    {"Pow", FuzzKind::BINARY, {-4, 4, 0, 0}, {0, 3, 0, 1}, false, true, true, false, 1e-1, 1e-2,
+     [](double a, double b) { return std::pow(a, b); }, nullptr, FUZZ_BINARY(Pow), 3},
+    {"Less", FuzzKind::BINARY, kCompare, kCompare, true, true, false, true, 1e-3, 0,
+     [](double a, double b) { return double(a < b); }, nullptr, FUZZ_BINARY(Less)},
+    {"LessEqual", FuzzKind::BINARY, kCompare, kCompare, true, true, false, true, 1e-3, 0,
+     [](double a, double b) { return double(a <= b); }, nullptr, FUZZ_BINARY(LessEqual)},
+    {"Greater", FuzzKind::BINARY, kCompare, kCompare, true, true, false, true, 1e-3, 0,
+     [](double a, double b) { return double(a > b); }, nullptr, FUZZ_BINARY(Greater)},
+    {"GreaterEqual", FuzzKind::BINARY, kCompare, kCompare, true, true, false, true, 1e-3, 0,
+     [](double a, double b) { return double(a >= b); }, nullptr, FUZZ_BINARY(GreaterEqual)},
+    {"Equal", FuzzKind::BINARY, kCompare, kCompare, true, true, false, true, 1e-3, 0,
+     [](double a, double b) { return double(a == b); }, nullptr, FUZZ_BINARY(Equal)},
+    {"NotEqual", FuzzKind::BINARY, kCompare, kCompare, true, true, false, true, 1e-3, 0,
+     [](double a, double b) { return double(a != b); }, nullptr, FUZZ_BINARY(NotEqual)},
+    {"AND", FuzzKind::BINARY, kBit, kBit, false, false, false, false, 1e-3, 0,
+     [](double a, double b) { return a * b; }, nullptr, FUZZ_BINARY(AND)},
+    {"OR", FuzzKind::BINARY, kBit, kBit, false, false, false, false, 1e-3, 0,
+     [](double a, double b) { return a + b - a * b; }, nullptr, FUZZ_BINARY(OR)},
+    {"XOR", FuzzKind::BINARY, kBit, kBit, false, false, false, false, 1e-3, 0,
+     [](double a, double b) { return a + b - 2 * a * b; }, nullptr, FUZZ_BINARY(XOR)},
+    {"SigmoidCrossEntropy", FuzzKind::BINARY, {-10, 10, 0, 0}, kBit, false, false, false, false, 1e-1, 0,
+     [](double x, double z) { return std::max(x, 0.0) - x * z + std::log1p(std::exp(-std::abs(x))); },
+     nullptr, FUZZ_BINARY(SigmoidCrossEntropy), 2},
+
+    {"NOT", FuzzKind::UNARY, kBit, kNone, false, false, false, false, 1e-3, 0,
+     [](double a, double) { return 1 - a; }, nullptr, FUZZ_UNARY(NOT)},
+    {"Negative", FuzzKind::UNARY, kWide, kNone, false, false, false, false, 1e-3, 0,
+     [](double a, double) { return -a; }, nullptr, FUZZ_UNARY(Negative)},
+    {"Square", FuzzKind::UNARY, kHundred, kNone, false, false, false, false, 5e-2, 1e-3,
+     [](double a, double) { return a * a; }, nullptr, FUZZ_UNARY(Square), 2},
+    {"Abs", FuzzKind::UNARY, kWide, kNone, false, false, false, false, 1e-3, 0,
+     [](double a, double) { return std::abs(a); }, nullptr, FUZZ_UNARY(Abs)},
+    {"AbsPrime", FuzzKind::UNARY, kSign, kNone, false, false, false, false, 1e-3, 0,
+     [](double a, double) { return a >= 0 ? 1.0 : -1.0; }, nullptr, FUZZ_UNARY(AbsPrime)},
+    {"Relu", FuzzKind::UNARY, kWide, kNone, false, false, false, false, 1e-3, 0,
+     [](double a, double) { return std::max(a, 0.0); }, nullptr, FUZZ_UNARY(Relu)},
+    {"ReluPrime", FuzzKind::UNARY, kSign, kNone, false, false, false, false, 1e-3, 0,
+     [](double a, double) { return a >= 0 ? 1.0 : 0.0; }, nullptr, FUZZ_UNARY(ReluPrime)},
+    {"Sigmoid", FuzzKind::UNARY, {-10, 10, 0, 0}, kNone, false, false, false, false, 1e-1, 0,
+     [](double a, double) { return sigmoid(a); }, nullptr, FUZZ_UNARY(Sigmoid)},
+    {"Tanh", FuzzKind::UNARY, {-20, 20, 0, 0}, kNone, false, false, false, false, 1e-2, 0,
+     [](double a, double) { return std::tanh(a); }, nullptr, FUZZ_UNARY(Tanh)},
+    {"TanhGrad", FuzzKind::UNARY, {-20, 20, 0, 0}, kNone, false, false, false, false, 1e-2, 0,
+     [](double a, double) { return 1 - std::tanh(a) * std::tanh(a); }, nullptr, FUZZ_UNARY(TanhGrad)},
+    {"Gelu", FuzzKind::UNARY, {-20, 20, 0, 0}, kNone, false, false, false, false, 1e-2, 0,
+     [](double a, double) { return a * 0.5 * (1 + std::erf(a / std::sqrt(2.0))); }, nullptr, FUZZ_UNARY(Gelu)},
+    {"GeluGrad", FuzzKind::UNARY, {-20, 20, 0, 0}, kNone, false, false, false, false, 1e-2, 0,
+     [](double a, double) { return 0.5 * (1 + std::erf(a / std::sqrt(2.0))) + a * std::exp(-a * a / 2) / std::sqrt(2 * M_PI); }, nullptr, FUZZ_UNARY(GeluGrad)},
+    {"Swish", FuzzKind::UNARY, {-20, 20, 0, 0}, kNone, false, false, false, false, 1e-2, 0,
+     [](double a, double) { return a * sigmoid(a); }, nullptr, FUZZ_UNARY(Swish)},
+    {"SwishGrad", FuzzKind::UNARY, {-20, 20, 0, 0}, kNone, false, false, false, false, 1e-2, 0,
+     [](double a, double) { return sigmoid(a) + a * sigmoid(a) * (1 - sigmoid(a)); }, nullptr, FUZZ_UNARY(SwishGrad)},
+    {"Softplus", FuzzKind::UNARY, {-20, 20, 0, 0}, kNone, false, false, false, false, 1e-2, 0,
+     [](double a, double) { return std::log1p(std::exp(a)); }, nullptr, FUZZ_UNARY(Softplus)},
+    {"SoftplusGrad", FuzzKind::UNARY, {-20, 20, 0, 0}, kNone, false, false, false, false, 1e-2, 0,
+     [](double a, double) { return sigmoid(a); }, nullptr, FUZZ_UNARY(SoftplusGrad)},
+    {"Exp", FuzzKind::UNARY, {-4, 3, 0, 0}, kNone, false, false, false, false, 5e-1, 5e-2,
+     [](double a, double) { return std::exp(a); }, nullptr, FUZZ_UNARY(Exp)},
+    {"Sqrt", FuzzKind::UNARY, {0.4, 256, 0, 0}, kNone, false, false, false, false, 1e-1, 1e-2,
+     [](double a, double) { return std::sqrt(a); }, nullptr, FUZZ_UNARY(Sqrt)},
+    {"Rsqrt", FuzzKind::UNARY, {0.4, 256, 0, 0}, kNone, false, false, false, false, 1e-1, 0,
+     [](double a, double) { return 1.0 / std::sqrt(a); }, nullptr, FUZZ_UNARY(Rsqrt)},
+    {"Log", FuzzKind::UNARY, {0.001, 8, 0, 0}, kNone, false, false, false, false, 1.2, 0,
+     [](double a, double) { return std::log(a); }, nullptr, FUZZ_UNARY(Log)},
+    {"HLog", FuzzKind::UNARY, {0.001, 100, 0, 0}, kNone, false, false, false, false, 1e-1, 0,
+     [](double a, double) { return std::log(a); }, nullptr, FUZZ_UNARY(HLog)},
+    {"Log1p", FuzzKind::UNARY, {0.001, 8, 0, 0}, kNone, false, false, false, false, 5e-1, 0,
+     [](double a, double) { return std::log1p(a); }, nullptr, FUZZ_UNARY(Log1p)},
+
+    {"Max", FuzzKind::REDUCE, kHundred, kNone, false, false, false, false, 1e-3, 0, nullptr,
+     [](const vector<double>& r) { return *std::max_element(r.begin(), r.end()); }, FUZZ_UNARY(Max)},
+    {"Min", FuzzKind::REDUCE, kHundred, kNone, false, false, false, false, 1e-3, 0, nullptr,
+     [](const vector<double>& r) { return *std::min_element(r.begin(), r.end()); }, FUZZ_UNARY(Min)},
+    {"Sum", FuzzKind::REDUCE, kHundred, kNone, false, false, false, false, 1e-2, 0, nullptr,
+     [](const vector<double>& r) { return std::accumulate(r.begin(), r.end(), 0.0); }, FUZZ_UNARY(Sum)},
+    {"Mean", FuzzKind::REDUCE, kHundred, kNone, false, false, false, false, 1e-2, 0, nullptr,
+     [](const vector<double>& r) { return std::accumulate(r.begin(), r.end(), 0.0) / r.size(); },
+     FUZZ_UNARY(Mean)},
+
+    {"Matmul", FuzzKind::MATMUL, {-10, 10, 0, 0}, {-10, 10, 0, 0}, false, false, false, false, 5e-2, 1e-3,
+     nullptr, nullptr, FUZZ_BINARY(Matmul), 2},
+  };
+  return ops;
+}
+
+#undef FUZZ_BINARY
+#undef FUZZ_UNARY
+
+// The domain d of an op, restricted to the fixed-point range at this precision:
+// degree values of magnitude |x| * 2^precision multiply before each truncation,
+// so |x|^degree * 2^(degree * precision) must stay below 2^(L-2); and positive
+// inputs, denominators and comparison grids must not encode below one LSB.
+FuzzDomain fuzz_domain(const FuzzDomain& d, int degree, int precision) {
+  const int L = sizeof(mpc_t) * 8;
+  const double max_abs = std::ldexp(1.0, (L - 2) / std::max(degree, 1) - precision);
+  const double lsb = std::ldexp(1.0, -precision);
+  FuzzDomain r = d;
+  r.hi = std::min(d.hi, max_abs);
+  r.lo = std::max(d.lo, -max_abs);
+  if (d.lo > 0)
+    r.lo = std::max(d.lo, lsb);
+  if (d.min_abs > 0)
+    r.min_abs = std::max(d.min_abs, lsb);
+  if (d.grid > 0)
+    r.grid = std::max(d.grid, lsb);
+  return r;
+}
+
+double fuzz_value(std::mt19937_64& rng, const FuzzDomain& d) {
+  std::uniform_real_distribution<double> uniform(d.lo, d.hi);
+  std::uniform_int_distribution<int> pick(0, 7);
+  double v = 0;
+  switch (pick(rng)) {
+    case 0: v = d.lo; break;
+    case 1: v = d.hi; break;
+    case 2: v = (rng() & 1) ? d.min_abs : -d.min_abs; break;
+    default: v = uniform(rng);
+  }
+  if (d.grid > 0)
+    v = std::round(v / d.grid) * d.grid;
+  if (std::abs(v) < d.min_abs)
+    v = (v < 0) ? -d.min_abs : d.min_abs;
+  return std::max(d.lo, std::min(d.hi, v));
+}
+
+vector<double> fuzz_values(std::mt19937_64& rng, const FuzzDomain& d, size_t size) {
+  vector<double> v(size);
+  for (auto& x : v)
+    x = fuzz_value(rng, d);
+  return v;
+}
+
+FuzzCase fuzz_case(const FuzzOp& fop, uint64_t seed, int round, size_t op_index, int precision) {
+  FuzzOp op = fop;
+  op.a = fuzz_domain(fop.a, fop.degree, precision);
+  op.b = fuzz_domain(fop.b, fop.degree, precision);
+  // one independent stream per (seed, round, op), so any case can be replayed alone
+  std::seed_seq seq{(uint32_t)seed, (uint32_t)(seed >> 32), (uint32_t)round, (uint32_t)op_index};
+  std::mt19937_64 rng(seq);
+  auto dim = [&rng](int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); };
+  const vector<string> nodes = {"P0", "P1", "P2"};
+
+  FuzzCase c;
+  c.owner_a = nodes[dim(0, 2)];
+  c.owner_b = nodes[dim(0, 2)];
+  switch (op.kind) {
+    case FuzzKind::UNARY:
+      c.a = fuzz_values(rng, op.a, dim(1, 32));
+      break;
+    case FuzzKind::BINARY: {
+      size_t size = dim(1, 32);
+      c.a = fuzz_values(rng, op.a, size);
+      c.b = fuzz_values(rng, op.b, size);
+      if (op.ties) {
+        for (size_t i = 0; i < size; i++)
+          if (dim(0, 2) == 0)
+            c.b[i] = c.a[i];
+      }
+      c.rh_const = op.rh_const_only || (op.rh_const && dim(0, 2) == 0);
+      c.lh_const = !c.rh_const && op.lh_const && dim(0, 2) == 0;
+      break;
+    }
+    case FuzzKind::REDUCE:
+      c.rows = dim(1, 4);
+      c.cols = dim(1, 16);
+      c.a = fuzz_values(rng, op.a, c.rows * c.cols);
+      break;
+    case FuzzKind::MATMUL:
+      c.m = dim(1, 6);
+      c.k = dim(1, 6);
+      c.n = dim(1, 6);
+      c.transpose_a = dim(0, 1) == 1;
+      c.transpose_b = dim(0, 1) == 1;
+      c.a = fuzz_values(rng, op.a, c.m * c.k);
+      c.b = fuzz_values(rng, op.b, c.k * c.n);
+      break;
+  }
+  return c;
+}
+
+vector<double> fuzz_reference(const FuzzOp& op, const FuzzCase& c) {
+  vector<double> want;
+  switch (op.kind) {
+    case FuzzKind::UNARY:
+      for (size_t i = 0; i < c.a.size(); i++)
+        want.push_back(op.ref(c.a[i], 0));
+      break;
+    case FuzzKind::BINARY:
+      for (size_t i = 0; i < c.a.size(); i++)
+        want.push_back(op.ref(c.a[i], c.b[i]));
+      break;
+    case FuzzKind::REDUCE:
+      for (int r = 0; r < c.rows; r++)
+        want.push_back(op.reduce_ref(vector<double>(c.a.begin() + r * c.cols, c.a.begin() + (r + 1) * c.cols)));
+      break;
+    case FuzzKind::MATMUL:
+      for (int i = 0; i < c.m; i++) {
+        for (int j = 0; j < c.n; j++) {
+          double s = 0;
+          for (int t = 0; t < c.k; t++) {
+            double x = c.transpose_a ? c.a[t * c.m + i] : c.a[i * c.k + t];
+            double y = c.transpose_b ? c.b[j * c.k + t] : c.b[t * c.n + j];
+            s += x * y;
+          }
+          want.push_back(s);
+        }
+      }
+      break;
+  }
+  return want;
+}
+
+// Returns false if the op threw or returned an error, with the reason in error.
+bool fuzz_execute(
+  MpcProtocol* proto,
+  const FuzzOp& op,
+  const FuzzCase& c,
+  const attr_type& reveal_attr,
+  vector<double>& got,
+  string& error) {
+  msg_id_t msgid("diff-fuzz-" + op.name);
+  int precision = proto->GetMpcContext()->GetFixPointPrecision();
+  try {
+    auto ops = proto->GetOps(msgid);
+    attr_type attr;
+    vector<string> sa, sb, sc;
+    if (c.lh_const) {
+      attr["lh_is_const"] = "1";
+      convert_double_to_literal_str(c.a, sa, precision);
+    } else {
+      ops->PrivateInput(c.owner_a, c.a, sa);
+    }
+    if (c.rh_const) {
+      attr["rh_is_const"] = "1";
+      convert_double_to_literal_str(c.b, sb, precision);
+    } else if (!c.b.empty()) {
+      ops->PrivateInput(c.owner_b, c.b, sb);
+    }
+    if (op.kind == FuzzKind::REDUCE) {
+      attr["rows"] = std::to_string(c.rows);
+      attr["cols"] = std::to_string(c.cols);
+    } else if (op.kind == FuzzKind::MATMUL) {
+      attr["m"] = std::to_string(c.m);
+      attr["k"] = std::to_string(c.k);
+      attr["n"] = std::to_string(c.n);
+      attr["transpose_a"] = c.transpose_a ? "1" : "0";
+      attr["transpose_b"] = c.transpose_b ? "1" : "0";
+    }
+
+    int ret = op.run(ops.get(), sa, sb, sc, &attr);
+    if (ret != 0) {
+      error = "returned " + std::to_string(ret);
+      return false;
+    }
+    ops->Reveal(sc, got, &reveal_attr);
+  } catch (const std::exception& e) {
+    error = string("threw: ") + e.what();
+    return false;
+  } catch (...) {
+    error = "threw a non-std exception";
+    return false;
+  }
+  return true;
+}
+
+vector<size_t> fuzz_mismatches(const FuzzOp& op, const vector<double>& got, const vector<double>& want) {
+  vector<size_t> bad;
+  for (size_t i = 0; i < want.size(); i++) {
+    if (i >= got.size() || std::isnan(got[i]) ||
+        std::abs(got[i] - want[i]) > op.abs_err + op.rel_err * std::abs(want[i]))
+      bad.push_back(i);
+  }
+  return bad;
+}
+
+// Narrows a failing case down to what produced output `index`.
+FuzzCase fuzz_shrink(const FuzzOp& op, const FuzzCase& c, size_t index) {
+  FuzzCase s = c;
+  switch (op.kind) {
+    case FuzzKind::UNARY:
+      s.a = {c.a[index]};
+      break;
+    case FuzzKind::BINARY:
+      s.a = {c.a[index]};
+      s.b = {c.b[index]};
+      break;
+    case FuzzKind::REDUCE:
+      s.rows = 1;
+      s.a.assign(c.a.begin() + index * c.cols, c.a.begin() + (index + 1) * c.cols);
+      break;
+    case FuzzKind::MATMUL: {
+      size_t i = index / c.n, j = index % c.n;
+      s.a.clear();
+      s.b.clear();
+      for (int t = 0; t < c.k; t++) {
+        s.a.push_back(c.transpose_a ? c.a[t * c.m + i] : c.a[i * c.k + t]);
+        s.b.push_back(c.transpose_b ? c.b[j * c.k + t] : c.b[t * c.n + j]);
+      }
+      s.m = s.n = 1;
+      s.transpose_a = s.transpose_b = false;
+      break;
+    }
+  }
+  return s;
+}
+
+string fuzz_vec_str(const vector<double>& v) {
+  std::stringstream ss;
+  ss << std::setprecision(17) << "[";
+  for (size_t i = 0; i < v.size(); i++)
+    ss << (i ? ", " : "") << v[i];
+  ss << "]";
+  return ss.str();
+}
+
+void fuzz_report(
+  const string& backend,
+  const FuzzOp& op,
+  const FuzzCase& c,
+  const vector<double>& got,
+  const vector<double>& want,
+  uint64_t seed,
+  int round,
+  bool minimal,
+  const string& error = "") {
+  std::stringstream ss;
+  ss << "[diff-fuzz] FAIL " << op.name << " on " << backend << " (seed " << seed << ", round " << round;
+  if (!error.empty())
+    ss << ") " << error << "\n";
+  else
+    ss << (minimal ? ", minimized" : ", not reproducible after shrinking") << ")\n";
+  ss << "  lh_is_const=" << c.lh_const << " rh_is_const=" << c.rh_const << " owner_a=" << c.owner_a
+     << " owner_b=" << c.owner_b;
+  if (op.kind == FuzzKind::REDUCE)
+    ss << " rows=" << c.rows << " cols=" << c.cols;
+  if (op.kind == FuzzKind::MATMUL)
+    ss << " m=" << c.m << " k=" << c.k << " n=" << c.n << " transpose_a=" << c.transpose_a
+       << " transpose_b=" << c.transpose_b;
+  ss << "\n  a    = " << fuzz_vec_str(c.a) << "\n";
+  if (!c.b.empty())
+    ss << "  b    = " << fuzz_vec_str(c.b) << "\n";
+  if (error.empty()) {
+    ss << "  got  = " << fuzz_vec_str(got) << "\n";
+    ss << "  want = " << fuzz_vec_str(want) << "  (budget " << op.abs_err << " + " << op.rel_err << "*|want|)";
+  }
+  cout << ss.str() << endl;
+  log_error << ss.str();
+}
+
+struct FuzzStats {
+  int cases = 0;
+  int failures = 0;
+};
+
+// Runs one case on one backend; returns true if it passed.
+bool fuzz_check(
+  MpcProtocol* proto,
+  const string& backend,
+  const FuzzOp& op,
+  const FuzzCase& c,
+  const attr_type& reveal_attr,
+  bool verbose,
+  uint64_t seed,
+  int round,
+  FuzzStats& stats) {
+  vector<double> got;
+  string error;
+  stats.cases++;
+  if (!fuzz_execute(proto, op, c, reveal_attr, got, error)) {
+    stats.failures++;
+    if (verbose)
+      fuzz_report(backend, op, c, got, vector<double>(), seed, round, false, error);
+    return false;
+  }
+  vector<double> want = fuzz_reference(op, c);
+  vector<size_t> bad = fuzz_mismatches(op, got, want);
+  if (bad.empty())
+    return true;
+
+  stats.failures++;
+  FuzzCase small = fuzz_shrink(op, c, bad[0]);
+  vector<double> small_got;
+  vector<double> small_want = fuzz_reference(op, small);
+  bool minimal = fuzz_execute(proto, op, small, reveal_attr, small_got, error) &&
+    !fuzz_mismatches(op, small_got, small_want).empty();
+  if (verbose) {
+    if (minimal)
+      fuzz_report(backend, op, small, small_got, small_want, seed, round, true);
+    else
+      fuzz_report(backend, op, c, got, want, seed, round, false);
+  }
+  return false;
+}
+
+string fuzz_loopback_config(int base_port) {
+  std::stringstream ss;
+  ss << "{\"NODE_INFO\": [";
+  for (int i = 0; i < 3; i++) {
+    ss << (i ? "," : "") << "{\"NAME\": \"PartyP" << i << "\", \"HOST\": \"127.0.0.1\", \"PORT\": "
+       << base_port + i << ", \"NODE_ID\": \"P" << i << "\"}";
+  }
+  ss << "], \"DATA_NODES\": [\"P0\", \"P1\", \"P2\"],"
+     << " \"COMPUTATION_NODES\": {\"P0\": 0, \"P1\": 1, \"P2\": 2},"
+     << " \"RESULT_NODES\": [\"P0\", \"P1\", \"P2\"]}";
+  return ss.str();
+}
+
+struct FuzzOptions {
+  int rounds = 10;
+  uint64_t seed = 20201123;
+  vector<string> only;
+  int first_round = 0;
+  int base_port = 32300;
+};
+
+int run_fuzz(int partyid, const FuzzOptions& opt) {
+  GET_PROTOCOL(mpc_proto);
+  mkdir("log", 0755);
+  string logfile = "log/mpc_tests_" + protocol_name + "_diff_fuzz-" + to_string(partyid);
+  Logger::Get().log_to_stdout(false);
+  Logger::Get().set_filename(logfile + "-backend.log");
+  Logger::Get().set_level(0);
+
+  string node_id;
+  string config_json;
+  rosetta_old_conf_parse(node_id, config_json, partyid, fuzz_loopback_config(opt.base_port));
+  IOManager::Instance()->CreateChannel("", node_id, config_json);
+  mpc_proto->Init(logfile + "-console.log");
+
+  rosetta::PlainFixpointProtocol plain("diff-fuzz-plain");
+  const int precision = mpc_proto->GetMpcContext()->GetFixPointPrecision();
+  plain.GetMpcContext()->FLOAT_PRECISION = precision;
+  plain.Init();
+
+  vector<string> reveal_receivers = {"P0", "P1", "P2"};
+  rosetta::attr_type reveal_attr;
+  reveal_attr["receive_parties"] = receiver_parties_pack(reveal_receivers);
+  bool verbose = (partyid == 0);
+
+  vector<FuzzOp> ops = fuzz_ops();
+  vector<FuzzStats> secure_stats(ops.size()), plain_stats(ops.size());
+  for (int round = opt.first_round; round < opt.first_round + opt.rounds; round++) {
+    for (size_t i = 0; i < ops.size(); i++) {
+      if (!opt.only.empty() && std::find(opt.only.begin(), opt.only.end(), ops[i].name) == opt.only.end())
+        continue;
+      FuzzCase c = fuzz_case(ops[i], opt.seed, round, i, precision);
+      fuzz_check(mpc_proto, protocol_name, ops[i], c, reveal_attr, verbose, opt.seed, round, secure_stats[i]);
+      fuzz_check(&plain, "PlainFixpoint", ops[i], c, reveal_attr, verbose, opt.seed, round, plain_stats[i]);
+    }
+  }
+
+  int failures = 0;
+  for (size_t i = 0; i < ops.size(); i++) {
+    const FuzzStats& s = secure_stats[i];
+    const FuzzStats& p = plain_stats[i];
+    failures += s.failures + p.failures;
+    if (verbose && (s.cases > 0 || p.cases > 0)) {
+      cout << "[diff-fuzz] " << std::left << std::setw(20) << ops[i].name << protocol_name << ": "
+           << s.failures << "/" << s.cases << " failed, PlainFixpoint: " << p.failures << "/" << p.cases
+           << " failed" << endl;
+    }
+  }
+
+  plain.Uninit();
+  PROTOCOL_MPC_TEST_UNINIT(partyid);
+  return failures == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  FuzzOptions opt;
+  if (argc > 1)
+    opt.rounds = std::stoi(argv[1]);
+  if (argc > 2)
+    opt.seed = std::stoull(argv[2]);
+  if (argc > 3 && string(argv[3]) != "all") {
+    std::stringstream ss(argv[3]);
+    string name;
+    while (std::getline(ss, name, ','))
+      opt.only.push_back(name);
+  }
+  if (argc > 4)
+    opt.first_round = std::stoi(argv[4]);
+  if (getenv("ROSETTA_DIFF_FUZZ_PORT") != nullptr)
+    opt.base_port = std::stoi(getenv("ROSETTA_DIFF_FUZZ_PORT"));
+
+  vector<pid_t> parties;
+  for (int partyid = 0; partyid < 3; partyid++) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      cerr << "error in fork P" << partyid << "!" << endl;
+      exit(1);
+    }
+    if (pid == 0)
+      _exit(run_fuzz(partyid, opt));
+    parties.push_back(pid);
+  }
+
+  int ret = 0;
+  for (pid_t pid : parties) {
+    int status = -1;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      ret = 1;
+  }
+  cout << "[diff-fuzz] " << (ret == 0 ? "all backends within budget." : "FAILED, see the cases above.") << endl;
+  return ret;
+}
@@ -0,0 +1,116 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+// only for disable vscode warnings
+#ifndef PROTOCOL_MPC_TEST
+#define PROTOCOL_MPC_TEST_SNN 1
+#endif
+
+#include "cc/modules/protocol/mpc/tests/test.h"
+#include "cc/modules/common/include/utils/rtt_exceptions.h"
+
+/**
+ * Fault injection on loopback, for the IOWrapper health layer.
+ *
+ * 1. P2 aborts in the middle of a Mul, P0 and P1 must unwind with peer_abort_exp.
+ * 2. All the parties tear the task down and start it again, a Mul must work.
+ * 3. P1 dies without a word, P0 and P2 must unwind with network_failure_exp.
+ *
+ * usage: protocol_mpc_tests_<proto>_fault_abort
+ */
+
+namespace {
+
+IOHealthConfig test_health() {
+  IOHealthConfig health;
+  health.heartbeat_interval_ms = 100;
+  health.peer_timeout_ms = 2000;
+  health.op_timeout_ms = 20 * 1000;
+  return health;
+}
+
+template <typename Exp, typename Func>
+bool expect_unwind(int partyid, const string& tag, Func f) {
+  auto beg = std::chrono::steady_clock::now();
+  string got = "nothing";
+  try {
+    f();
+  } catch (const Exp& e) {
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - beg).count();
+    cout << "[" << tag << "] P" << partyid << " => Pass. " << e.what() << " after " << ms << "ms"
+         << endl;
+    return true;
+  } catch (const std::exception& e) {
+    got = e.what();
+  }
+  cout << "[" << tag << "] P" << partyid << " => ***Error*** got " << got << endl;
+  return false;
+}
+
+} // namespace
+
+static void run(int partyid) {
+  vector<double> X = {-1.5, 0.5, 2.0, 3.0};
+  vector<double> want = {2.25, 0.25, 4.0, 9.0};
+
+  // 1. coordinated abort
+  {
+    PROTOCOL_MPC_TEST_INIT(partyid);
+    net_io->StartHealth(test_health());
+    auto ops = mpc_proto->GetOps(msg_id_t("fault abort: coordinated abort"));
+    vector<string> sx, sy;
+    if (partyid == 2) {
+      ops->PrivateInput(node_id_0, X, sx);
+      net_io->Abort("injected by the test");
+    } else {
+      expect_unwind<peer_abort_exp>(partyid, "coordinated abort", [&]() {
+        ops->PrivateInput(node_id_0, X, sx);
+        ops->Mul(sx, sx, sy);
+      });
+    }
+    PROTOCOL_MPC_TEST_UNINIT(partyid);
+  }
+
+  // the others leave their aborted channels too
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  // 2. restart of the same task
+  {
+    PROTOCOL_MPC_TEST_INIT(partyid);
+    net_io->StartHealth(test_health());
+    auto ops = mpc_proto->GetOps(msg_id_t("fault abort: restart"));
+    vector<string> sx, sy;
+    vector<double> y;
+    ops->PrivateInput(node_id_0, X, sx);
+    ops->Mul(sx, sx, sy);
+    ops->Reveal(sy, y, &reveal_attr);
+    if (partyid == 0)
+      around_equal(y.begin(), y.end(), want.begin(), want.end(), 0.01, "restart");
+
+    // 3. peer failure
+    if (partyid == 1)
+      _exit(0);
+    expect_unwind<network_failure_exp>(partyid, "peer failure", [&]() {
+      ops->Mul(sy, sx, sy);
+      ops->Reveal(sy, y, &reveal_attr);
+    });
+    PROTOCOL_MPC_TEST_UNINIT(partyid);
+  }
+}
+
+RUN_MPC_TEST(run);
@@ -0,0 +1,119 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+// only for disable vscode warnings
+#ifndef PROTOCOL_MPC_TEST
+#define PROTOCOL_MPC_TEST_SNN 1
+#endif
+
+#include "cc/modules/protocol/mpc/tests/test.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_lr_serving.h"
+
+#include <cmath>
+#include <random>
+
+/**
+ * LR inference serving on loopback.
+ *
+ * P0 holds the model and P1 the features. P2 only helps. The three parties
+ * are forked like the other tests in this directory. A client thread on P1
+ * submits requests with random gaps, compares every answer with the plaintext
+ * model, and stops the server. P1 then prints the latency percentiles.
+ *
+ * usage: protocol_mpc_tests_<proto>_lr_serving
+ *   ROSETTA_LR_SERVING_REQUESTS (default 2000), ROSETTA_LR_SERVING_WINDOW_MS (default 5)
+ *   and ROSETTA_LR_SERVING_LABEL_ONLY (default 0) change the run.
+ */
+
+namespace {
+
+const size_t kFeatures = 32;
+const double kMeanGapMs = 0.2;
+
+size_t env_or(const char* name, size_t value) {
+  const char* v = getenv(name);
+  return v ? std::stoul(v) : value;
+}
+
+} // namespace
+
+static void run(int partyid) {
+  PROTOCOL_MPC_TEST_INIT(partyid);
+
+  MpcLrServingConfig config;
+  config.model_owner = node_id_0;
+  config.feature_owner = node_id_1;
+  config.features = kFeatures;
+  config.batch_window_ms = env_or("ROSETTA_LR_SERVING_WINDOW_MS", 5);
+  config.label_only = env_or("ROSETTA_LR_SERVING_LABEL_ONLY", 0) != 0;
+  const size_t requests = env_or("ROSETTA_LR_SERVING_REQUESTS", 2000);
+
+  // every party draws the same model, only P0 passes it on
+  std::mt19937_64 rng(20201123);
+  std::normal_distribution<double> normal(0, 0.3);
+  vector<double> weights(kFeatures);
+  for (auto& w : weights)
+    w = normal(rng);
+  double bias = normal(rng);
+
+  MpcLrServer server(mpc_proto, config);
+  server.LoadModel(weights, bias);
+
+  std::thread client;
+  std::atomic<size_t> errors(0);
+  if (node_id == config.feature_owner) {
+    client = std::thread([&]() {
+      std::mt19937_64 crng(partyid);
+      std::uniform_real_distribution<double> uniform(-2, 2);
+      std::exponential_distribution<double> gap(1.0 / kMeanGapMs);
+      vector<vector<double>> xs(requests, vector<double>(kFeatures));
+      vector<std::future<double>> answers;
+      for (size_t r = 0; r < requests; r++) {
+        for (auto& x : xs[r])
+          x = uniform(crng);
+        answers.push_back(server.Submit(xs[r]));
+        std::this_thread::sleep_for(std::chrono::microseconds(int64_t(gap(crng) * 1000)));
+      }
+
+      for (size_t r = 0; r < requests; r++) {
+        double z = bias;
+        for (size_t j = 0; j < kFeatures; j++)
+          z += xs[r][j] * weights[j];
+        double want = config.label_only ? (z >= 0 ? 1.0 : 0.0) : 1.0 / (1.0 + std::exp(-z));
+        double got = answers[r].get();
+        // labels may flip right at the boundary
+        double tolerance = config.label_only ? (std::abs(z) < 0.01 ? 1.0 : 0.0) : 0.02;
+        if (std::abs(got - want) > tolerance + 1e-6) {
+          if (errors++ < 10)
+            cout << "request " << r << ": got " << got << ", want " << want << endl;
+        }
+      }
+      server.Stop();
+    });
+  }
+
+  server.Serve();
+  if (client.joinable()) {
+    client.join();
+    cout << protocol_name << " lr serving, " << server.Stats().to_string() << ", errors: " << errors
+         << endl;
+  }
+
+  PROTOCOL_MPC_TEST_UNINIT(partyid);
+}
+
+RUN_MPC_TEST(run);
@@ -0,0 +1,128 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+// only for disable vscode warnings
+#ifndef PROTOCOL_MPC_TEST
+#define PROTOCOL_MPC_TEST_SNN 1
+#endif
+
+#include "cc/modules/protocol/mpc/tests/test.h"
+
+/**
+ * Transcript recording and offline replay on loopback.
+ *
+ * The three parties run a small program with every party recording its
+ * transcript. P1 then replays its own side alone, with no network: once with
+ * its recorded input, which must not diverge, and once with another input,
+ * which must be flagged at the first message that differs.
+ *
+ * usage: protocol_mpc_tests_<proto>_replay
+ */
+
+namespace {
+
+vector<double> X = {0.5, -1.0, 1.5, 2.0, -0.25, 0.75, -2.0, 1.0};
+vector<double> Y = {1.0, 2.0, -0.5, 0.25, 3.0, -1.5, 0.5, -2.0};
+
+// relu(x * y) + x, revealed to all, with its ops recorded
+void program(MpcProtocol* proto, const vector<double>& y_input, vector<double>& out) {
+  auto net_io = proto->GetNetHandler();
+  const string& node_id_0 = net_io->GetNodeId(0);
+  const string& node_id_1 = net_io->GetNodeId(1);
+  msg_id_t msgid("replay program");
+  auto ops = proto->GetOps(msgid);
+
+  vector<string> receivers = {"P0", "P1", "P2"};
+  rosetta::attr_type reveal_attr;
+  reveal_attr["receive_parties"] = receiver_parties_pack(receivers);
+
+  vector<string> x, y, z, r, s;
+  net_io->RecordOp("PrivateInput", msgid);
+  ops->PrivateInput(node_id_0, X, x);
+  net_io->RecordOp("PrivateInput", msgid);
+  ops->PrivateInput(node_id_1, y_input, y);
+  net_io->RecordOp("Mul", msgid);
+  ops->Mul(x, y, z);
+  net_io->RecordOp("Relu", msgid);
+  ops->Relu(z, r);
+  net_io->RecordOp("Add", msgid);
+  ops->Add(r, x, s);
+  net_io->RecordOp("Reveal", msgid);
+  ops->Reveal(s, out, &reveal_attr);
+}
+
+} // namespace
+
+static void run(int partyid) {
+  const string transcript = "log/mpc_tests_replay-" + to_string(partyid) + ".trs";
+  vector<double> expect(X.size()), recorded;
+  for (size_t i = 0; i < X.size(); i++)
+    expect[i] = std::max(X[i] * Y[i], 0.0) + X[i];
+
+  // 1. the networked run, recorded from before Init
+  string task_id = "";
+  {
+    GET_PROTOCOL(mpc_proto);
+    string logfile = "log/mpc_tests_" + protocol_name + "_replay-" + to_string(partyid);
+    Logger::Get().log_to_stdout(false);
+    Logger::Get().set_filename(logfile + "-backend.log");
+    Logger::Get().set_level(0);
+    string node_id, config_json;
+    rosetta_old_conf_parse(node_id, config_json, partyid, "CONFIG.json");
+    IOManager::Instance()->CreateChannel(task_id, node_id, config_json);
+    IOManager::Instance()->GetIOWrapper(task_id)->StartRecording(transcript);
+    mpc_proto->Init(logfile + "-console.log");
+
+    program(mpc_proto, Y, recorded);
+    if (partyid == 0)
+      around_equal(recorded.begin(), recorded.end(), expect.begin(), expect.end(), 0.01, protocol_name + " recorded run");
+    PROTOCOL_MPC_TEST_UNINIT(partyid);
+  }
+  if (partyid != 1)
+    return;
+
+  // 2. P1 alone, from its transcript
+  for (bool tamper : {false, true}) {
+    GET_PROTOCOL(mpc_proto);
+    if (!IOManager::Instance()->CreateReplayChannel(task_id, transcript)) {
+      cout << "[replay] => ***Error*** can not read " << transcript << endl;
+      delete mpc_proto;
+      return;
+    }
+    mpc_proto->Init();
+    auto net_io = mpc_proto->GetNetHandler();
+
+    vector<double> y_input(Y), replayed;
+    if (tamper)
+      y_input[3] += 1.0;
+    program(mpc_proto, y_input, replayed);
+    size_t divergences = net_io->ReplayDivergences();
+    string first = net_io->FirstDivergence();
+    mpc_proto->Uninit();
+    delete mpc_proto;
+
+    string tag = protocol_name + (tamper ? " replay, other input" : " replay");
+    if (!tamper && divergences == 0 && replayed == recorded)
+      cout << "[" << tag << "] => Pass." << endl;
+    else if (tamper && divergences > 0)
+      cout << "[" << tag << "] => Pass, flagged: " << first << endl;
+    else
+      cout << "[" << tag << "] => ***Error*** " << divergences << " divergences, first: " << first << endl;
+  }
+}
+
+RUN_MPC_TEST(run);
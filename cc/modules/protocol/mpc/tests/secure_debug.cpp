@@ -0,0 +1,66 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+// only for disable vscode warnings
+#ifndef PROTOCOL_MPC_TEST
+#define PROTOCOL_MPC_TEST_SNN 1
+#endif
+
+#include "cc/modules/protocol/mpc/tests/test.h"
+
+/**
+ * The secure-debug range monitor on loopback.
+ *
+ * Values of ~2^20 stay in the safe range at FLOAT_PRECISION 13, their square
+ * of ~2^40 does not (|x| < 2^(64-1-26)). P0 checks that the monitor saw both
+ * ops and reports the Mul as the first overflow.
+ *
+ * usage: protocol_mpc_tests_<proto>_secure_debug, in a -DROSETTA_ENABLES_SECURE_DEBUG=ON build
+ */
+
+static void run(int partyid) {
+#if !ROSETTA_ENABLES_SECURE_DEBUG
+  if (partyid == 0)
+    cout << "[secure debug] => skipped, build with -DROSETTA_ENABLES_SECURE_DEBUG=ON" << endl;
+#else
+  PROTOCOL_MPC_TEST_INIT(partyid);
+  msg_id_t msgid("secure debug range");
+  auto ops = mpc_proto->GetOps(msgid);
+
+  vector<double> X = {1048576.0, -1048576.0, 3.0};
+  vector<string> x, y, z;
+  ops->PrivateInput(node_id_0, X, x);
+  ops->Add(x, x, y);
+  ops->Mul(x, x, z);
+
+  PerfStats stats = mpc_proto->GetPerfStats();
+  if (partyid == 0) {
+    string tag = protocol_name + " secure debug";
+    bool ok = stats.numerics.count("Add") > 0 && stats.numerics["Add"].overflows == 0 &&
+      stats.numerics.count("Mul") > 0 && stats.numerics["Mul"].overflows == 2 &&
+      stats.first_overflow.find("Mul") == 0 && !stats.precision_hint.empty();
+    if (ok)
+      cout << "[" << tag << "] => Pass, " << stats.first_overflow << ": " << stats.precision_hint << endl;
+    else
+      cout << "[" << tag << "] => ***Error*** first overflow: '" << stats.first_overflow << "'" << endl;
+  }
+
+  PROTOCOL_MPC_TEST_UNINIT(partyid);
+#endif
+}
+
+RUN_MPC_TEST(run);
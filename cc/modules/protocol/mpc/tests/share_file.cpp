@@ -0,0 +1,89 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+// only for disable vscode warnings
+#ifndef PROTOCOL_MPC_TEST
+#define PROTOCOL_MPC_TEST_SNN 1
+#endif
+
+#include "cc/modules/protocol/mpc/tests/test.h"
+#include "cc/modules/protocol/mpc/comm/include/mpc_share_file.h"
+
+/**
+ * Share files on loopback.
+ *
+ * P0 imports a weight matrix from a .npy file and P1 a bias. Every party
+ * saves its shares, loads them back and reveals them to all. The loaded
+ * shares are also reshared to the other layout (Helix <-> SecureNN) and back,
+ * and must reveal the same values.
+ *
+ * usage: protocol_mpc_tests_<proto>_share_file
+ */
+
+namespace {
+
+vector<int64_t> kShape = {2, 3};
+vector<double> W = {0.5, -1.0, 1.5, 2.0, -0.25, 100.75};
+vector<double> B = {-3.125};
+
+} // namespace
+
+static void run(int partyid) {
+  PROTOCOL_MPC_TEST_INIT(partyid);
+  const string prefix = "log/mpc_tests_" + protocol_name + "_share_file-" + to_string(partyid);
+  vector<string> receivers = {node_id_0, node_id_1, node_id_2};
+
+  vector<int64_t> shape;
+  vector<double> w;
+  if (node_id == node_id_0) {
+    MpcWriteNpy(prefix + ".npy", kShape, W);
+    MpcReadNpy(prefix + ".npy", shape, w);
+  }
+
+  MpcShareFile file(mpc_proto), loaded;
+  MpcImportPlain(mpc_proto, node_id_0, "w", kShape, w, file);
+  MpcImportPlain(mpc_proto, node_id_1, "b", {}, node_id == node_id_1 ? B : vector<double>(), file);
+  file.Save(prefix + ".rtt");
+  if (loaded.Load(prefix + ".rtt") != 0) {
+    cout << "[" << protocol_name << " share file] => ***Error*** can not load " << prefix << ".rtt" << endl;
+    PROTOCOL_MPC_TEST_UNINIT(partyid);
+    return;
+  }
+
+  map<string, vector<double>> plain;
+  MpcExportPlain(mpc_proto, loaded, receivers, plain);
+  HD_AROUND_EQUAL_T(plain["w"], W, protocol_name + " share file w");
+  HD_AROUND_EQUAL_T(plain["b"], B, protocol_name + " share file b");
+
+  // to the other layout and back
+  MpcShareFile other, back;
+  if (loaded.protocol == "Helix") {
+    MpcReshareHelixToSnn(net_io, loaded, other);
+    MpcReshareSnnToHelix(net_io, other, back);
+  } else {
+    MpcReshareSnnToHelix(net_io, loaded, other);
+    MpcReshareHelixToSnn(net_io, other, back);
+  }
+  plain.clear();
+  MpcExportPlain(mpc_proto, back, receivers, plain);
+  HD_AROUND_EQUAL_T(plain["w"], W, protocol_name + " reshared w");
+  HD_AROUND_EQUAL_T(plain["b"], B, protocol_name + " reshared b");
+
+  PROTOCOL_MPC_TEST_UNINIT(partyid);
+}
+
+RUN_MPC_TEST(run);
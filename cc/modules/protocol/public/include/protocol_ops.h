@@ -156,6 +156,10 @@ struct RestoreModel {
   const string& get_plaintext_node() const { return plaintext_node_; }
 };
 
+class SecureDebugMonitor;
+class MpcMaskStore;
+class MpcGcCompare;
+
 struct ProtocolContext {
   short VERSION = 2;
   int FLOAT_PRECISION = FLOAT_PRECISION_DEFAULT;
@@ -169,8 +173,15 @@ struct ProtocolContext {
   int ROLE_ID;
   map<string, int> NODE_ROLE_MAPPING; // node_id -> role
   string PAYLOAD;
+  // only created in secure-debug builds (ROSETTA_ENABLES_SECURE_DEBUG)
+  shared_ptr<SecureDebugMonitor> SECURE_DEBUG = nullptr;
+  // masks of random ops (Dropout) kept by msg_id for their gradient ops
+  shared_ptr<MpcMaskStore> MASK_STORE = nullptr;
+  // garbled-circuit comparison of two-party shares, if the protocol set one up
+  shared_ptr<MpcGcCompare> GC_COMPARE = nullptr;
 
   int GetMyRole() { return ROLE_ID; }
+  int GetFixPointPrecision() const { return FLOAT_PRECISION; }
 
   int GetRole(const string& node_id) {
     if (NODE_ROLE_MAPPING.find(node_id) == NODE_ROLE_MAPPING.end()) {
@@ -526,6 +537,166 @@ class ProtocolOps {
     THROW_NOT_IMPL;
   }
 
+  /**
+   * Smooth activations and their derivatives w.r.t. the input, y = f'(a).
+   * Swish is x * sigmoid(x), also known as SiLU.
+   */
+  virtual int Tanh(
+    const vector<string>& a,
+    vector<string>& output,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+  virtual int TanhGrad(
+    const vector<string>& a,
+    vector<string>& output,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+  virtual int Gelu(
+    const vector<string>& a,
+    vector<string>& output,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+  virtual int GeluGrad(
+    const vector<string>& a,
+    vector<string>& output,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+  virtual int Swish(
+    const vector<string>& a,
+    vector<string>& output,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+  virtual int SwishGrad(
+    const vector<string>& a,
+    vector<string>& output,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+  virtual int Softplus(
+    const vector<string>& a,
+    vector<string>& output,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+  virtual int SoftplusGrad(
+    const vector<string>& a,
+    vector<string>& output,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+
+  /**
+   * Layer normalization over the rows of x, attr_info holds "rows", "cols" and "epsilon".
+   * gamma and beta have cols elements, inv_std gets the rows values 1/sqrt(var + epsilon)
+   * that LayerNormGrad takes back. An epsilon below the fixed-point LSB 2^-precision (eg. the
+   * default 1e-5 at precision 13) would encode to 0, it is raised to 2^-precision instead.
+   */
+  virtual int LayerNorm(
+    const vector<string>& x,
+    const vector<string>& gamma,
+    const vector<string>& beta,
+    vector<string>& y,
+    vector<string>& inv_std,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+  virtual int LayerNormGrad(
+    const vector<string>& x,
+    const vector<string>& gamma,
+    const vector<string>& inv_std,
+    const vector<string>& dy,
+    vector<string>& dx,
+    vector<string>& dgamma,
+    vector<string>& dbeta,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+
+  /**
+   * output = a + noise, with the noise sampled jointly in secret-shared form so that no
+   * party learns it. attr_info holds "mechanism" ("gaussian" or "laplace") and "scale"
+   * (the standard deviation, or the Laplace b), a positive value. The noise is the discrete
+   * Laplace or the binomial mechanism on the fixed-point grid, see mpc_dp.h for the (eps, delta)
+   * each one gives.
+   */
+  virtual int DPNoise(
+    const vector<string>& a,
+    vector<string>& output,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+
+  /**
+   * Per-example clipping, each row g of a rows x cols matrix becomes
+   * g * min(1, clip_norm / ||g||_2). attr_info holds "rows", "cols" and "clip_norm" (positive).
+   */
+  virtual int ClipByL2Norm(
+    const vector<string>& a,
+    vector<string>& output,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+
+  /**
+   * Inverted dropout, each element is kept with probability 1 - rate (rounded to the grid
+   * of the backend's uniforms) and scaled by the inverse of that probability. attr_info holds "rate" and "common_mask": with "1" the mask is drawn
+   * from the PRG common to all parties and applied locally, otherwise it stays
+   * secret-shared. The mask is kept under this op's msg_id for DropoutGrad.
+   */
+  virtual int Dropout(
+    const vector<string>& a,
+    vector<string>& output,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+  /**
+   * dx = dy * mask, with the mask of the Dropout op whose graph name is in attr_info
+   * "forward_msgid", resolved in this task by MsgIdMgr::ResolveMsgId.
+   */
+  virtual int DropoutGrad(
+    const vector<string>& dy,
+    vector<string>& dx,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+
+  /**
+   * The k largest values of each row of a rows x cols matrix, descending, and their
+   * positions as one-hot rows. attr_info holds "rows", "cols" and "k".
+   * values gets rows x k elements and indices rows x k x cols.
+   */
+  virtual int TopK(
+    const vector<string>& a,
+    vector<string>& values,
+    vector<string>& indices,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+
+  /**
+   * One-hot encoding of secret integers with a public vocabulary size, attr_info holds "depth".
+   * b gets a.size() x depth elements, rows of values outside [0, depth) are all zero.
+   */
+  virtual int OneHot(const vector<string>& a, vector<string>& b, const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+
+  /**
+   * The inverse of OneHot, the index of each one-hot row of a, attr_info holds "depth".
+   * b gets a.size() / depth elements.
+   */
+  virtual int OneHotToIndex(
+    const vector<string>& a,
+    vector<string>& b,
+    const attr_type* attr_info = nullptr) {
+    THROW_NOT_IMPL;
+  }
+
   virtual int BiasAdd(
     const vector<string>& a,
     const vector<string>& b,
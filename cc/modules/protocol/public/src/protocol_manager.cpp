@@ -16,7 +16,16 @@
 using namespace rosetta::snn;
 #endif
 
+#if ROSETTA_ENABLES_PROTOCOL_MPC_OT2PC
+#include "cc/modules/protocol/mpc/ot2pc/include/ot2pc_impl.h"
+#endif
+
+#if ROSETTA_ENABLES_PROTOCOL_MPC_SHAMIR
+#include "cc/modules/protocol/mpc/shamir/include/shamir_impl.h"
+#endif
+
 #include "cc/modules/protocol/mpc/naive/include/naive_impl.h"
+#include "cc/modules/protocol/mpc/plain/include/plain_impl.h"
 #if ROSETTA_ENABLES_PROTOCOL_ZK
 #include "cc/modules/protocol/zk/wolverine/include/wolverine_impl.h"
 #endif
@@ -331,7 +340,16 @@ REGISTER_SECURE_PROTOCOL_FACTORY(HelixProtocolFactory, "Helix");
 REGISTER_SECURE_PROTOCOL_FACTORY(SnnProtocolFactory, "SecureNN");
 #endif
 
+#if ROSETTA_ENABLES_PROTOCOL_MPC_OT2PC
+REGISTER_SECURE_PROTOCOL_FACTORY(Ot2pcProtocolFactory, "OT2PC");
+#endif
+
+#if ROSETTA_ENABLES_PROTOCOL_MPC_SHAMIR
+REGISTER_SECURE_PROTOCOL_FACTORY(ShamirProtocolFactory, "Shamir");
+#endif
+
 REGISTER_SECURE_PROTOCOL_FACTORY(NaiveProtocolFactory, "Naive");
+REGISTER_SECURE_PROTOCOL_FACTORY(PlainFixpointProtocolFactory, "PlainFixpoint");
 
 #if ROSETTA_ENABLES_PROTOCOL_ZK
 REGISTER_SECURE_PROTOCOL_FACTORY(WolverineProtocolFactory, "Wolverine");
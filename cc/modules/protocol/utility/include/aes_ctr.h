@@ -0,0 +1,115 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include "cc/modules/protocol/utility/include/binary_state.h"
+
+#include <immintrin.h>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace rosetta {
+
+/**
+ * AES-128 in counter mode as a bulk randomness engine, shared by the SecureNN
+ * AESObject and the Helix RttPRG.
+ *
+ * Keystream blocks are AES_k(nonce || counter). Blocks are encrypted 8 per
+ * iteration with interleaved AES-NI rounds, or 16 per iteration with VAES when
+ * the compiler targets it (-march=native on a VAES capable host).
+ *
+ * The output is a byte stream: fill(p, a) followed by fill(p + a, b) equals
+ * fill(p, a + b), so parties holding the same key draw the same values as long
+ * as they issue the same sequence of calls.
+ */
+class RttAesCtr {
+ public:
+  RttAesCtr();
+  //! key is 16 bytes
+  explicit RttAesCtr(const void* key, uint64_t nonce = 0);
+
+  //! key is 16 bytes, restarts the stream at counter 0
+  void reseed(const void* key, uint64_t nonce = 0);
+  //! derives key and nonce from SHA256(seed), for seeds of any length
+  void reseed_from(const std::string& seed);
+
+  //! raw keystream bytes
+  void fill(void* data, size_t nbytes);
+  //! n values in {0, 1}, one per byte
+  void fill_bits(uint8_t* data, size_t n);
+  //! n uniform ring elements (uint8_t, uint64_t, mpc_t, ...)
+  template <typename T>
+  void fill_ring(T* data, size_t n) {
+    fill(data, n * sizeof(T));
+  }
+  /**
+   * n uniform values in [lo, modulus), modulus <= 2^32.
+   * Uses Lemire's multiply-shift bounded sampling on 32-bit words, rejecting only
+   * when the low word falls below 2^32 % range.
+   */
+  template <typename T>
+  void fill_mod(T* data, size_t n, uint64_t modulus, uint64_t lo = 0) {
+    assert(modulus > lo && modulus <= (1ULL << 32));
+    uint64_t range = modulus - lo;
+    words_.resize(n);
+    fill(words_.data(), n * sizeof(uint32_t));
+    uint32_t threshold = (uint32_t)((1ULL << 32) % range);
+    for (size_t i = 0; i < n; i++) {
+      uint64_t m = (uint64_t)words_[i] * range;
+      while ((uint32_t)m < threshold) {
+        uint32_t x;
+        fill(&x, sizeof(x));
+        m = (uint64_t)x * range;
+      }
+      data[i] = (T)(lo + (m >> 32));
+    }
+  }
+
+  //! number of keystream blocks produced since the last reseed
+  uint64_t blocks() const { return counter_; }
+
+  //! where the stream is, under the current key
+  struct Position {
+    uint64_t counter = 0;
+    uint8_t buf[16] = {0};
+    uint64_t buf_pos = 16;
+  };
+  Position position() const;
+  //! moves the stream back (or on) to a position taken under the same key
+  void seek(const Position& pos);
+
+  //! key and position, for checkpoints
+  void save_state(BinaryStateWriter& w) const;
+  bool load_state(BinaryStateReader& r);
+
+ private:
+  void encrypt_blocks(__m128i* out, size_t nblocks);
+
+ private:
+  __m128i rk_[11];
+  uint64_t nonce_ = 0;
+  uint64_t counter_ = 0;
+  alignas(16) uint8_t buf_[16];
+  size_t buf_pos_ = 16; //! unread bytes of the last block are buf_[buf_pos_, 16)
+  std::vector<uint32_t> words_;
+};
+
+} // namespace rosetta
@@ -0,0 +1,156 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include "cc/modules/common/include/utils/msg_id.h"
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace rosetta {
+
+/**
+ * Little helpers to snapshot the in-memory state of a protocol (PRG positions,
+ * triple caches, ...) into a byte string and back, eg. for checkpoints.
+ *
+ * Values are copied raw, so a state is only read back by the same build on the
+ * same kind of host. The reader does not throw, it turns not ok on a short
+ * input and every later get fails too.
+ */
+class BinaryStateWriter {
+ public:
+  explicit BinaryStateWriter(std::string& out) : out_(out) {}
+
+  template <typename T>
+  void put(const T& v) {
+    static_assert(std::is_trivially_copyable<T>::value, "raw values only");
+    out_.append((const char*)&v, sizeof(T));
+  }
+  void put_bytes(const void* data, size_t len) { out_.append((const char*)data, len); }
+  void put_string(const std::string& s) {
+    put<uint64_t>(s.size());
+    out_.append(s);
+  }
+  template <typename T>
+  void put_vector(const std::vector<T>& v) {
+    put<uint64_t>(v.size());
+    put_bytes(v.data(), v.size() * sizeof(T));
+  }
+  void put_strings(const std::vector<std::string>& v) {
+    put<uint64_t>(v.size());
+    for (auto& s : v)
+      put_string(s);
+  }
+  void put_string_map(const std::map<std::string, std::string>& m) {
+    put<uint64_t>(m.size());
+    for (auto& kv : m) {
+      put_string(kv.first);
+      put_string(kv.second);
+    }
+  }
+
+ private:
+  std::string& out_;
+};
+
+class BinaryStateReader {
+ public:
+  explicit BinaryStateReader(const std::string& in) : in_(in) {}
+
+  bool ok() const { return ok_; }
+  bool eof() const { return pos_ == in_.size(); }
+
+  template <typename T>
+  bool get(T& v) {
+    static_assert(std::is_trivially_copyable<T>::value, "raw values only");
+    return get_bytes(&v, sizeof(T));
+  }
+  bool get_bytes(void* data, size_t len) {
+    if (!ok_ || in_.size() - pos_ < len)
+      return ok_ = false;
+    memcpy(data, in_.data() + pos_, len);
+    pos_ += len;
+    return true;
+  }
+  bool get_string(std::string& s) {
+    uint64_t n = 0;
+    if (!get(n) || in_.size() - pos_ < n)
+      return ok_ = false;
+    s.assign(in_.data() + pos_, n);
+    pos_ += n;
+    return true;
+  }
+  template <typename T>
+  bool get_vector(std::vector<T>& v) {
+    uint64_t n = 0;
+    if (!get(n) || (in_.size() - pos_) / sizeof(T) < n)
+      return ok_ = false;
+    v.resize(n);
+    return get_bytes(v.data(), n * sizeof(T));
+  }
+  bool get_strings(std::vector<std::string>& v) {
+    uint64_t n = 0;
+    if (!get(n) || in_.size() - pos_ < n * sizeof(uint64_t))
+      return ok_ = false;
+    v.resize(n);
+    for (auto& s : v)
+      get_string(s);
+    return ok_;
+  }
+  bool get_string_map(std::map<std::string, std::string>& m) {
+    uint64_t n = 0;
+    if (!get(n))
+      return false;
+    m.clear();
+    for (uint64_t i = 0; i < n && ok_; i++) {
+      std::string k, v;
+      get_string(k);
+      get_string(v);
+      m[k] = v;
+    }
+    return ok_;
+  }
+
+ private:
+  const std::string& in_;
+  size_t pos_ = 0;
+  bool ok_ = true;
+};
+
+// a msg id by its source string, checked against its binary id
+inline void put_msg_id(BinaryStateWriter& w, const msg_id_t& id) {
+  w.put_string(id.str());
+  w.put_bytes(id.data(), msg_id_t::Size());
+}
+
+inline bool get_msg_id(BinaryStateReader& r, msg_id_t& id) {
+  std::string src;
+  char bin[msg_id_t::Size()];
+  if (!r.get_string(src) || !r.get_bytes(bin, sizeof(bin)))
+    return false;
+  id = msg_id_t(src);
+  if (memcmp(id.data(), bin, sizeof(bin)) != 0)
+    id = msg_id_t(bin, sizeof(bin));
+  return true;
+}
+
+} // namespace rosetta
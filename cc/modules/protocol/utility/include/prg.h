@@ -17,6 +17,8 @@
 // ==============================================================================
 #pragma once
 
+#include "cc/modules/protocol/utility/include/aes_ctr.h"
+
 #include <immintrin.h>
 #include <iostream>
 #include <memory>
@@ -25,7 +27,6 @@
 using namespace std;
 
 namespace emp {
-class PRG;
 using block = __m128i;
 } // namespace emp
 using emp::block;
@@ -44,7 +45,8 @@ class RttPRG {
   block block08{0};
   block block01{0};
 
-  shared_ptr<emp::PRG> prg_ = nullptr;
+  RttAesCtr prg_;
+  RttAesCtr::Position refill_at_; // where data_ was drawn from, to rebuild it on load_state
   std::string kdefault =
     std::string("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00");
 
@@ -62,10 +64,21 @@ class RttPRG {
   void reseed(const void* key, uint64_t id = 0);
   void reseed(const std::string& key);
   void randomDatas(void* data, int nbytes);
+
+  // bulk fills, see RttAesCtr
+  void fillBits(uint8_t* data, size_t n) { prg_.fill_bits(data, n); }
+  template <typename T>
+  void fillRing(T* data, size_t n) { prg_.fill_ring(data, n); }
+  template <typename T>
+  void fillMod(T* data, size_t n, uint64_t modulus) { prg_.fill_mod(data, n, modulus); }
   uint64_t get64Bits();
   uint8_t get8Bits();
   uint8_t getBit();
 
+  //! the whole state, so that a loaded PRG goes on with the same values
+  void save_state(BinaryStateWriter& w) const;
+  bool load_state(BinaryStateReader& r);
+
   uint64_t getFpBits(uint64_t prime, bool need_lt_prime=true) {
     uint64_t ret(0);
     do {
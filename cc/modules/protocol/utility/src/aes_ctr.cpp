@@ -0,0 +1,182 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/utility/include/aes_ctr.h"
+
+#include <openssl/sha.h>
+#include <algorithm>
+
+namespace rosetta {
+
+namespace {
+inline __m128i key_expand(__m128i key, __m128i gen) {
+  gen = _mm_shuffle_epi32(gen, 0xff);
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, gen);
+}
+} // namespace
+
+#define AES_128_EXPAND(i, rcon) \
+  rk_[i] = key_expand(rk_[i - 1], _mm_aeskeygenassist_si128(rk_[i - 1], rcon))
+
+RttAesCtr::RttAesCtr() {
+  uint8_t zero[16] = {0};
+  reseed(zero);
+}
+
+RttAesCtr::RttAesCtr(const void* key, uint64_t nonce) { reseed(key, nonce); }
+
+void RttAesCtr::reseed(const void* key, uint64_t nonce) {
+  rk_[0] = _mm_loadu_si128((const __m128i*)key);
+  AES_128_EXPAND(1, 0x01);
+  AES_128_EXPAND(2, 0x02);
+  AES_128_EXPAND(3, 0x04);
+  AES_128_EXPAND(4, 0x08);
+  AES_128_EXPAND(5, 0x10);
+  AES_128_EXPAND(6, 0x20);
+  AES_128_EXPAND(7, 0x40);
+  AES_128_EXPAND(8, 0x80);
+  AES_128_EXPAND(9, 0x1b);
+  AES_128_EXPAND(10, 0x36);
+  nonce_ = nonce;
+  counter_ = 0;
+  buf_pos_ = sizeof(buf_);
+}
+
+void RttAesCtr::reseed_from(const std::string& seed) {
+  unsigned char digest[SHA256_DIGEST_LENGTH];
+  SHA256((const unsigned char*)seed.data(), seed.size(), digest);
+  uint64_t nonce;
+  memcpy(&nonce, digest + 16, sizeof(nonce));
+  reseed(digest, nonce);
+}
+
+void RttAesCtr::encrypt_blocks(__m128i* out, size_t nblocks) {
+  size_t i = 0;
+  const uint64_t nonce = nonce_;
+
+#if defined(__VAES__) && defined(__AVX512F__)
+  // 4 x 4 blocks per iteration in 512-bit lanes
+  __m512i rk512[11];
+  for (int r = 0; r < 11; r++)
+    rk512[r] = _mm512_broadcast_i32x4(rk_[r]);
+  for (; i + 16 <= nblocks; i += 16) {
+    uint64_t c = counter_;
+    __m512i b[4];
+    for (int k = 0; k < 4; k++) {
+      uint64_t ck = c + 4 * k;
+      b[k] = _mm512_set_epi64(nonce, ck + 3, nonce, ck + 2, nonce, ck + 1, nonce, ck);
+      b[k] = _mm512_xor_si512(b[k], rk512[0]);
+    }
+    for (int r = 1; r < 10; r++)
+      for (int k = 0; k < 4; k++)
+        b[k] = _mm512_aesenc_epi128(b[k], rk512[r]);
+    for (int k = 0; k < 4; k++) {
+      b[k] = _mm512_aesenclast_epi128(b[k], rk512[10]);
+      _mm512_storeu_si512((void*)(out + i + 4 * k), b[k]);
+    }
+    counter_ += 16;
+  }
+#endif
+
+  // 8 blocks per iteration, independent blocks keep the AES units busy
+  for (; i + 8 <= nblocks; i += 8) {
+    __m128i b[8];
+    for (int k = 0; k < 8; k++)
+      b[k] = _mm_xor_si128(_mm_set_epi64x(nonce, counter_ + k), rk_[0]);
+    for (int r = 1; r < 10; r++)
+      for (int k = 0; k < 8; k++)
+        b[k] = _mm_aesenc_si128(b[k], rk_[r]);
+    for (int k = 0; k < 8; k++)
+      _mm_storeu_si128(out + i + k, _mm_aesenclast_si128(b[k], rk_[10]));
+    counter_ += 8;
+  }
+
+  for (; i < nblocks; i++) {
+    __m128i b = _mm_xor_si128(_mm_set_epi64x(nonce, counter_), rk_[0]);
+    for (int r = 1; r < 10; r++)
+      b = _mm_aesenc_si128(b, rk_[r]);
+    _mm_storeu_si128(out + i, _mm_aesenclast_si128(b, rk_[10]));
+    counter_++;
+  }
+}
+
+void RttAesCtr::fill(void* data, size_t nbytes) {
+  uint8_t* p = (uint8_t*)data;
+
+  // the rest of the previous block first
+  size_t n = std::min(nbytes, sizeof(buf_) - buf_pos_);
+  if (n > 0) {
+    memcpy(p, buf_ + buf_pos_, n);
+    buf_pos_ += n;
+    p += n;
+    nbytes -= n;
+  }
+
+  size_t nblocks = nbytes / sizeof(__m128i);
+  if (nblocks > 0) {
+    encrypt_blocks((__m128i*)p, nblocks);
+    p += nblocks * sizeof(__m128i);
+    nbytes -= nblocks * sizeof(__m128i);
+  }
+
+  if (nbytes > 0) {
+    encrypt_blocks((__m128i*)buf_, 1);
+    memcpy(p, buf_, nbytes);
+    buf_pos_ = nbytes;
+  }
+}
+
+RttAesCtr::Position RttAesCtr::position() const {
+  Position pos;
+  pos.counter = counter_;
+  memcpy(pos.buf, buf_, sizeof(buf_));
+  pos.buf_pos = buf_pos_;
+  return pos;
+}
+
+void RttAesCtr::seek(const Position& pos) {
+  counter_ = pos.counter;
+  memcpy(buf_, pos.buf, sizeof(buf_));
+  buf_pos_ = std::min<size_t>(pos.buf_pos, sizeof(buf_));
+}
+
+void RttAesCtr::save_state(BinaryStateWriter& w) const {
+  w.put_bytes(rk_, sizeof(rk_));
+  w.put(nonce_);
+  w.put(position());
+}
+
+bool RttAesCtr::load_state(BinaryStateReader& r) {
+  Position pos;
+  if (!r.get_bytes(rk_, sizeof(rk_)) || !r.get(nonce_) || !r.get(pos))
+    return false;
+  seek(pos);
+  return true;
+}
+
+void RttAesCtr::fill_bits(uint8_t* data, size_t n) {
+  size_t nbytes = (n + 7) / 8;
+  std::vector<uint8_t> bytes(nbytes);
+  fill(bytes.data(), nbytes);
+  for (size_t i = 0; i < n; i++)
+    data[i] = (bytes[i >> 3] >> (i & 7)) & 0x01;
+}
+
+} // namespace rosetta
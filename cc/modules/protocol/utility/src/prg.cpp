@@ -17,28 +17,23 @@
 // ==============================================================================
 #include "cc/modules/protocol/utility/include/prg.h"
 
-#include "emp-tool/emp-tool.h"
-using namespace emp;
+#include <algorithm>
+#include <cstring>
 
 namespace rosetta {
 
-RttPRG::RttPRG() {
-  prg_ = make_shared<emp::PRG>();
-  reseed(kdefault);
-}
-RttPRG::RttPRG(const std::string& key) {
-  prg_ = make_shared<emp::PRG>();
-  reseed(key);
-}
+RttPRG::RttPRG() { reseed(kdefault); }
+RttPRG::RttPRG(const std::string& key) { reseed(key); }
 
 block RttPRG::newRandomBlocks() {
   if (counter_++ % BLOCK_COUNT == 0) {
+    refill_at_ = prg_.position();
     randomDatas((char*)data_, BLOCK_COUNT * sizeof(block));
   }
   return data_[counter_ % BLOCK_COUNT];
 }
 
-void RttPRG::randomDatas(void* data, int nbytes) { prg_->random_data(data, nbytes); }
+void RttPRG::randomDatas(void* data, int nbytes) { prg_.fill(data, nbytes); }
 uint64_t RttPRG::get64Bits() {
   uint64_t ret = 0;
   if (index64 == 0)
@@ -85,7 +80,51 @@ uint8_t RttPRG::getBit() {
   return ret;
 }
 
-void RttPRG::reseed(const void* key, uint64_t id) { prg_->reseed((const block*)key, id); }
-void RttPRG::reseed(const std::string& key) { reseed((const void*)key.data()); }
+void RttPRG::save_state(BinaryStateWriter& w) const {
+  prg_.save_state(w);
+  w.put(refill_at_);
+  w.put(counter_);
+  w.put(index64);
+  w.put(index08);
+  w.put(index01);
+  w.put(block64);
+  w.put(block08);
+  w.put(block01);
+}
+
+bool RttPRG::load_state(BinaryStateReader& r) {
+  if (!prg_.load_state(r))
+    return false;
+  r.get(refill_at_);
+  r.get(counter_);
+  r.get(index64);
+  r.get(index08);
+  r.get(index01);
+  r.get(block64);
+  r.get(block08);
+  r.get(block01);
+  if (!r.ok())
+    return false;
+  // data_ is not saved, it is drawn again from where it was drawn
+  if (counter_ > 0) {
+    RttAesCtr::Position now = prg_.position();
+    prg_.seek(refill_at_);
+    randomDatas((char*)data_, BLOCK_COUNT * sizeof(block));
+    prg_.seek(now);
+  }
+  return true;
+}
+
+void RttPRG::reseed(const void* key, uint64_t id) {
+  prg_.reseed(key, id);
+  counter_ = 0;
+  index64 = index08 = index01 = 0;
+}
+void RttPRG::reseed(const std::string& key) {
+  // keys shorter than 16 bytes (eg. kdefault, which is empty) are zero padded
+  char k[16] = {0};
+  memcpy(k, key.data(), std::min(key.size(), sizeof(k)));
+  reseed((const void*)k);
+}
 
 } // namespace rosetta
@@ -0,0 +1,118 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include "cc/modules/protocol/zk/wolverine/include/zk_int_fp.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Commitments to private inputs that outlive one proof, typically the weights of a model.
+ *
+ * Commit authenticates the values once (IT-MACs, as PrivateInput does) and
+ * keeps them. Proofs of the same session then use the same authenticated
+ * values, so a model is committed once for any number of queries, and the
+ * verifier knows they all ran on the same model.
+ *
+ * Save writes the commitments to a file. The prover keeps the values and
+ * their MACs, the verifier the keys and its Delta. The file ends with a
+ * SHA-256 of its content. Both parties also keep a binding hash of the
+ * name, the size and a nonce of the verifier, which must match to import.
+ *
+ * A new session has a new Delta, so Import authenticates the values again
+ * and checks them against the old commitment: with random public chi, the
+ * prover opens y = sum(chi_i * x_i) + r under the old MACs and under the new
+ * ones, and the verifier checks both. r is one of kCommitMasks random values
+ * committed along with the model, each used once, so y tells nothing about x.
+ * Import writes the store back to the file it was loaded from (or last saved
+ * to) with the mask marked used before y is opened, and both parties check
+ * they are at the same mask, so reloading the file can not reuse a mask.
+ * A wrong value passes with probability 1 / PR.
+ */
+namespace rosetta {
+namespace zk {
+
+// the number of later sessions that can import a commitment
+const int kCommitMasks = 64;
+
+struct ZkCommitRecord {
+  std::string name;
+  uint64_t size = 0;
+  uint8_t binding[32] = {0};
+  // the commitment as made: the prover's (value << 64 | mac), or the verifier's key.
+  // The values come first, then the kCommitMasks masks.
+  std::vector<__uint128_t> auth;
+  uint64_t delta = 0; // verifier only
+  uint64_t masks_used = 0;
+
+  // the values authenticated in this session, empty until committed or imported
+  std::vector<ZkIntFp> live;
+};
+
+class ZkCommitStore {
+ public:
+  explicit ZkCommitStore(int party) : party_(party) {}
+
+  /**
+   * @desc: commits size values in this session, on both parties.
+   *     The prover passes the values, the verifier anything of the same size.
+   * @return: 0, or -1 if the name is taken
+   */
+  int Commit(const std::string& name, const std::vector<double>& values, std::vector<ZkIntFp>& out);
+
+  //! the values of a commitment made or imported in this session
+  bool Get(const std::string& name, std::vector<ZkIntFp>& out);
+
+  /**
+   * @desc: brings a loaded commitment into this session, on both parties.
+   *     The prover passes the committed values again.
+   * @return: 0, or -1 if it is unknown, the bindings or mask indexes differ, no mask
+   *     is left, or the store can not be written back to its file.
+   *     Throws if the values do not match the commitment.
+   */
+  int Import(const std::string& name, const std::vector<double>& values, std::vector<ZkIntFp>& out);
+
+  bool Has(const std::string& name);
+
+  //! how many masks of a commitment are used, 0 if it is unknown
+  uint64_t MasksUsed(const std::string& name);
+
+  //! writes every commitment, as made, and how many masks are used. Import writes there again.
+  int Save(const std::string& path);
+
+  //! reads commitments of earlier sessions, to be imported. Import writes back there.
+  int Load(const std::string& path);
+
+ private:
+  int Write(const std::string& path);
+  void Exchange(void* data, int len, bool from_prover);
+  void Binding(const std::string& name, uint64_t size, const uint8_t nonce[16], uint8_t binding[32]);
+
+ private:
+  int party_ = 0;
+  std::mutex mtx_;
+  std::map<std::string, ZkCommitRecord> records_;
+  // the file the store was loaded from or last saved to
+  std::string path_;
+};
+
+} // namespace zk
+} // namespace rosetta
@@ -34,6 +34,8 @@ using namespace emp;
 using namespace std;
 
 #include "cc/modules/protocol/zk/wolverine/include/wvr_util.h"
+#include "cc/modules/protocol/zk/wolverine/include/wolverine_commit.h"
+#include "cc/modules/protocol/zk/wolverine/include/wolverine_setup_pool.h"
 
 namespace rosetta {
 class RosettaConfig;
@@ -58,12 +60,20 @@ class WolverineProtocol : public ProtocolBase {
  public:
   virtual shared_ptr<ProtocolOps> GetOps(const msg_id_t& msgid);
   virtual shared_ptr<NET_IO> GetNetHandler() { return net_io_; }
+
+  //! committed inputs of this session, and Save/Load to carry them to later ones
+  shared_ptr<zk::ZkCommitStore> GetCommitStore() { return commit_store_; }
   
 
   ZK_NET_IO* zk_ios[THREAD_NUM + 1];
   std::string host = "127.0.0.1";
   int port=11224, party;
   shared_ptr<RosettaConfig> config = nullptr;
+
+ private:
+  shared_ptr<zk::ZkCommitStore> commit_store_ = nullptr;
+  shared_ptr<zk::WolverineSetup> setup_ = nullptr;
+  bool pool_owns_channel_ = false;
 };
 
 class WolverineProtocolFactory : public IProtocolFactory {
@@ -24,6 +24,7 @@
 #include "cc/modules/protocol/public/include/protocol_ops.h"
 
 #include "cc/modules/protocol/zk/wolverine/include/wvr_util.h"
+#include "cc/modules/protocol/zk/wolverine/include/wolverine_commit.h"
 
 namespace rosetta {
 class WolverineOpsImpl : public ProtocolOps {
@@ -40,6 +41,13 @@ class WolverineOpsImpl : public ProtocolOps {
 
   int PublicInput(const string& node_id, const vector<double>& in_x, vector<ZkIntFp>& out_x);
   int PublicInput(int party_id, const vector<double>& in_x, vector<ZkIntFp>& out_x);
+
+  /**
+   * Private input of the prover that stays committed under its name, e.g. model weights.
+   * The first call in a session commits it, or imports it if it was loaded from an
+   * earlier session. Later calls reuse the authenticated values, in_x is then ignored.
+   */
+  int CommittedInput(const string& name, const vector<double>& in_x, vector<string>& out_x);
   
   int Broadcast(const string& from_node, const char* msg, char* result, size_t size);
   int Broadcast(int from_party, const char* msg, char* result, size_t size);
@@ -149,6 +157,7 @@ private:
 
  public:
   shared_ptr<NET_IO> io = nullptr;
+  shared_ptr<zk::ZkCommitStore> commit_store = nullptr;
   int port, party;
 
   // TODO: find a right place to hold these.
@@ -0,0 +1,131 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#pragma once
+
+#include "cc/modules/protocol/zk/wolverine/include/wvr_util.h"
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Keeps the Wolverine setup (base OTs and VOLE bootstrapping of emp-zk) warm
+ * between sessions of a long-lived process, so short proving tasks start at once.
+ *
+ * Acquire gives a session its setup: a prepared one if there is, else a new one.
+ * Release finalizes it, which runs the last checks of the session's proofs.
+ * With keep_warm, the pool then prepares the next setup of the same task in the
+ * background, over the same channel, which it keeps open until Drain. A session
+ * that comes after the idle time takes the prepared setup instead of running its own.
+ *
+ * emp-zk runs one setup per process at a time, through its globals. The pool hands
+ * them to one owner at a time: a session from Acquire to Release, then the setup it
+ * prepares in the background, which gives them back once parked. Another task's
+ * Acquire waits for them, so nothing overwrites the globals of a running session.
+ * Both parties must keep their setups warm or not, alike.
+ *
+ * With a state store, Drain writes the Ferret COT state (Delta and the correlations
+ * reserved for its next extension) of each prepared, never used, setup to disk,
+ * encrypted and authenticated with AES-256-GCM. The first setup of the task in a later
+ * process resumes the boolean part from it instead of running the base OTs, if the
+ * peer holds the state of the same Drain. A state file is removed as it is read, so
+ * its correlations serve once; Ferret reserves fresh ones at every extension, and the
+ * store is refilled by the next Drain. emp-zk's arithmetic VOLE has no state export,
+ * so that part is set up again.
+ */
+namespace rosetta {
+namespace zk {
+
+struct WolverineSetup {
+  string task_id;
+  shared_ptr<NET_IO> net_io = nullptr;
+  int party = 0;
+  ZK_NET_IO* ios[THREAD_NUM + 1] = {nullptr};
+
+  // the emp-zk globals of this setup, in place while it is installed
+  CircuitExecution* circ_exec = nullptr;
+  ProtocolExecution* prot_exec = nullptr;
+  ZKFpExec* zk_exec = nullptr;
+};
+
+class WolverineSetupPool {
+ private:
+  WolverineSetupPool() = default;
+  WolverineSetupPool(const WolverineSetupPool&) = delete;
+  WolverineSetupPool& operator=(const WolverineSetupPool&) = delete;
+
+ public:
+  static WolverineSetupPool* Instance() {
+    static WolverineSetupPool pool;
+    return &pool;
+  }
+
+  //! prepare the next setup of a task when it is released. Off by default.
+  void SetKeepWarm(bool keep_warm) { keep_warm_ = keep_warm; }
+  bool KeepWarm() const { return keep_warm_; }
+
+  //! persist prepared setups in dir at Drain, under a key derived from secret. Empty dir turns it off.
+  void SetStateStore(const string& dir, const string& secret);
+
+  //! the setup of a new session, installed. Waits for the session or setup holding the globals.
+  shared_ptr<WolverineSetup> Acquire(const string& task_id, shared_ptr<NET_IO> net_io, int party);
+
+  //! finalizes the setup of a session. Returns whether the pool now owns the channel.
+  bool Release(shared_ptr<WolverineSetup> setup);
+
+  //! gives up the setup of an aborted session, without talking to the peer
+  void Abandon(shared_ptr<WolverineSetup> setup);
+
+  //! persists or finalizes the prepared setups and closes their channels
+  void Drain();
+
+ private:
+  shared_ptr<WolverineSetup> Setup(const string& task_id, shared_ptr<NET_IO> net_io, int party);
+  static void Finalize(shared_ptr<WolverineSetup> setup);
+  // the globals out, a setup keeps its own pointers
+  static void Park();
+  static void Install(const WolverineSetup& setup);
+
+  // the Ferret COT state of a prepared setup, to the store
+  void Persist(const WolverineSetup& setup);
+  string StatePath(const string& task_id, int party) const;
+  bool LoadState(const string& task_id, int party, uint8_t tag[16], std::vector<uint8_t>& state);
+  bool SaveState(const string& task_id, int party, const uint8_t tag[16], const std::vector<uint8_t>& state);
+
+  // ownership of the emp-zk globals, mtx_ held
+  void TakeGlobals(std::unique_lock<std::mutex>& lck);
+  void GiveGlobals();
+
+ private:
+  bool keep_warm_ = false;
+  std::mutex mtx_;
+  std::condition_variable globals_cv_;
+  bool globals_busy_ = false;
+  std::map<string, shared_ptr<WolverineSetup>> parked_;
+  std::map<string, std::thread> preparing_;
+
+  string state_dir_;
+  std::vector<uint8_t> state_key_;
+};
+
+} // namespace zk
+} // namespace rosetta
@@ -0,0 +1,364 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/zk/wolverine/include/wolverine_commit.h"
+#include "cc/modules/protocol/zk/wolverine/include/wvr_util.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace rosetta {
+namespace zk {
+
+namespace {
+
+const char kCommitFileMagic[8] = {'R', 'T', 'T', 'Z', 'K', 'C', '0', '1'};
+
+template <typename T>
+void put(std::string& out, const T& v) {
+  out.append((const char*)&v, sizeof(T));
+}
+
+template <typename T>
+bool get(const std::string& in, size_t& pos, T& v) {
+  if (pos + sizeof(T) > in.size())
+    return false;
+  memcpy(&v, in.data() + pos, sizeof(T));
+  pos += sizeof(T);
+  return true;
+}
+
+inline uint64_t auth_value(__uint128_t v) { return (uint64_t)(v >> 64); }
+inline uint64_t auth_low(__uint128_t v) { return (uint64_t)v; }
+
+} // namespace
+
+void ZkCommitStore::Exchange(void* data, int len, bool from_prover) {
+  auto io = ((ZKFpExecPrv<BoolIO<ZKNetIO>>*)(ZKFpExec::zk_exec))->io;
+  if ((party_ == ALICE) == from_prover)
+    io->send_data(data, len);
+  else
+    io->recv_data(data, len);
+}
+
+void ZkCommitStore::Binding(
+  const std::string& name,
+  uint64_t size,
+  const uint8_t nonce[16],
+  uint8_t binding[32]) {
+  std::string msg(name);
+  put(msg, size);
+  msg.append((const char*)nonce, 16);
+  Hash::hash_once(binding, msg.data(), msg.size());
+}
+
+int ZkCommitStore::Commit(
+  const std::string& name,
+  const std::vector<double>& values,
+  std::vector<ZkIntFp>& out) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  if (records_.count(name) > 0) {
+    log_error << "zk commit: " << name << " is already committed";
+    return -1;
+  }
+
+  size_t size = values.size();
+  std::vector<uint64_t> fields(size + kCommitMasks, 0);
+  if (party_ == ALICE) {
+    std::vector<uint64_t> encoded;
+    zk_encode(values, encoded);
+    std::copy(encoded.begin(), encoded.end(), fields.begin());
+    PRG prg;
+    prg.random_data(fields.data() + size, kCommitMasks * sizeof(uint64_t));
+    for (size_t i = size; i < fields.size(); ++i)
+      fields[i] = mod(fields[i]);
+  }
+
+  ZkCommitRecord& rec = records_[name];
+  rec.name = name;
+  rec.size = size;
+  rec.live.resize(size + kCommitMasks);
+  batch_feed((IntFp*)rec.live.data(), party_ == ALICE ? fields.data() : nullptr, rec.live.size());
+  sync_zk_bool<BoolIO<ZKNetIO>>();
+
+  uint8_t nonce[16] = {0};
+  if (party_ == BOB) {
+    PRG prg;
+    prg.random_data(nonce, sizeof(nonce));
+    rec.delta = ((ZKFpExecVer<BoolIO<ZKNetIO>>*)(ZKFpExec::zk_exec))->ostriple->delta;
+  }
+  Exchange(nonce, sizeof(nonce), false);
+  Binding(name, size, nonce, rec.binding);
+
+  rec.auth.resize(rec.live.size());
+  for (size_t i = 0; i < rec.live.size(); ++i)
+    rec.auth[i] = rec.live[i].value;
+  rec.live.resize(size);
+  out = rec.live;
+  log_info << "zk commit: " << name << " of " << size << " values committed";
+  return 0;
+}
+
+bool ZkCommitStore::Get(const std::string& name, std::vector<ZkIntFp>& out) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto iter = records_.find(name);
+  if (iter == records_.end() || iter->second.live.empty())
+    return false;
+  out = iter->second.live;
+  return true;
+}
+
+bool ZkCommitStore::Has(const std::string& name) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  return records_.count(name) > 0;
+}
+
+int ZkCommitStore::Import(
+  const std::string& name,
+  const std::vector<double>& values,
+  std::vector<ZkIntFp>& out) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto iter = records_.find(name);
+  // both parties agree on going on, so that neither waits for the other
+  uint8_t ok = iter != records_.end() && iter->second.live.empty() &&
+    iter->second.masks_used < kCommitMasks &&
+    (party_ == BOB || values.size() == iter->second.size);
+  uint8_t peer_ok = ok;
+  uint8_t binding[32] = {0};
+  uint64_t index = 0;
+  if (ok) {
+    memcpy(binding, iter->second.binding, sizeof(binding));
+    index = iter->second.masks_used;
+  }
+  Exchange(&peer_ok, 1, true);
+  Exchange(binding, sizeof(binding), true);
+  Exchange(&index, sizeof(index), true);
+  if (party_ == BOB) {
+    ok = ok && peer_ok && memcmp(binding, iter->second.binding, sizeof(binding)) == 0 &&
+      index == iter->second.masks_used;
+    peer_ok = ok;
+  }
+  Exchange(&peer_ok, 1, false);
+  if (!ok || !peer_ok) {
+    log_error << "zk commit: can not import " << name
+              << ", unknown, already imported, bindings or mask indexes differ, or no mask left";
+    return -1;
+  }
+
+  // the mask is used up on disk before y is opened, a reload can not take it again
+  ZkCommitRecord& rec = iter->second;
+  const size_t size = rec.size;
+  const size_t mask = size + rec.masks_used;
+  rec.masks_used++;
+  ok = !path_.empty() && Write(path_) == 0;
+  if (!ok)
+    rec.masks_used--;
+  peer_ok = ok;
+  Exchange(&peer_ok, 1, true);
+  if (party_ == BOB) {
+    ok = ok && peer_ok;
+    peer_ok = ok;
+  }
+  Exchange(&peer_ok, 1, false);
+  if (!ok || !peer_ok) {
+    log_error << "zk commit: can not import " << name << ", the used mask can not be saved"
+              << (path_.empty() ? ", the store was neither loaded nor saved" : " to " + path_);
+    return -1;
+  }
+
+  // the values and the next mask, in this session
+  std::vector<uint64_t> fields(size + 1, 0);
+  if (party_ == ALICE) {
+    std::vector<uint64_t> encoded;
+    zk_encode(values, encoded);
+    std::copy(encoded.begin(), encoded.end(), fields.begin());
+    fields[size] = auth_value(rec.auth[mask]);
+  }
+  std::vector<ZkIntFp> fresh(size + 1);
+  batch_feed((IntFp*)fresh.data(), party_ == ALICE ? fields.data() : nullptr, fresh.size());
+  sync_zk_bool<BoolIO<ZKNetIO>>();
+
+  // the challenge comes after the values are fixed
+  block seed;
+  if (party_ == BOB) {
+    PRG prg;
+    prg.random_block(&seed, 1);
+  }
+  Exchange(&seed, sizeof(seed), false);
+  std::vector<uint64_t> chi(size);
+  PRG chi_prg(&seed);
+  chi_prg.random_data(chi.data(), size * sizeof(uint64_t));
+  for (size_t i = 0; i < size; ++i)
+    chi[i] = mod(chi[i]);
+
+  // y and its MAC under the old Delta
+  uint64_t ym[2] = {0, 0};
+  uint64_t key = 0;
+  for (size_t i = 0; i < size; ++i) {
+    if (party_ == ALICE) {
+      ym[0] = add_mod(ym[0], mult_mod(chi[i], auth_value(rec.auth[i])));
+      ym[1] = add_mod(ym[1], mult_mod(chi[i], auth_low(rec.auth[i])));
+    } else {
+      key = add_mod(key, mult_mod(chi[i], auth_low(rec.auth[i])));
+    }
+  }
+  if (party_ == ALICE) {
+    ym[0] = add_mod(ym[0], auth_value(rec.auth[mask]));
+    ym[1] = add_mod(ym[1], auth_low(rec.auth[mask]));
+  } else {
+    key = add_mod(key, auth_low(rec.auth[mask]));
+  }
+  Exchange(ym, sizeof(ym), true);
+  // as in emp-zk, mac = key + value * Delta
+  if (party_ == BOB && ym[1] != add_mod(key, mult_mod(ym[0], rec.delta))) {
+    log_error << "zk commit: " << name << " does not open under its commitment";
+    throw std::runtime_error("zk commit: import of " + name + " failed the commitment check");
+  }
+
+  // the same y under the new Delta
+  ZkIntFp z = fresh[size];
+  for (size_t i = 0; i < size; ++i)
+    z += fresh[i] * chi[i];
+  if (!z.reveal_u64(ym[0]))
+    throw std::runtime_error("zk commit: import of " + name + " failed the commitment check");
+
+  fresh.resize(size);
+  rec.live = fresh;
+  out = fresh;
+  log_info << "zk commit: " << name << " imported, " << kCommitMasks - rec.masks_used
+           << " imports left";
+  return 0;
+}
+
+uint64_t ZkCommitStore::MasksUsed(const std::string& name) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto iter = records_.find(name);
+  return iter == records_.end() ? 0 : iter->second.masks_used;
+}
+
+int ZkCommitStore::Save(const std::string& path) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  if (Write(path) != 0)
+    return -1;
+  path_ = path;
+  log_info << "zk commit: " << records_.size() << " commitments saved to " << path;
+  return 0;
+}
+
+int ZkCommitStore::Write(const std::string& path) {
+  std::string out(kCommitFileMagic, sizeof(kCommitFileMagic));
+  put(out, (int32_t)party_);
+  put(out, (uint64_t)records_.size());
+  for (auto& iter : records_) {
+    const ZkCommitRecord& rec = iter.second;
+    put(out, (uint64_t)rec.name.size());
+    out.append(rec.name);
+    put(out, rec.size);
+    out.append((const char*)rec.binding, sizeof(rec.binding));
+    put(out, rec.delta);
+    put(out, rec.masks_used);
+    out.append((const char*)rec.auth.data(), rec.auth.size() * sizeof(__uint128_t));
+  }
+  uint8_t digest[32];
+  Hash::hash_once(digest, out.data(), out.size());
+  out.append((const char*)digest, sizeof(digest));
+
+  // written aside and renamed, so the file always holds a whole store
+  std::string tmp = path + ".tmp";
+  {
+    std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+    if (!ofs.write(out.data(), out.size()) || !ofs.flush()) {
+      log_error << "zk commit: can not write " << tmp;
+      return -1;
+    }
+  }
+  if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+    log_error << "zk commit: can not rename " << tmp << " to " << path;
+    return -1;
+  }
+  return 0;
+}
+
+int ZkCommitStore::Load(const std::string& path) {
+  std::ifstream ifs(path, std::ios::binary);
+  if (!ifs) {
+    log_error << "zk commit: can not read " << path;
+    return -1;
+  }
+  std::stringstream ss;
+  ss << ifs.rdbuf();
+  std::string in = ss.str();
+
+  uint8_t digest[32];
+  if (in.size() < sizeof(kCommitFileMagic) + sizeof(digest) ||
+      memcmp(in.data(), kCommitFileMagic, sizeof(kCommitFileMagic)) != 0) {
+    log_error << "zk commit: " << path << " is not a commitment file";
+    return -1;
+  }
+  Hash::hash_once(digest, in.data(), in.size() - sizeof(digest));
+  if (memcmp(digest, in.data() + in.size() - sizeof(digest), sizeof(digest)) != 0) {
+    log_error << "zk commit: " << path << " is corrupted, its digest does not match";
+    return -1;
+  }
+  in.resize(in.size() - sizeof(digest));
+
+  size_t pos = sizeof(kCommitFileMagic);
+  int32_t party = 0;
+  uint64_t count = 0;
+  if (!get(in, pos, party) || !get(in, pos, count) || party != party_) {
+    log_error << "zk commit: " << path << " belongs to the other party";
+    return -1;
+  }
+
+  std::map<std::string, ZkCommitRecord> loaded;
+  for (uint64_t c = 0; c < count; ++c) {
+    ZkCommitRecord rec;
+    uint64_t name_size = 0;
+    bool ok = get(in, pos, name_size) && pos + name_size <= in.size();
+    if (ok) {
+      rec.name = in.substr(pos, name_size);
+      pos += name_size;
+    }
+    ok = ok && get(in, pos, rec.size) && get(in, pos, rec.binding) && get(in, pos, rec.delta) &&
+      get(in, pos, rec.masks_used);
+    size_t auth_bytes = (rec.size + kCommitMasks) * sizeof(__uint128_t);
+    if (!ok || pos + auth_bytes > in.size()) {
+      log_error << "zk commit: " << path << " is truncated";
+      return -1;
+    }
+    rec.auth.resize(rec.size + kCommitMasks);
+    memcpy(rec.auth.data(), in.data() + pos, auth_bytes);
+    pos += auth_bytes;
+    loaded[rec.name] = std::move(rec);
+  }
+
+  std::unique_lock<std::mutex> lck(mtx_);
+  for (auto& iter : loaded) {
+    if (records_.count(iter.first) == 0)
+      records_[iter.first] = std::move(iter.second);
+  }
+  path_ = path;
+  log_info << "zk commit: " << count << " commitments loaded from " << path;
+  return 0;
+}
+
+} // namespace zk
+} // namespace rosetta
@@ -112,17 +112,16 @@ int WolverineProtocol::Init(std::string logfile) {
       //   zk_ios[i] = new ZK_NET_IO(
       //     new ZKNetIO(party == ALICE ? nullptr : host.c_str(), port + i), party == ALICE);
 
-      for (int i = 0; i < THREAD_NUM + 1; ++i)
-        zk_ios[i] = new ZK_NET_IO(new ZKNetIO(net_io_, to_string(i)), party == ALICE);
-
-      // Setup
+      // Setup, or one prepared after the last session of this task
       auto start = clock_start();
       // setup_boolean_zk<ZK_NET_IO>(zk_ios, THREAD_NUM, party);
       // setup_fp_zk<ZK_NET_IO>(zk_ios, THREAD_NUM, party);
-      setup_zk_bool<ZK_NET_IO>(zk_ios, THREAD_NUM, party);
-      setup_zk_arith<ZK_NET_IO>(zk_ios, THREAD_NUM, party, true);
+      setup_ = zk::WolverineSetupPool::Instance()->Acquire(context_->TASK_ID, net_io_, party);
+      for (int i = 0; i < THREAD_NUM + 1; ++i)
+        zk_ios[i] = setup_->ios[i];
       auto timesetup = time_from(start);
       tlog_info << "time for setup: " << timesetup / 1000 << " " << party;
+      commit_store_ = std::make_shared<zk::ZkCommitStore>(party);
 
       is_inited_ = true;
       StartPerfStats();
@@ -146,8 +145,16 @@ int WolverineProtocol::Uninit() {
 
     // finalize_fp_zk();
     // finalize_boolean_zk<ZK_NET_IO>(my_party_id);
-    finalize_zk_bool<BoolIO<ZKNetIO>>();
-    finalize_zk_arith<BoolIO<ZKNetIO>>();
+    // finalizing talks to the peer, an aborted session is dropped as it is
+    if (net_io_->Aborted()) {
+      zk::WolverineSetupPool::Instance()->Abandon(setup_);
+      pool_owns_channel_ = false;
+    } else {
+      pool_owns_channel_ = zk::WolverineSetupPool::Instance()->Release(setup_);
+    }
+    setup_.reset();
+    // the values authenticated in this session go with it
+    commit_store_.reset();
     // for (int i = 0; i < (THREAD_NUM + 1); ++i) {
     //   if (zk_ios[i] != nullptr) {
     //     delete zk_ios[i];
@@ -156,10 +163,13 @@ int WolverineProtocol::Uninit() {
 
     msg_id_t msgid(context_->TASK_ID + "_this message id for synchronize P0/P1/P2 uninit");
 
-    // the following time(0) will show the sync beg/end
-    tlog_debug << __FUNCTION__ << " beg sync :" << time(0);
-    net_io_->sync_with(msgid);
-    tlog_debug << __FUNCTION__ << " end sync :" << time(0);
+    if (!net_io_->Aborted()) {
+      // the following time(0) will show the sync beg/end
+      tlog_debug << __FUNCTION__ << " beg sync :" << time(0);
+      net_io_->sync_with(msgid);
+      tlog_debug << __FUNCTION__ << " end sync :" << time(0);
+    }
+    net_io_->StopHealth();
 
     //IOManager::Instance()->DestroyIO();
     net_io_.reset();
@@ -170,9 +180,11 @@ int WolverineProtocol::Uninit() {
     is_inited_ = false;
   }
 
-  IOManager::Instance()->DestroyChannel(
-    context_
-      ->TASK_ID); // [HGF] why should we destroy channel here ? channel creation and destory should be outside
+  // a setup kept warm for the next session still runs on the channel
+  if (!pool_owns_channel_)
+    IOManager::Instance()->DestroyChannel(
+      context_
+        ->TASK_ID); // [HGF] why should we destroy channel here ? channel creation and destory should be outside
   tlog_debug << "WolverineProtocol Uninit ok.";
   return 0;
 }
@@ -181,6 +193,7 @@ shared_ptr<ProtocolOps> WolverineProtocol::GetOps(const msg_id_t& msgid) {
   auto wvr_ops_ptr = make_shared<WolverineOpsImpl>(msgid, context_);
   // wvr_ops_ptr->op_config_map["PID"] = "P" + to_string(my_party_id);
   wvr_ops_ptr->io = GetNetHandler();
+  wvr_ops_ptr->commit_store = commit_store_;
   for (int i = 0; i < THREAD_NUM; ++i) {
     wvr_ops_ptr->zk_ios[i] = zk_ios[i];
   }
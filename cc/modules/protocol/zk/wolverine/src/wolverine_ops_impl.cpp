@@ -87,6 +87,24 @@ int WolverineOpsImpl::PrivateInput(
   return 0;
 }
 
+int WolverineOpsImpl::CommittedInput(
+  const string& name,
+  const vector<double>& in_x,
+  vector<string>& out_x) {
+  tlog_debug << "calling WolverineOpsImpl::CommittedInput " << name << ENDL;
+  vector<ZkIntFp> inner_x;
+  if (!commit_store->Get(name, inner_x)) {
+    int ret = commit_store->Has(name) ? commit_store->Import(name, in_x, inner_x)
+                                      : commit_store->Commit(name, in_x, inner_x);
+    if (ret != 0) {
+      tlog_error << "committed input " << name << " is not available";
+      return ret;
+    }
+  }
+  convert_mac_to_string(inner_x, out_x);
+  return 0;
+}
+
 int WolverineOpsImpl::PublicInput(const string& node_id, const vector<double>& in_x, vector<string>& out_x){
     int p = io->GetPartyId(node_id);
     return  PublicInput(p,in_x,out_x);
@@ -0,0 +1,366 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/zk/wolverine/include/wolverine_setup_pool.h"
+#include "cc/modules/iowrapper/include/io_manager.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace rosetta {
+namespace zk {
+
+namespace {
+
+const char kStateMagic[4] = {'W', 'V', 'R', 'S'};
+const int kStateTagSize = 16;
+const int kStateIvSize = 12;
+const int kStateMacSize = 16;
+
+// AES-256-GCM of a state file, aad binds it to its task, party and Drain
+bool seal_state(
+  const std::vector<uint8_t>& key,
+  const string& aad,
+  const uint8_t* iv,
+  const std::vector<uint8_t>& in,
+  std::vector<uint8_t>& out,
+  uint8_t* mac,
+  bool encrypt) {
+  EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+  if (ctx == nullptr)
+    return false;
+  int len = 0;
+  out.resize(in.size());
+  bool ok = EVP_CipherInit_ex(ctx, EVP_aes_256_gcm(), nullptr, nullptr, nullptr, encrypt ? 1 : 0) == 1 &&
+    EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, kStateIvSize, nullptr) == 1 &&
+    EVP_CipherInit_ex(ctx, nullptr, nullptr, key.data(), iv, encrypt ? 1 : 0) == 1 &&
+    EVP_CipherUpdate(ctx, nullptr, &len, (const uint8_t*)aad.data(), aad.size()) == 1 &&
+    EVP_CipherUpdate(ctx, out.data(), &len, in.data(), in.size()) == 1;
+  if (ok && !encrypt)
+    ok = EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, kStateMacSize, mac) == 1;
+  ok = ok && EVP_CipherFinal_ex(ctx, out.data() + len, &len) == 1;
+  if (ok && encrypt)
+    ok = EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, kStateMacSize, mac) == 1;
+  EVP_CIPHER_CTX_free(ctx);
+  return ok;
+}
+
+// the Ferret COT behind the boolean triples of a setup
+FerretCOT<ZK_NET_IO>* bool_ferret(const WolverineSetup& setup) {
+  if (setup.party == ALICE)
+    return ((ZKProver<ZK_NET_IO>*)setup.prot_exec)->ostriple->ferret;
+  return ((ZKVerifier<ZK_NET_IO>*)setup.prot_exec)->ostriple->ferret;
+}
+
+} // namespace
+
+void WolverineSetupPool::SetStateStore(const string& dir, const string& secret) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  state_dir_ = dir;
+  state_key_.assign(EVP_MAX_MD_SIZE, 0);
+  unsigned int len = 0;
+  EVP_Digest(secret.data(), secret.size(), state_key_.data(), &len, EVP_sha256(), nullptr);
+  state_key_.resize(len);
+  if (!dir.empty())
+    ::mkdir(dir.c_str(), 0700);
+}
+
+string WolverineSetupPool::StatePath(const string& task_id, int party) const {
+  string name(task_id);
+  for (auto& c : name) {
+    if (c == '/' || c == '\\')
+      c = '_';
+  }
+  return state_dir_ + "/wolverine-" + name + "-" + to_string(party) + ".state";
+}
+
+// magic | tag | iv | mac | AES-256-GCM(state)
+bool WolverineSetupPool::LoadState(
+  const string& task_id,
+  int party,
+  uint8_t tag[16],
+  std::vector<uint8_t>& state) {
+  memset(tag, 0, kStateTagSize);
+  if (state_dir_.empty())
+    return false;
+  string path = StatePath(task_id, party);
+  std::ifstream ifs(path, std::ios::binary);
+  if (!ifs.is_open())
+    return false;
+  std::vector<uint8_t> file((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  ifs.close();
+  // the correlations in the file serve once, whether they are resumed or not
+  std::remove(path.c_str());
+
+  size_t header = sizeof(kStateMagic) + kStateTagSize + kStateIvSize + kStateMacSize;
+  if (file.size() <= header || memcmp(file.data(), kStateMagic, sizeof(kStateMagic)) != 0) {
+    log_warn << "wolverine state of task " << task_id << " is malformed, ignored";
+    return false;
+  }
+  const uint8_t* file_tag = file.data() + sizeof(kStateMagic);
+  const uint8_t* iv = file_tag + kStateTagSize;
+  uint8_t mac[kStateMacSize];
+  memcpy(mac, iv + kStateIvSize, kStateMacSize);
+  std::vector<uint8_t> sealed(file.begin() + header, file.end());
+  string aad = task_id + "/" + to_string(party) + "/" + string((const char*)file_tag, kStateTagSize);
+  if (!seal_state(state_key_, aad, iv, sealed, state, mac, false)) {
+    log_warn << "wolverine state of task " << task_id << " does not authenticate, ignored";
+    return false;
+  }
+  memcpy(tag, file_tag, kStateTagSize);
+  return true;
+}
+
+bool WolverineSetupPool::SaveState(
+  const string& task_id,
+  int party,
+  const uint8_t tag[16],
+  const std::vector<uint8_t>& state) {
+  uint8_t iv[kStateIvSize];
+  uint8_t mac[kStateMacSize];
+  std::vector<uint8_t> sealed;
+  string aad = task_id + "/" + to_string(party) + "/" + string((const char*)tag, kStateTagSize);
+  if (RAND_bytes(iv, kStateIvSize) != 1 || !seal_state(state_key_, aad, iv, state, sealed, mac, true))
+    return false;
+
+  // written aside and renamed, so a reader never sees half a file
+  string path = StatePath(task_id, party);
+  string tmp = path + ".tmp";
+  {
+    std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open())
+      return false;
+    ::chmod(tmp.c_str(), 0600);
+    ofs.write(kStateMagic, sizeof(kStateMagic));
+    ofs.write((const char*)tag, kStateTagSize);
+    ofs.write((const char*)iv, kStateIvSize);
+    ofs.write((const char*)mac, kStateMacSize);
+    ofs.write((const char*)sealed.data(), sealed.size());
+    if (!ofs.good())
+      return false;
+  }
+  return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+shared_ptr<WolverineSetup> WolverineSetupPool::Setup(
+  const string& task_id,
+  shared_ptr<NET_IO> net_io,
+  int party) {
+  auto setup = std::make_shared<WolverineSetup>();
+  setup->task_id = task_id;
+  setup->net_io = net_io;
+  setup->party = party;
+  for (int i = 0; i < THREAD_NUM + 1; ++i)
+    setup->ios[i] = new ZK_NET_IO(new ZKNetIO(net_io, to_string(i)), party == ALICE);
+
+  // both parties resume from the state of the same Drain, or neither does
+  std::vector<uint8_t> state;
+  uint8_t tag[kStateTagSize], peer_tag[kStateTagSize];
+  bool stored = LoadState(task_id, party, tag, state);
+  ZK_NET_IO* io = setup->ios[0];
+  if (party == ALICE) {
+    io->send_data(tag, kStateTagSize);
+    io->flush();
+    io->recv_data(peer_tag, kStateTagSize);
+  } else {
+    io->recv_data(peer_tag, kStateTagSize);
+    io->send_data(tag, kStateTagSize);
+    io->flush();
+  }
+  bool resume = stored && memcmp(tag, peer_tag, kStateTagSize) == 0;
+
+  auto start = clock_start();
+  setup_zk_bool<ZK_NET_IO>(setup->ios, THREAD_NUM, party, resume ? state.data() : nullptr);
+  setup_zk_arith<ZK_NET_IO>(setup->ios, THREAD_NUM, party, true);
+  setup->circ_exec = CircuitExecution::circ_exec;
+  setup->prot_exec = ProtocolExecution::prot_exec;
+  setup->zk_exec = ZKFpExec::zk_exec;
+  log_info << "wolverine setup of task " << task_id << (resume ? " (resumed from the store)" : "")
+           << ": " << time_from(start) / 1000 << " ms";
+  return setup;
+}
+
+void WolverineSetupPool::Finalize(shared_ptr<WolverineSetup> setup) {
+  Install(*setup);
+  finalize_zk_bool<ZK_NET_IO>();
+  finalize_zk_arith<ZK_NET_IO>();
+  setup->circ_exec = nullptr;
+  setup->prot_exec = nullptr;
+  setup->zk_exec = nullptr;
+  Park();
+}
+
+void WolverineSetupPool::Park() {
+  CircuitExecution::circ_exec = nullptr;
+  ProtocolExecution::prot_exec = nullptr;
+  ZKFpExec::zk_exec = nullptr;
+}
+
+void WolverineSetupPool::Install(const WolverineSetup& setup) {
+  CircuitExecution::circ_exec = setup.circ_exec;
+  ProtocolExecution::prot_exec = setup.prot_exec;
+  ZKFpExec::zk_exec = setup.zk_exec;
+}
+
+void WolverineSetupPool::Persist(const WolverineSetup& setup) {
+  // ALICE draws the tag of this Drain, the resumed setups must come from the same one
+  uint8_t tag[kStateTagSize];
+  ZK_NET_IO* io = setup.ios[0];
+  if (setup.party == ALICE) {
+    PRG prg;
+    prg.random_data(tag, kStateTagSize);
+    io->send_data(tag, kStateTagSize);
+    io->flush();
+  } else {
+    io->recv_data(tag, kStateTagSize);
+  }
+
+  FerretCOT<ZK_NET_IO>* ferret = bool_ferret(setup);
+  std::vector<uint8_t> state(ferret->state_size());
+  ferret->assemble_state(state.data(), state.size());
+  if (SaveState(setup.task_id, setup.party, tag, state))
+    log_info << "wolverine state of task " << setup.task_id << " stored, " << state.size() << " bytes";
+  else
+    log_error << "wolverine state of task " << setup.task_id << " could not be stored in " << state_dir_;
+}
+
+void WolverineSetupPool::TakeGlobals(std::unique_lock<std::mutex>& lck) {
+  globals_cv_.wait(lck, [this]() { return !globals_busy_; });
+  globals_busy_ = true;
+}
+
+void WolverineSetupPool::GiveGlobals() {
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    globals_busy_ = false;
+  }
+  globals_cv_.notify_all();
+}
+
+shared_ptr<WolverineSetup> WolverineSetupPool::Acquire(
+  const string& task_id,
+  shared_ptr<NET_IO> net_io,
+  int party) {
+  auto start = clock_start();
+  std::thread worker;
+  shared_ptr<WolverineSetup> setup = nullptr;
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    // a setup being prepared holds the globals until it is parked
+    TakeGlobals(lck);
+    auto iter = preparing_.find(task_id);
+    if (iter != preparing_.end()) {
+      worker = std::move(iter->second);
+      preparing_.erase(iter);
+    }
+    auto parked = parked_.find(task_id);
+    if (parked != parked_.end()) {
+      setup = parked->second;
+      parked_.erase(parked);
+    }
+  }
+  if (worker.joinable())
+    worker.join();
+
+  if (setup != nullptr) {
+    Install(*setup);
+    log_info << "wolverine task " << task_id << " takes a prepared setup, waited "
+             << time_from(start) / 1000 << " ms";
+    return setup;
+  }
+  try {
+    return Setup(task_id, net_io, party);
+  } catch (...) {
+    Park();
+    GiveGlobals();
+    throw;
+  }
+}
+
+bool WolverineSetupPool::Release(shared_ptr<WolverineSetup> setup) {
+  Finalize(setup);
+  if (!keep_warm_) {
+    GiveGlobals();
+    return false;
+  }
+
+  // the next session of this task runs on a setup made in the idle time,
+  // the globals pass to it and come back once it is parked
+  string task_id = setup->task_id;
+  shared_ptr<NET_IO> net_io = setup->net_io;
+  int party = setup->party;
+  std::unique_lock<std::mutex> lck(mtx_);
+  preparing_[task_id] = std::thread([this, task_id, net_io, party]() {
+    shared_ptr<WolverineSetup> next = nullptr;
+    try {
+      next = Setup(task_id, net_io, party);
+    } catch (const std::exception& e) {
+      log_error << "wolverine setup of task " << task_id << " failed: " << e.what();
+    }
+    Park();
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      if (next != nullptr)
+        parked_[task_id] = next;
+      globals_busy_ = false;
+    }
+    globals_cv_.notify_all();
+  });
+  return true;
+}
+
+void WolverineSetupPool::Abandon(shared_ptr<WolverineSetup> setup) {
+  // finalizing needs the peer, the emp-zk objects of the session are left as they are
+  log_warn << "wolverine setup of task " << setup->task_id << " abandoned, not finalized";
+  Park();
+  GiveGlobals();
+}
+
+void WolverineSetupPool::Drain() {
+  std::map<string, std::thread> preparing;
+  std::map<string, shared_ptr<WolverineSetup>> parked;
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    TakeGlobals(lck);
+    preparing.swap(preparing_);
+    parked.swap(parked_);
+  }
+  for (auto& iter : preparing)
+    iter.second.join();
+
+  for (auto& iter : parked) {
+    if (!state_dir_.empty()) {
+      // never used, so its reserved correlations are fresh; finalizing it would extend them
+      Persist(*iter.second);
+    } else {
+      Finalize(iter.second);
+    }
+    IOManager::Instance()->DestroyChannel(iter.first);
+  }
+  GiveGlobals();
+  log_info << "wolverine setup pool drained, " << parked.size() << " prepared setups "
+           << (state_dir_.empty() ? "finalized" : "stored");
+}
+
+} // namespace zk
+} // namespace rosetta
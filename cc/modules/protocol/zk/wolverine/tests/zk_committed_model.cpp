@@ -0,0 +1,155 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/utility/include/_test_common.h"
+#include "cc/modules/protocol/zk/wolverine/include/wolverine_impl.h"
+#include "cc/modules/protocol/zk/wolverine/include/wolverine_ops_impl.h"
+#include "cc/modules/iowrapper/include/io_manager.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <chrono>
+#include <random>
+
+using namespace rosetta;
+
+/**
+ * Proofs of many inference queries against one committed model.
+ *
+ * The prover (P0) proves y = x * w for its queries x, first with the weights
+ * given by PrivateInput to every query, then committed once by CommittedInput,
+ * and prints the time per query of both. The commitments are saved, and two
+ * later sessions load the same file, import them and prove one more query.
+ * Each import uses the next mask, also when the file is not saved in between.
+ *
+ * usage: protocol_zkp_wolverine_tests_zk_committed_model
+ */
+
+namespace {
+
+const int kFeatures = 64;
+const int kQueries = 200;
+const int kBasePort = 14220;
+
+string two_party_config() {
+  stringstream ss;
+  ss << "{\n  \"NODE_INFO\": [\n";
+  for (int i = 0; i < 2; i++) {
+    ss << "    {\"NAME\": \"Party" << i << "\", \"HOST\": \"127.0.0.1\", \"PORT\": " << kBasePort + i
+       << ", \"NODE_ID\": \"P" << i << "\"}" << (i == 0 ? ",\n" : "\n");
+  }
+  ss << "  ],\n  \"DATA_NODES\": [\"P0\", \"P1\"],\n  \"COMPUTATION_NODES\": {\"P0\": 0, \"P1\": 1},\n"
+     << "  \"RESULT_NODES\": [\"P0\", \"P1\"]\n}\n";
+  return ss.str();
+}
+
+double seconds_since(std::chrono::steady_clock::time_point beg) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+}
+
+WolverineProtocol* start(int partyid, const string& logfile) {
+  IOManager::Instance()->CreateChannel("", "P" + to_string(partyid), two_party_config());
+  WolverineProtocol* proto = new WolverineProtocol();
+  proto->Init(logfile + "-console.log");
+  return proto;
+}
+
+// proves y = x * w and counts the answers that differ from the plaintext
+int prove_query(
+  shared_ptr<ProtocolOps> ops,
+  const vector<string>& sw,
+  const vector<double>& w,
+  std::mt19937_64& rng) {
+  std::uniform_real_distribution<double> uniform(-1, 1);
+  vector<double> x(kFeatures);
+  double want = 0;
+  for (int j = 0; j < kFeatures; j++) {
+    x[j] = uniform(rng);
+    want += x[j] * w[j];
+  }
+  attr_type mm_attr;
+  mm_attr["m"] = "1";
+  mm_attr["k"] = to_string(kFeatures);
+  mm_attr["n"] = "1";
+  vector<string> sx, sy;
+  vector<double> y;
+  ops->PrivateInput("P0", x, sx);
+  ops->Matmul(sx, sw, sy, &mm_attr);
+  ops->Reveal(sy, y);
+  return std::abs(y[0] - want) > 0.01;
+}
+
+} // namespace
+
+static void run(int partyid) {
+  string logfile = "log/zk_committed_model-" + to_string(partyid);
+  Logger::Get().log_to_stdout(false);
+  Logger::Get().set_filename(logfile + "-backend.log");
+  string store_file = "data/zk_committed_model-" + to_string(partyid) + ".bin";
+
+  // both parties draw the same model and queries, only the prover's count
+  std::mt19937_64 rng(20210301);
+  std::normal_distribution<double> normal(0, 0.3);
+  vector<double> w(kFeatures);
+  for (auto& v : w)
+    v = normal(rng);
+
+  WolverineProtocol* proto = start(partyid, logfile);
+  auto ops = proto->GetOps(msg_id_t("zk committed model"));
+  auto wvr_ops = std::dynamic_pointer_cast<WolverineOpsImpl>(ops);
+
+  int errors = 0;
+  auto beg = std::chrono::steady_clock::now();
+  for (int q = 0; q < kQueries; q++) {
+    vector<string> sw;
+    ops->PrivateInput("P0", w, sw);
+    errors += prove_query(ops, sw, w, rng);
+  }
+  double fresh_s = seconds_since(beg);
+
+  beg = std::chrono::steady_clock::now();
+  for (int q = 0; q < kQueries; q++) {
+    vector<string> sw;
+    wvr_ops->CommittedInput("model", w, sw);
+    errors += prove_query(ops, sw, w, rng);
+  }
+  double committed_s = seconds_since(beg);
+  proto->GetCommitStore()->Save(store_file);
+  proto->Uninit();
+  delete proto;
+
+  // later sessions prove against the same commitment, each import takes the next mask
+  for (uint64_t session = 1; session <= 2; session++) {
+    proto = start(partyid, logfile);
+    ops = proto->GetOps(msg_id_t("zk committed model, session " + to_string(session)));
+    wvr_ops = std::dynamic_pointer_cast<WolverineOpsImpl>(ops);
+    proto->GetCommitStore()->Load(store_file);
+    vector<string> sw;
+    int ret = wvr_ops->CommittedInput("model", w, sw);
+    errors += ret != 0 || prove_query(ops, sw, w, rng);
+    errors += proto->GetCommitStore()->MasksUsed("model") != session;
+    proto->Uninit();
+    delete proto;
+  }
+
+  if (partyid == 0) {
+    cout << "zk committed model, " << kQueries << " queries of " << kFeatures
+         << " features, per query: " << fresh_s * 1000 / kQueries << " ms with the model input each time, "
+         << committed_s * 1000 / kQueries << " ms committed once, errors: " << errors << endl;
+  }
+}
+
+RUN_ZK_TEST(run);
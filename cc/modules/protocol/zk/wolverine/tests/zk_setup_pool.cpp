@@ -0,0 +1,110 @@
+// ==============================================================================
+// Copyright 2020 The LatticeX Foundation
+// This file is part of the Rosetta library.
+//
+// The Rosetta library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// The Rosetta library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+// ==============================================================================
+#include "cc/modules/protocol/utility/include/_test_common.h"
+#include "cc/modules/protocol/zk/wolverine/include/wolverine_impl.h"
+#include "cc/modules/protocol/zk/wolverine/include/wolverine_setup_pool.h"
+#include "cc/modules/iowrapper/include/io_manager.h"
+#include "cc/modules/common/include/utils/rtt_logger.h"
+
+#include <chrono>
+
+using namespace rosetta;
+
+/**
+ * Short proving tasks with and without a warm setup.
+ *
+ * Each task opens a session, proves one product and closes it, then the parties
+ * idle a while, as a service between requests. The tasks run first with the
+ * setup made at each Init, then with the setup kept warm by the pool. Drain then
+ * stores the last prepared setup, and one more task resumes from it as a new
+ * process would. P0 prints the mean Init time of each run.
+ *
+ * usage: protocol_zkp_wolverine_tests_zk_setup_pool
+ */
+
+namespace {
+
+const int kTasks = 5;
+const int kIdleMs = 3000;
+const int kBasePort = 14230;
+const char* kStateDir = "./data/zk_setup_pool";
+
+string two_party_config() {
+  stringstream ss;
+  ss << "{\n  \"NODE_INFO\": [\n";
+  for (int i = 0; i < 2; i++) {
+    ss << "    {\"NAME\": \"Party" << i << "\", \"HOST\": \"127.0.0.1\", \"PORT\": " << kBasePort + i
+       << ", \"NODE_ID\": \"P" << i << "\"}" << (i == 0 ? ",\n" : "\n");
+  }
+  ss << "  ],\n  \"DATA_NODES\": [\"P0\", \"P1\"],\n  \"COMPUTATION_NODES\": {\"P0\": 0, \"P1\": 1},\n"
+     << "  \"RESULT_NODES\": [\"P0\", \"P1\"]\n}\n";
+  return ss.str();
+}
+
+// the mean time of Init over short tasks, in milliseconds
+double run_tasks(int partyid, const string& logfile, int tasks, int& errors) {
+  double init_ms = 0;
+  for (int t = 0; t < tasks; t++) {
+    IOManager::Instance()->CreateChannel("", "P" + to_string(partyid), two_party_config());
+    WolverineProtocol* proto = new WolverineProtocol();
+    auto beg = std::chrono::steady_clock::now();
+    proto->Init(logfile + "-console.log");
+    init_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - beg).count();
+
+    auto ops = proto->GetOps(msg_id_t("zk setup pool task"));
+    vector<string> sx, sy, sz;
+    vector<double> z;
+    ops->PrivateInput("P0", {1.5, -2}, sx);
+    ops->PrivateInput("P0", {2, 3}, sy);
+    ops->Mul(sx, sy, sz);
+    ops->Reveal(sz, z);
+    errors += std::abs(z[0] - 3) > 0.01 || std::abs(z[1] + 6) > 0.01;
+
+    proto->Uninit();
+    delete proto;
+    std::this_thread::sleep_for(std::chrono::milliseconds(kIdleMs));
+  }
+  return init_ms / tasks;
+}
+
+} // namespace
+
+static void run(int partyid) {
+  string logfile = "log/zk_setup_pool-" + to_string(partyid);
+  Logger::Get().log_to_stdout(false);
+  Logger::Get().set_filename(logfile + "-backend.log");
+
+  int errors = 0;
+  auto pool = zk::WolverineSetupPool::Instance();
+  double cold_ms = run_tasks(partyid, logfile, kTasks, errors);
+  pool->SetKeepWarm(true);
+  double warm_ms = run_tasks(partyid, logfile, kTasks, errors);
+  pool->SetStateStore(kStateDir, "zk setup pool test secret");
+  pool->Drain();
+  pool->SetKeepWarm(false);
+  double resumed_ms = run_tasks(partyid, logfile, 1, errors);
+  pool->SetStateStore("", "");
+
+  if (partyid == 0) {
+    cout << "zk setup pool, " << kTasks << " tasks, mean Init: " << cold_ms << " ms cold, "
+         << warm_ms << " ms warm (the first one is cold), " << resumed_ms
+         << " ms resumed from the store, errors: " << errors << endl;
+  }
+}
+
+RUN_ZK_TEST(run);
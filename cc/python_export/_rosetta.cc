@@ -116,7 +116,8 @@ PYBIND11_MODULE(_rosetta, m) {
   py::module m_msgid_handle = m.def_submodule("msgid_handle");
   py::class_<MsgIdHandle>(m_msgid_handle, "MsgIdHandle")
     .def(py::init<>())
-    .def("update_message_id_info", &MsgIdHandle::update_message_id_info);
+    .def("update_message_id_info", &MsgIdHandle::update_message_id_info)
+    .def("update_message_id_table", &MsgIdHandle::update_message_id_table);
 
   //py::module m_netutil = m.def_submodule("netutil");
   //m_netutil.def("enable_ssl_socket",    &netutil::enable_ssl_socket, "");
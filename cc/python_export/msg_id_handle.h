@@ -37,4 +37,9 @@ class MsgIdHandle {
     if (!rosetta::MsgIdMgr::Instance()->UpdateMsgIdInfo(msgid_infos))
       cerr << "update message id info failure." << std::endl;
   }
+
+  void update_message_id_table(const py::bytes& table) {
+    if (!rosetta::MsgIdMgr::Instance()->UpdateMsgIdTable(std::string(table)))
+      cerr << "update message id table failure." << std::endl;
+  }
 };
@@ -31,6 +31,7 @@ using namespace std;
 #include "cc/modules/protocol/public/include/protocol_manager.h"
 #include "cc/modules/protocol/public/include/protocol_ops.h"
 #include "cc/modules/common/include/utils/rtt_logger.h"
+#include "cc/modules/common/include/utils/rtt_async_logger.h"
 #include "cc/modules/common/include/utils/rtt_exceptions.h"
 
 
@@ -167,7 +168,7 @@ class ProtocolHandler {
   void set_logfile(const std::string& logfile, const std::string& task_id="") { Logger::Get().set_filename(logfile, task_id); }
   void set_logpattern(const std::string& pattern) { Logger::Get().set_pattern(pattern);}
   // Note: LogLevel \in { Trace, Debug, Audit, Info, Warn, Error, Fatal, off };
-  void set_loglevel(int loglevel) { Logger::Get().set_level((int)loglevel % 7); }
+  void set_loglevel(int loglevel) { rosetta::set_log_level((int)loglevel % 7); }
 
   // stats
   void start_perf_stats(const string& task_id) {
@@ -116,9 +116,16 @@ class SecureOpKernel : public OpKernel {
  protected:
   int verbose_ = 1;
   string op_;
+  // the node name in the graph, the key of its message id in the table
+  string graph_name_;
+  // graph_name_ qualified by the task
   string op_name_;
   msg_id_t msg_id_;
   unordered_map<string, string> attrs_;
+  // the task of the session, fixed for the life of the kernel
+  string task_id_;
+  // the version of the message id table msg_id_ was resolved against
+  uint64_t msg_id_version_ = 0;
 
  public:
   explicit SecureOpKernel(OpKernelConstruction* context) : OpKernel(context) {
@@ -147,10 +154,8 @@ class SecureOpKernel : public OpKernel {
     }
 #endif
     
-    string task_id = ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation());
-    op_name_ = def.name() + "#T" + task_id;//def.name();
-    msg_id_ = msg_id_t(def.name() + "#T" + task_id);
-    log_debug << "SecureOpKernel msgid:" << msg_id();
+    task_id_ = ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation());
+    graph_name_ = def.name();
 
     //-----------------------------------------------
     //Deal with PrivateInput op in decode function
@@ -160,23 +165,28 @@ class SecureOpKernel : public OpKernel {
       if (func_def) {
         std::vector<string> func_name_lists = func_def->ListFunctionNames();
         if (func_name_lists.size() == 1 && !strcmp(def.name().c_str(), "PrivateInput")) {
-          string op_unique_name = func_name_lists[0] + "/" + def.name()+ "#T" + task_id;
-          msg_id_ = msg_id_t(op_unique_name);
-          op_name_ = op_unique_name;
-          log_debug << "New SecureOpKernel msgid:" << msg_id();
+          graph_name_ = func_name_lists[0] + "/" + def.name();
         }
       }
     }
     //-----------------------------------------------
+    op_name_ = MsgIdMgr::TaskOpName(graph_name_, task_id_);
+    resolve_msg_id();
+  }
+
+  // takes the message id of this op from the table of the graph, precomputed for both
+  // the SHA256 and the index ids, else derives it from op_name_
+  void resolve_msg_id() {
+    msg_id_version_ = MsgIdMgr::Instance()->TableVersion();
+    MsgIdMgr::Instance()->ResolveMsgId(graph_name_, task_id_, msg_id_);
+    log_debug << "SecureOpKernel msgid:" << msg_id();
   }
+
   void Compute(OpKernelContext* context) override {
-#if !USE_SHA256_ID
-    msg_id_t& iid = MsgIdMgr::Instance()->GetMsgIdFromOpName(op_name_);
-    if (!iid.str().empty()) {
-      msg_id_ = iid;
+    // the table is only looked at again when the graph is regenerated
+    if (msg_id_version_ != MsgIdMgr::Instance()->TableVersion()) {
+      resolve_msg_id();
     }
-    log_debug << "SecureOpKernel Compute msgid:" << msg_id();
-#endif
 
     SECURE_OP_KERNEL_BASE_CLASS_COMPUTE_STATS_BEG(op_);
     DEBUG_PRINT_BEFORE(context);
@@ -201,7 +211,7 @@ class SecureOpKernel : public OpKernel {
     return false;
   }
   bool is_public_or_constant_input_by_restore_model(OpKernelContext* context) {
-    string task_id = ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation());
+    const string& task_id = task_id_;
     int parties = ProtocolManager::Instance()->GetProtocol(task_id) ->GetParties();
     auto proto_context = ProtocolManager::Instance()->GetProtocol(task_id)->GetMpcContext();
 #ifndef ENABLE_ZK_TASK
@@ -269,7 +279,7 @@ class SecureOpKernel : public OpKernel {
     }
     if (vs.size() > 0) {
       auto ops = ProtocolManager::Instance()
-                  ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+                  ->GetProtocol(task_id_)
                   ->GetOps(msg_id());
       ops->Reveal(vs, vd);
       print_vector(vd, prefix + " index " + to_string(j), 5, 8);
@@ -339,7 +349,7 @@ class SecureOpKernel : public OpKernel {
     attrs_["receive_parties"] = recv_nodes;
     // attrs_["receive_party"] = string("1");
     rosetta::ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Reveal(in, outs, &attrs_);
     print_vec(outs);
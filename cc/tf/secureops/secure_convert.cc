@@ -80,7 +80,7 @@ class TfToSecureOp : public SecureOpKernel {
     // attrs_["is_const"] = isconst;
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(TfToSecure);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->TfToSecure(inputs, outputs, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(TfToSecure);
@@ -136,7 +136,7 @@ class TfToSecureOp<string> : public SecureOpKernel {
     // attrs_["is_const"] = isconst;
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(TfToSecure);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->TfToSecure(inputs, outputs, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(TfToSecure);
@@ -180,7 +180,7 @@ class SecureToTfOp : public SecureOpKernel {
     // convert from protocol type hex string to native double string
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(SecureToTf);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->SecureToTf(inputs, outputs);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(SecureToTf);
@@ -220,7 +220,7 @@ class SecureToTfOp<string> : public SecureOpKernel {
     // convert from protocol type hex string to native double string
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(SecureToTf);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->SecureToTf(inputs, outputs);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(SecureToTf);
@@ -261,7 +261,7 @@ class PrivateInputOp : public SecureOpKernel {
     const auto& data_owner_flat = data_owner->flat<string>();
     data_owner_ = data_owner_flat(0);
 
-    string task_id = ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation());
+    const string& task_id = task_id_;
     shared_ptr<NET_IO> netio = ProtocolManager::Instance()->GetProtocol(task_id)->GetNetHandler();
     const vector<string>& party2nodes = netio->GetParty2Node();
     const vector<string>& result_nodes = netio->GetResultNodes();
@@ -273,7 +273,7 @@ class PrivateInputOp : public SecureOpKernel {
     vector<string> outputs(input_flat.size());
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(PrivateInput);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->PrivateInput(data_owner_, inputs, outputs);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(PrivateInput);
@@ -317,7 +317,7 @@ class PrivateInputOp<string> : public SecureOpKernel {
     const auto& data_owner_flat = data_owner->flat<string>();
     data_owner_ = data_owner_flat(0);
 
-    string task_id = ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation());
+    const string& task_id = task_id_;
     shared_ptr<NET_IO> netio = ProtocolManager::Instance()->GetProtocol(task_id)->GetNetHandler();
     const vector<string>& party2nodes = netio->GetParty2Node();
     const vector<string>& result_nodes = netio->GetResultNodes();
@@ -330,7 +330,7 @@ class PrivateInputOp<string> : public SecureOpKernel {
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(PrivateInput);
     // log_info << "private input:" << data_owner_ << "data owner:" << data_owner_ << " size:" << inputs.size();
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->PrivateInput(data_owner_, inputs, outputs);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(PrivateInput);
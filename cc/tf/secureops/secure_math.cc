@@ -35,7 +35,7 @@ class SecureAddOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> Add OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Add);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Add(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Add);
@@ -55,7 +55,7 @@ class SecureSubOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> Sub OpKernel compute." ;
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Sub);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Sub(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Sub);
@@ -75,7 +75,7 @@ class SecureMulOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> Mul OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Mul);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Mul(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Mul);
@@ -95,7 +95,7 @@ class SecureLessOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> Less OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Less);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Less(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Less);
@@ -115,7 +115,7 @@ class SecureLessEqualOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> LessEqual OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(LessEqual);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->LessEqual(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(LessEqual);
@@ -135,7 +135,7 @@ class SecureEqualOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> Equal OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Equal);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Equal(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Equal);
@@ -155,7 +155,7 @@ class SecureNotEqualOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> NotEqual OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(NotEqual);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->NotEqual(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(NotEqual);
@@ -175,7 +175,7 @@ class SecureGreaterOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> Greater OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Greater);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Greater(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Greater);
@@ -195,7 +195,7 @@ class SecureGreaterEqualOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> GreaterEqual OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(GreaterEqual);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->GreaterEqual(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(GreaterEqual);
@@ -215,7 +215,7 @@ class SecureDivOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> Div OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Div);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Div(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Div);
@@ -235,7 +235,7 @@ class SecureReciprocaldivOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> Reciprocaldiv OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Reciprocaldiv);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Reciprocaldiv(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Reciprocaldiv);
@@ -255,7 +255,7 @@ class SecureTruedivOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> Truediv OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Truediv);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Truediv(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Truediv);
@@ -275,7 +275,7 @@ class SecureFloordivOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> Floordiv OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Floordiv);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Floordiv(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Floordiv);
@@ -296,7 +296,7 @@ class SecureRealdivOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> Realdiv OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Div);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Div(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Div);
@@ -323,7 +323,7 @@ class SecurePowOp : public SecureBinaryOp<BinaryOpState> {
     log_debug << "--> Pow OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Pow);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Pow(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Pow);
@@ -413,7 +413,7 @@ class SecureMatmulOp : public SecureOpKernel {
     vector<string> outstr(m * n);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Matmul);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Matmul(in1, in2, outstr, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Matmul);
@@ -451,7 +451,7 @@ class SecureSquareOp : public SecureUnaryOp {
     log_debug << "--> Square OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Square);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Square(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Square);
@@ -471,7 +471,7 @@ class SecureNegativeOp : public SecureUnaryOp {
     log_debug << "--> Negative OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Negative);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Negative(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Negative);
@@ -491,7 +491,7 @@ class SecureReduceMeanOp : public SecureReduceOp {
     log_debug << "--> ReduceMean OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Mean);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Mean(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Mean);
@@ -511,7 +511,7 @@ class SecureReduceSumOp : public SecureReduceOp {
     log_debug << "--> ReduceSum OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Sum);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Sum(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Sum);
@@ -531,7 +531,7 @@ class SecureReduceMinOp : public SecureReduceOp {
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Min);
     log_debug << "--> ReduceMin OpKernel compute.";
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Min(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Min);
@@ -552,7 +552,7 @@ class SecureReduceMaxOp : public SecureReduceOp {
     log_debug << "--> ReduceMax OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Max);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Max(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Max);
@@ -585,7 +585,7 @@ class SecureExpOp : public SecureUnaryOp {
     log_debug << "--> Exp OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Exp);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Exp(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Exp);
@@ -605,7 +605,7 @@ class SecureRsqrtOp : public SecureUnaryOp {
     log_debug << "--> Rsqrt OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Rsqrt);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Rsqrt(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Rsqrt);
@@ -625,7 +625,7 @@ class SecureSqrtOp : public SecureUnaryOp {
     log_debug << "--> Sqrt OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Sqrt);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Sqrt(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Sqrt);
@@ -645,7 +645,7 @@ class SecureAbsOp : public SecureUnaryOp {
     log_debug << "--> Abs OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Abs);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Abs(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Abs);
@@ -665,7 +665,7 @@ class SecureAbsPrimeOp : public SecureUnaryOp {
     log_debug << "--> AbsPrime OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(AbsPrime);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->AbsPrime(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(AbsPrime);
@@ -685,7 +685,7 @@ class SecureLogOp : public SecureUnaryOp {
     log_debug << "--> Log OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Log);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Log(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Log);
@@ -705,7 +705,7 @@ class SecureHLogOp : public SecureUnaryOp {
     log_debug << "--> HLog OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(HLog);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->HLog(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(HLog);
@@ -725,7 +725,7 @@ class SecureLog1pOp : public SecureUnaryOp {
     log_debug << "--> Log1p OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Log1p);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Log1p(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Log1p);
@@ -776,7 +776,7 @@ class SecureAddNOp : public SecureOpKernel {
     vector<string> output(size);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(AddN);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->AddN(inputs, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(AddN);
@@ -809,7 +809,7 @@ class SecureRevealOp : public SecureUnaryOp {
     attrs_["receive_parties"] = receive_parties_;
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Reveal);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Reveal(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Reveal);
@@ -827,7 +827,7 @@ class SecureLogicalAndOp : public SecureBinaryOp<BinaryOpState> {
   int BinaryCompute(const vector<string>& in1, const vector<string>& in2, vector<string>& output, OpKernelContext* context) {
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(AND);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->AND(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(AND);
@@ -843,7 +843,7 @@ class SecureLogicalOrOp : public SecureBinaryOp<BinaryOpState> {
   int BinaryCompute(const vector<string>& in1, const vector<string>& in2, vector<string>& output, OpKernelContext* context) {
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(OR);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->OR(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(OR);
@@ -859,7 +859,7 @@ class SecureLogicalXorOp : public SecureBinaryOp<BinaryOpState> {
   int BinaryCompute(const vector<string>& in1, const vector<string>& in2, vector<string>& output, OpKernelContext* context) {
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(XOR);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->XOR(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(XOR);
@@ -875,7 +875,7 @@ class SecureLogicalNotOp : public SecureUnaryOp {
   int UnaryCompute(const vector<string>& input, vector<string>& output, OpKernelContext* context) {
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(NOT);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->NOT(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(NOT);
@@ -565,7 +565,7 @@ class SecureSaveV2Op : public SecureOpKernel {
       }
       SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(ConditionalReveal);
       ProtocolManager::Instance()
-        ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+        ->GetProtocol(task_id_)
         ->GetOps(msg_id())
         ->ConditionalReveal(input_tensor_vec, potential_cipher_res, potential_plain_res);
       SECURE_OP_CALL_PROTOCOL_OP_STATS_END(ConditionalReveal);
@@ -676,13 +676,13 @@ class SecureRestoreV2Op : public SecureOpKernel {
   void ComputeImpl(OpKernelContext* context) {
     SimpleTimer timer;
     int parties = ProtocolManager::Instance()
-                    ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+                    ->GetProtocol(task_id_)
                     ->GetParties();
     node_id_ = ProtocolManager::Instance()
-                  ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+                  ->GetProtocol(task_id_)
                   ->GetNetHandler()->GetCurrentNodeId();
     restore_model_ = ProtocolManager::Instance()
-                  ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+                  ->GetProtocol(task_id_)
                   ->GetMpcContext()->RESTORE_MODEL;
     int restore_party_id = -1;
     bool is_public_model = false;
@@ -691,7 +691,7 @@ class SecureRestoreV2Op : public SecureOpKernel {
 
     // party id start 0
     std::string restore_desc = "unsupported restore_model";
-    auto prtc = ProtocolManager::Instance()->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()));
+    auto prtc = ProtocolManager::Instance()->GetProtocol(task_id_);
     vector<string> data_nodes = prtc->GetNetHandler()->GetDataNodes();
     map<string, int> computation_nodes = prtc->GetNetHandler()->GetComputationNodes(); 
     if (restore_model_.is_local_ciphertext_mode()) {
@@ -805,7 +805,7 @@ class SecureRestoreV2Op : public SecureOpKernel {
     } else if (restore_model_.is_ciphertext_mode()) {
       const map<string, string>& ciphertext_nodes = restore_model_.get_ciphertext_nodes();
       auto protocol = ProtocolManager::Instance()
-                ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()));
+                ->GetProtocol(task_id_);
       auto ops = protocol->GetOps(msg_id());
       shared_ptr<NET_IO> net_io = protocol->GetNetHandler();
       const map<string, int> computation_nodes = net_io->GetComputationNodes();
@@ -968,7 +968,7 @@ class SecureRestoreV2Op : public SecureOpKernel {
     }
     const string& plaintext_node = restore_model_.get_plaintext_node();
     auto protocol = ProtocolManager::Instance()
-                ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()));
+                ->GetProtocol(task_id_);
     auto ops = protocol->GetOps(msg_id());
     shared_ptr<NET_IO> net_io = protocol->GetNetHandler();
     if (node_id_ == plaintext_node) {
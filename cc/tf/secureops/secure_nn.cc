@@ -47,7 +47,7 @@ class SecureSigmoidOp : public SecureUnaryOp {
     output.resize(input.size());
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Sigmoid);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Sigmoid(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Sigmoid);
@@ -56,6 +56,265 @@ class SecureSigmoidOp : public SecureUnaryOp {
   }
 };
 
+class SecureTanhOp : public SecureUnaryOp {
+ public:
+  SecureTanhOp(OpKernelConstruction* context) : SecureUnaryOp(context) {}
+  ~SecureTanhOp() {}
+
+  int UnaryCompute(const vector<string>& input, vector<string>& output, OpKernelContext* context) {
+    log_debug << "--> Tanh OpKernel compute.";
+    output.resize(input.size());
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Tanh);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->Tanh(input, output, &attrs_);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Tanh);
+    log_debug << "Tanh OpKernel compute ok. <--";
+    return 0;
+  }
+};
+
+class SecureTanhGradOp : public SecureUnaryOp {
+ public:
+  SecureTanhGradOp(OpKernelConstruction* context) : SecureUnaryOp(context) {}
+  ~SecureTanhGradOp() {}
+
+  int UnaryCompute(const vector<string>& input, vector<string>& output, OpKernelContext* context) {
+    log_debug << "--> TanhGrad OpKernel compute.";
+    output.resize(input.size());
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(TanhGrad);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->TanhGrad(input, output, &attrs_);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(TanhGrad);
+    log_debug << "TanhGrad OpKernel compute ok. <--";
+    return 0;
+  }
+};
+
+class SecureGeluOp : public SecureUnaryOp {
+ public:
+  SecureGeluOp(OpKernelConstruction* context) : SecureUnaryOp(context) {}
+  ~SecureGeluOp() {}
+
+  int UnaryCompute(const vector<string>& input, vector<string>& output, OpKernelContext* context) {
+    log_debug << "--> Gelu OpKernel compute.";
+    output.resize(input.size());
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Gelu);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->Gelu(input, output, &attrs_);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Gelu);
+    log_debug << "Gelu OpKernel compute ok. <--";
+    return 0;
+  }
+};
+
+class SecureGeluGradOp : public SecureUnaryOp {
+ public:
+  SecureGeluGradOp(OpKernelConstruction* context) : SecureUnaryOp(context) {}
+  ~SecureGeluGradOp() {}
+
+  int UnaryCompute(const vector<string>& input, vector<string>& output, OpKernelContext* context) {
+    log_debug << "--> GeluGrad OpKernel compute.";
+    output.resize(input.size());
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(GeluGrad);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->GeluGrad(input, output, &attrs_);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(GeluGrad);
+    log_debug << "GeluGrad OpKernel compute ok. <--";
+    return 0;
+  }
+};
+
+class SecureSwishOp : public SecureUnaryOp {
+ public:
+  SecureSwishOp(OpKernelConstruction* context) : SecureUnaryOp(context) {}
+  ~SecureSwishOp() {}
+
+  int UnaryCompute(const vector<string>& input, vector<string>& output, OpKernelContext* context) {
+    log_debug << "--> Swish OpKernel compute.";
+    output.resize(input.size());
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Swish);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->Swish(input, output, &attrs_);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Swish);
+    log_debug << "Swish OpKernel compute ok. <--";
+    return 0;
+  }
+};
+
+class SecureSwishGradOp : public SecureUnaryOp {
+ public:
+  SecureSwishGradOp(OpKernelConstruction* context) : SecureUnaryOp(context) {}
+  ~SecureSwishGradOp() {}
+
+  int UnaryCompute(const vector<string>& input, vector<string>& output, OpKernelContext* context) {
+    log_debug << "--> SwishGrad OpKernel compute.";
+    output.resize(input.size());
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(SwishGrad);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->SwishGrad(input, output, &attrs_);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(SwishGrad);
+    log_debug << "SwishGrad OpKernel compute ok. <--";
+    return 0;
+  }
+};
+
+class SecureSoftplusOp : public SecureUnaryOp {
+ public:
+  SecureSoftplusOp(OpKernelConstruction* context) : SecureUnaryOp(context) {}
+  ~SecureSoftplusOp() {}
+
+  int UnaryCompute(const vector<string>& input, vector<string>& output, OpKernelContext* context) {
+    log_debug << "--> Softplus OpKernel compute.";
+    output.resize(input.size());
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Softplus);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->Softplus(input, output, &attrs_);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Softplus);
+    log_debug << "Softplus OpKernel compute ok. <--";
+    return 0;
+  }
+};
+
+class SecureSoftplusGradOp : public SecureUnaryOp {
+ public:
+  SecureSoftplusGradOp(OpKernelConstruction* context) : SecureUnaryOp(context) {}
+  ~SecureSoftplusGradOp() {}
+
+  int UnaryCompute(const vector<string>& input, vector<string>& output, OpKernelContext* context) {
+    log_debug << "--> SoftplusGrad OpKernel compute.";
+    output.resize(input.size());
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(SoftplusGrad);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->SoftplusGrad(input, output, &attrs_);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(SoftplusGrad);
+    log_debug << "SoftplusGrad OpKernel compute ok. <--";
+    return 0;
+  }
+};
+
+class SecureDPNoiseOp : public SecureUnaryOp {
+ public:
+  SecureDPNoiseOp(OpKernelConstruction* context) : SecureUnaryOp(context) {
+    string mechanism;
+    float scale = 1.0f;
+    OP_REQUIRES_OK(context, context->GetAttr("mechanism", &mechanism));
+    OP_REQUIRES_OK(context, context->GetAttr("scale", &scale));
+    attrs_["mechanism"] = mechanism;
+    attrs_["scale"] = std::to_string(scale);
+  }
+  ~SecureDPNoiseOp() {}
+
+  int UnaryCompute(const vector<string>& input, vector<string>& output, OpKernelContext* context) {
+    log_debug << "--> DPNoise OpKernel compute.";
+    output.resize(input.size());
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(DPNoise);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->DPNoise(input, output, &attrs_);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(DPNoise);
+    log_debug << "DPNoise OpKernel compute ok. <--";
+    return 0;
+  }
+};
+
+// clips each row (the last dimension) of x to L2 norm at most clip_norm
+class SecureClipByL2NormOp : public SecureUnaryOp {
+ public:
+  SecureClipByL2NormOp(OpKernelConstruction* context) : SecureUnaryOp(context) {
+    float clip_norm = 1.0f;
+    OP_REQUIRES_OK(context, context->GetAttr("clip_norm", &clip_norm));
+    attrs_["clip_norm"] = std::to_string(clip_norm);
+  }
+  ~SecureClipByL2NormOp() {}
+
+  int UnaryCompute(const vector<string>& input, vector<string>& output, OpKernelContext* context) {
+    log_debug << "--> ClipByL2Norm OpKernel compute.";
+    const Tensor& x = context->input(0);
+    int64 cols = x.dims() > 0 ? x.dim_size(x.dims() - 1) : 1;
+    int64 rows = cols > 0 ? x.NumElements() / cols : 0;
+    attrs_["rows"] = std::to_string(rows);
+    attrs_["cols"] = std::to_string(cols);
+
+    output.resize(input.size());
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(ClipByL2Norm);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->ClipByL2Norm(input, output, &attrs_);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(ClipByL2Norm);
+    log_debug << "ClipByL2Norm OpKernel compute ok. <--";
+    return 0;
+  }
+};
+
+class SecureDropoutOp : public SecureUnaryOp {
+ public:
+  SecureDropoutOp(OpKernelConstruction* context) : SecureUnaryOp(context) {
+    float rate = 0.5f;
+    bool common_mask = false;
+    OP_REQUIRES_OK(context, context->GetAttr("rate", &rate));
+    OP_REQUIRES_OK(context, context->GetAttr("common_mask", &common_mask));
+    attrs_["rate"] = std::to_string(rate);
+    attrs_["common_mask"] = common_mask ? "1" : "0";
+  }
+  ~SecureDropoutOp() {}
+
+  int UnaryCompute(const vector<string>& input, vector<string>& output, OpKernelContext* context) {
+    log_debug << "--> Dropout OpKernel compute.";
+    output.resize(input.size());
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Dropout);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->Dropout(input, output, &attrs_);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Dropout);
+    log_debug << "Dropout OpKernel compute ok. <--";
+    return 0;
+  }
+};
+
+// applies the mask of the SecureDropout op named forward_op, found by that op's msg id
+class SecureDropoutGradOp : public SecureUnaryOp {
+ public:
+  SecureDropoutGradOp(OpKernelConstruction* context) : SecureUnaryOp(context) {
+    string forward_op;
+    OP_REQUIRES_OK(context, context->GetAttr("forward_op", &forward_op));
+    // resolved by the backend like the msg id of the forward kernel, see MsgIdMgr::ResolveMsgId
+    attrs_["forward_msgid"] = forward_op;
+  }
+  ~SecureDropoutGradOp() {}
+
+  int UnaryCompute(const vector<string>& input, vector<string>& output, OpKernelContext* context) {
+    log_debug << "--> DropoutGrad OpKernel compute.";
+    output.resize(input.size());
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(DropoutGrad);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->DropoutGrad(input, output, &attrs_);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(DropoutGrad);
+    log_debug << "DropoutGrad OpKernel compute ok. <--";
+    return 0;
+  }
+};
+
 class SecureSigmoidCrossEntropyOp : public SecureBinaryOp<BinaryOpState> {
  private:
   /* data */
@@ -68,7 +327,7 @@ class SecureSigmoidCrossEntropyOp : public SecureBinaryOp<BinaryOpState> {
     output.resize(in1.size());
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(SigmoidCrossEntropy);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->SigmoidCrossEntropy(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(SigmoidCrossEntropy);
@@ -88,7 +347,7 @@ class SecureReluOp : public SecureUnaryOp {
     log_debug << "--> Relu OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Relu);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Relu(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Relu);
@@ -108,7 +367,7 @@ class SecureReluPrimeOp : public SecureUnaryOp {
     log_debug << "--> ReluPrime OpKernel compute.";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(ReluPrime);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->ReluPrime(input, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(ReluPrime);
@@ -267,7 +526,7 @@ class SecureConv2DOp : public SecureOpKernel {
       vector<string> szero(1);
       SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(PublicInput);
       auto protocol = ProtocolManager::Instance()
-        ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()));
+        ->GetProtocol(task_id_);
       protocol->GetOps(msg_id())->PublicInput(protocol->GetNetHandler()->GetNodeId(0), dzero, szero);
       SECURE_OP_CALL_PROTOCOL_OP_STATS_END(PublicInput);
 
@@ -477,7 +736,7 @@ class SecureConv2DOp : public SecureOpKernel {
     vector<string> tmpc; //(out_batch * out_rows * out_cols * out_depth); // N*((H*W)*C)
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Matmul);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Matmul(tmpa, tmpb, tmpc, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Matmul);
@@ -541,7 +800,7 @@ class SecureBiasAddOp : public SecureBinaryOp<BinaryOpState> {
     int ret = -1;
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(BiasAdd);
     ret = ProtocolManager::Instance()
-                ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+                ->GetProtocol(task_id_)
                 ->GetOps(msg_id())
                 ->Add(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(BiasAdd);
@@ -649,6 +908,118 @@ class SecureBiasAddOp : public SecureBinaryOp<BinaryOpState> {
   TensorFormat data_format_;
 };
 
+/**
+ * The gradient of BiasAdd w.r.t. bias is the sum of `out_backprop` over all but the channel axis.
+ * The reduction is linear, so each party accumulates its own shares and no communication is needed.
+ *
+ * NHWC: out_backprop is viewed as [rest, depth], reduced column-wise with AddN (no reordering).
+ * NCHW: out_backprop is viewed as [batch, depth, rest], gathered into [depth, batch*rest] and
+ *       reduced row-wise with Sum.
+ */
+class SecureBiasAddGradOp : public SecureOpKernel {
+ public:
+  explicit SecureBiasAddGradOp(OpKernelConstruction* context) : SecureOpKernel(context) {
+    string data_format;
+    if (context->GetAttr("data_format", &data_format).ok()) {
+      OP_REQUIRES(
+        context, FormatFromString(data_format, &data_format_),
+        errors::InvalidArgument("Invalid data format"));
+    } else {
+      data_format_ = FORMAT_NHWC;
+    }
+  }
+  ~SecureBiasAddGradOp() {}
+
+  void ComputeImpl(OpKernelContext* context) override {
+    log_debug << "--> SecureBiasAddGradOp OpKernel compute.";
+    const Tensor& output_backprop = context->input(0);
+
+    OP_REQUIRES(
+      context, TensorShapeUtils::IsMatrixOrHigher(output_backprop.shape()),
+      errors::InvalidArgument(
+        "Input tensor must be at least 2D: ", output_backprop.shape().DebugString()));
+    OP_REQUIRES(
+      context,
+      FastBoundsCheck(output_backprop.NumElements(), std::numeric_limits<int32>::max()),
+      errors::InvalidArgument("BiasGrad requires tensor size <= int32 max"));
+
+    int64_t batch = 1, depth = 0, rest = 1;
+    const int dims = output_backprop.dims();
+    if (data_format_ == FORMAT_NCHW) {
+      batch = output_backprop.dim_size(0);
+      depth = output_backprop.dim_size(1);
+      for (int i = 2; i < dims; i++) {
+        rest *= output_backprop.dim_size(i);
+      }
+    } else {
+      depth = output_backprop.dim_size(dims - 1);
+      for (int i = 0; i < dims - 1; i++) {
+        rest *= output_backprop.dim_size(i);
+      }
+    }
+
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, TensorShape({depth}), &output));
+    if (depth == 0) {
+      return;
+    }
+
+    auto out_flat = output->flat<string>();
+    if (output_backprop.NumElements() == 0) {
+      // literal zeros are valid inputs for every protocol
+      for (int64_t i = 0; i < depth; i++) {
+        out_flat(i) = "0";
+      }
+      return;
+    }
+
+    const auto& in_flat = output_backprop.flat<string>();
+    const int64_t size = output_backprop.NumElements();
+    vector<string> input(size);
+    vector<string> outs;
+
+    auto ops = ProtocolManager::Instance()
+                 ->GetProtocol(task_id_)
+                 ->GetOps(msg_id());
+    if (data_format_ == FORMAT_NCHW) {
+      // [batch, depth, rest] -> [depth, batch * rest]
+      const int64_t cols = batch * rest;
+      for (int64_t n = 0; n < batch; n++) {
+        for (int64_t c = 0; c < depth; c++) {
+          const int64_t src = (n * depth + c) * rest;
+          const int64_t dst = c * cols + n * rest;
+          for (int64_t k = 0; k < rest; k++) {
+            input[dst + k] = in_flat(src + k);
+          }
+        }
+      }
+      attrs_["rows"] = std::to_string(depth);
+      attrs_["cols"] = std::to_string(cols);
+      SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Sum);
+      ops->Sum(input, outs, &attrs_);
+      SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Sum);
+    } else {
+      // [rest, depth], reduce each column
+      for (int64_t i = 0; i < size; i++) {
+        input[i] = in_flat(i);
+      }
+      attrs_["rows"] = std::to_string(rest);
+      attrs_["cols"] = std::to_string(depth);
+      SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(AddN);
+      ops->AddN(input, outs, &attrs_);
+      SECURE_OP_CALL_PROTOCOL_OP_STATS_END(AddN);
+    }
+
+    for (int64_t i = 0; i < depth; i++) {
+      out_flat(i) = std::move(outs[i]);
+    }
+    log_debug << "SecureBiasAddGradOp OpKernel compute ok. <--";
+  }
+
+ private:
+  TensorFormat data_format_;
+};
+
 class SecureL2LossOp : public SecureUnaryOp {
  private:
   /* data */
@@ -789,7 +1160,7 @@ class SecureFusedBatchNormOp : public SecureOpKernel {
     const auto& offset_flat = offset.flat<string>();
 
     auto ops = ProtocolManager::Instance()
-                ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+                ->GetProtocol(task_id_)
                 ->GetOps(msg_id());
 
     // for debuging:
@@ -1005,7 +1376,7 @@ class SecureSoftmaxOp : public SecureOpKernel {
 
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Softmax);
     ProtocolManager::Instance()
-                      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+                      ->GetProtocol(task_id_)
                       ->GetOps(msg_id())
                       ->Softmax(a, b, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Softmax);
@@ -1021,14 +1392,300 @@ class SecureSoftmaxOp : public SecureOpKernel {
   }
 };
 
+// normalizes over the last dimension, rows = all the leading dimensions
+class SecureLayerNormOp : public SecureOpKernel {
+ private:
+  float epsilon_;
+
+ public:
+  SecureLayerNormOp(OpKernelConstruction* context) : SecureOpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("epsilon", &epsilon_));
+  }
+  ~SecureLayerNormOp() {}
+
+  void ComputeImpl(OpKernelContext* context) {
+    log_debug << "--> SecureLayerNormOp OpKernel compute.";
+    const Tensor& x = context->input(0);
+    const Tensor& gamma = context->input(1);
+    const Tensor& beta = context->input(2);
+    OP_REQUIRES(
+      context, TensorShapeUtils::IsVectorOrHigher(x.shape()),
+      errors::InvalidArgument("x must have >= 1 dimension, got ", x.shape().DebugString()));
+    const int64_t cols = x.dim_size(x.dims() - 1);
+    OP_REQUIRES(
+      context, gamma.NumElements() == cols && beta.NumElements() == cols,
+      errors::InvalidArgument(
+        "gamma and beta must have ", cols, " elements, got ", gamma.shape().DebugString(), " and ",
+        beta.shape().DebugString()));
+
+    TensorShape row_shape(x.shape());
+    row_shape.RemoveLastDims(1);
+    Tensor* y = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, x.shape(), &y));
+    Tensor* inv_std = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(1, row_shape, &inv_std));
+    if (x.NumElements() == 0)
+      return;
+    const int64_t rows = x.NumElements() / cols;
+
+    vector<string> in_x, in_gamma, in_beta, out_y, out_inv_std;
+    in_x.assign(x.flat<string>().data(), x.flat<string>().data() + x.NumElements());
+    in_gamma.assign(gamma.flat<string>().data(), gamma.flat<string>().data() + gamma.NumElements());
+    in_beta.assign(beta.flat<string>().data(), beta.flat<string>().data() + beta.NumElements());
+
+    attr_type attrs;
+    attrs["rows"] = to_string(rows);
+    attrs["cols"] = to_string(cols);
+    attrs["epsilon"] = to_string(epsilon_);
+
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(LayerNorm);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->LayerNorm(in_x, in_gamma, in_beta, out_y, out_inv_std, &attrs);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(LayerNorm);
+
+    auto y_flat = y->flat<string>();
+    for (int64_t i = 0; i < y_flat.size(); ++i)
+      y_flat(i) = std::move(out_y[i]);
+    auto inv_std_flat = inv_std->flat<string>();
+    for (int64_t i = 0; i < inv_std_flat.size(); ++i)
+      inv_std_flat(i) = std::move(out_inv_std[i]);
+    log_debug << "SecureLayerNormOp OpKernel compute ok. <--";
+  }
+};
+
+class SecureLayerNormGradOp : public SecureOpKernel {
+ public:
+  SecureLayerNormGradOp(OpKernelConstruction* context) : SecureOpKernel(context) {}
+  ~SecureLayerNormGradOp() {}
+
+  void ComputeImpl(OpKernelContext* context) {
+    log_debug << "--> SecureLayerNormGradOp OpKernel compute.";
+    const Tensor& x = context->input(0);
+    const Tensor& gamma = context->input(1);
+    const Tensor& inv_std = context->input(2);
+    const Tensor& dy = context->input(3);
+    OP_REQUIRES(
+      context, TensorShapeUtils::IsVectorOrHigher(x.shape()),
+      errors::InvalidArgument("x must have >= 1 dimension, got ", x.shape().DebugString()));
+    OP_REQUIRES(
+      context, x.shape() == dy.shape(),
+      errors::InvalidArgument(
+        "x and dy must have the same shape, got ", x.shape().DebugString(), " and ",
+        dy.shape().DebugString()));
+    const int64_t cols = x.dim_size(x.dims() - 1);
+    OP_REQUIRES(
+      context, gamma.NumElements() == cols,
+      errors::InvalidArgument("gamma must have ", cols, " elements, got ", gamma.shape().DebugString()));
+
+    Tensor* dx = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, x.shape(), &dx));
+    Tensor* dgamma = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(1, gamma.shape(), &dgamma));
+    Tensor* dbeta = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(2, gamma.shape(), &dbeta));
+    if (x.NumElements() == 0)
+      return;
+    const int64_t rows = x.NumElements() / cols;
+    OP_REQUIRES(
+      context, inv_std.NumElements() == rows,
+      errors::InvalidArgument("inv_std must have ", rows, " elements, got ", inv_std.shape().DebugString()));
+
+    vector<string> in_x, in_gamma, in_inv_std, in_dy, out_dx, out_dgamma, out_dbeta;
+    in_x.assign(x.flat<string>().data(), x.flat<string>().data() + x.NumElements());
+    in_gamma.assign(gamma.flat<string>().data(), gamma.flat<string>().data() + gamma.NumElements());
+    in_inv_std.assign(inv_std.flat<string>().data(), inv_std.flat<string>().data() + inv_std.NumElements());
+    in_dy.assign(dy.flat<string>().data(), dy.flat<string>().data() + dy.NumElements());
+
+    attr_type attrs;
+    attrs["rows"] = to_string(rows);
+    attrs["cols"] = to_string(cols);
+
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(LayerNormGrad);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->LayerNormGrad(in_x, in_gamma, in_inv_std, in_dy, out_dx, out_dgamma, out_dbeta, &attrs);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(LayerNormGrad);
+
+    auto dx_flat = dx->flat<string>();
+    for (int64_t i = 0; i < dx_flat.size(); ++i)
+      dx_flat(i) = std::move(out_dx[i]);
+    auto dgamma_flat = dgamma->flat<string>();
+    for (int64_t i = 0; i < dgamma_flat.size(); ++i)
+      dgamma_flat(i) = std::move(out_dgamma[i]);
+    auto dbeta_flat = dbeta->flat<string>();
+    for (int64_t i = 0; i < dbeta_flat.size(); ++i)
+      dbeta_flat(i) = std::move(out_dbeta[i]);
+    log_debug << "SecureLayerNormGradOp OpKernel compute ok. <--";
+  }
+};
+
+class SecureTopKOp : public SecureOpKernel {
+ private:
+  int k_;
+
+ public:
+  SecureTopKOp(OpKernelConstruction* context) : SecureOpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("k", &k_));
+  }
+  ~SecureTopKOp() {}
+
+  void ComputeImpl(OpKernelContext* context) {
+    log_debug << "--> SecureTopKOp OpKernel compute.";
+    const Tensor& x = context->input(0);
+    OP_REQUIRES(
+      context, TensorShapeUtils::IsVectorOrHigher(x.shape()),
+      errors::InvalidArgument("x must have >= 1 dimension, got ", x.shape().DebugString()));
+    const int64_t cols = x.dim_size(x.dims() - 1);
+    OP_REQUIRES(
+      context, k_ >= 1 && k_ <= cols,
+      errors::InvalidArgument("k must be in [1, ", cols, "], got ", k_));
+
+    TensorShape values_shape(x.shape());
+    values_shape.set_dim(values_shape.dims() - 1, k_);
+    TensorShape indices_shape(values_shape);
+    indices_shape.AddDim(cols);
+    Tensor* values = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, values_shape, &values));
+    Tensor* indices = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(1, indices_shape, &indices));
+    if (x.NumElements() == 0)
+      return;
+    const int64_t rows = x.NumElements() / cols;
+
+    vector<string> in_x, out_values, out_indices;
+    in_x.assign(x.flat<string>().data(), x.flat<string>().data() + x.NumElements());
+
+    attr_type attrs;
+    attrs["rows"] = to_string(rows);
+    attrs["cols"] = to_string(cols);
+    attrs["k"] = to_string(k_);
+
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(TopK);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->TopK(in_x, out_values, out_indices, &attrs);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(TopK);
+
+    auto values_flat = values->flat<string>();
+    for (int64_t i = 0; i < values_flat.size(); ++i)
+      values_flat(i) = std::move(out_values[i]);
+    auto indices_flat = indices->flat<string>();
+    for (int64_t i = 0; i < indices_flat.size(); ++i)
+      indices_flat(i) = std::move(out_indices[i]);
+    log_debug << "SecureTopKOp OpKernel compute ok. <--";
+  }
+};
+
+class SecureOneHotOp : public SecureOpKernel {
+ private:
+  int depth_;
+
+ public:
+  SecureOneHotOp(OpKernelConstruction* context) : SecureOpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("depth", &depth_));
+  }
+  ~SecureOneHotOp() {}
+
+  void ComputeImpl(OpKernelContext* context) {
+    log_debug << "--> SecureOneHotOp OpKernel compute.";
+    const Tensor& x = context->input(0);
+    TensorShape y_shape(x.shape());
+    y_shape.AddDim(depth_);
+    Tensor* y = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, y_shape, &y));
+    if (x.NumElements() == 0)
+      return;
+
+    vector<string> in_x, out_y;
+    in_x.assign(x.flat<string>().data(), x.flat<string>().data() + x.NumElements());
+
+    attr_type attrs;
+    attrs["depth"] = to_string(depth_);
+
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(OneHot);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->OneHot(in_x, out_y, &attrs);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(OneHot);
+
+    auto y_flat = y->flat<string>();
+    for (int64_t i = 0; i < y_flat.size(); ++i)
+      y_flat(i) = std::move(out_y[i]);
+    log_debug << "SecureOneHotOp OpKernel compute ok. <--";
+  }
+};
+
+class SecureOneHotToIndexOp : public SecureOpKernel {
+ public:
+  SecureOneHotToIndexOp(OpKernelConstruction* context) : SecureOpKernel(context) {}
+  ~SecureOneHotToIndexOp() {}
+
+  void ComputeImpl(OpKernelContext* context) {
+    log_debug << "--> SecureOneHotToIndexOp OpKernel compute.";
+    const Tensor& x = context->input(0);
+    OP_REQUIRES(
+      context, TensorShapeUtils::IsVectorOrHigher(x.shape()),
+      errors::InvalidArgument("x must have >= 1 dimension, got ", x.shape().DebugString()));
+    const int64_t depth = x.dim_size(x.dims() - 1);
+
+    TensorShape y_shape(x.shape());
+    y_shape.RemoveLastDims(1);
+    Tensor* y = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, y_shape, &y));
+    if (x.NumElements() == 0)
+      return;
+
+    vector<string> in_x, out_y;
+    in_x.assign(x.flat<string>().data(), x.flat<string>().data() + x.NumElements());
+
+    attr_type attrs;
+    attrs["depth"] = to_string(depth);
+
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(OneHotToIndex);
+    ProtocolManager::Instance()
+      ->GetProtocol(task_id_)
+      ->GetOps(msg_id())
+      ->OneHotToIndex(in_x, out_y, &attrs);
+    SECURE_OP_CALL_PROTOCOL_OP_STATS_END(OneHotToIndex);
+
+    auto y_flat = y->flat<string>();
+    for (int64_t i = 0; i < y_flat.size(); ++i)
+      y_flat(i) = std::move(out_y[i]);
+    log_debug << "SecureOneHotToIndexOp OpKernel compute ok. <--";
+  }
+};
+
 //-----------------------------------------------------------------------------
 REGISTER_STR_CPU_KERNEL(SecureRelu, SecureReluOp);
 REGISTER_STR_CPU_KERNEL(SecureReluPrime, SecureReluPrimeOp);
 REGISTER_STR_CPU_KERNEL(SecureSigmoid, SecureSigmoidOp);
 REGISTER_STR_CPU_KERNEL(SecureSigmoidCrossEntropy, SecureSigmoidCrossEntropyOp);
+REGISTER_STR_CPU_KERNEL(SecureTanh, SecureTanhOp);
+REGISTER_STR_CPU_KERNEL(SecureTanhGrad, SecureTanhGradOp);
+REGISTER_STR_CPU_KERNEL(SecureGelu, SecureGeluOp);
+REGISTER_STR_CPU_KERNEL(SecureGeluGrad, SecureGeluGradOp);
+REGISTER_STR_CPU_KERNEL(SecureSwish, SecureSwishOp);
+REGISTER_STR_CPU_KERNEL(SecureSwishGrad, SecureSwishGradOp);
+REGISTER_STR_CPU_KERNEL(SecureSoftplus, SecureSoftplusOp);
+REGISTER_STR_CPU_KERNEL(SecureSoftplusGrad, SecureSoftplusGradOp);
+REGISTER_STR_CPU_KERNEL(SecureDPNoise, SecureDPNoiseOp);
+REGISTER_STR_CPU_KERNEL(SecureClipByL2Norm, SecureClipByL2NormOp);
+REGISTER_STR_CPU_KERNEL(SecureDropout, SecureDropoutOp);
+REGISTER_STR_CPU_KERNEL(SecureDropoutGrad, SecureDropoutGradOp);
 REGISTER_STR_CPU_KERNEL(SecureConv2D, SecureConv2DOp);
 REGISTER_STR_CPU_KERNEL(SecureBiasAdd, SecureBiasAddOp);
+REGISTER_STR_CPU_KERNEL(SecureBiasAddGrad, SecureBiasAddGradOp);
 REGISTER_STR_CPU_KERNEL(SecureL2Loss, SecureL2LossOp);
 REGISTER_STR_CPU_KERNEL(SecureFusedBatchNorm, SecureFusedBatchNormOp);
 REGISTER_STR_CPU_KERNEL(SecureSoftmax, SecureSoftmaxOp);
+REGISTER_STR_CPU_KERNEL(SecureLayerNorm, SecureLayerNormOp);
+REGISTER_STR_CPU_KERNEL(SecureLayerNormGrad, SecureLayerNormGradOp);
+REGISTER_STR_CPU_KERNEL(SecureTopK, SecureTopKOp);
+REGISTER_STR_CPU_KERNEL(SecureOneHot, SecureOneHotOp);
+REGISTER_STR_CPU_KERNEL(SecureOneHotToIndex, SecureOneHotToIndexOp);
 } // namespace tensorflow
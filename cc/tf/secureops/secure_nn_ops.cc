@@ -18,6 +18,56 @@ std::string GetConvnetDataFormatAttrString() {
 }
 
 
+REGISTER_OP("SecureDPNoise")
+  .Input("x: string")
+  .Output("y: string")
+  .Attr("mechanism: {'gaussian', 'laplace'} = 'gaussian'")
+  .Attr("scale: float = 1.0")
+  .SetIsStateful()
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+  .SetShapeFn(::tensorflow::shape_inference::UnchangedShape)
+#endif
+  .Doc(R"doc(
+SecureDPNoiseOp, y = x + scale * noise, the noise is jointly sampled and known to no party.
+)doc");
+
+REGISTER_OP("SecureClipByL2Norm")
+  .Input("x: string")
+  .Output("y: string")
+  .Attr("clip_norm: float")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+  .SetShapeFn(::tensorflow::shape_inference::UnchangedShape)
+#endif
+  .Doc(R"doc(
+SecureClipByL2NormOp, each row of x (the last dimension) is scaled to L2 norm at most clip_norm.
+)doc");
+
+REGISTER_OP("SecureDropout")
+  .Input("x: string")
+  .Output("y: string")
+  .Attr("rate: float = 0.5")
+  .Attr("common_mask: bool = false")
+  .SetIsStateful()
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+  .SetShapeFn(::tensorflow::shape_inference::UnchangedShape)
+#endif
+  .Doc(R"doc(
+SecureDropoutOp, inverted dropout. With common_mask the mask is known to the parties
+and applied locally, otherwise it stays secret-shared.
+)doc");
+
+REGISTER_OP("SecureDropoutGrad")
+  .Input("dy: string")
+  .Output("dx: string")
+  .Attr("forward_op: string")
+  .SetIsStateful()
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+  .SetShapeFn(::tensorflow::shape_inference::UnchangedShape)
+#endif
+  .Doc(R"doc(
+SecureDropoutGradOp, dx = dy * mask of the SecureDropout op named forward_op.
+)doc");
+
 REGISTER_OP("SecureSigmoidCrossEntropy")
     .Input("logits: string")
     .Input("labels: string")
@@ -36,6 +86,86 @@ REGISTER_OP("SecureSigmoid")
 SecureSigmoidOp
 )doc");
 
+REGISTER_OP("SecureTanh")
+  .Input("x: string")
+  .Output("y: string")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+  .SetShapeFn(::tensorflow::shape_inference::UnchangedShape)
+#endif
+  .Doc(R"doc(
+SecureTanhOp
+)doc");
+
+REGISTER_OP("SecureTanhGrad")
+  .Input("x: string")
+  .Output("y: string")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+  .SetShapeFn(::tensorflow::shape_inference::UnchangedShape)
+#endif
+  .Doc(R"doc(
+SecureTanhGradOp
+)doc");
+
+REGISTER_OP("SecureGelu")
+  .Input("x: string")
+  .Output("y: string")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+  .SetShapeFn(::tensorflow::shape_inference::UnchangedShape)
+#endif
+  .Doc(R"doc(
+SecureGeluOp
+)doc");
+
+REGISTER_OP("SecureGeluGrad")
+  .Input("x: string")
+  .Output("y: string")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+  .SetShapeFn(::tensorflow::shape_inference::UnchangedShape)
+#endif
+  .Doc(R"doc(
+SecureGeluGradOp
+)doc");
+
+REGISTER_OP("SecureSwish")
+  .Input("x: string")
+  .Output("y: string")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+  .SetShapeFn(::tensorflow::shape_inference::UnchangedShape)
+#endif
+  .Doc(R"doc(
+SecureSwishOp
+)doc");
+
+REGISTER_OP("SecureSwishGrad")
+  .Input("x: string")
+  .Output("y: string")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+  .SetShapeFn(::tensorflow::shape_inference::UnchangedShape)
+#endif
+  .Doc(R"doc(
+SecureSwishGradOp
+)doc");
+
+REGISTER_OP("SecureSoftplus")
+  .Input("x: string")
+  .Output("y: string")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+  .SetShapeFn(::tensorflow::shape_inference::UnchangedShape)
+#endif
+  .Doc(R"doc(
+SecureSoftplusOp
+)doc");
+
+REGISTER_OP("SecureSoftplusGrad")
+  .Input("x: string")
+  .Output("y: string")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+  .SetShapeFn(::tensorflow::shape_inference::UnchangedShape)
+#endif
+  .Doc(R"doc(
+SecureSoftplusGradOp
+)doc");
+
 REGISTER_OP("SecureRelu")
   .Input("x: string")
   .Output("y: string")
@@ -85,6 +215,17 @@ REGISTER_OP("SecureBiasAdd")
 SecureBiasAddOp
 )doc");
 
+REGISTER_OP("SecureBiasAddGrad")
+    .Input("out_backprop: string")
+    .Attr(GetConvnetDataFormatAttrString())
+    .Output("output: string")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+    .SetShapeFn(::tensorflow::shape_inference::BiasAddGradShape)
+#endif
+    .Doc(R"doc(
+SecureBiasAddGradOp
+)doc");
+
 REGISTER_OP("SecureL2Loss")
     .Input("t: string")
     .Output("output: string")
@@ -155,3 +296,103 @@ REGISTER_OP("SecureSoftmax")
     .Doc(R"doc(
 SecureSoftmaxOp
 )doc");
+
+REGISTER_OP("SecureLayerNorm")
+    .Input("x: string")
+    .Input("gamma: string")
+    .Input("beta: string")
+    .Output("y: string")
+    .Output("inv_std: string")
+    .Attr("epsilon: float = 0.00001")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      ::tensorflow::shape_inference::ShapeHandle x, rows;
+      TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(0), 1, &x));
+      TF_RETURN_IF_ERROR(c->Subshape(x, 0, -1, &rows));
+      c->set_output(0, x);
+      c->set_output(1, rows);
+      return ::tensorflow::Status::OK();
+    })
+#endif
+    .Doc(R"doc(
+SecureLayerNormOp, normalizes over the last dimension of x.
+inv_std is 1/sqrt(var + epsilon) of each row, for SecureLayerNormGrad.
+)doc");
+
+REGISTER_OP("SecureLayerNormGrad")
+    .Input("x: string")
+    .Input("gamma: string")
+    .Input("inv_std: string")
+    .Input("dy: string")
+    .Output("dx: string")
+    .Output("dgamma: string")
+    .Output("dbeta: string")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(1));
+      c->set_output(2, c->input(1));
+      return ::tensorflow::Status::OK();
+    })
+#endif
+    .Doc(R"doc(
+SecureLayerNormGradOp
+)doc");
+
+REGISTER_OP("SecureTopK")
+    .Input("x: string")
+    .Output("values: string")
+    .Output("indices: string")
+    .Attr("k: int >= 1")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      ::tensorflow::shape_inference::ShapeHandle x, values, indices;
+      TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(0), 1, &x));
+      int k;
+      TF_RETURN_IF_ERROR(c->GetAttr("k", &k));
+      TF_RETURN_IF_ERROR(c->ReplaceDim(x, -1, c->MakeDim(k), &values));
+      TF_RETURN_IF_ERROR(c->Concatenate(values, c->Vector(c->Dim(x, -1)), &indices));
+      c->set_output(0, values);
+      c->set_output(1, indices);
+      return ::tensorflow::Status::OK();
+    })
+#endif
+    .Doc(R"doc(
+SecureTopKOp, the k largest values of each row (the last dimension) of x, in descending order.
+indices holds the position of each of them as a secret-shared one-hot row of x's width.
+)doc");
+
+REGISTER_OP("SecureOneHot")
+    .Input("indices: string")
+    .Output("output: string")
+    .Attr("depth: int >= 1")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      int depth;
+      TF_RETURN_IF_ERROR(c->GetAttr("depth", &depth));
+      ::tensorflow::shape_inference::ShapeHandle out;
+      TF_RETURN_IF_ERROR(c->Concatenate(c->input(0), c->Vector(depth), &out));
+      c->set_output(0, out);
+      return ::tensorflow::Status::OK();
+    })
+#endif
+    .Doc(R"doc(
+SecureOneHotOp, secret-shared one-hot rows of depth for the secret integers of indices,
+along a new last dimension. Values outside [0, depth) give all-zero rows.
+)doc");
+
+REGISTER_OP("SecureOneHotToIndex")
+    .Input("x: string")
+    .Output("indices: string")
+#if ROSETTA_ENABLES_SHAPE_INFERENCE
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      ::tensorflow::shape_inference::ShapeHandle x, out;
+      TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(0), 1, &x));
+      TF_RETURN_IF_ERROR(c->Subshape(x, 0, -1, &out));
+      c->set_output(0, out);
+      return ::tensorflow::Status::OK();
+    })
+#endif
+    .Doc(R"doc(
+SecureOneHotToIndexOp, the inverse of SecureOneHot, the index of each one-hot row of x (the last dimension).
+)doc");
@@ -358,7 +358,7 @@ class SecureMaxPool2DOp : public SecurePooling2DOp {
     log_debug << "SecureMaxPool2DOp...";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Max);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Max(window, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Max);
@@ -370,7 +370,7 @@ class SecureMaxPool2DOp : public SecurePooling2DOp {
     log_debug << "SecureMaxPool2DOp, matrix with axis...";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Max);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Max(window_blocks, window_out_blocks, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Max);
@@ -390,7 +390,7 @@ class SecureAvgPool2DOp : public SecurePooling2DOp {
     // window block calling secure protocol mean ops
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Mean);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Mean(window, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Mean);
@@ -402,7 +402,7 @@ class SecureAvgPool2DOp : public SecurePooling2DOp {
     log_debug << "SecureMeanPool2DOp, matrix with axis...";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Mean);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Mean(window_blocks, window_out_blocks, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Mean);
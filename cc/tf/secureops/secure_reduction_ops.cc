@@ -92,7 +92,7 @@ void SecureReduceOp::ComputeImpl(OpKernelContext* context) {
   ///DETAIL/// }
   ///DETAIL/// vector<double> input_plain(size);
   ///DETAIL/// ProtocolManager::Instance()
-  ///DETAIL///   ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(context->device()->attributes().incarnation()))
+  ///DETAIL///   ->GetProtocol(task_id_)
   ///DETAIL///   ->GetOps(msg_id())
   ///DETAIL///   ->Reveal(input_text, input_plain);
 
@@ -64,7 +64,7 @@ class SecureAssignSubOp : public SecureOpKernel {
     int ret = -1;
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Sub);
     ret = ProtocolManager::Instance()
-                ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(ctx->device()->attributes().incarnation()))
+                ->GetProtocol(task_id_)
                 ->GetOps(msg_id())
                 ->Sub(in1, in2, output, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Sub);
@@ -80,7 +80,7 @@ class SecureApplyGradientDescentOp : public SecureOpKernel {
 
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Mul);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(ctx->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Mul(input_alpha, input_delta, out_var, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Mul);
@@ -89,7 +89,7 @@ class SecureApplyGradientDescentOp : public SecureOpKernel {
     attrs_["rh_is_const"] = "0";
     SECURE_OP_CALL_PROTOCOL_OP_STATS_BEG(Sub);
     ProtocolManager::Instance()
-      ->GetProtocol(ProtocolManager::Instance()->QueryMappingID(ctx->device()->attributes().incarnation()))
+      ->GetProtocol(task_id_)
       ->GetOps(msg_id())
       ->Sub(input_var, out_var, out_var, &attrs_);
     SECURE_OP_CALL_PROTOCOL_OP_STATS_END(Sub);
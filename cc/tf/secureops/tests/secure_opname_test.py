@@ -19,7 +19,13 @@ support_ops = ["secure_add", "secure_matmul",
                "secure_save_v2", "secure_to_tf", "tf_to_secure", "private_input",
                "secure_less", "secure_less_equal", "secure_not_equal",
                "secure_equal", "secure_greater", "secure_greater_equal",
-               "secure_sigmoid", "secure_relu", "secure_sigmoid_cross_entropy" ]
+               "secure_sigmoid", "secure_relu", "secure_sigmoid_cross_entropy",
+               "secure_tanh", "secure_tanh_grad", "secure_gelu", "secure_gelu_grad",
+               "secure_swish", "secure_swish_grad", "secure_softplus", "secure_softplus_grad",
+               "secure_layer_norm", "secure_layer_norm_grad", "secure_dp_noise", "secure_clip_by_l2_norm",
+               "secure_dropout", "secure_dropout_grad", "secure_top_k", "secure_one_hot",
+               "secure_one_hot_to_index",
+               "secure_bias_add", "secure_bias_add_grad" ]
 
 def create_run_session(target):
     init = tf.global_variables_initializer()
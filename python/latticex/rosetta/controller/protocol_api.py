@@ -67,9 +67,11 @@ def activate(protocol_name=None, protocol_config_str=None, task_id=None):
     # if it is already been activated, we should deactivate it first, this action
     # will be carried by PM internally.
     # step 1: fill all as default if parameter is none
-    _check_io(task_id)
     if protocol_name is None:
         protocol_name = get_default_protocol_name()
+    # the single-process reference backend does not need any network
+    if protocol_name != "PlainFixpoint":
+        _check_io(task_id)
 
     # step 2: check parameter 'protocol_name'
     # TODO: check parameter 'protocol_config_str'
@@ -65,6 +65,9 @@ from latticex.rosetta.secure.grads_ops.nn.secure_fusedbatchnorm_grad import *
 from latticex.rosetta.secure.grads_ops.nn.secure_avgpool_grad import *
 from latticex.rosetta.secure.grads_ops.nn.secure_maxpool_grad import *
 from latticex.rosetta.secure.grads_ops.nn.secure_softmax_grad import *
+from latticex.rosetta.secure.grads_ops.nn.secure_activation_grad import *
+from latticex.rosetta.secure.grads_ops.nn.secure_layernorm_grad import *
+from latticex.rosetta.secure.grads_ops.nn.secure_dropout_grad import *
 
 # static pass, replace
 from latticex.rosetta.secure.spass.static_replace_pass import *
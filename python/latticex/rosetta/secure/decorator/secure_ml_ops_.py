@@ -140,6 +140,38 @@ def SecureReluPrime(x, name=None):
     return _secure_ops.secure_relu_prime(x, name=name)
 
 
+def SecureTanh(x, name=None):
+    return _secure_ops.secure_tanh(x, name=name)
+
+
+def SecureTanhGrad(x, name=None):
+    return _secure_ops.secure_tanh_grad(x, name=name)
+
+
+def SecureGelu(x, name=None):
+    return _secure_ops.secure_gelu(x, name=name)
+
+
+def SecureGeluGrad(x, name=None):
+    return _secure_ops.secure_gelu_grad(x, name=name)
+
+
+def SecureSwish(x, name=None):
+    return _secure_ops.secure_swish(x, name=name)
+
+
+def SecureSwishGrad(x, name=None):
+    return _secure_ops.secure_swish_grad(x, name=name)
+
+
+def SecureSoftplus(x, name=None):
+    return _secure_ops.secure_softplus(x, name=name)
+
+
+def SecureSoftplusGrad(x, name=None):
+    return _secure_ops.secure_softplus_grad(x, name=name)
+
+
 SecureSaveV2 = _secure_ops.secure_save_v2
 SecureRestoreV2 = _secure_ops.secure_restore_v2
 SecureApplyGradientDescent = _secure_ops.secure_apply_gradient_descent
@@ -161,10 +193,70 @@ def SecureBiasAdd(x, y, name=None, lh_is_const=False, rh_is_const=False):
     return _secure_ops.secure_bias_add(x, y, name=name)
 
 
+def SecureBiasAddGrad(out_backprop, data_format="NHWC", name=None):
+    return _secure_ops.secure_bias_add_grad(out_backprop, data_format=data_format, name=name)
+
+
 def SecureL2Loss(x, name=None):
     return _secure_ops.secure_l2_loss(x, name=name)
 
 
+def SecureLayerNorm(x, gamma, beta, epsilon=1e-5, name=None):
+    """Layer normalization over the last dimension of x, gamma and beta have its size."""
+    y, _ = _secure_ops.secure_layer_norm(x, gamma, beta, epsilon=epsilon, name=name)
+    return y
+
+
+def SecureLayerNormGrad(x, gamma, inv_std, dy, name=None):
+    return _secure_ops.secure_layer_norm_grad(x, gamma, inv_std, dy, name=name)
+
+
+def SecureDPNoise(x, mechanism="gaussian", scale=1.0, name=None):
+    """x + noise of standard deviation (gaussian) or Laplace b (laplace) scale.
+    The noise is sampled jointly by the parties, none of them learns it: the discrete
+    Laplace, or the binomial mechanism with x rounded to its grid, on the fixed-point grid."""
+    return _secure_ops.secure_dp_noise(x, mechanism=mechanism, scale=scale, name=name)
+
+
+def SecureClipByL2Norm(x, clip_norm, name=None):
+    """Scales each row of x (the last dimension) to L2 norm at most clip_norm.
+    With per-example gradients as rows, DP-SGD is clip, reduce_sum over the batch,
+    then SecureDPNoise with scale = noise_multiplier * clip_norm."""
+    return _secure_ops.secure_clip_by_l2_norm(x, clip_norm=clip_norm, name=name)
+
+
+def SecureDropout(x, rate=0.5, common_mask=False, name=None):
+    """Inverted dropout, kept elements are scaled by 1 / (1 - rate).
+    With common_mask the mask is known to the parties and applied locally,
+    otherwise it stays secret-shared at the cost of one comparison."""
+    return _secure_ops.secure_dropout(x, rate=rate, common_mask=common_mask, name=name)
+
+
+def SecureDropoutGrad(dy, forward_op, name=None):
+    return _secure_ops.secure_dropout_grad(dy, forward_op=forward_op, name=name)
+
+
+def SecureTopK(x, k, reveal_indices_to=None, name=None):
+    """The k largest values of each row of x (the last dimension), in descending order,
+    and their positions as secret-shared one-hot rows of shape [..., k, cols].
+    With reveal_indices_to the indices are opened to that party, the values stay shared."""
+    values, indices = _secure_ops.secure_top_k(x, k=k, name=name)
+    if reveal_indices_to is not None:
+        indices = SecureReveal(indices, reveal_indices_to)
+    return values, indices
+
+
+def SecureOneHot(indices, depth, name=None):
+    """Secret-shared one-hot rows of depth along a new last dimension, for secret-shared
+    integer indices and a public vocabulary size. Values outside [0, depth) give all-zero rows."""
+    return _secure_ops.secure_one_hot(indices, depth=depth, name=name)
+
+
+def SecureOneHotToIndex(x, name=None):
+    """The inverse of SecureOneHot, the index of each one-hot row of x (the last dimension)."""
+    return _secure_ops.secure_one_hot_to_index(x, name=name)
+
+
 def SecureFusedBatchNorm(x, scale, offset, mean, variance, epsilon=0.0001, data_format="NHWC", is_training=True, name=None):
     y, _, _, _, _ = _secure_ops.secure_fused_batch_norm(x, scale, offset, mean, variance, epsilon=epsilon,
                                             data_format=data_format, is_training=is_training, name=name)
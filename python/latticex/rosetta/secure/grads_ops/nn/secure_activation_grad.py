@@ -0,0 +1,57 @@
+# ==============================================================================
+# Copyright 2020 The LatticeX Foundation
+# This file is part of the Rosetta library.
+#
+# The Rosetta library is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# The Rosetta library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
+# =============================================================================="
+from latticex.rosetta.secure.decorator import SecureMul
+from latticex.rosetta.secure.decorator import SecureTanhGrad, SecureGeluGrad
+from latticex.rosetta.secure.decorator import SecureSwishGrad, SecureSoftplusGrad
+from tensorflow.python.framework import ops
+
+
+# The derivative kernels are the piecewise polynomial approximations of f'(x)
+# evaluated on the forward input, so the backward pass costs one more
+# activation call plus a multiplication.
+
+@ops.RegisterGradient("SecureTanh")
+def _SecureTanhGrad(op, grad):
+    """ The gradient for the Secure Tanh """
+    x = op.inputs[0]
+    with ops.control_dependencies([grad]):
+        return SecureMul(grad, SecureTanhGrad(x))
+
+
+@ops.RegisterGradient("SecureGelu")
+def _SecureGeluGrad(op, grad):
+    """ The gradient for the Secure Gelu """
+    x = op.inputs[0]
+    with ops.control_dependencies([grad]):
+        return SecureMul(grad, SecureGeluGrad(x))
+
+
+@ops.RegisterGradient("SecureSwish")
+def _SecureSwishGrad(op, grad):
+    """ The gradient for the Secure Swish """
+    x = op.inputs[0]
+    with ops.control_dependencies([grad]):
+        return SecureMul(grad, SecureSwishGrad(x))
+
+
+@ops.RegisterGradient("SecureSoftplus")
+def _SecureSoftplusGrad(op, grad):
+    """ The gradient for the Secure Softplus """
+    x = op.inputs[0]
+    with ops.control_dependencies([grad]):
+        return SecureMul(grad, SecureSoftplusGrad(x))
@@ -15,13 +15,15 @@
 # You should have received a copy of the GNU Lesser General Public License
 # along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
 # =============================================================================="
+from latticex.rosetta.secure.decorator import SecureBiasAddGrad
 from tensorflow.python.framework import ops
 
 
 
 @ops.RegisterGradient("SecureBiasAdd")
-def SecureBiasAddGrad(op, grad):
+def _SecureBiasAddGrad(op, grad):
     """ The gradient for the Secure BiasAdd """
-    # not implement now
-    return (None, None)
-
+    data_format = op.get_attr("data_format")
+    if isinstance(data_format, bytes):
+        data_format = data_format.decode()
+    return (grad, SecureBiasAddGrad(grad, data_format=data_format))
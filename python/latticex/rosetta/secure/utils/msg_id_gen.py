@@ -15,6 +15,7 @@
 # You should have received a copy of the GNU Lesser General Public License
 # along with the Rosetta library. If not, see <http://www.gnu.org/licenses/>.
 # =============================================================================="
+import struct
 import tensorflow as tf
 from latticex.rosetta.controller.controller_base_ import _rtt
 from latticex.rosetta.controller.common_util import rtt_get_logger
@@ -23,9 +24,11 @@ from latticex.rosetta.controller.common_util import rtt_get_logger
 class MsgIdGenerator():
     """
     generate message id for rosetta graph
-    message id format:
-    "rosetta op name" +  "\t" + message id index  + "\n"
-    "rosetta op name2" + "\t" + message id index2 + "\n"
+    message id table format (little-endian, see MsgIdMgr::UpdateMsgIdTable):
+    b"RTTMID01" + uint32 count
+    + per op: uint32 message id index + uint32 name length + op name (utf-8)
+    The keys are the graph op names, a kernel looks up its own node name in
+    every task (see MsgIdMgr::ResolveMsgId).
     
     For example:
     a = tf.Variable(...)
@@ -33,10 +36,10 @@ class MsgIdGenerator():
     c = a * b
 
     generate the message id:(index start with 0)
-    "Mpc/MpcMul 0 \n"
+    "Mpc/MpcMul" -> 0
     """
 
-    # class variable, map rosetta graph to message id string
+    # class variable, map rosetta graph to message id table
     rtt_graph_mapto_msgid = {}
 
 
@@ -68,7 +71,7 @@ class MsgIdGenerator():
         Generate message id
 
         :param privacy_tensor: privacy tensor, eg:mpc tensor or he tensor...
-        return: message id string
+        return: message id table (bytes)
         """
         if (not self.regen):
             # if it has already generated, then return the message id string
@@ -77,15 +80,20 @@ class MsgIdGenerator():
 
         # generate the message id
         idx = 0
-        current_msg_id = ""
+        entries = []
         for rtt_op in tf.compat.v1.get_default_graph().get_operations():
             if (self._is_privacy_op_name(rtt_op.name)):
-                current_msg_id += "{0}\t{1}\n".format(rtt_op.name, idx)
+                name = rtt_op.name.encode("utf-8")
+                entries.append(struct.pack("<II", idx, len(name)))
+                entries.append(name)
                 idx += 1
 
+        if idx == 0:
+            return b""
+        current_msg_id = b"RTTMID01" + struct.pack("<I", idx) + b"".join(entries)
+
         # save the message id info
-        if current_msg_id:
-            self.rtt_graph_mapto_msgid[privacy_tensor] = current_msg_id
+        self.rtt_graph_mapto_msgid[privacy_tensor] = current_msg_id
 
         # return the message id info
         return current_msg_id
@@ -96,7 +104,9 @@ class MsgIdGenerator():
         generate the rosetta message id, and notified message id to player
         """
         msg_id = self._generate(loss)
-        rtt_get_logger().debug(msg_id)
+        if not msg_id:
+            return
+        rtt_get_logger().debug("message id table: {0} bytes".format(len(msg_id)))
         py_msgid_handler = _rtt.msgid_handle.MsgIdHandle()
-        py_msgid_handler.update_message_id_info(msg_id)
+        py_msgid_handler.update_message_id_table(msg_id)
 
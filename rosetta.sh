@@ -66,6 +66,8 @@ function show_compile_usage() {
     echo "     --enable-all                         [OFF] Enable all the following options"
     echo "       --enable-protocol-mpc-securenn     [OFF] Secure Multi-party Computation (base on SecureNN)"
     echo "       --enable-protocol-mpc-helix        [OFF] Secure Multi-party Computation (base on Helix)"
+    echo "       --enable-protocol-mpc-ot2pc        [OFF] Dealer-free 2PC (triples from OT extension)"
+    echo "       --enable-protocol-mpc-shamir       [OFF] n-party Shamir sharing (honest majority)"
     echo "       --enable-protocol-zk               [OFF] Zero-Knowledge Proof"
     echo "       --enable-128bit                    [OFF] 128-bit data type"
     echo "       --enable-tests                     [OFF] Compile all the test cases"
@@ -157,6 +159,8 @@ if [ "${cmd}" = "compile" ]; then
     enable_all=0
     enable_protocol_mpc_securenn=OFF
     enable_protocol_mpc_helix=OFF
+    enable_protocol_mpc_ot2pc=OFF
+    enable_protocol_mpc_shamir=OFF
     enable_protocol_zk=OFF
     enable_128bit=OFF
     enable_shape_inference=OFF
@@ -170,7 +174,7 @@ if [ "${cmd}" = "compile" ]; then
         enable_shape_inference=ON
     fi
 
-    ARGS=$(getopt -o "h" -l "help,phase:,build-type:,enable-gmssl,enable-all,enable-protocol-mpc-securenn,enable-protocol-mpc-helix,enable-protocol-zk,enable-128bit,enable-tests" -n "$0" -- "$@")
+    ARGS=$(getopt -o "h" -l "help,phase:,build-type:,enable-gmssl,enable-all,enable-protocol-mpc-securenn,enable-protocol-mpc-helix,enable-protocol-mpc-ot2pc,enable-protocol-mpc-shamir,enable-protocol-zk,enable-128bit,enable-tests" -n "$0" -- "$@")
     eval set -- "${ARGS}"
     while true; do
         case "${1}" in
@@ -203,6 +207,14 @@ if [ "${cmd}" = "compile" ]; then
             enable_protocol_mpc_helix=ON
             shift
             ;;
+        --enable-protocol-mpc-ot2pc)
+            enable_protocol_mpc_ot2pc=ON
+            shift
+            ;;
+        --enable-protocol-mpc-shamir)
+            enable_protocol_mpc_shamir=ON
+            shift
+            ;;
         --enable-protocol-zk)
             enable_protocol_zk=ON
             shift
@@ -228,6 +240,8 @@ if [ "${cmd}" = "compile" ]; then
     if [ ${enable_all} -eq 1 ]; then
         enable_protocol_mpc_securenn=ON
         enable_protocol_mpc_helix=ON
+        enable_protocol_mpc_ot2pc=ON
+        enable_protocol_mpc_shamir=ON
         enable_protocol_zk=ON
         enable_128bit=ON
         enable_tests=ON
@@ -246,6 +260,8 @@ if [ "${cmd}" = "compile" ]; then
     export rtt_enable_gmssl=OFF
     export rtt_enable_protocol_mpc_securenn=${enable_protocol_mpc_securenn}
     export rtt_enable_protocol_mpc_helix=${enable_protocol_mpc_helix}
+    export rtt_enable_protocol_mpc_ot2pc=${enable_protocol_mpc_ot2pc}
+    export rtt_enable_protocol_mpc_shamir=${enable_protocol_mpc_shamir}
     export rtt_enable_shape_inference=${enable_shape_inference}
     export rtt_enable_protocol_zk=${enable_protocol_zk}
     export rtt_enable_tests=${enable_tests}